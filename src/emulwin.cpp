@@ -638,8 +638,7 @@ void MainWin::frame_timer() {
 	}
 #if defined(USEOPENGL) && !BLOCKGL
 	if (conf.emu.fast || conf.emu.pause) {
-		glBindTexture(GL_TEXTURE_2D, texids[curtex]);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, bytesPerLine / 4, comp->vid->vsze.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, comp->flgDBG ? scrimg : bufimg);
+		texUpload(curtex, comp->vid, comp->flgDBG);
 		queue.clear();
 		queue.append(texids[curtex]);
 	}
@@ -658,8 +657,7 @@ void MainWin::d_frame() {
 	queue.append(texids[curtex]);
 	if (queue.size() > 3)
 		queue.takeFirst();
-	glBindTexture(GL_TEXTURE_2D, texids[curtex]);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, bytesPerLine / 4, comp->vid->vsze.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, comp->flgDBG ? scrimg : bufimg);
+	texUpload(curtex, comp->vid, comp->flgDBG);
 	curtex++;
 #endif
 }
@@ -719,7 +717,7 @@ void MainWin::paintEvent(QPaintEvent*) {
 	pnt.endNativePainting();
 #else
 	Computer* comp = conf.prof.cur->zx;
-	pnt.drawImage(0, 0, QImage(comp->flgDBG ? scrimg : bufimg, width(), height(), QImage::Format_RGBA8888));
+	pnt.drawImage(0, 0, QImage(comp->flgDBG ? comp->vid->scrimg : comp->vid->bufimg, width(), height(), QImage::Format_RGBA8888));
 #endif
 	drawIcons(pnt);
 	pnt.end();
@@ -893,13 +891,13 @@ void MainWin::screenShot() {
 	std::string fnam(fnams.toUtf8().data());
 	std::ofstream file;
 #if defined(USEOPENGL)
-	QImage img(bufimg, bytesPerLine / 4, comp->vid->vsze.y, QImage::Format_RGBA8888);
+	QImage img(comp->vid->bufimg, bytesPerLine / 4, comp->vid->vsze.y, QImage::Format_RGBA8888);
 	img = img.scaled(width(), height());
 #else
-	QImage img(bufimg, width(), height(), QImage::Format_RGBA8888);
+	QImage img(comp->vid->bufimg, width(), height(), QImage::Format_RGBA8888);
 #endif
 	int x,y,dx,dy;
-	char* sptr = (char*)(comp->mem->ramData + (comp->vid->vidPage << 14));
+	char* sptr = (char*)(comp->mem->ramData + ((comp->vid->vidPage << 14) & comp->mem->ramMask));
 	switch (frm) {
 		case SCR_HOB:
 			file.open(fnam.c_str(),std::ios::binary);
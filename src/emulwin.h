@@ -228,8 +228,11 @@ typedef struct {
 #if defined(USEOPENGL) && !BLOCKGL
 		unsigned curtex:2;
 		GLuint texids[4];
+		int texw[4];		// allocated texture size, texture is reallocated only when it's changed
+		int texh[4];
 		GLuint curtxid;
 		QList<GLuint> queue;
+		void texUpload(int, Video*, int);
 		void initializeGL();
 		void resizeGL(int,int);
 		void paintGL();
@@ -245,6 +248,9 @@ typedef struct {
 		QOpenGLShader* frg_shd;
 		QOpenGLVertexArrayObject vao;
 		QOpenGLBuffer vbo;
+		QOpenGLBuffer pbo[2];	// pixel unpack buffers for frame upload (not created if unsupported)
+		int pbosz[2];		// allocated pbo storage size
+		unsigned curpbo:1;
 #endif
 #endif
 };
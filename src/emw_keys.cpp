@@ -208,6 +208,11 @@ void MainWin::xkey_press(int xkey) {
 				conf.emu.fast ^= 1;
 				updateHead();
 				break;
+			case XCUT_REWIND:
+				if (!conf.emu.rwd) break;
+				conf.emu.back.ref();
+				setMessage(" rewind ");
+				break;
 			case XCUT_TURBO:
 				if (comp->frqMul < 2) {
 					compSetTurbo(comp, 2.0);
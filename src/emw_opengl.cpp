@@ -2,6 +2,7 @@
 
 #include <QRegularExpression>
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 #if defined(USEOPENGL) && !BLOCKGL
@@ -199,6 +200,8 @@ void MainWin::initializeGL() {
 	glGenTextures(4, texids);
 	glEnable(GL_MULTISAMPLE);
 	for (int i = 0; i < 4; i++) {
+		texw[i] = 0;
+		texh[i] = 0;
 		glBindTexture(GL_TEXTURE_2D, texids[i]);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
@@ -221,6 +224,26 @@ void MainWin::initializeGL() {
 	                      reinterpret_cast<void *>(2 * sizeof(GLfloat)));
 	vbo.release();
 	vao.release();
+
+	// PBO: desktop GL 2.1+ or GLES 3+
+	QOpenGLContext* ctx = QOpenGLContext::currentContext();
+	bool pbo_ok = ctx->isOpenGLES()
+		? (ctx->format().majorVersion() >= 3)
+		: ((ctx->format().version() >= qMakePair(2, 1)) || ctx->hasExtension("GL_ARB_pixel_buffer_object"));
+	curpbo = 0;
+	for (int i = 0; i < 2; i++) {
+		pbosz[i] = 0;
+		pbo[i] = QOpenGLBuffer(QOpenGLBuffer::PixelUnpackBuffer);
+		if (pbo_ok) {
+			pbo[i].create();
+			pbo[i].setUsagePattern(QOpenGLBuffer::StreamDraw);
+		}
+	}
+	if (!pbo[0].isCreated() || !pbo[1].isCreated()) {
+		pbo[0].destroy();
+		pbo[1].destroy();
+		qDebug() << "WARNING: PBO not supported, direct texture upload";
+	}
 #endif
 
 	loadShader();
@@ -234,6 +257,8 @@ void MainWin::cleanupGL() {
 	makeCurrent();
 	if (vao.isCreated()) vao.destroy();
 	if (vbo.isCreated()) vbo.destroy();
+	pbo[0].destroy();
+	pbo[1].destroy();
 	prg.removeAllShaders();
 	glDeleteTextures(4, texids);
 	doneCurrent();
@@ -251,6 +276,47 @@ void MainWin::resizeGL(int w, int h) {
 void MainWin::paintGL() {
 }
 
+// upload frame image to texture idx: complete frame (bufimg) or the one being drawn (scrimg, debug).
+// frames are RGBA: palette is applied by vid_dot_* per dot, because it can be changed during frame.
+// texture and PBO storage is allocated only when size is changed, then texture is updated by glTexSubImage2D.
+// with PBOs image is copied into mapped buffer (old content invalidated, so driver doesn't wait for GPU reading it)
+// and texture is updated from buffer asynchronously. PBOs are used by turns.
+void MainWin::texUpload(int idx, Video* vid, int cur) {
+	unsigned char* img = cur ? vid->scrimg : vid->bufimg;
+	int w = cur ? (bytesPerLine >> 2) : vid->bufsz.x;
+	int h = cur ? vid->vsze.y : vid->bufsz.y;
+	if ((w < 1) || (h < 1)) return;
+	glBindTexture(GL_TEXTURE_2D, texids[idx]);
+	if ((texw[idx] != w) || (texh[idx] != h)) {
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		texw[idx] = w;
+		texh[idx] = h;
+	}
+#if !ISLEGACYGL
+	if (pbo[0].isCreated()) {
+		QOpenGLBuffer& buf = pbo[curpbo];
+		int sz = w * h * 4;
+		buf.bind();
+		if (pbosz[curpbo] != sz) {
+			buf.allocate(sz);
+			pbosz[curpbo] = sz;
+		}
+		void* ptr = buf.mapRange(0, sz, QOpenGLBuffer::RangeWrite | QOpenGLBuffer::RangeInvalidateBuffer);
+		if (ptr) {
+			memcpy(ptr, img, sz);
+			buf.unmap();
+		} else {
+			buf.write(0, img, sz);		// no glMapBufferRange (GL < 3.0)
+		}
+		curpbo ^= 1;
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		buf.release();
+		return;
+	}
+#endif
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, img);
+}
+
 #endif
 
 void MainWin::loadShader() {
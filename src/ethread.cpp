@@ -40,6 +40,7 @@ void xThread::stop() {
 }
 
 void xThread::tap_catch_load(Computer* comp) {
+	comp_dev_sync(comp);		// tape must be actual
 	int blk = comp->tape->block;
 	if (blk >= comp->tape->blkCount) return;
 	if (conf.tape.fast && comp->tape->blkData[blk].hasBytes) {
@@ -90,6 +91,7 @@ void xThread::tap_catch_load(Computer* comp) {
 }
 
 void xThread::tap_catch_save(Computer* comp) {
+	comp_dev_sync(comp);
 	if (conf.tape.fast) {
 		unsigned short de = comp->cpu->regDE;	// len
 		unsigned short ix = comp->cpu->regIX;	// adr
@@ -150,6 +152,7 @@ void xThread::emuCycle(Computer* comp) {
 					tap_catch_save(comp);
 				}
 				if (conf.tape.autostart && !conf.tape.fast && ((pc == 0x5df) || (pc == 0x53a))) {
+					comp_dev_sync(comp);
 					comp->tape->sigLen = 1e6;
 					tapNextBlock(comp->tape);
 					tapStop(comp->tape);
@@ -174,7 +177,9 @@ void xThread::emuCycle(Computer* comp) {
 // process noflic/scanlines (if !fast ???)
 // buffers is already switches, bufimg - just painted (greyscale, if flag is set), scrimg - new
 			if (!conf.emu.fast && (noflic > 0))
-				scrMix(pscr, bufimg, bufSize, noflic / 100.0, noflicGamma, noflicMode);
+				scrMix(pscr, comp->vid->bufimg, bufSize, noflic / 100.0, noflicGamma, noflicMode);
+			if (conf.emu.rwd)
+				rw_frame(conf.emu.rwd, comp);
 
 			// printf("s_frame\n");
 			emit s_frame();
@@ -232,7 +237,10 @@ void xThread::emuCycle(Computer* comp) {
 
 void xThread::run() {
 	Computer* comp;
+	int back;
 	conf.snd.need = 0;		// reset sound buffer
+	if (conf.emu.rewind > 0)
+		conf.emu.rwd = rw_create(conf.emu.rewind << 20, 1);
 	do {
 #if !USEMUTEX
 		sleepy = 1;
@@ -246,8 +254,12 @@ void xThread::run() {
 			comp->rzx.fCurrent = 0;
 			rewind(comp->rzx.file);
 			rzxGetFrame(comp);
+			comp_upd_fast(comp);
 		}
 #endif
+		back = conf.emu.back.fetchAndStoreOrdered(0);
+		if ((back > 0) && conf.emu.rwd && rw_back_show(conf.emu.rwd, comp, back))
+			emit s_frame();
 		if (!conf.emu.pause) {
 			emuCycle(comp);
 		}
@@ -262,5 +274,8 @@ void xThread::run() {
 			usleep(10);
 #endif
 	} while (!finish);
+	if (conf.emu.rwd)
+		rw_destroy(conf.emu.rwd);
+	conf.emu.rwd = NULL;
 	exit(0);
 }
@@ -40,6 +40,7 @@ static xFileTypeInfo ft_tab[] = {
 	{FL_SNA, 0, ".sna", "*.sna", loadSNA, saveSNA, "SNA snapshot"},
 	{FL_Z80, 0, ".z80", "*.z80", loadZ80, NULL, "Z80 snapshot"},
 	{FL_SPG, 0, ".spg", "*.spg", loadSPG, NULL, "SPG snapshot"},
+	{FL_XST, 0, ".xst", "*.xst", loadXST, saveXST, "Xpeccy machine state"},
 	{FL_TAP, 0, ".tap", "*.tap", loadTAP, saveTAP, "TAP tape image"},
 	{FL_TZX, 0, ".tzx", "*.tzx", loadTZX, NULL, "TZX tape image"},
 	{FL_WAV, 0, ".wav", "*.wav", loadWAV, saveWAV, "WAV tape image"},
@@ -89,7 +90,7 @@ static xFileTypeInfo ft_dum = {FL_NONE, 0, NULL, NULL, NULL, NULL, "Dummy entry"
 // 0..3 : disk (must be inserted for save)
 // 4 : tape (block count > 0)
 static xFileGroupInfo fg_tab[] = {
-	{FG_SNAPSHOT, ".sna", -1, "Snapshot", NULL, {FL_SNA, FL_Z80, FL_SPG, 0}},
+	{FG_SNAPSHOT, ".sna", -1, "Snapshot", NULL, {FL_SNA, FL_Z80, FL_SPG, FL_XST, 0}},
 	{FG_TAPE, ".tap", 4, "Tape", NULL, {FL_TAP, FL_TZX, FL_WAV, 0}},
 	{FG_DISK_A, ".trd", 0,"Disk A", NULL, {FL_SCL, FL_TRD, FL_TD0, FL_FDI, FL_UDI, FL_DSK, FL_IMA, FL_PCIMG, FL_HOBETA, 0}},
 	{FG_DISK_B, ".trd", 1, "Disk B", NULL, {FL_SCL, FL_TRD, FL_TD0, FL_FDI, FL_UDI, FL_DSK, FL_IMA, FL_PCIMG, FL_HOBETA, 0}},
@@ -331,6 +332,7 @@ static xFilerError err_tab[] = {
 	{ERR_WAV_FORMAT, "Unsupported WAV format"},
 	{ERR_NES_HEAD, "Wrong NES header"},
 	{ERR_NES_MAPPER, "Unsupported mapper"},
+	{ERR_XST_SIGN, "State doesn't fit this machine"},
 	{ERR_T64_SIGN, "Wrong T64 header"},
 	{ERR_C64T_SIGN, "Wrong C64 raw tape header"},
 	{ERR_TRD_SNF, "Wrong disk structure for TRD file"},
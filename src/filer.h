@@ -19,6 +19,7 @@ enum {
 	FL_SNA,
 	FL_Z80,
 	FL_SPG,
+	FL_XST,
 	FL_RZX,
 	FL_HOBETA,
 	FL_RAW,
@@ -0,0 +1,885 @@
+// headless batch runner: libxpeccy only, no Qt/SDL, no sleeping
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "libxpeccy/spectrum.h"
+#include "libxpeccy/filetypes/filetypes.h"
+#include "libxpeccy/rewind.h"
+#include "libxpeccy/trace.h"
+
+#define HL_MAXROMS	16
+#define HL_MAXJOBS	16
+
+typedef struct {
+	char name[FILENAME_MAX];
+	int foff;		// KB
+	int fsize;		// KB, 0 = whole file
+	int roff;		// KB
+} hlRomFile;
+
+typedef struct {
+	char hwName[64];
+	char cpuName[64];
+	char rsName[64];
+	int cpuFrq;		// Hz, 0 = hw default
+	int memory;		// KB, 0 = hw default
+	int resbank;
+	int contmem;
+	int contio;
+	int cpucache;
+	int chip[3];
+	int gs;
+	int gsthread;
+	int saa;
+	int tstype;
+	int sdrv;
+	int diskif;
+	int ideType;
+	int hddLba[2];
+	char hddImage[2][FILENAME_MAX];	// master, slave
+	char sdImage[FILENAME_MAX];
+	int cow;
+	double border;
+	char romDir[FILENAME_MAX];
+	char gsFile[FILENAME_MAX];
+	char fntFile[FILENAME_MAX];
+	int romCount;
+	hlRomFile roms[HL_MAXROMS];
+	xRomImage* rom;		// loaded once, shared by all jobs
+	xRomImage* gsrom;
+} hlSetup;
+
+typedef struct {
+	const char* ext;
+	int(*load)(Computer*, const char*, int);
+} hlLoader;
+
+static hlLoader hlLoadTab[] = {
+	{".sna", loadSNA},
+	{".z80", loadZ80},
+	{".spg", loadSPG},
+	{".xst", loadXST},
+	{".tap", loadTAP},
+	{".tzx", loadTZX},
+	{".wav", loadWAV},
+	{".scl", loadSCL},
+	{".trd", loadTRD},
+	{".td0", loadTD0},
+	{".fdi", loadFDI},
+	{".udi", loadUDI},
+	{".dsk", loadDSK},
+	{".$b", loadHobeta},
+	{".$c", loadHobeta},
+	{".gb", loadGB},
+	{".gbc", loadGB},
+	{".nes", loadNes},
+	{".mx1", loadMSX},
+	{".mx2", loadMSX},
+	{".cas", loadCAS},
+	{".t64", loadT64},
+	{".prg", loadC64prg},
+#ifdef HAVEZLIB
+	{".rzx", loadRZX},
+#endif
+	{NULL, NULL}
+};
+
+void help() {
+	printf("xpeccy-headless command line arguments:\n");
+	printf("-h | --help\t\tshow this help\n");
+	printf("-p | --profile FILE\tload machine settings from profile config FILE\n");
+	printf("-c | --config FILE\tload romsets from main config FILE ([ROMSETS] section)\n");
+	printf("--romdir DIR\t\tdirectory for rom files (default: config file directory)\n");
+	printf("--romset NAME\t\tuse romset NAME from config\n");
+	printf("--hw NAME\t\tset hardware (overrides profile)\n");
+	printf("--rom FILE[:FOFF:FSIZE:ROFF]\tload rom file (offsets/size in KB), can be repeated\n");
+	printf("--memory KB\t\tset RAM size\n");
+	printf("--reset MODE\t\treset to basic48|basic128|shadow|dos\n");
+	printf("-l | --load FILE\tload snapshot/tape/disk/cartrige (by extension), can be repeated\n");
+	printf("-j | --jobs N\t\trun each loaded file on its own machine, N threads in parallel\n");
+	printf("\t\t\t%%i in --scr/--wav/--dump/--state/--trace names is replaced with job number\n");
+	printf("--play\t\t\tstart tape playback after loading\n");
+	printf("--frames N\t\tstop after N frames\n");
+	printf("--ticks N\t\tstop after N cpu ticks\n");
+	printf("--pc ADR\t\tstop when PC reaches ADR\n");
+	printf("--scr FILE\t\tsave last frame as PPM image\n");
+	printf("--wav FILE\t\tsave audio as 16-bit stereo WAV\n");
+	printf("--rate HZ\t\taudio sample rate (default 44100)\n");
+	printf("--dump FILE\t\tsave all RAM banks (as addressed by memory mapper) to FILE\n");
+	printf("--state FILE\t\tsave full machine state to FILE (load it back with -l FILE.xst)\n");
+	printf("--back N\t\trecord rewind ring each frame, step N frames back at the end\n");
+	printf("--trace FILE\t\trecord binary execution trace to FILE\n");
+	printf("--trace-last N\t\tkeep only last N commands of trace (written at the end)\n");
+	printf("--trace-text FILE\tprint trace FILE as text and exit\n");
+	printf("--trace-csv FILE\tprint trace FILE as csv and exit\n");
+	printf("--panic\t\t\tstop on undefined ports/opcodes\n");
+	printf("--no-lazy\t\tdraw video dot by dot through vid_tick (no catch-up rendering, no spans)\n");
+	printf("--gs-thread\t\trun General Sound cpu on its own thread\n");
+	printf("--fdc-turbo\t\tfloppy controller turbo: no seek/spin delays\n");
+	printf("--hdd FILE\t\tIDE master image (interface is set by [IDE] iface in profile)\n");
+	printf("--sd FILE\t\tSD card image\n");
+	printf("--cow\t\t\topen IDE/SD images copy-on-write: files are not changed, so jobs can share them\n");
+}
+
+// config file parsing
+
+static char* hl_trim(char* str) {
+	char* end;
+	while (isspace((unsigned char)*str)) str++;
+	end = str + strlen(str);
+	while ((end > str) && isspace((unsigned char)end[-1])) end--;
+	*end = 0;
+	return str;
+}
+
+// split 'name = value' line, cut comments. return 0 if line is empty
+static int hl_split(char* line, char** pnam, char** pval) {
+	char* ptr = strpbrk(line, "#;");
+	if (ptr) *ptr = 0;
+	ptr = strchr(line, '=');
+	if (ptr) {
+		*ptr = 0;
+		*pval = hl_trim(ptr + 1);
+	} else {
+		*pval = line + strlen(line);
+	}
+	*pnam = hl_trim(line);
+	return **pnam ? 1 : 0;
+}
+
+static int hl_bool(const char* val) {
+	return (!strcasecmp(val, "yes") || !strcasecmp(val, "true") || !strcmp(val, "1")) ? 1 : 0;
+}
+
+static void hl_add_rom(hlSetup* set, const char* str) {
+	hlRomFile* rf;
+	char* ptr;
+	if (set->romCount >= HL_MAXROMS) return;
+	rf = &set->roms[set->romCount++];
+	memset(rf, 0x00, sizeof(hlRomFile));
+	snprintf(rf->name, sizeof(rf->name), "%s", str);
+	ptr = strchr(rf->name, ':');
+	if (ptr) {
+		*ptr = 0;
+		sscanf(ptr + 1, "%i:%i:%i", &rf->foff, &rf->fsize, &rf->roff);
+	}
+}
+
+// add rom as it described in old-style romset entries: file[:part]
+static void hl_add_rom_part(hlSetup* set, const char* str, int roff) {
+	char buf[FILENAME_MAX + 32];
+	char* ptr;
+	int part = 0;
+	strncpy(buf, str, FILENAME_MAX - 1);
+	buf[FILENAME_MAX - 1] = 0;
+	ptr = strrchr(buf, ':');
+	if (ptr) {
+		*ptr = 0;
+		part = atoi(ptr + 1);
+	}
+	sprintf(buf + strlen(buf), ":%i:16:%i", part * 16, roff);
+	hl_add_rom(set, buf);
+}
+
+int hl_load_profile(hlSetup* set, const char* path) {
+	char buf[0x1000];
+	char* pnam;
+	char* pval;
+	char sect[32] = "";
+	int v;
+	FILE* file = fopen(path, "rb");
+	if (!file) return ERR_CANT_OPEN;
+	while (fgets(buf, sizeof(buf), file)) {
+		if (!hl_split(buf, &pnam, &pval)) continue;
+		if (*pnam == '[') {
+			snprintf(sect, sizeof(sect), "%s", pnam);
+			continue;
+		}
+		if (!strcmp(sect, "[MACHINE]") || !strcmp(sect, "[GENERAL]")) {
+			if (!strcmp(pnam, "current")) strncpy(set->hwName, pval, 63);
+			if (!strcmp(pnam, "cpu.type")) strncpy(set->cpuName, pval, 63);
+			if (!strcmp(pnam, "cpu.frq")) {
+				v = strtol(pval, NULL, 0);
+				if ((v > 1) && (v < 58)) v *= 5e5;
+				set->cpuFrq = v;
+			}
+			if (!strcmp(pnam, "memory")) set->memory = strtol(pval, NULL, 0);
+			if (!strcmp(pnam, "contmem")) set->contmem = hl_bool(pval);
+			if (!strcmp(pnam, "contio")) set->contio = hl_bool(pval);
+			if (!strcmp(pnam, "cpu.cache")) set->cpucache = hl_bool(pval);
+		} else if (!strcmp(sect, "[ROMSET]")) {
+			if (!strcmp(pnam, "current")) strncpy(set->rsName, pval, 63);
+			if (!strcmp(pnam, "reset")) {
+				if (!strcmp(pval, "basic128") || !strcmp(pval, "0")) set->resbank = RES_128;
+				if (!strcmp(pval, "basic48") || !strcmp(pval, "1")) set->resbank = RES_48;
+				if (!strcmp(pval, "shadow") || !strcmp(pval, "2")) set->resbank = RES_SHADOW;
+				if (!strcmp(pval, "dos") || !strcmp(pval, "3")) set->resbank = RES_DOS;
+			}
+		} else if (!strcmp(sect, "[SOUND]")) {
+			if (!strcmp(pnam, "chip1")) set->chip[0] = strtol(pval, NULL, 0);
+			if (!strcmp(pnam, "chip2")) set->chip[1] = strtol(pval, NULL, 0);
+			if (!strcmp(pnam, "chip3")) set->chip[2] = strtol(pval, NULL, 0);
+			if (!strcmp(pnam, "gs")) set->gs = hl_bool(pval);
+			if (!strcmp(pnam, "gs.thread")) set->gsthread = hl_bool(pval);
+			if (!strcmp(pnam, "saa")) set->saa = hl_bool(pval);
+			if (!strcmp(pnam, "ts.type")) set->tstype = strtol(pval, NULL, 0);
+			if (!strcmp(pnam, "soundrive_type")) set->sdrv = strtol(pval, NULL, 0);
+		} else if (!strcmp(sect, "[DISK]")) {
+			if (!strcmp(pnam, "type")) set->diskif = strtol(pval, NULL, 0);
+		} else if (!strcmp(sect, "[IDE]")) {
+			if (!strcmp(pnam, "iface")) set->ideType = strtol(pval, NULL, 0);
+			if (!strcmp(pnam, "master.lba")) set->hddLba[0] = hl_bool(pval);
+			if (!strcmp(pnam, "master.image")) strncpy(set->hddImage[0], pval, FILENAME_MAX - 1);
+			if (!strcmp(pnam, "slave.lba")) set->hddLba[1] = hl_bool(pval);
+			if (!strcmp(pnam, "slave.image")) strncpy(set->hddImage[1], pval, FILENAME_MAX - 1);
+		} else if (!strcmp(sect, "[SDC]")) {
+			if (!strcmp(pnam, "sdcimage")) strncpy(set->sdImage, pval, FILENAME_MAX - 1);
+		}
+	}
+	fclose(file);
+	return ERR_OK;
+}
+
+// find romset @name in [ROMSETS] section of main config
+int hl_load_romset(hlSetup* set, const char* path, const char* name) {
+	char buf[0x1000];
+	char* pnam;
+	char* pval;
+	int sect = 0;
+	int found = 0;
+	FILE* file = fopen(path, "rb");
+	if (!file) return ERR_CANT_OPEN;
+	while (fgets(buf, sizeof(buf), file)) {
+		if (!hl_split(buf, &pnam, &pval)) continue;
+		if (*pnam == '[') {
+			sect = !strcmp(pnam, "[ROMSETS]");
+			found = 0;
+			continue;
+		}
+		if (!sect) continue;
+		if (!strcmp(pnam, "name")) {
+			found = !strcmp(pval, name);
+			if (found) set->romCount = 0;
+		}
+		if (!found) continue;
+		if (!strcmp(pnam, "rom")) hl_add_rom(set, pval);
+		if (!strcmp(pnam, "file")) hl_add_rom(set, pval);
+		if (!strcmp(pnam, "basic128") || !strcmp(pnam, "0")) hl_add_rom_part(set, pval, 0);
+		if (!strcmp(pnam, "basic48") || !strcmp(pnam, "1")) hl_add_rom_part(set, pval, 16);
+		if (!strcmp(pnam, "shadow") || !strcmp(pnam, "2")) hl_add_rom_part(set, pval, 32);
+		if (!strcmp(pnam, "trdos") || !strcmp(pnam, "3")) hl_add_rom_part(set, pval, 48);
+		if (!strcmp(pnam, "gs")) strncpy(set->gsFile, pval, FILENAME_MAX - 1);
+		if (!strcmp(pnam, "font")) strncpy(set->fntFile, pval, FILENAME_MAX - 1);
+	}
+	fclose(file);
+	return ERR_OK;
+}
+
+// machine setup
+
+// rom files are searched in romdir first, then as is
+static FILE* hl_open_rom(hlSetup* set, const char* name, char* path) {
+	FILE* file = NULL;
+	if (set->romDir[0] && (name[0] != SLSH)) {
+		sprintf(path, "%s%s%s", set->romDir, SLASH, name);
+		file = fopen(path, "rb");
+	}
+	if (!file) {
+		strcpy(path, name);
+		file = fopen(path, "rb");
+	}
+	if (!file)
+		printf("Can't load rom file '%s'\n", name);
+	return file;
+}
+
+static xRomImage* hl_rom_image(hlSetup* set) {
+	char path[FILENAME_MAX * 2 + 2];
+	unsigned char* buf = malloc(MEM_512K);
+	xRomImage* img;
+	int romsz = MEM_256;
+	int foff, fsze, roff;
+	int i;
+	FILE* file;
+	memset(buf, 0xff, MEM_512K);
+	for (i = 0; i < set->romCount; i++) {
+		file = hl_open_rom(set, set->roms[i].name, path);
+		if (!file) continue;
+		foff = set->roms[i].foff * 1024;
+		roff = set->roms[i].roff * 1024;
+		if (set->roms[i].fsize <= 0) {
+			fsze = fgetSize(file);
+		} else {
+			fsze = set->roms[i].fsize * 1024;
+		}
+		if (roff + fsze > romsz) {
+			romsz = roff + fsze;
+			if (romsz > MEM_512K) romsz = MEM_512K;
+			while (romsz & (romsz - 1))
+				romsz += romsz & -romsz;
+		}
+		if (roff + fsze > romsz)
+			fsze = romsz - roff;
+		if ((foff >= 0) && (roff >= 0) && (roff < MEM_512K) && (fsze > 0)) {
+			fseek(file, foff, SEEK_SET);
+			fread(buf + roff, fsze, 1, file);
+		}
+		fclose(file);
+	}
+	img = rom_image_create(buf, romsz);
+	free(buf);
+	return img;
+}
+
+static xRomImage* hl_gs_image(hlSetup* set) {
+	char path[FILENAME_MAX * 2 + 2];
+	unsigned char buf[MEM_32K];
+	FILE* file = hl_open_rom(set, set->gsFile, path);
+	memset(buf, 0xff, MEM_32K);
+	if (file) {
+		fread(buf, MEM_32K, 1, file);
+		fclose(file);
+	}
+	return rom_image_create(buf, MEM_32K);
+}
+
+void hl_load_roms(Computer* comp, hlSetup* set) {
+	char path[FILENAME_MAX * 2 + 2];
+	FILE* file;
+	if (!set->rom)
+		set->rom = hl_rom_image(set);
+	mem_set_rom(comp->mem, set->rom);
+	if (set->gsFile[0]) {
+		if (!set->gsrom)
+			set->gsrom = hl_gs_image(set);
+		mem_set_rom(comp->gs->mem, set->gsrom);
+	}
+	if (set->fntFile[0]) {
+		file = hl_open_rom(set, set->fntFile, path);
+		if (file) {
+			fclose(file);
+			vid_fnt_load(comp->vid, path);
+		}
+	}
+}
+
+Computer* hl_create(hlSetup* set) {
+	Computer* comp = compCreate();
+	vLayout vlay = {{448,320},{72,64},{64,16},{256,192},{0,0},64};
+	xColor xcol;
+	int tmask;
+	int i;
+	if (set->cpuName[0])
+		cpu_set_type(comp->cpu, set->cpuName, NULL, NULL);
+	if (set->cpuFrq > 0)
+		compSetBaseFrq(comp, set->cpuFrq / 1e6);
+	comp->flgCNTM = set->contmem;
+	comp->flgCNTI = set->contio;
+	cpu_set_cache(comp->cpu, set->cpucache);
+	comp->resbank = set->resbank;
+	comp->gs->enable = set->gs;
+	gs_thread(comp->gs, set->gsthread);
+	comp->saa->enabled = set->saa;
+	comp->ts->type = set->tstype;
+	comp->sdrv->type = set->sdrv;
+	chip_set_type(comp->ts->chipA, set->chip[0]);
+	chip_set_type(comp->ts->chipB, set->chip[1]);
+	chip_set_type(comp->ts->chipC, set->chip[2]);
+	difSetHW(comp->dif, set->diskif);
+	if (set->ideType)
+		ide_set_type(comp->ide, set->ideType);
+	comp->ide->master->hasLBA = set->hddLba[0];
+	comp->ide->master->cow = set->cow;
+	if (set->hddImage[0][0])
+		ideSetImage(comp->ide, IDE_MASTER, set->hddImage[0]);
+	comp->ide->slave->hasLBA = set->hddLba[1];
+	comp->ide->slave->cow = set->cow;
+	if (set->hddImage[1][0])
+		ideSetImage(comp->ide, IDE_SLAVE, set->hddImage[1]);
+	comp->sdc->cow = set->cow;
+	if (set->sdImage[0])
+		sdcSetImage(comp->sdc, set->sdImage);
+	if (!compSetHardware(comp, set->hwName)) {
+		printf("Can't find hardware '%s', set to 'Dummy'\n", set->hwName);
+		compSetHardware(comp, "Dummy");
+	}
+	hl_load_roms(comp, set);
+	tmask = set->memory ? (set->memory << 10) : MEM_4M;
+	if ((comp->hw->mask != 0) && (~comp->hw->mask & tmask)) {
+		tmask = MEM_4M;
+		while (!(comp->hw->mask & tmask) && tmask)
+			tmask >>= 1;
+	}
+	memSetSize(comp->mem, tmask, -1);
+	comp_set_layout(comp, &vlay);
+	vid_set_border(comp->vid, set->border);
+	for (i = 0; i < 16; i++) {		// default palette (see loadPalette)
+		xcol.b = (i & 1) ? ((i & 8) ? 0xff : 0xaa) : 0x00;
+		xcol.r = (i & 2) ? ((i & 8) ? 0xff : 0xaa) : 0x00;
+		xcol.g = (i & 4) ? ((i & 8) ? 0xff : 0xaa) : 0x00;
+		vid_set_bcol(comp->vid, i, xcol);
+		vid_set_col(comp->vid, i, xcol);
+	}
+	// each dot is 2 pixels wide (as opengl output), no line doubling
+	xstep = 0x200;
+	ystep = 0x100;
+	bytesPerLine = comp->vid->vsze.x * 8;
+	bufSize = bytesPerLine * comp->vid->vsze.y;
+	compReset(comp, RES_DEFAULT);
+	comp_kbd_release(comp);		// keyboard matrix is 'all pressed' until released (see prfSetCurrent)
+	mouseReleaseAll(comp->mouse);
+	return comp;
+}
+
+int hl_load_file(Computer* comp, const char* path) {
+	const char* ext = strrchr(path, '.');
+	int i;
+	if (ext) {
+		for (i = 0; hlLoadTab[i].ext; i++) {
+			if (!strcasecmp(ext, hlLoadTab[i].ext))
+				return hlLoadTab[i].load(comp, path, 0);
+		}
+	}
+	printf("Unknown file type '%s'\n", path);
+	return ERR_CANT_OPEN;
+}
+
+// output
+
+int hl_save_scr(Computer* comp, const char* path) {
+	int wid = comp->vid->vsze.x * 2;
+	int hei = comp->vid->vsze.y;
+	unsigned char* ptr;
+	int x, y;
+	FILE* file = fopen(path, "wb");
+	if (!file) return ERR_CANT_OPEN;
+	fprintf(file, "P6\n%i %i\n255\n", wid, hei);
+	for (y = 0; y < hei; y++) {
+		ptr = comp->vid->bufimg + y * bytesPerLine;
+		for (x = 0; x < wid; x++) {
+			fputc(ptr[0], file);		// ABGR, R = LSB
+			fputc(ptr[1], file);
+			fputc(ptr[2], file);
+			ptr += 4;
+		}
+	}
+	fclose(file);
+	return ERR_OK;
+}
+
+// whole ram buffer under ramMask: machines map banks there by own numbers (zx48 uses banks 5,2,0 of 128K)
+int hl_save_dump(Computer* comp, const char* path) {
+	int size = comp->mem->ramMask + 1;
+	FILE* file = fopen(path, "wb");
+	if (!file) return ERR_CANT_OPEN;
+	if (size > comp->mem->ramAlloc)
+		size = comp->mem->ramAlloc;
+	fwrite(comp->mem->ramData, size, 1, file);
+	fclose(file);
+	return ERR_OK;
+}
+
+static void hl_wav_head(FILE* file, int rate, unsigned int size) {
+	wavHead hd;
+	memcpy(hd.chunkId, "RIFF", 4);
+	hd.chunkSize = size + sizeof(wavHead) - 8;
+	memcpy(hd.format, "WAVE", 4);
+	memcpy(hd.subchunk1Id, "fmt ", 4);
+	hd.subchunk1Size = 16;
+	hd.audioFormat = 1;
+	hd.numChannels = 2;
+	hd.sampleRate = rate;
+	hd.byteRate = rate * 4;
+	hd.blockAlign = 4;
+	hd.bitsPerSample = 16;
+	memcpy(hd.subchunk2Id, "data", 4);
+	hd.subchunk2Size = size;
+	fseek(file, 0, SEEK_SET);
+	fwrite(&hd, sizeof(wavHead), 1, file);
+}
+
+static void hl_put_smp(FILE* file, int val) {
+	if (val > 0x7fff) val = 0x7fff;
+	if (val < -0x8000) val = -0x8000;
+	fputc(val & 0xff, file);
+	fputc((val >> 8) & 0xff, file);
+}
+
+// run
+
+typedef struct {
+	long frames;
+	long long ticks;
+	int stopPC;
+	int rate;
+	int play;
+	const char* scrPath;
+	const char* wavPath;
+	const char* dumpPath;
+	const char* statePath;
+	const char* tracePath;
+	int traceLast;
+	int back;
+} hlRun;
+
+typedef struct {
+	int idx;
+	const char* name;
+	Computer* comp;
+	long fcnt;
+	long long tcnt;
+	double hsec;
+} hlJob;
+
+typedef struct {
+	hlRun* run;
+	hlJob* jobs;
+	int count;
+	int next;
+	int multi;		// 1 if output names must be numbered
+	pthread_mutex_t lock;
+} hlPool;
+
+static double hl_time() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// %i in path is replaced with job number; if there is no %i, number is appended for multiple jobs
+static const char* hl_job_path(char* buf, const char* path, int idx, int multi) {
+	const char* ptr;
+	if (!path) return NULL;
+	ptr = strstr(path, "%i");
+	if (ptr) {
+		snprintf(buf, FILENAME_MAX, "%.*s%i%s", (int)(ptr - path), path, idx, ptr + 2);
+	} else if (multi) {
+		snprintf(buf, FILENAME_MAX, "%s.%i", path, idx);
+	} else {
+		return path;
+	}
+	return buf;
+}
+
+static void hl_run_job(hlRun* run, hlJob* job, int multi) {
+	Computer* comp = job->comp;
+	char path[FILENAME_MAX];
+	const char* fnam;
+	long smpNs = 0;
+	int nsPerSmp = 1e9 / run->rate / BLEP_POLL;		// output level polling period
+	unsigned int wavSize = 0;
+	FILE* wav = NULL;
+	sndPair lev;
+	sndPair smp[16];
+	int cnt;
+	int i;
+	sndVolume vol = {100, 100, 100, 100, 100, 100, 100};
+	xRewind* rwd = NULL;
+	xTrace* trc = NULL;
+	double tbgn;
+
+	if (run->play)
+		tapPlay(comp->tape);
+	fnam = hl_job_path(path, run->wavPath, job->idx, multi);
+	if (fnam) {
+		wav = fopen(fnam, "wb");
+		if (wav) {
+			hl_wav_head(wav, run->rate, 0);
+		} else {
+			printf("Can't create '%s'\n", fnam);
+		}
+	}
+	blepSetRate(comp->blep, run->rate);
+	if (run->back > 0)
+		rwd = rw_create(256 << 20, 1);
+	fnam = hl_job_path(path, run->tracePath, job->idx, multi);
+	if (fnam) {
+		trc = trc_create(comp, run->traceLast ? NULL : fnam, run->traceLast);
+		if (!trc)
+			printf("Can't create '%s'\n", fnam);
+	}
+	job->fcnt = 0;
+	job->tcnt = 0;
+	tbgn = hl_time();
+	while (1) {
+		if ((run->stopPC >= 0) && (cpu_get_pc(comp->cpu) == run->stopPC)) break;
+		if ((run->ticks >= 0) && (job->tcnt >= run->ticks)) break;
+		if ((run->frames >= 0) && (job->fcnt >= run->frames)) break;
+		comp->flgDBG = 1;		// breakpoints are not used here
+		smpNs += compExec(comp);
+		job->tcnt = comp->tickCount;
+		if (comp->flgFRM) {
+			comp->flgFRM = 0;
+			job->fcnt++;
+			if (rwd) rw_frame(rwd, comp);
+		}
+		while (smpNs >= nsPerSmp) {
+			smpNs -= nsPerSmp;
+			if (wav) {
+				comp_snd_sync(comp);
+				if (comp->hw->grp == HWG_ZX)
+					gsFlush(comp->gs);
+				lev = comp->hw->vol(comp, &vol);
+				blepSync(comp->blep, nsPerSmp);
+				blepLevel(comp->blep, lev);
+				while ((cnt = blepRead(comp->blep, smp, 16)) > 0) {
+					for (i = 0; i < cnt; i++) {
+						hl_put_smp(wav, smp[i].left);
+						hl_put_smp(wav, smp[i].right);
+						wavSize += 4;
+					}
+				}
+			}
+		}
+		if (comp->flgBRK) {
+			comp->flgBRK = 0;
+			if (comp->brkt == -2) break;		// IRQ_STOP (--panic)
+		}
+	}
+	if (rwd) {
+		if (rw_back_show(rwd, comp, run->back))
+			job->tcnt = comp->tickCount;
+		rw_destroy(rwd);
+	}
+	job->hsec = hl_time() - tbgn;
+	if (trc) {
+		if (run->traceLast && !trc_save(trc, fnam))
+			printf("Can't save trace to '%s'\n", fnam);
+		trc_destroy(trc);
+	}
+	if (wav) {
+		hl_wav_head(wav, run->rate, wavSize);
+		fclose(wav);
+	}
+	fnam = hl_job_path(path, run->scrPath, job->idx, multi);
+	if (fnam && (hl_save_scr(comp, fnam) != ERR_OK))
+		printf("Can't save screen to '%s'\n", fnam);
+	fnam = hl_job_path(path, run->dumpPath, job->idx, multi);
+	if (fnam && (hl_save_dump(comp, fnam) != ERR_OK))
+		printf("Can't save dump to '%s'\n", fnam);
+	fnam = hl_job_path(path, run->statePath, job->idx, multi);
+	if (fnam && (saveXST(comp, fnam, 0) != ERR_OK))
+		printf("Can't save state to '%s'\n", fnam);
+}
+
+// worker thread: take next job from pool until all jobs are done
+static void* hl_worker(void* ptr) {
+	hlPool* pool = (hlPool*)ptr;
+	int idx;
+	while (1) {
+		pthread_mutex_lock(&pool->lock);
+		idx = pool->next++;
+		pthread_mutex_unlock(&pool->lock);
+		if (idx >= pool->count) break;
+		hl_run_job(pool->run, &pool->jobs[idx], pool->multi);
+	}
+	return NULL;
+}
+
+static void hl_print_job(hlJob* job) {
+	if (job->name)
+		printf("[%i] %s: ", job->idx, job->name);
+	printf("frames: %li, ticks: %lli, pc: %.4X, host time: %.3f s", job->fcnt, job->tcnt, cpu_get_pc(job->comp->cpu), job->hsec);
+	if (job->hsec > 0)
+		printf(", speed: %.1f fps", job->fcnt / job->hsec);
+	printf("\n");
+}
+
+int main(int ac, char** av) {
+	hlSetup set;
+	hlRun run;
+	hlPool pool;
+	hlJob jobs[HL_MAXJOBS];
+	pthread_t thr[HL_MAXJOBS];
+	char* parg;
+	char* cfgPath = NULL;
+	char* loads[16];
+	int lcnt = 0;
+	int threads = 0;
+	int i = 1;
+	int err;
+	double tbgn;
+
+	tClock = clock();
+	memset(&set, 0x00, sizeof(hlSetup));
+	strcpy(set.hwName, "ZX48K");
+	set.resbank = RES_48;
+	set.chip[0] = SND_AY;
+	set.border = 0.5;
+	set.hddLba[0] = 1;
+	set.hddLba[1] = 1;
+	memset(&run, 0x00, sizeof(hlRun));
+	run.frames = -1;
+	run.ticks = -1;
+	run.stopPC = -1;
+	run.rate = 44100;
+
+	while (i < ac) {
+		parg = av[i++];
+		if (!strcmp(parg, "-h") || !strcmp(parg, "--help")) {
+			help();
+			return 0;
+		} else if (!strcmp(parg, "--panic")) {
+			compflags |= CFLG_PANIC;
+		} else if (!strcmp(parg, "--no-lazy")) {
+			compflags |= CFLG_NOLAZY;
+		} else if (!strcmp(parg, "--gs-thread")) {
+			set.gsthread = 1;
+		} else if (!strcmp(parg, "--fdc-turbo")) {
+			fdcFlag |= FDC_FAST;
+		} else if (!strcmp(parg, "--play")) {
+			run.play = 1;
+		} else if (!strcmp(parg, "--cow")) {
+			set.cow = 1;
+		} else if (i < ac) {
+			if (!strcmp(parg, "-p") || !strcmp(parg, "--profile")) {
+				if (hl_load_profile(&set, av[i]) != ERR_OK)
+					printf("Can't open profile '%s'\n", av[i]);
+			} else if (!strcmp(parg, "-c") || !strcmp(parg, "--config")) {
+				cfgPath = av[i];
+				if (!set.romDir[0]) {
+					strncpy(set.romDir, cfgPath, FILENAME_MAX - 1);
+					parg = strrchr(set.romDir, SLSH);
+					if (parg) {
+						strcpy(parg, SLASH "roms");
+					} else {
+						strcpy(set.romDir, "roms");
+					}
+				}
+			} else if (!strcmp(parg, "--romdir")) {
+				strncpy(set.romDir, av[i], FILENAME_MAX - 1);
+			} else if (!strcmp(parg, "--romset")) {
+				strncpy(set.rsName, av[i], 63);
+			} else if (!strcmp(parg, "--hw")) {
+				strncpy(set.hwName, av[i], 63);
+			} else if (!strcmp(parg, "--rom")) {
+				hl_add_rom(&set, av[i]);
+			} else if (!strcmp(parg, "--hdd")) {
+				strncpy(set.hddImage[0], av[i], FILENAME_MAX - 1);
+			} else if (!strcmp(parg, "--sd")) {
+				strncpy(set.sdImage, av[i], FILENAME_MAX - 1);
+			} else if (!strcmp(parg, "--memory")) {
+				set.memory = strtol(av[i], NULL, 0);
+			} else if (!strcmp(parg, "--reset")) {
+				if (!strcmp(av[i], "basic128")) set.resbank = RES_128;
+				if (!strcmp(av[i], "basic48")) set.resbank = RES_48;
+				if (!strcmp(av[i], "shadow")) set.resbank = RES_SHADOW;
+				if (!strcmp(av[i], "dos")) set.resbank = RES_DOS;
+			} else if (!strcmp(parg, "-l") || !strcmp(parg, "--load")) {
+				if (lcnt < 16) loads[lcnt++] = av[i];
+			} else if (!strcmp(parg, "-j") || !strcmp(parg, "--jobs")) {
+				threads = strtol(av[i], NULL, 0);
+				if (threads < 1) threads = 1;
+				if (threads > HL_MAXJOBS) threads = HL_MAXJOBS;
+			} else if (!strcmp(parg, "--frames")) {
+				run.frames = strtol(av[i], NULL, 0);
+			} else if (!strcmp(parg, "--ticks")) {
+				run.ticks = strtoll(av[i], NULL, 0);
+			} else if (!strcmp(parg, "--pc")) {
+				run.stopPC = strtol(av[i], NULL, 0);
+			} else if (!strcmp(parg, "--scr")) {
+				run.scrPath = av[i];
+			} else if (!strcmp(parg, "--wav")) {
+				run.wavPath = av[i];
+			} else if (!strcmp(parg, "--rate")) {
+				run.rate = strtol(av[i], NULL, 0);
+				if ((run.rate < 8000) || (run.rate > 192000)) run.rate = 44100;
+			} else if (!strcmp(parg, "--dump")) {
+				run.dumpPath = av[i];
+			} else if (!strcmp(parg, "--state")) {
+				run.statePath = av[i];
+			} else if (!strcmp(parg, "--back")) {
+				run.back = strtol(av[i], NULL, 0);
+			} else if (!strcmp(parg, "--trace")) {
+				run.tracePath = av[i];
+			} else if (!strcmp(parg, "--trace-last")) {
+				run.traceLast = strtol(av[i], NULL, 0);
+				if (run.traceLast < 0) run.traceLast = 0;
+			} else if (!strcmp(parg, "--trace-text") || !strcmp(parg, "--trace-csv")) {
+				if (trc_decode(av[i], stdout, !strcmp(parg, "--trace-csv")) < 0) {
+					printf("Can't read trace '%s'\n", av[i]);
+					return 1;
+				}
+				return 0;
+			} else {
+				printf("Unknown argument '%s'\n", parg);
+				return 1;
+			}
+			i++;
+		} else {
+			printf("Unknown argument '%s'\n", parg);
+			return 1;
+		}
+	}
+	if (run.frames < 0 && run.ticks < 0 && run.stopPC < 0) {
+		printf("No stop condition (--frames, --ticks or --pc), set to 50 frames\n");
+		run.frames = 50;
+	}
+	if (cfgPath && set.rsName[0]) {
+		set.romCount = 0;
+		if (hl_load_romset(&set, cfgPath, set.rsName) != ERR_OK)
+			printf("Can't open config '%s'\n", cfgPath);
+		if (!set.romCount)
+			printf("Romset '%s' not found\n", set.rsName);
+		for (i = 1; i < ac - 1; i++) {		// --rom keys overrides romset
+			if (!strcmp(av[i], "--rom"))
+				hl_add_rom(&set, av[i + 1]);
+		}
+	}
+
+	// machines are created and loaded here, in main thread. each one is independent, so they can be run in parallel
+	memset(jobs, 0x00, sizeof(jobs));
+	if (threads < 1) {
+		pool.count = 1;
+		jobs[0].comp = hl_create(&set);
+		for (i = 0; i < lcnt; i++) {
+			err = hl_load_file(jobs[0].comp, loads[i]);
+			if (err != ERR_OK)
+				printf("Can't load '%s' (error %i)\n", loads[i], err);
+		}
+	} else {
+		pool.count = lcnt ? lcnt : 1;
+		for (i = 0; i < pool.count; i++) {
+			jobs[i].idx = i;
+			jobs[i].comp = hl_create(&set);
+			if (i < lcnt) {
+				jobs[i].name = loads[i];
+				err = hl_load_file(jobs[i].comp, loads[i]);
+				if (err != ERR_OK)
+					printf("Can't load '%s' (error %i)\n", loads[i], err);
+			}
+		}
+		if (threads > pool.count)
+			threads = pool.count;
+	}
+	pool.run = &run;
+	pool.jobs = jobs;
+	pool.next = 0;
+	pool.multi = (pool.count > 1);
+	pthread_mutex_init(&pool.lock, NULL);
+	tbgn = hl_time();
+	if (threads < 2) {
+		hl_worker(&pool);
+	} else {
+		for (i = 0; i < threads; i++)
+			pthread_create(&thr[i], NULL, hl_worker, &pool);
+		for (i = 0; i < threads; i++)
+			pthread_join(thr[i], NULL);
+	}
+	pthread_mutex_destroy(&pool.lock);
+	for (i = 0; i < pool.count; i++) {
+		hl_print_job(&jobs[i]);
+		compDestroy(jobs[i].comp);
+	}
+	if (set.rom) rom_image_destroy(set.rom);
+	if (set.gsrom) rom_image_destroy(set.gsrom);
+	if (pool.count > 1)
+		printf("jobs: %i, threads: %i, total host time: %.3f s\n", pool.count, threads, hl_time() - tbgn);
+	return 0;
+}
@@ -763,6 +763,7 @@ void sltEject(xCartridge* slot) {
 		free(slot->brkMap);
 		slot->brkMap = NULL;
 	}
+	slot->brkCount = 0;
 	// free chr-rom
 	if (slot->chrrom) {
 		free(slot->chrrom);
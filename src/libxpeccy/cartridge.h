@@ -127,6 +127,7 @@ struct xCartridge {
 	xCardCallback* core;
 	unsigned char* data;		// onboard rom (malloc) = nes prg-rom
 	unsigned char* brkMap;
+	int brkCount;			// armed cells in brkMap (see comp_set_slot_brk)
 	unsigned char* chrrom;		// nes chr rom (malloc)
 };
 
@@ -257,10 +257,6 @@ void pdp_dst(CPU* cpu, unsigned short wrd, int type, int b) {
 
 // commands
 
-static unsigned short twsrc;
-static unsigned short twdst;
-static int twres;
-
 void pdp_undef(CPU* cpu) {
 	printf("undef command %.4X : %.4X\n", cpu->regRN(7) - 2, cpu->com);
 //	cpu->xirq(IRQ_BRK, cpu->xptr);
@@ -371,13 +367,13 @@ void pdp_000x(CPU* cpu) {
 
 //0000 0000 01dd dddd	jmp		r7 = [dd]
 void pdp_jmp(CPU* cpu) {
-	twres = pdp_adr(cpu, cpu->com, 0);
-	if (twres < 0) {
+	cpu->twres = pdp_adr(cpu, cpu->com, 0);
+	if (cpu->twres < 0) {
 		cpu->regMCIR = 5;
 		cpu->regVCEL = 4;
 		pdp_trap(cpu, 4);
 	} else {
-		cpu->regRN(7) = twres & 0xffff;
+		cpu->regRN(7) = cpu->twres & 0xffff;
 	}
 }
 
@@ -415,14 +411,14 @@ void pdp_se(CPU* cpu) {
 // 0000 0000 11dd dddd	swab		swap hi/lo bytes in [dd]
 void pdp_swab(CPU* cpu) {
 	// cpu->mcir = 7;
-	twsrc = pdp_src(cpu, cpu->com, 0);
-	twdst = ((twsrc << 8) & 0xff00) | ((twsrc >> 8) & 0xff);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twdst = ((cpu->twsrc << 8) & 0xff00) | ((cpu->twsrc >> 8) & 0xff);
 	//cpu->f &= ~(PDP_FC | PDP_FV | PDP_FN | PDP_FZ);	// reset c,v
 	cpu->flgC = 0;
 	cpu->flgV = 0;
-	cpu->flgN = !!(twdst & 0x80);
-	cpu->flgZ = !(twdst & 0xff);
-	pdp_wres(cpu, cpu->com, twdst);
+	cpu->flgN = !!(cpu->twdst & 0x80);
+	cpu->flgZ = !(cpu->twdst & 0xff);
+	pdp_wres(cpu, cpu->com, cpu->twdst);
 }
 
 static cbcpu pdp_00nx_tab[16] = {
@@ -439,10 +435,10 @@ void pdp_00xx(CPU* cpu) {
 // conditional jumps
 
 void pdp_jr(CPU* cpu) {
-	twsrc = (cpu->com << 1) & 0x1fe;
-	if (twsrc & 0x100)
-		twsrc |= 0xff00;
-	cpu->regRN(7) += twsrc;
+	cpu->twsrc = (cpu->com << 1) & 0x1fe;
+	if (cpu->twsrc & 0x100)
+		cpu->twsrc |= 0xff00;
+	cpu->regRN(7) += cpu->twsrc;
 }
 
 // br
@@ -468,8 +464,8 @@ void pdp_03xx(CPU* cpu) {
 // bge
 void pdp_04xx(CPU* cpu) {
 	cpu->t += 12;
-//	twres = cpu->flgN;
-//	if (cpu->flgV) twres ^= 1;
+//	cpu->twres = cpu->flgN;
+//	if (cpu->flgV) cpu->twres ^= 1;
 	if (!(cpu->flgN ^ cpu->flgV))
 		pdp_jr(cpu);
 }
@@ -477,8 +473,8 @@ void pdp_04xx(CPU* cpu) {
 // blt
 void pdp_05xx(CPU* cpu) {
 	cpu->t += 12;
-//	twres = (cpu->f & PDP_FN) ? 1 : 0;
-//	if (cpu->f & PDP_FV) twres ^= 1;
+//	cpu->twres = (cpu->f & PDP_FN) ? 1 : 0;
+//	if (cpu->f & PDP_FV) cpu->twres ^= 1;
 	if (cpu->flgN ^ cpu->flgV)
 		pdp_jr(cpu);
 }
@@ -486,9 +482,9 @@ void pdp_05xx(CPU* cpu) {
 // bgt
 void pdp_06xx(CPU* cpu) {
 	cpu->t += 12;
-//	twres = (cpu->f & PDP_FN) ? 1 : 0;
-//	if (cpu->f & PDP_FV) twres ^= 1;
-//	if (cpu->f & PDP_FZ) twres |= 1;
+//	cpu->twres = (cpu->f & PDP_FN) ? 1 : 0;
+//	if (cpu->f & PDP_FV) cpu->twres ^= 1;
+//	if (cpu->f & PDP_FZ) cpu->twres |= 1;
 	if (!(cpu->flgZ | (cpu->flgN ^ cpu->flgV)))
 		pdp_jr(cpu);
 }
@@ -496,9 +492,9 @@ void pdp_06xx(CPU* cpu) {
 // ble
 void pdp_07xx(CPU* cpu) {
 	cpu->t += 12;
-//	twres = (cpu->f & PDP_FN) ? 1 : 0;
-//	if (cpu->f & PDP_FV) twres ^= 1;
-//	if (cpu->f & PDP_FZ) twres |= 1;
+//	cpu->twres = (cpu->f & PDP_FN) ? 1 : 0;
+//	if (cpu->f & PDP_FV) cpu->twres ^= 1;
+//	if (cpu->f & PDP_FZ) cpu->twres |= 1;
 	if (cpu->flgZ | (cpu->flgN ^ cpu->flgV))
 		pdp_jr(cpu);
 }
@@ -506,18 +502,18 @@ void pdp_07xx(CPU* cpu) {
 // 0000 100r rrdd dddd	jsr		push reg:reg=r7:r7=[dd]
 // !!! if addressation method = 0, exception (4)
 void pdp_jsr(CPU* cpu) {
-	twres = pdp_adr(cpu, cpu->com, 0);
-	if (twres < 0) {		// addr type 0: exception
+	cpu->twres = pdp_adr(cpu, cpu->com, 0);
+	if (cpu->twres < 0) {		// addr type 0: exception
 		cpu->regMCIR = 5;
 		cpu->regVCEL = 4;
 		pdp_trap(cpu, 4);
 	} else {
 		// cpu->mcir = 4;
-		twsrc = (cpu->com >> 6) & 7;
+		cpu->twsrc = (cpu->com >> 6) & 7;
 		cpu->regRN(6) -= 2;
-		pdp_wr(cpu, cpu->regRN(6), cpu->regRN(twsrc));
-		cpu->regRN(twsrc) = cpu->regRN(7);
-		cpu->regRN(7) = twres & 0xffff;
+		pdp_wr(cpu, cpu->regRN(6), cpu->regRN(cpu->twsrc));
+		cpu->regRN(cpu->twsrc) = cpu->regRN(7);
+		cpu->regRN(7) = cpu->twres & 0xffff;
 	}
 }
 
@@ -536,12 +532,12 @@ void pdp_clr(CPU* cpu) {
 //0000 1010 01dd dddd	com		invert all bits (cpl)
 void pdp_com(CPU* cpu) {
 //	cpu->mcir = (cpu->com & 0x38) ? 7 : 5;
-	twsrc = pdp_src(cpu, cpu->com, 0);
-	twsrc ^= 0xffff;
-	pdp_wres(cpu, cpu->com, twsrc);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc ^= 0xffff;
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 //	cpu->f |= PDP_FC;
-	cpu->flgZ = !twsrc;
-	cpu->flgN = !!(twsrc & 0x8000);
+	cpu->flgZ = !cpu->twsrc;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
 	cpu->flgC = 1;
 	cpu->flgV = 0;
 //	cpu->f |= PDP_FC;
@@ -549,24 +545,24 @@ void pdp_com(CPU* cpu) {
 
 //0000 1010 10dd dddd	inc
 void pdp_inc(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
-	twsrc++;
-	pdp_wres(cpu, cpu->com, twsrc);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc++;
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 //	cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !twsrc;
-	cpu->flgN = !!(twsrc & 0x8000);
-	cpu->flgV = !!(twsrc == 0x8000);
+	cpu->flgZ = !cpu->twsrc;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
+	cpu->flgV = !!(cpu->twsrc == 0x8000);
 }
 
 //0000 1010 11dd dddd	dec
 void pdp_dec(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
-	twsrc--;
-	pdp_wres(cpu, cpu->com, twsrc);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc--;
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 //	cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !twsrc;
-	cpu->flgN = !!(twsrc & 0x8000);
-	cpu->flgV = !!(twsrc == 0x7fff);
+	cpu->flgZ = !cpu->twsrc;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
+	cpu->flgV = !!(cpu->twsrc == 0x7fff);
 }
 
 static cbcpu pdp_0axx_tab[4] = {pdp_clr, pdp_com, pdp_inc, pdp_dec};
@@ -580,52 +576,52 @@ void pdp_0axx(CPU* cpu) {
 //0000 1011 10dd dddd	sbc		[dd] = [dd] - C
 //0000 1011 11dd dddd	tst
 void pdp_neg(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
-	cpu->flgV = !!(twsrc == 0x8000);
-	twsrc = ~twsrc + 1;
-	pdp_wres(cpu, cpu->com, twsrc);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->flgV = !!(cpu->twsrc == 0x8000);
+	cpu->twsrc = ~cpu->twsrc + 1;
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 //	cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ | PDP_FC);
-	cpu->flgZ = !twsrc;			// TODO: check flags
-	cpu->flgN = !!(twsrc & 0x8000);
-	// cpu->flgC = !!(twsrc != 0);
+	cpu->flgZ = !cpu->twsrc;			// TODO: check flags
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
+	// cpu->flgC = !!(cpu->twsrc != 0);
 }
 
 void pdp_adc(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
 	if (cpu->flgC)
-		twsrc++;
-	pdp_wres(cpu, cpu->com, twsrc);
+		cpu->twsrc++;
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !twsrc;
-	cpu->flgN = !!(twsrc & 0x8000);
-	cpu->flgV = !!(twsrc == 0x8000);
+	cpu->flgZ = !cpu->twsrc;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
+	cpu->flgV = !!(cpu->twsrc == 0x8000);
 	if (cpu->flgC) {
-		if (twsrc) cpu->flgC = 0;
+		if (cpu->twsrc) cpu->flgC = 0;
 	}
 }
 
 void pdp_sbc(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
 	if (cpu->flgC)
-		twsrc--;
-	pdp_wres(cpu, cpu->com, twsrc);
+		cpu->twsrc--;
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !twsrc;
-	cpu->flgN = !!(twsrc & 0x8000);
+	cpu->flgZ = !cpu->twsrc;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
 	cpu->flgV = 0;
 	if (cpu->flgC) {
-		if (twsrc != 0xffff) cpu->flgC = 0;
-		if (twsrc == 0x7fff) cpu->flgV = 1;
+		if (cpu->twsrc != 0xffff) cpu->flgC = 0;
+		if (cpu->twsrc == 0x7fff) cpu->flgV = 1;
 	}
 }
 
 void pdp_tst(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FC | PDP_FZ);
 	cpu->flgC = 0;
 	cpu->flgV = 0;
-	cpu->flgZ = !twsrc;
-	cpu->flgN = !!(twsrc & 0x8000);
+	cpu->flgZ = !cpu->twsrc;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
 }
 
 static cbcpu pdp_0bxx_tab[4] = {pdp_neg, pdp_adc, pdp_sbc, pdp_tst};
@@ -636,55 +632,55 @@ void pdp_0bxx(CPU* cpu) {
 
 //0000 1100 00dd dddd	ror
 void pdp_ror(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
 	cpu->tmpw = cpu->flgC;
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgC = twsrc & 1;
-	twsrc >>= 1;
-	if (cpu->tmpw) twsrc |= 0x8000;
-	cpu->flgN = !!(twsrc & 0x8000);
-	cpu->flgZ = !twsrc;
+	cpu->flgC = cpu->twsrc & 1;
+	cpu->twsrc >>= 1;
+	if (cpu->tmpw) cpu->twsrc |= 0x8000;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
+	cpu->flgZ = !cpu->twsrc;
 	cpu->flgV = cpu->flgC ^ cpu->flgN;
-	pdp_wres(cpu, cpu->com, twsrc);
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 }
 
 //0000 1100 01dd dddd	rol
 void pdp_rol(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
 	cpu->tmpw = cpu->flgC;
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgC = !!(twsrc & 0x8000);
-	twsrc <<= 1;
-	if (cpu->tmpw) twsrc |= 1;
-	cpu->flgN = !!(twsrc & 0x8000);
-	cpu->flgZ = !twsrc;
+	cpu->flgC = !!(cpu->twsrc & 0x8000);
+	cpu->twsrc <<= 1;
+	if (cpu->tmpw) cpu->twsrc |= 1;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
+	cpu->flgZ = !cpu->twsrc;
 	cpu->flgV = cpu->flgC ^ cpu->flgN;
-	pdp_wres(cpu, cpu->com, twsrc);
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 }
 
 //0000 1100 10dd dddd	asr
 void pdp_asr(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgC = twsrc & 1;
-	twsrc >>= 1;
-	if (twsrc & 0x4000) twsrc |= 0x8000;
-	cpu->flgN = !!(twsrc & 0x8000);
-	cpu->flgZ = !twsrc;
+	cpu->flgC = cpu->twsrc & 1;
+	cpu->twsrc >>= 1;
+	if (cpu->twsrc & 0x4000) cpu->twsrc |= 0x8000;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
+	cpu->flgZ = !cpu->twsrc;
 	cpu->flgV = cpu->flgC ^ cpu->flgN;
-	pdp_wres(cpu, cpu->com, twsrc);
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 }
 
 //0000 1100 11dd dddd	arl
 void pdp_asl(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgC = !!(twsrc & 0x8000);
-	twsrc <<= 1;
-	cpu->flgN = !!(twsrc & 0x8000);
-	cpu->flgZ = !twsrc;
+	cpu->flgC = !!(cpu->twsrc & 0x8000);
+	cpu->twsrc <<= 1;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
+	cpu->flgZ = !cpu->twsrc;
 	cpu->flgV = cpu->flgC ^ cpu->flgN;
-	pdp_wres(cpu, cpu->com, twsrc);
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 }
 
 static cbcpu pdp_0cxx_tab[4] = {pdp_ror, pdp_rol, pdp_asr, pdp_asl};
@@ -713,11 +709,11 @@ void pdp_mtpi(CPU* cpu) {
 }
 
 void pdp_sxt(CPU* cpu) {
-	twdst = cpu->flgN ? 0xffff : 0x0000;
+	cpu->twdst = cpu->flgN ? 0xffff : 0x0000;
 	//cpu->f &= ~(PDP_FZ | PDP_FV);
 	cpu->flgZ = !cpu->flgN;
 	// cpu->flgV = 0;
-	pdp_dst(cpu, twdst, cpu->com, 0);
+	pdp_dst(cpu, cpu->twdst, cpu->com, 0);
 }
 
 static cbcpu pdp_0dxx_tab[4] = {pdp_mark, pdp_mfpi, pdp_mtpi, pdp_sxt};
@@ -825,34 +821,34 @@ void pdp_clrb(CPU* cpu) {
 
 // FC = 1 !!!
 void pdp_comb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = twsrc ^ 0xff;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = cpu->twsrc ^ 0xff;
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
 	cpu->flgC = 1;
-	cpu->flgN = !!(twdst & 0x80);
-	cpu->flgZ = !(twdst & 0xff);
-	pdp_wresb(cpu, cpu->com, twdst);
+	cpu->flgN = !!(cpu->twdst & 0x80);
+	cpu->flgZ = !(cpu->twdst & 0xff);
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 void pdp_incb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = (twsrc + 1) & 0xff;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = (cpu->twsrc + 1) & 0xff;
 	// cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgN = !!(twdst & 0x80);
-	cpu->flgZ = !twdst;
-	cpu->flgV = !!(twdst == 0x80);	// 7f->80
-	pdp_wresb(cpu, cpu->com, twdst);
+	cpu->flgN = !!(cpu->twdst & 0x80);
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgV = !!(cpu->twdst == 0x80);	// 7f->80
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 void pdp_decb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = (twsrc - 1) & 0xff;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = (cpu->twsrc - 1) & 0xff;
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgN = !!(twdst & 0x80);
-	cpu->flgZ = !twdst;
-	cpu->flgV = !!(twdst == 0x7f);	// 80->7f
-	pdp_wresb(cpu, cpu->com, twdst);
+	cpu->flgN = !!(cpu->twdst & 0x80);
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgV = !!(cpu->twdst == 0x7f);	// 80->7f
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 static cbcpu pdp_8axx_tab[4] = {pdp_clrb, pdp_comb, pdp_incb, pdp_decb};
@@ -867,62 +863,62 @@ void pdp_8axx(CPU* cpu) {
 //1000 1011 11dd dddd	tstb
 
 void pdp_negb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = (0 - twsrc) & 0xff;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = (0 - cpu->twsrc) & 0xff;
 	// cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !twdst;
-	cpu->flgC = !!twdst;
-	cpu->flgN = !!(twdst & 0x80);
-	cpu->flgV = !!(twdst == 0x80);
-	pdp_wresb(cpu, cpu->com, twdst);
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgC = !!cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x80);
+	cpu->flgV = !!(cpu->twdst == 0x80);
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 void pdp_adcb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = twsrc;
-	if (cpu->flgC) twdst++;
-	twdst &= 0xff;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = cpu->twsrc;
+	if (cpu->flgC) cpu->twdst++;
+	cpu->twdst &= 0xff;
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x80);
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x80);
 	cpu->flgV = 0;
 	if (cpu->flgC) {
-		if (twdst) cpu->flgC = 0;
-		if (twdst == 0x80) cpu->flgV = 1;
+		if (cpu->twdst) cpu->flgC = 0;
+		if (cpu->twdst == 0x80) cpu->flgV = 1;
 	}
-	pdp_wresb(cpu, cpu->com, twdst);
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 void pdp_sbcb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = twsrc;
-	if (cpu->flgC) twdst--;
-	twdst &= 0xff;
-//	twsrc &= 0xff00;
-//	twsrc |= twdst;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = cpu->twsrc;
+	if (cpu->flgC) cpu->twdst--;
+	cpu->twdst &= 0xff;
+//	cpu->twsrc &= 0xff00;
+//	cpu->twsrc |= cpu->twdst;
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x80);
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x80);
 	cpu->flgV = 0;
 	if (cpu->flgC) {
-		if (twdst != 0xff) cpu->flgC = 0;
-		if (twdst == 0x7f) cpu->flgV = 1;
+		if (cpu->twdst != 0xff) cpu->flgC = 0;
+		if (cpu->twdst == 0x7f) cpu->flgV = 1;
 	}
-	pdp_wresb(cpu, cpu->com, twdst);
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 //	if (cpu->com & 070) {
-//		pdp_wrb(cpu, cpu->mptr, twsrc & 0xff);
+//		pdp_wrb(cpu, cpu->mptr, cpu->twsrc & 0xff);
 //	} else {
-//		cpu->preg[cpu->com & 7] = twsrc;
+//		cpu->preg[cpu->com & 7] = cpu->twsrc;
 //	}
 }
 
 void pdp_tstb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
 	cpu->flgC = 0;
-	cpu->flgZ = !twsrc;
-	cpu->flgN = !!(twsrc & 0x80);
+	cpu->flgZ = !cpu->twsrc;
+	cpu->flgN = !!(cpu->twsrc & 0x80);
 }
 
 static cbcpu pdp_8bxx_tab[4] = {pdp_negb, pdp_adcb, pdp_sbcb, pdp_tstb};
@@ -937,62 +933,62 @@ void pdp_8bxx(CPU* cpu) {
 //1000 1100 11dd dddd	aslb
 
 void pdp_rorb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = twsrc & 0xff;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = cpu->twsrc & 0xff;
 	cpu->tmpw = cpu->flgC;
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgC = twdst & 1;
-	twdst >>= 1;
-	if (cpu->tmpw) twdst |= 0x80;
-	twdst &= 0xff;
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x80);
+	cpu->flgC = cpu->twdst & 1;
+	cpu->twdst >>= 1;
+	if (cpu->tmpw) cpu->twdst |= 0x80;
+	cpu->twdst &= 0xff;
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x80);
 	cpu->flgV = cpu->flgC ^ cpu->flgN; //if (((cpu->f & PDP_FC) ? 1 : 0) ^ ((cpu->f & PDP_FN) ? 1 : 0)) cpu->f |= PDP_FV;
-	pdp_wresb(cpu, cpu->com, twdst);
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 void pdp_rolb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = twsrc & 0xff;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = cpu->twsrc & 0xff;
 	cpu->tmpw = cpu->flgC;
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgC = !!(twdst & 0x80);
-	twdst <<= 1;
-	twdst &= 0xfe;
-	if (cpu->tmpw) twdst |= 1;
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x80);
+	cpu->flgC = !!(cpu->twdst & 0x80);
+	cpu->twdst <<= 1;
+	cpu->twdst &= 0xfe;
+	if (cpu->tmpw) cpu->twdst |= 1;
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x80);
 	cpu->flgV = cpu->flgC ^ cpu->flgN; //if (((cpu->f & PDP_FC) ? 1 : 0) ^ ((cpu->f & PDP_FN) ? 1 : 0)) cpu->f |= PDP_FV;
-	pdp_wresb(cpu, cpu->com, twdst);
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 void pdp_asrb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = twsrc & 0xff;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = cpu->twsrc & 0xff;
 	cpu->tmpw = cpu->flgC;
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgC = twdst & 1;
-	twdst >>= 1;
-	if (twdst & 0x40) twdst |= 0x80;
-	twdst &= 0xff;
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x80);
+	cpu->flgC = cpu->twdst & 1;
+	cpu->twdst >>= 1;
+	if (cpu->twdst & 0x40) cpu->twdst |= 0x80;
+	cpu->twdst &= 0xff;
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x80);
 	cpu->flgV = cpu->flgC ^ cpu->flgN; // if (((cpu->f & PDP_FC) ? 1 : 0) ^ ((cpu->f & PDP_FN) ? 1 : 0) cpu->f |= PDP_FV;
-	pdp_wresb(cpu, cpu->com, twdst);
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 void pdp_aslb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twdst = twsrc & 0xff;
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst = cpu->twsrc & 0xff;
 	cpu->tmpw = cpu->flgC;
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgC = !!(twdst & 0x80);
-	twdst <<= 1;
-	twdst &= 0xfe;
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x80);
+	cpu->flgC = !!(cpu->twdst & 0x80);
+	cpu->twdst <<= 1;
+	cpu->twdst &= 0xfe;
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x80);
 	cpu->flgV = cpu->flgC ^ cpu->flgN; //if (((cpu->f & PDP_FC) ? 1 : 0) ^ ((cpu->f & PDP_FN) ? 1 : 0)) cpu->f |= PDP_FV;
-	pdp_wresb(cpu, cpu->com, twdst);
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 static cbcpu pdp_8cxx_tab[4] = {pdp_rorb, pdp_rolb, pdp_asrb, pdp_aslb};
@@ -1005,11 +1001,11 @@ void pdp_8cxx(CPU* cpu) {
 // MOVB _DST, F (except bit T)
 
 void pdp_mtps(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 1);
-	twsrc &= 0xef;		// T flag, b8..15 is not affected
+	cpu->twsrc = pdp_src(cpu, cpu->com, 1);
+	cpu->twsrc &= 0xef;		// T flag, b8..15 is not affected
 	int f = pdp_get_flag(cpu);
 	f &= 0xff10;
-	f |= twsrc;
+	f |= cpu->twsrc;
 	pdp_set_flag(cpu, f);
 }
 
@@ -1020,17 +1016,17 @@ void pdp_mtps(CPU* cpu) {
 // C: not affected
 void pdp_mfps(CPU* cpu) {
 	cpu->regWZ = pdp_adr(cpu, cpu->com, 1);
-	twsrc = pdp_get_flag(cpu) & 0xff;
-	if (twsrc & 0x80) twsrc |= 0xff00;
+	cpu->twsrc = pdp_get_flag(cpu) & 0xff;
+	if (cpu->twsrc & 0x80) cpu->twsrc |= 0xff00;
 	if (cpu->com & 0x38) {
-		pdp_wrb(cpu, cpu->regWZ, twsrc & 0xff);
+		pdp_wrb(cpu, cpu->regWZ, cpu->twsrc & 0xff);
 	} else {
-		cpu->regRN(cpu->com & 7) = twsrc;
+		cpu->regRN(cpu->com & 7) = cpu->twsrc;
 	}
 	//cpu->f &= ~(PDP_FZ | PDP_FN | PDP_FV);
 	cpu->flgV = 0;
-	cpu->flgZ = !(twsrc & 0xff);
-	cpu->flgN = !!(twsrc & 0x80);
+	cpu->flgZ = !(cpu->twsrc & 0xff);
+	cpu->flgN = !!(cpu->twsrc & 0x80);
 }
 
 static cbcpu pdp_8dxx_tab[4] = {pdp_mtps, pdp_undef, pdp_undef, pdp_mfps};
@@ -1097,28 +1093,28 @@ void pdp_ash(CPU* cpu) {
 	if (cpu->gen < 1) {
 		pdp_undef(cpu);
 	} else {
-		twsrc = pdp_src(cpu, cpu->com, 0) & 0x3f;
+		cpu->twsrc = pdp_src(cpu, cpu->com, 0) & 0x3f;
 		int rn = (cpu->com >> 6) & 7;
-		twdst = cpu->regRN(rn);
-		twres = twdst;
-		if (twsrc & 0x20) {	// shift right
-			twsrc = 0x40 - twsrc;
-			while (twsrc) {
-				cpu->flgC = twdst & 1;
-				twdst = (twdst & 0x8000) | (twdst >> 1);
-				twsrc--;
+		cpu->twdst = cpu->regRN(rn);
+		cpu->twres = cpu->twdst;
+		if (cpu->twsrc & 0x20) {	// shift right
+			cpu->twsrc = 0x40 - cpu->twsrc;
+			while (cpu->twsrc) {
+				cpu->flgC = cpu->twdst & 1;
+				cpu->twdst = (cpu->twdst & 0x8000) | (cpu->twdst >> 1);
+				cpu->twsrc--;
 			}
 		} else {		// shift left
-			while (twsrc) {
-				cpu->flgC = !!(twdst & 0x8000);
-				twdst <<= 1;
-				twsrc--;
+			while (cpu->twsrc) {
+				cpu->flgC = !!(cpu->twdst & 0x8000);
+				cpu->twdst <<= 1;
+				cpu->twsrc--;
 			}
 		}
-		cpu->regRN(rn) = twdst;
-		cpu->flgN = !!(twdst & 0x8000);
-		cpu->flgZ = !twdst;
-		cpu->flgV = !!((twres ^ twdst) & 0x8000);	// sign changed?
+		cpu->regRN(rn) = cpu->twdst;
+		cpu->flgN = !!(cpu->twdst & 0x8000);
+		cpu->flgZ = !cpu->twdst;
+		cpu->flgV = !!((cpu->twres ^ cpu->twdst) & 0x8000);	// sign changed?
 	}
 }
 
@@ -1127,40 +1123,40 @@ void pdp_ashc(CPU* cpu) {
 	if (cpu->gen < 1) {
 		pdp_undef(cpu);
 	} else {
-		twsrc = pdp_src(cpu, cpu->com, 0) & 0x3f;
+		cpu->twsrc = pdp_src(cpu, cpu->com, 0) & 0x3f;
 		int rn = (cpu->com >> 6) & 7;
-		twres = (cpu->regRN(rn) << 16) | (cpu->regRN(rn | 1));
-		twdst = cpu->regRN(rn);
-		if (twsrc & 0x20) {
-			twsrc = 0x40 - twsrc;
-			while (twsrc) {
-				cpu->flgC = twres & 1;
-				twres >>= 1;		// sign?
-				twsrc--;
+		cpu->twres = (cpu->regRN(rn) << 16) | (cpu->regRN(rn | 1));
+		cpu->twdst = cpu->regRN(rn);
+		if (cpu->twsrc & 0x20) {
+			cpu->twsrc = 0x40 - cpu->twsrc;
+			while (cpu->twsrc) {
+				cpu->flgC = cpu->twres & 1;
+				cpu->twres >>= 1;		// sign?
+				cpu->twsrc--;
 			}
 		} else {
-			while (twsrc) {
-				cpu->flgC = !!(twres & (1 << 31));
-				twres <<= 1;
-				twsrc--;
+			while (cpu->twsrc) {
+				cpu->flgC = !!(cpu->twres & (1 << 31));
+				cpu->twres <<= 1;
+				cpu->twsrc--;
 			}
 		}
-		cpu->regRN(rn) = (twres >> 16) & 0xffff;
-		cpu->regRN(rn | 1) = twres & 0xffff;
-		cpu->flgN = !!(twres & (1 << 31));
-		cpu->flgZ = !twres;
-		cpu->flgV = !!((cpu->regRN(rn) ^ twdst) & 0x8000);	// sign changed?
+		cpu->regRN(rn) = (cpu->twres >> 16) & 0xffff;
+		cpu->regRN(rn | 1) = cpu->twres & 0xffff;
+		cpu->flgN = !!(cpu->twres & (1 << 31));
+		cpu->flgZ = !cpu->twres;
+		cpu->flgV = !!((cpu->regRN(rn) ^ cpu->twdst) & 0x8000);	// sign changed?
 	}
 }
 
 // 074rss	xor Rn,ss	ss ^= Rn
 void pdp_xor(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com, 0);
-	twsrc ^= cpu->regRN((cpu->com >> 6) & 7);
+	cpu->twsrc = pdp_src(cpu, cpu->com, 0);
+	cpu->twsrc ^= cpu->regRN((cpu->com >> 6) & 7);
 	cpu->flgV = 0;
-	cpu->flgZ = !twsrc;
-	cpu->flgN = !!(twsrc & 0x8000);
-	pdp_wres(cpu, cpu->com, twsrc);
+	cpu->flgZ = !cpu->twsrc;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
+	pdp_wres(cpu, cpu->com, cpu->twsrc);
 }
 
 // for VM2 only:
@@ -1176,9 +1172,9 @@ void pdp_075x(CPU* cpu) {
 // 07ruu
 void pdp_sob(CPU* cpu) {
 	cpu->t += 8;
-	twsrc = (cpu->com >> 6) & 7;
-	cpu->regRN(twsrc)--;
-	if (cpu->regRN(twsrc)) {
+	cpu->twsrc = (cpu->com >> 6) & 7;
+	cpu->regRN(cpu->twsrc)--;
+	if (cpu->regRN(cpu->twsrc)) {
 		cpu->regRN(7) -= (cpu->com & 0x3f) * 2;
 	}
 }
@@ -1204,32 +1200,32 @@ void pdp_7xxx(CPU* cpu) {
 // dst = 37	@(R7)+		177716 (2nd)
 
 void pdp_mov(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 0);
-	pdp_dst(cpu, twsrc, cpu->com, 0);
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 0);
+	pdp_dst(cpu, cpu->twsrc, cpu->com, 0);
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
-	cpu->flgZ = !twsrc;
-	cpu->flgN = !!(twsrc & 0x8000);
+	cpu->flgZ = !cpu->twsrc;
+	cpu->flgN = !!(cpu->twsrc & 0x8000);
 }
 
 // movb works as RMW (read-modify-write)
 // movb (R1)+, @R3 : R1+=1
 // movb (R0)+, (R1)+ : R0+=1, R1+=1
 void pdp_movb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 1);
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 1);
 	if (cpu->com & 0x38) {
-		twdst = pdp_src(cpu, cpu->com, 1);
-		pdp_wrb(cpu, cpu->regWZ, twsrc & 0xff);		// write low byte only
+		cpu->twdst = pdp_src(cpu, cpu->com, 1);
+		pdp_wrb(cpu, cpu->regWZ, cpu->twsrc & 0xff);		// write low byte only
 	} else {
-		twsrc &= 0xff;					// extend sign
-		if (twsrc & 0x80)
-			twsrc |= 0xff00;
-		cpu->regRN(cpu->com & 7) = twsrc;
+		cpu->twsrc &= 0xff;					// extend sign
+		if (cpu->twsrc & 0x80)
+			cpu->twsrc |= 0xff00;
+		cpu->regRN(cpu->com & 7) = cpu->twsrc;
 	}
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
-	cpu->flgZ = !(twsrc & 0xff);
-	cpu->flgN = !!(twsrc & 0x80);
+	cpu->flgZ = !(cpu->twsrc & 0xff);
+	cpu->flgN = !!(cpu->twsrc & 0x80);
 }
 
 // B2SSDD:cmp
@@ -1239,26 +1235,26 @@ void pdp_movb(CPU* cpu) {
 // C: high byte carry
 // V: overflow
 void pdp_cmp(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 0);
-	twdst = pdp_src(cpu, cpu->com, 0);
-	twres = twsrc - twdst;
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 0);
+	cpu->twdst = pdp_src(cpu, cpu->com, 0);
+	cpu->twres = cpu->twsrc - cpu->twdst;
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !(twres & 0xffff);
-	cpu->flgN = !!(twres & 0x8000);
-	cpu->flgC = !!(twres & ~0xffff);
+	cpu->flgZ = !(cpu->twres & 0xffff);
+	cpu->flgN = !!(cpu->twres & 0x8000);
+	cpu->flgC = !!(cpu->twres & ~0xffff);
 	// V: neg - pos = pos || pos - neg = neg
-	cpu->flgV = !!(((twsrc ^ twdst) & 0x8000) && ((twsrc ^ twres) & 0x8000));
+	cpu->flgV = !!(((cpu->twsrc ^ cpu->twdst) & 0x8000) && ((cpu->twsrc ^ cpu->twres) & 0x8000));
 }
 
 void pdp_cmpb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 1) & 0xff;
-	twdst = pdp_src(cpu, cpu->com, 1) & 0xff;
-	twres = twsrc - twdst;
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 1) & 0xff;
+	cpu->twdst = pdp_src(cpu, cpu->com, 1) & 0xff;
+	cpu->twres = cpu->twsrc - cpu->twdst;
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !(twres & 0xff);
-	cpu->flgN = !!(twres & 0x80);
-	cpu->flgC = !!(twres & 0x100);
-	cpu->flgV = !!(((twsrc ^ twdst) & 0x80) && ((twsrc ^ twres) & 0x80));
+	cpu->flgZ = !(cpu->twres & 0xff);
+	cpu->flgN = !!(cpu->twres & 0x80);
+	cpu->flgC = !!(cpu->twres & 0x100);
+	cpu->flgV = !!(((cpu->twsrc ^ cpu->twdst) & 0x80) && ((cpu->twsrc ^ cpu->twres) & 0x80));
 }
 
 // B3SSDD:bit (and)
@@ -1268,23 +1264,23 @@ void pdp_cmpb(CPU* cpu) {
 // C: not affected
 // V: 0
 void pdp_bit(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 0);
-	twdst = pdp_src(cpu, cpu->com, 0);
-	twdst &= twsrc;
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 0);
+	cpu->twdst = pdp_src(cpu, cpu->com, 0);
+	cpu->twdst &= cpu->twsrc;
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x8000);
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x8000);
 }
 
 void pdp_bitb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 1) & 0xff;
-	twdst = pdp_src(cpu, cpu->com, 1) & 0xff;
-	twdst &= twsrc;
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 1) & 0xff;
+	cpu->twdst = pdp_src(cpu, cpu->com, 1) & 0xff;
+	cpu->twdst &= cpu->twsrc;
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x80);
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x80);
 }
 
 // B4SSDD:bic (and not)
@@ -1294,25 +1290,25 @@ void pdp_bitb(CPU* cpu) {
 // C: not affected
 // V: 0
 void pdp_bic(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 0);
-	twdst = pdp_src(cpu, cpu->com, 0);
-	twdst &= ~twsrc;
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 0);
+	cpu->twdst = pdp_src(cpu, cpu->com, 0);
+	cpu->twdst &= ~cpu->twsrc;
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x8000);
-	pdp_wres(cpu, cpu->com, twdst);
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x8000);
+	pdp_wres(cpu, cpu->com, cpu->twdst);
 }
 
 void pdp_bicb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 1) & 0xff;
-	twdst = pdp_src(cpu, cpu->com, 1) & 0xff;
-	twdst &= ~twsrc;			// src = 00xx; ~src = FFzz; keep high byte of dst
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 1) & 0xff;
+	cpu->twdst = pdp_src(cpu, cpu->com, 1) & 0xff;
+	cpu->twdst &= ~cpu->twsrc;			// src = 00xx; ~src = FFzz; keep high byte of dst
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
-	cpu->flgZ = !(twdst & 0xff);
-	cpu->flgN = !!(twdst & 0x80);
-	pdp_wresb(cpu, cpu->com, twdst & 0xff);
+	cpu->flgZ = !(cpu->twdst & 0xff);
+	cpu->flgN = !!(cpu->twdst & 0x80);
+	pdp_wresb(cpu, cpu->com, cpu->twdst & 0xff);
 }
 
 // B5SSDD:bis (or)
@@ -1322,25 +1318,25 @@ void pdp_bicb(CPU* cpu) {
 // C: not affected
 // V: 0
 void pdp_bis(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 0);
-	twdst = pdp_src(cpu, cpu->com, 0);
-	twdst |= twsrc;
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 0);
+	cpu->twdst = pdp_src(cpu, cpu->com, 0);
+	cpu->twdst |= cpu->twsrc;
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
-	cpu->flgZ = !twdst;
-	cpu->flgN = !!(twdst & 0x8000);
-	pdp_wres(cpu, cpu->com, twdst);
+	cpu->flgZ = !cpu->twdst;
+	cpu->flgN = !!(cpu->twdst & 0x8000);
+	pdp_wres(cpu, cpu->com, cpu->twdst);
 }
 
 void pdp_bisb(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 1) & 0xff;
-	twdst = pdp_src(cpu, cpu->com, 1);
-	twdst |= twsrc;
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 1) & 0xff;
+	cpu->twdst = pdp_src(cpu, cpu->com, 1);
+	cpu->twdst |= cpu->twsrc;
 	//cpu->f &= ~(PDP_FN | PDP_FV | PDP_FZ);
 	cpu->flgV = 0;
-	cpu->flgZ = !(twdst & 0xff);
-	cpu->flgN = !!(twdst & 0x80);
-	pdp_wresb(cpu, cpu->com, twdst);
+	cpu->flgZ = !(cpu->twdst & 0xff);
+	cpu->flgN = !!(cpu->twdst & 0x80);
+	pdp_wresb(cpu, cpu->com, cpu->twdst);
 }
 
 // 06SSDD:add
@@ -1351,22 +1347,22 @@ void pdp_bisb(CPU* cpu) {
 // V: overflow (if both op is same sign, but res is opposite sign)		TODO: V = b15 overflow ^ b14 overflow
 
 unsigned short pdp_op_add(CPU* cpu, int src, int dst) {
-	twres = src + dst;
-	cpu->flgZ = !(twres & 0xffff);
-	cpu->flgN = !!(twres & 0x8000);
-	cpu->flgC = !!(twres > 0xffff);
-	twsrc = (twsrc ^ twdst) & 0x8000;	// src/dst sign is different (!twsrc - same)
-	twdst = (twsrc ^ twres) & 0x8000;	// src/res sign is different
-	cpu->flgV = !twsrc && twdst;		// neg + neg = pos || pos + pos = neg
-	// cpu->flgV = cpu->flgC ^ !!(((twsrc & 0x7fff) + (twdst & 0x7fff)) & 0x8000);
-	return twres & 0xffff;
+	cpu->twres = src + dst;
+	cpu->flgZ = !(cpu->twres & 0xffff);
+	cpu->flgN = !!(cpu->twres & 0x8000);
+	cpu->flgC = !!(cpu->twres > 0xffff);
+	cpu->twsrc = (cpu->twsrc ^ cpu->twdst) & 0x8000;	// src/dst sign is different (!cpu->twsrc - same)
+	cpu->twdst = (cpu->twsrc ^ cpu->twres) & 0x8000;	// src/res sign is different
+	cpu->flgV = !cpu->twsrc && cpu->twdst;		// neg + neg = pos || pos + pos = neg
+	// cpu->flgV = cpu->flgC ^ !!(((cpu->twsrc & 0x7fff) + (cpu->twdst & 0x7fff)) & 0x8000);
+	return cpu->twres & 0xffff;
 }
 
 void pdp_add(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 0);		// SS
-	twdst = pdp_src(cpu, cpu->com, 0);		// DD (cpu->mptr is DD address)
-	twres = pdp_op_add(cpu, twsrc, twdst);
-	pdp_wres(cpu, cpu->com, twres);
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 0);		// SS
+	cpu->twdst = pdp_src(cpu, cpu->com, 0);		// DD (cpu->mptr is DD address)
+	cpu->twres = pdp_op_add(cpu, cpu->twsrc, cpu->twdst);
+	pdp_wres(cpu, cpu->com, cpu->twres);
 }
 
 // 16SSDD:sub
@@ -1377,19 +1373,19 @@ void pdp_add(CPU* cpu) {
 // C: high byte carry
 // V: overflow
 void pdp_sub(CPU* cpu) {
-	twsrc = pdp_src(cpu, cpu->com >> 6, 0);
-	twdst = pdp_src(cpu, cpu->com, 0);
-//	twres = pdp_op_add(cpu, ~twsrc + 1, twdst);
-	twres = twdst - twsrc;
+	cpu->twsrc = pdp_src(cpu, cpu->com >> 6, 0);
+	cpu->twdst = pdp_src(cpu, cpu->com, 0);
+//	cpu->twres = pdp_op_add(cpu, ~cpu->twsrc + 1, cpu->twdst);
+	cpu->twres = cpu->twdst - cpu->twsrc;
 	//cpu->f &= ~(PDP_FC | PDP_FN | PDP_FV | PDP_FZ);
-	cpu->flgZ = !(twres & 0xffff);
-	cpu->flgN = !!(twres & 0x8000);
-	cpu->flgC = !!(twsrc > twdst);
+	cpu->flgZ = !(cpu->twres & 0xffff);
+	cpu->flgN = !!(cpu->twres & 0x8000);
+	cpu->flgC = !!(cpu->twsrc > cpu->twdst);
 	// flag V set if: pos - neg = neg || neg - pos = pos
-	twsrc = (twsrc ^ twdst) & 0x8000;	// src/dst sign is different (!twsrc - same)
-	twdst = (twsrc ^ twres) & 0x8000;	// src/res sign is different
-	cpu->flgV = twsrc && twdst;		// neg - pos = pos || pos - neg = neg
-	pdp_wres(cpu, cpu->com, twres);
+	cpu->twsrc = (cpu->twsrc ^ cpu->twdst) & 0x8000;	// src/dst sign is different (!cpu->twsrc - same)
+	cpu->twdst = (cpu->twsrc ^ cpu->twres) & 0x8000;	// src/res sign is different
+	cpu->flgV = cpu->twsrc && cpu->twdst;		// neg - pos = pos || pos - neg = neg
+	pdp_wres(cpu, cpu->com, cpu->twres);
 }
 
 // tables
@@ -56,13 +56,20 @@ void z80_reset(CPU* cpu) {
 // > For memory access, this happens on the first tstate (T1) of any instruction fetch, memory read or memory write operation
 
 int z80_mrdx(CPU* cpu, int adr, int m1) {
+	unsigned char* ptr;
+	int r;
 	cpu->adr = adr;
 	cpu->t++;		// T1
 	do {
 		cpu->t++;	// T2 while wait
 		cpu->xirq(IRQ_CPU_SYNC, cpu->xptr);
 	} while (cpu->flgWAIT);
-	int r = cpu->mrd(adr, m1, cpu->xptr) & 0xff;
+	ptr = cpu->fmrd ? cpu->fmrd[(adr >> 8) & 0xff] : NULL;
+	if (ptr && !(m1 && cpu->m1hook)) {
+		r = ptr[adr & 0xff];
+	} else {
+		r = cpu->mrd(adr, m1, cpu->xptr) & 0xff;
+	}
 	cpu->t++;		// T3
 	return r;
 }
@@ -77,13 +84,19 @@ int z80_mrd(CPU* cpu, int adr) {
 }
 
 void z80_mwr(CPU *cpu, int adr, int data) {
+	unsigned char* ptr;
 	cpu->adr = adr;
 	cpu->t++;		// T1
 	do {
 		cpu->t++;	// T2 while wait
 		cpu->xirq(IRQ_CPU_SYNC, cpu->xptr);
 	} while (cpu->flgWAIT);
-	cpu->mwr(adr, data, cpu->xptr);
+	ptr = cpu->fmwr ? cpu->fmwr[(adr >> 8) & 0xff] : NULL;
+	if (ptr) {
+		ptr[adr & 0xff] = data & 0xff;
+	} else {
+		cpu->mwr(adr, data, cpu->xptr);
+	}
 	cpu->t++;		// T3
 }
 
@@ -155,8 +168,83 @@ int z80_int(CPU* cpu) {
 	return res;
 }
 
+// pre-decoded opcodes cache
+// line is keyed by host pointer to opcode (= physical page + offset) and holds M1 bytes with resolved handlers:
+// prefixes chain (cb,dd,ed,fd) and final opcode. ddcb/fdcb read their bytes by themselves and finish the chain.
+// line is valid while bytes at key are the same, so any way of changing code (cpu, dma, loaders) drops it.
+
+#define Z80_CACHE_LINES	0x2000
+#define Z80_CACHE_DEPTH	3
+
+typedef struct {
+	unsigned char* key;
+	unsigned char len;
+	unsigned char code[Z80_CACHE_DEPTH];
+	opCode* op[Z80_CACHE_DEPTH];
+} xZ80Line;
+
+void* z80_cache_create() {
+	return calloc(Z80_CACHE_LINES, sizeof(xZ80Line));
+}
+
+static int z80_cache_fill(xZ80Line* ln, unsigned char* ptr, int lim) {
+	opCode* tab = npTab;
+	opCode* op;
+	int len = 0;
+	do {
+		if ((len >= lim) || (len >= Z80_CACHE_DEPTH)) return 0;	// chain crosses page or too long: interpreter
+		ln->code[len] = ptr[len];
+		op = &tab[ptr[len]];
+		ln->op[len] = op;
+		len++;
+		tab = op->tab;
+	} while ((op->flag & OF_PREFIX) && (tab != ddcbTab) && (tab != fdcbTab));
+	ln->key = ptr;
+	ln->len = len;
+	return 1;
+}
+
+// returns line for opcode at PC or NULL if it can't be cached
+static xZ80Line* z80_cache_get(CPU* cpu) {
+	unsigned char* ptr;
+	xZ80Line* ln;
+	int i;
+	if (!cpu->fmrd || cpu->m1hook) return NULL;
+	ptr = cpu->fmrd[cpu->regPCh];
+	if (!ptr) return NULL;
+	ptr += cpu->regPCl;
+	ln = (xZ80Line*)cpu->cache + (((size_t)ptr) & (Z80_CACHE_LINES - 1));
+	if (ln->key == ptr) {
+		for (i = 0; i < ln->len; i++) {
+			if (ln->code[i] != ptr[i]) break;
+		}
+		if (i == ln->len) return ln;
+	}
+	return z80_cache_fill(ln, ptr, 0x100 - cpu->regPCl) ? ln : NULL;
+}
+
+// same bus cycles as z80_fetch, but without memory reading and decoding
+static void z80_cache_exec(CPU* cpu, xZ80Line* ln) {
+	int i;
+	for (i = 0; i < ln->len; i++) {
+		cpu->adr = cpu->regPC++;
+		cpu->t++;		// T1
+		do {
+			cpu->t++;	// T2 while wait
+			cpu->xirq(IRQ_CPU_SYNC, cpu->xptr);
+		} while (cpu->flgWAIT);
+		cpu->t++;		// T3
+		cpu->com = ln->code[i];
+		cpu->op = ln->op[i];
+		cpu->regR++;
+		cpu->t += cpu->op->t - 3;
+		cpu->op->exec(cpu);
+	}
+}
+
 int z80_exec(CPU* cpu) {
 	int res = 0;
+	xZ80Line* ln;
 	if (cpu->intrq & cpu->inten) {
 		res = z80_int(cpu);
 	}
@@ -165,13 +253,18 @@ int z80_exec(CPU* cpu) {
 	if (!res) {
 		cpu->t = 0;
 		cpu->opTab = npTab;
-		do {
-			cpu->com = z80_fetch(cpu); // cpu->mrd(cpu->pc++,1,cpu->xptr);
-			cpu->op = &cpu->opTab[cpu->com];
-			cpu->regR++;
-			cpu->t += cpu->op->t - 3;
-			cpu->op->exec(cpu);
-		} while (cpu->op->flag & OF_PREFIX);
+		ln = cpu->cache ? z80_cache_get(cpu) : NULL;
+		if (ln) {
+			z80_cache_exec(cpu, ln);
+		} else {
+			do {
+				cpu->com = z80_fetch(cpu); // cpu->mrd(cpu->pc++,1,cpu->xptr);
+				cpu->op = &cpu->opTab[cpu->com];
+				cpu->regR++;
+				cpu->t += cpu->op->t - 3;
+				cpu->op->exec(cpu);
+			} while (cpu->op->flag & OF_PREFIX);
+		}
 		res = cpu->t;
 		cpu->t--;
 		cpu_irq(cpu, IRQ_CPU_ACK);
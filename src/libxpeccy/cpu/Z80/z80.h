@@ -81,6 +81,7 @@ enum {
 
 void z80_reset(CPU*);
 int z80_exec(CPU*);
+void* z80_cache_create();
 xAsmScan z80_asm(int, const char*, char*);
 xMnem z80_mnem(CPU*, int, cbdmr, void*);
 
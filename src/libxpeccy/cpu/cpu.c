@@ -238,12 +238,14 @@ CPU* cpuCreate(int type, cbmr fmr, cbmw fmw, cbir fir, cbiw fiw, cbiack frq, cbi
 	cpu->iwr = fiw;
 	cpu->xack = frq;
 	cpu->xirq = xirq;
+	cpu_tlb_flush(cpu);
 	cpuSetType(cpu, type);
 	return cpu;
 }
 
 void cpuDestroy(CPU* cpu) {
 	if (cpu->lib) cpu_close_lib(cpu);
+	if (cpu->cache) free(cpu->cache);
 	free(cpu);
 }
 
@@ -253,6 +255,21 @@ void cpu_reset(CPU* cpu) {
 	cpu->core->reset(cpu);
 }
 
+void cpu_set_cache(CPU* cpu, int on) {
+	if (on && !cpu->cache) {
+		cpu->cache = z80_cache_create();
+	} else if (!on && cpu->cache) {
+		free(cpu->cache);
+		cpu->cache = NULL;
+	}
+}
+
+void cpu_tlb_flush(CPU* cpu) {
+	int i;
+	for (i = 0; i < CPU_TLB_SIZE; i++)
+		cpu->tlb[i].tag = -1;
+}
+
 int cpu_exec(CPU* cpu) {
 	if (!cpu->core) return 1;
 	if (!cpu->core->exec) return 1;
@@ -85,6 +85,18 @@ typedef void(*cbiw)(int, int, void*);
 typedef int(*cbiack)(void*);
 // memrd external
 typedef int(*cbdmr)(int, void*);
+// host ptr to memory cell (adr, wr, xptr), NULL if cell must be accessed by mrd/mwr
+typedef unsigned char*(*cbmptr)(int, int, void*);
+
+// TLB: linear adr -> host ptr for wide adr bus (x86), direct mapped
+#define CPU_TLB_SIZE	256		// entries
+#define CPU_TLB_SHIFT	12		// 4K pages
+
+typedef struct {
+	int tag;		// page (adr >> CPU_TLB_SHIFT), -1 = empty
+	unsigned char* rd;	// host ptr to page start, NULL = use mrd
+	unsigned char* wr;	// ... mwr
+} xTlbItem;
 
 #define OF_PREFIX	1
 #define OF_EXT		OF_PREFIX
@@ -202,6 +214,15 @@ struct CPU {
 	cbiack xack;			// interrupt vector acknowledge
 	cbirq xirq;			// send signal
 	void* xptr;			// pointer to external data (almost always Computer*)
+	// direct memory access (256-byte pages, 16-bit bus). NULL table or page = use mrd/mwr
+	unsigned char** fmrd;
+	unsigned char** fmwr;
+	// direct memory access over TLB (x86). NULL mptr = use mrd/mwr. tlb must be flushed when mptr results are changed
+	cbmptr mptr;
+	xTlbItem tlb[CPU_TLB_SIZE];
+	int tlim;			// ticks limit for one exec call with bulk REP string ops (x86), 0 = one iteration per call
+	unsigned m1hook:1;		// opcode fetch must go through mrd
+	void* cache;			// pre-decoded opcodes cache (Z80 only), NULL = interpreter
 	// core: runtime callbacks (depends on type)
 	struct cpuCore* core;
 	// opcode
@@ -218,6 +239,9 @@ struct CPU {
 	reg16(tmpw,htw,ltw);
 	reg16(twrd,hwr,lwr);
 	int tmpi;
+	unsigned short twsrc;		// vm1/2 operands
+	unsigned short twdst;
+	int twres;
 //	jmp_buf jbuf;			// for throws
 // internal timer (for vm1/2)
 	xTimer timer;
@@ -264,6 +288,8 @@ int cpu_set_type(CPU*, const char*, const char*, const char*);
 
 void cpu_reset(CPU*);
 int cpu_exec(CPU*);
+void cpu_set_cache(CPU*, int);
+void cpu_tlb_flush(CPU*);
 
 // built-in cores tab
 extern cpuCore cpuTab[];
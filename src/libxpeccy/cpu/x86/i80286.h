@@ -121,6 +121,8 @@ void i286_wr_ea(CPU*, int, int);
 void i286_set_reg(CPU*, int, int);
 unsigned char i286_mrd(CPU*, xSegPtr, int, unsigned short);
 void i286_mwr(CPU*, xSegPtr, int, unsigned short, int);
+unsigned short i286_mrdw(CPU*, xSegPtr, int, unsigned short);
+void i286_mwrw(CPU*, xSegPtr, int, unsigned short, int);
 
 void i086_init(CPU*);
 void i186_init(CPU*);
@@ -134,6 +136,7 @@ void x86_set_flag(CPU*, int);
 int x86_get_flag(CPU*);
 
 void x86_set_mode(CPU*, int);
+extern void* x86_state_ptrs[];
 
 // ALU
 unsigned char i286_add8(CPU*, unsigned char, unsigned char, int);
@@ -1,5 +1,6 @@
 #include "i80286.h"
 #include <stdio.h>
+#include <string.h>
 
 // TODO: protected mode
 // segment:
@@ -97,6 +98,42 @@ int i286_check_segment_wr(CPU* cpu, xSegPtr* seg) {
 	return 0;
 }
 
+// linear adr -> host ptr over TLB. NULL if memory must be accessed by cpu->mrd/mwr
+
+#define TLB_PGMASK	((1 << CPU_TLB_SHIFT) - 1)
+
+static unsigned char* i286_tlb_ptr(CPU* cpu, int adr, int wr) {
+	xTlbItem* itm;
+	int pg;
+	if (!cpu->mptr) return NULL;
+	adr &= cpu->busmask;
+	pg = adr >> CPU_TLB_SHIFT;
+	itm = &cpu->tlb[pg & (CPU_TLB_SIZE - 1)];
+	if (itm->tag != pg) {
+		itm->tag = pg;
+		itm->rd = cpu->mptr(adr & ~TLB_PGMASK, 0, cpu->xptr);
+		itm->wr = cpu->mptr(adr & ~TLB_PGMASK, 1, cpu->xptr);
+	}
+	if (wr)
+		return itm->wr ? itm->wr + (adr & TLB_PGMASK) : NULL;
+	return itm->rd ? itm->rd + (adr & TLB_PGMASK) : NULL;
+}
+
+static int i286_lin_rd(CPU* cpu, int adr, int m1) {
+	unsigned char* ptr = i286_tlb_ptr(cpu, adr, 0);
+	if (ptr) return *ptr;
+	return (m1 ? cpu_fetch(cpu, adr) : cpu_mrd(cpu, adr)) & 0xff;
+}
+
+static void i286_lin_wr(CPU* cpu, int adr, int val) {
+	unsigned char* ptr = i286_tlb_ptr(cpu, adr, 1);
+	if (ptr) {
+		*ptr = val & 0xff;
+	} else {
+		cpu_mwr(cpu, adr, val);
+	}
+}
+
 unsigned char i286_mrd(CPU* cpu, xSegPtr seg, int rpl, unsigned short adr) {
 	return cpu->x86mrd(cpu, seg, rpl, adr);
 }
@@ -105,6 +142,49 @@ void i286_mwr(CPU* cpu, xSegPtr seg, int rpl, unsigned short adr, int val) {
 	cpu->x86mwr(cpu, seg, rpl, adr, val);
 }
 
+// host ptr to len bytes at seg:adr, if segment checks are passed. bytes must be inside TLB page and segment
+static unsigned char* i286_blk_ptr(CPU* cpu, xSegPtr* seg, unsigned short adr, int len, int wr) {
+	int ok = wr ? i286_check_segment_wr(cpu, seg) : i286_check_segment_rd(cpu, seg);
+	if (!ok || !i286_check_segment_limit(cpu, seg, adr) || !i286_check_segment_limit(cpu, seg, adr + len - 1)) return NULL;
+	return i286_tlb_ptr(cpu, seg->base + adr, wr);
+}
+
+// word rd/wr: at once, if word doesn't cross TLB page and segment checks are passed. otherwise by bytes (they do exceptions)
+static unsigned char* i286_word_ptr(CPU* cpu, xSegPtr* seg, unsigned short adr, int wr) {
+	if (adr == 0xffff) return NULL;
+	if (((seg->base + adr) & TLB_PGMASK) == TLB_PGMASK) return NULL;
+	return i286_blk_ptr(cpu, seg, adr, 2, wr);
+}
+
+unsigned short i286_mrdw(CPU* cpu, xSegPtr seg, int rpl, unsigned short adr) {
+	unsigned char* ptr;
+	PAIR(w,h,l) rx;
+	if (rpl && (cpu->seg.idx >= 0)) seg = cpu->seg;
+	ptr = i286_word_ptr(cpu, &seg, adr, 0);
+	if (ptr) {
+		if (!(cpu->regMSW & I286_FPE)) cpu->t += 2;	// as 2 real mode byte reads
+		rx.w = ptr[0] | (ptr[1] << 8);
+	} else {
+		rx.l = cpu->x86mrd(cpu, seg, 0, adr);
+		rx.h = cpu->x86mrd(cpu, seg, 0, adr + 1);
+	}
+	return rx.w;
+}
+
+void i286_mwrw(CPU* cpu, xSegPtr seg, int rpl, unsigned short adr, int val) {
+	unsigned char* ptr;
+	if (rpl && (cpu->seg.idx >= 0)) seg = cpu->seg;
+	ptr = i286_word_ptr(cpu, &seg, adr, 1);
+	if (ptr) {
+		if (!(cpu->regMSW & I286_FPE)) cpu->t += 2;
+		ptr[0] = val & 0xff;
+		ptr[1] = (val >> 8) & 0xff;
+	} else {
+		cpu->x86mwr(cpu, seg, 0, adr, val & 0xff);
+		cpu->x86mwr(cpu, seg, 0, adr + 1, (val >> 8) & 0xff);
+	}
+}
+
 // system mrd/mwr, w/o checks
 // TODO: 8086/80186: 20bit adr bus: mask (1<<20)-1
 //	80286: 24bit adr bus: mask (1<<24)-1
@@ -115,24 +195,24 @@ void i286_mwr(CPU* cpu, xSegPtr seg, int rpl, unsigned short adr, int val) {
 //}
 
 unsigned short i286_sys_mrdw(CPU* cpu, xSegPtr seg, unsigned short adr) {
-	unsigned char rl = cpu_mrd(cpu, seg.base + adr) & 0xff;
-	unsigned char rh = cpu_mrd(cpu, seg.base + adr + 1) & 0xff;
+	unsigned char rl = i286_lin_rd(cpu, seg.base + adr, 0);
+	unsigned char rh = i286_lin_rd(cpu, seg.base + adr + 1, 0);
 	return (rh << 8) | rl;
 }
 
 void i286_sys_mwr(CPU* cpu, xSegPtr seg, unsigned short adr, unsigned char v) {
-	cpu_mwr(cpu, seg.base + adr, v);
+	i286_lin_wr(cpu, seg.base + adr, v);
 }
 
 void i286_sys_mwrw(CPU* cpu, xSegPtr seg, unsigned short adr, unsigned short v) {
-	cpu_mwr(cpu, seg.base + adr, v & 0xff);
-	cpu_mwr(cpu, seg.base + adr, (v >> 8) & 0xff);
+	i286_lin_wr(cpu, seg.base + adr, v & 0xff);
+	i286_lin_wr(cpu, seg.base + adr + 1, (v >> 8) & 0xff);
 }
 
 // real mode
 
 unsigned char i286_fetch_real(CPU* cpu) {
-	unsigned char res = cpu_fetch(cpu, cpu->cs.base + cpu->regIP) & 0xff;
+	unsigned char res = i286_lin_rd(cpu, cpu->cs.base + cpu->regIP, 1);
 	cpu->regIP++;
 	return res;
 }
@@ -140,13 +220,13 @@ unsigned char i286_fetch_real(CPU* cpu) {
 unsigned char i286_mrd_real(CPU* cpu, xSegPtr seg, int rpl, unsigned short adr) {
 	if (rpl && (cpu->seg.idx >= 0)) seg = cpu->seg;
 	cpu->t++;
-	return cpu_mrd(cpu, seg.base + adr) & 0xff;
+	return i286_lin_rd(cpu, seg.base + adr, 0);
 }
 
 void i286_mwr_real(CPU* cpu, xSegPtr seg, int rpl, unsigned short adr, int val) {
 	if (rpl && (cpu->seg.idx >= 0)) seg = cpu->seg;
 	cpu->t++;
-	cpu_mwr(cpu, seg.base + adr, val);
+	i286_lin_wr(cpu, seg.base + adr, val);
 }
 
 // stack (TODO: real/prt mode stack rd/wr procedures)
@@ -156,8 +236,7 @@ void i286_push(CPU* cpu, unsigned short w) {
 		x86_exception(cpu, I286_INT_SS, 0);
 	}
 	cpu->regSP -= 2;
-	i286_mwr(cpu, cpu->ss, 0, cpu->regSP, w & 0xff);
-	i286_mwr(cpu, cpu->ss, 0, cpu->regSP + 1, (w >> 8) & 0xff);
+	i286_mwrw(cpu, cpu->ss, 0, cpu->regSP, w);
 }
 
 unsigned short i286_pop(CPU* cpu) {
@@ -165,8 +244,7 @@ unsigned short i286_pop(CPU* cpu) {
 		x86_exception(cpu, I286_INT_SS, 0);
 	}
 	xreg16 rx;
-	rx.l = i286_mrd(cpu, cpu->ss, 0, cpu->regSP);
-	rx.h = i286_mrd(cpu, cpu->ss, 0, cpu->regSP + 1);
+	rx.w = i286_mrdw(cpu, cpu->ss, 0, cpu->regSP);
 	cpu->regSP += 2;
 	return rx.w;
 }
@@ -176,7 +254,7 @@ unsigned short i286_pop(CPU* cpu) {
 unsigned char i286_fetch_prt(CPU* cpu) {
 	unsigned char res = 0xff;
 	if (i286_check_segment_limit(cpu, &cpu->cs, cpu->regIP)) {
-		res = cpu_fetch(cpu, cpu->cs.base + cpu->regIP) & 0xff;
+		res = i286_lin_rd(cpu, cpu->cs.base + cpu->regIP, 1);
 		cpu->regIP++;
 	} else {
 		x86_exception(cpu, I286_INT_SL, 0);
@@ -189,7 +267,7 @@ unsigned char i286_mrd_prt(CPU* cpu, xSegPtr seg, int rpl, unsigned short adr) {
 	if (rpl && (cpu->seg.idx >= 0)) seg = cpu->seg;
 	if (i286_check_segment_rd(cpu, &seg)) {
 		if (i286_check_segment_limit(cpu, &seg, adr)) {
-			res = cpu_fetch(cpu, seg.base + adr) & 0xff;
+			res = i286_lin_rd(cpu, seg.base + adr, 1);
 		} else {
 			x86_exception(cpu, I286_INT_SL, 0);
 		}
@@ -203,7 +281,7 @@ void i286_mwr_prt(CPU* cpu, xSegPtr seg, int rpl, unsigned short adr, int val) {
 	if (rpl && (cpu->seg.idx >= 0)) seg = cpu->seg;
 	if (i286_check_segment_wr(cpu, &seg)) {
 		if (i286_check_segment_limit(cpu, &seg, adr)) {
-			cpu_mwr(cpu, seg.base + adr, val);
+			i286_lin_wr(cpu, seg.base + adr, val);
 		} else {
 			cpu->regIP = cpu->oldpc;
 			x86_exception(cpu, I286_INT_SL, 0);
@@ -242,6 +320,9 @@ void x86_set_mode(CPU* cpu, int m) {
 	}
 }
 
+// mode callbacks by id for state (see state.c), new items go to the end
+void* x86_state_ptrs[] = {i286_fetch_real, i286_mrd_real, i286_mwr_real, i286_fetch_prt, i286_mrd_prt, i286_mwr_prt, NULL};
+
 // imm: byte from ip
 unsigned char i286_rd_imm(CPU* cpu) {
 //	unsigned char res = i286_mrd(cpu, cpu->cs, 0, cpu->pc);
@@ -676,8 +757,12 @@ void i286_get_ea(CPU* cpu, int wrd) {
 void i286_rd_ea(CPU* cpu, int wrd) {
 	i286_get_ea(cpu, wrd);
 	if (!cpu->ea.reg) {
-		cpu->ltw = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr);
-		cpu->htw = wrd ? i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 1) : 0;
+		if (wrd) {
+			cpu->tmpw = i286_mrdw(cpu, cpu->ea.seg, 1, cpu->ea.adr);
+		} else {
+			cpu->ltw = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr);
+			cpu->htw = 0;
+		}
 	}
 }
 
@@ -708,8 +793,11 @@ void i286_wr_ea(CPU* cpu, int val, int wrd) {
 			}
 		}
 	} else {
-		i286_mwr(cpu, cpu->ea.seg, 1, cpu->ea.adr, val & 0xff);
-		if (wrd) i286_mwr(cpu, cpu->ea.seg, 1, cpu->ea.adr + 1, (val >> 8) & 0xff);
+		if (wrd) {
+			i286_mwrw(cpu, cpu->ea.seg, 1, cpu->ea.adr, val);
+		} else {
+			i286_mwr(cpu, cpu->ea.seg, 1, cpu->ea.adr, val & 0xff);
+		}
 	}
 }
 
@@ -1423,8 +1511,7 @@ void i286_op62(CPU* cpu) {
 	} else if ((signed short)cpu->twrd < (signed short)cpu->tmpw) {	// not in bounds: INT5
 		x86_exception(cpu, I286_INT_BR, 0);
 	} else {
-		cpu->ltw = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);
-		cpu->htw = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 3);
+		cpu->tmpw = i286_mrdw(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);
 		if ((signed short)cpu->twrd > (signed short)cpu->tmpw) {
 			x86_exception(cpu, I286_INT_BR, 0);
 		}
@@ -1495,6 +1582,105 @@ void i286_rep(CPU* cpu, cbcpu foo) {
 	}
 }
 
+// bulk rep movs/stos/scas/cmps
+// 1st iteration is done by usual way (it does all checks and exceptions, and gives ticks per iteration),
+// next ones are done here on host memory until cpu->tlim ticks, so one exec call (and device sync) covers many of them.
+// only forward direction, by blocks inside TLB page and segment. ip = adr after opcode
+
+enum {
+	I286_BLK_MOVS = 0,
+	I286_BLK_STOS,
+	I286_BLK_SCAS,
+	I286_BLK_CMPS
+};
+
+// iterations from seg:adr to the end of TLB page or segment
+static int i286_blk_cnt(xSegPtr* seg, unsigned short adr, int sz) {
+	int pg = (1 << CPU_TLB_SHIFT) - ((seg->base + adr) & TLB_PGMASK);
+	int sg = 0x10000 - adr;
+	return ((pg < sg) ? pg : sg) / sz;
+}
+
+// is element k of cmps/scas equal
+static int i286_blk_eq(CPU* cpu, unsigned char* sptr, unsigned char* dptr, int k, int sz) {
+	if (sptr)
+		return (sz == 1) ? (sptr[k] == dptr[k]) : ((sptr[k] == dptr[k]) && (sptr[k + 1] == dptr[k + 1]));
+	return (sz == 1) ? (dptr[k] == cpu->regAL) : ((dptr[k] == cpu->regAL) && (dptr[k + 1] == cpu->regAH));
+}
+
+static void i286_rep_blk(CPU* cpu, int op, int sz, unsigned short ip) {
+	int tcnt = cpu->t;
+	xSegPtr src = (cpu->seg.idx >= 0) ? cpu->seg : cpu->ds;
+	unsigned char* sptr = NULL;
+	unsigned char* dptr;
+	unsigned char* fptr;
+	int n, cnt, len, k;
+	int scan = (op == I286_BLK_SCAS) || (op == I286_BLK_CMPS);
+	if ((cpu->regREP == I286_REP_NONE) || !cpu->tlim || !cpu->mptr) return;
+	if (cpu->flgEXC || cpu->flgD || (cpu->regIP != cpu->oldpc) || (tcnt < 1)) return;
+	while (cpu->regCX) {
+		n = (cpu->tlim - cpu->t) / tcnt;
+		// cmps/scas: last iteration is left for usual way, it sets flags
+		cnt = scan ? cpu->regCX - 1 : cpu->regCX;
+		if (cnt < n) n = cnt;
+		cnt = i286_blk_cnt(&cpu->es, cpu->regDI, sz);
+		if (cnt < n) n = cnt;
+		if ((op == I286_BLK_MOVS) || (op == I286_BLK_CMPS)) {
+			cnt = i286_blk_cnt(&src, cpu->regSI, sz);
+			if (cnt < n) n = cnt;
+		}
+		if (n < 1) break;
+		len = n * sz;
+		dptr = i286_blk_ptr(cpu, &cpu->es, cpu->regDI, len, !scan);
+		if (!dptr) break;
+		if ((op == I286_BLK_MOVS) || (op == I286_BLK_CMPS)) {
+			sptr = i286_blk_ptr(cpu, &src, cpu->regSI, len, 0);
+			if (!sptr) break;
+		}
+		cnt = n;
+		switch (op) {
+			case I286_BLK_MOVS:
+				if ((dptr > sptr) && (dptr < sptr + len)) {
+					for (k = 0; k < len; k += sz)		// overlapped: element by element, as cpu does
+						memmove(dptr + k, sptr + k, sz);
+				} else {
+					memmove(dptr, sptr, len);
+				}
+				break;
+			case I286_BLK_STOS:
+				if (sz == 1) {
+					memset(dptr, cpu->regAL, len);
+				} else {
+					for (k = 0; k < len; k += 2) {
+						dptr[k] = cpu->regAL;
+						dptr[k + 1] = cpu->regAH;
+					}
+				}
+				break;
+			default:
+				// skip elements that don't stop repeating
+				if ((op == I286_BLK_SCAS) && (sz == 1) && (cpu->regREP == I286_REPNZ)) {
+					fptr = memchr(dptr, cpu->regAL, len);
+					n = fptr ? fptr - dptr : n;
+				} else {
+					for (k = 0; k < n; k++) {
+						if (i286_blk_eq(cpu, sptr, dptr, k * sz, sz) != (cpu->regREP == I286_REPZ))
+							break;
+					}
+					n = k;
+				}
+				len = n * sz;
+				break;
+		}
+		cpu->regDI += len;
+		if (sptr) cpu->regSI += len;
+		cpu->regCX -= n;
+		cpu->t += n * tcnt;
+		if (n < cnt) break;
+	}
+	cpu->regIP = cpu->regCX ? cpu->oldpc : ip;
+}
+
 // 6c: insb: [es:di] = in dx;
 void i286_6c_cb(CPU* cpu) {
 	cpu->tmp = i286_ird(cpu, cpu->regDX);
@@ -1506,8 +1692,7 @@ void i286_op6C(CPU* cpu) {i286_rep(cpu, i286_6c_cb);}
 // 6d: insw: word [es:di] = in dx;
 void i286_6d_cb(CPU* cpu) {
 	cpu->tmpw = i286_ird(cpu, cpu->regDX);
-	i286_mwr(cpu, cpu->es, 0, cpu->regDI, cpu->ltw);
-	i286_mwr(cpu, cpu->es, 0, cpu->regDI + 1, cpu->htw);
+	i286_mwrw(cpu, cpu->es, 0, cpu->regDI, cpu->tmpw);
 	cpu->regDI += cpu->flgD ? -2 : 2;
 }
 void i286_op6D(CPU* cpu) {
@@ -1529,8 +1714,7 @@ void i286_op6E(CPU* cpu) {i286_rep(cpu, i286_6e_cb);}
 
 // 6f: outs dx,wrd
 void i286_6f_cb(CPU* cpu) {
-	cpu->ltw = i286_mrd(cpu, cpu->ds, 1, cpu->regSI);
-	cpu->htw = i286_mrd(cpu, cpu->ds, 1, cpu->regSI + 1);
+	cpu->tmpw = i286_mrdw(cpu, cpu->ds, 1, cpu->regSI);
 	i286_iwr(cpu, cpu->regDX, cpu->tmpw, 1);
 	cpu->regSI += cpu->flgD ? -2 : 2;
 }
@@ -1937,8 +2121,7 @@ void i286_opA1(CPU* cpu) {
 		i286_push(cpu, 0);
 		x86_exception(cpu, I286_INT_GP, 0);
 	} else {
-		cpu->regAL = i286_mrd(cpu, cpu->ds, 1, cpu->tmpw);
-		cpu->regAH = i286_mrd(cpu, cpu->ds, 1, cpu->tmpw + 1);
+		cpu->regAX = i286_mrdw(cpu, cpu->ds, 1, cpu->tmpw);
 	}
 }
 
@@ -1955,8 +2138,7 @@ void i286_opA3(CPU* cpu) {
 		i286_push(cpu, 0);
 		x86_exception(cpu, I286_INT_GP, 0);
 	} else {
-		i286_mwr(cpu, cpu->ds, 1, cpu->tmpw, cpu->regAL);
-		i286_mwr(cpu, cpu->ds, 1, cpu->tmpw + 1, cpu->regAH);
+		i286_mwrw(cpu, cpu->ds, 1, cpu->tmpw, cpu->regAX);
 	}
 }
 
@@ -1972,14 +2154,16 @@ void i286_a4_cb(CPU* cpu) {
 		cpu->regDI++;
 	}
 }
-void i286_opA4(CPU* cpu) {i286_rep(cpu, i286_a4_cb);}
+void i286_opA4(CPU* cpu) {
+	unsigned short ip = cpu->regIP;
+	i286_rep(cpu, i286_a4_cb);
+	i286_rep_blk(cpu, I286_BLK_MOVS, 1, ip);
+}
 
 // a5: movsw [*ds:si]->[es:di] by word, si,di +/-= 2
 void i286_a5_cb(CPU* cpu) {
-	cpu->ltw = i286_mrd(cpu, cpu->ds, 1, cpu->regSI);
-	cpu->htw = i286_mrd(cpu, cpu->ds, 1, cpu->regSI + 1);
-	i286_mwr(cpu, cpu->es, 0, cpu->regDI, cpu->ltw);
-	i286_mwr(cpu, cpu->es, 0, cpu->regDI + 1, cpu->htw);
+	cpu->tmpw = i286_mrdw(cpu, cpu->ds, 1, cpu->regSI);
+	i286_mwrw(cpu, cpu->es, 0, cpu->regDI, cpu->tmpw);
 	if (cpu->flgD) {
 		cpu->regSI -= 2;
 		cpu->regDI -= 2;
@@ -1993,7 +2177,9 @@ void i286_opA5(CPU* cpu) {
 		i286_push(cpu, 0);
 		x86_exception(cpu, I286_INT_GP, 0);
 	} else {
+		unsigned short ip = cpu->regIP;
 		i286_rep(cpu, i286_a5_cb);
+		i286_rep_blk(cpu, I286_BLK_MOVS, 2, ip);
 	}
 }
 
@@ -2026,15 +2212,15 @@ void i286_a6_cb(CPU* cpu) {
 	}
 }
 void i286_opA6(CPU* cpu) {
+	unsigned short ip = cpu->regIP;
 	i286_rep_fz(cpu, i286_a6_cb);
+	i286_rep_blk(cpu, I286_BLK_CMPS, 1, ip);
 }
 
 // a7: cmpsw
 void i286_a7_cb(CPU* cpu) {
-	cpu->ltw = i286_mrd(cpu, cpu->ds, 1, cpu->regSI);
-	cpu->htw = i286_mrd(cpu, cpu->ds, 1, cpu->regSI + 1);
-	cpu->lwr = i286_mrd(cpu, cpu->es, 0, cpu->regDI);
-	cpu->hwr = i286_mrd(cpu, cpu->es, 0, cpu->regDI + 1);
+	cpu->tmpw = i286_mrdw(cpu, cpu->ds, 1, cpu->regSI);
+	cpu->twrd = i286_mrdw(cpu, cpu->es, 0, cpu->regDI);
 	cpu->tmpw = i286_sub16(cpu, cpu->tmpw, cpu->twrd, 0);
 	if (cpu->flgD) {
 		cpu->regSI -= 2;
@@ -2049,7 +2235,9 @@ void i286_opA7(CPU* cpu) {
 		i286_push(cpu, 0);
 		x86_exception(cpu, I286_INT_GP, 0);
 	} else {
+		unsigned short ip = cpu->regIP;
 		i286_rep_fz(cpu, i286_a7_cb);
+		i286_rep_blk(cpu, I286_BLK_CMPS, 2, ip);
 	}
 }
 
@@ -2070,12 +2258,15 @@ void i286_aa_cb(CPU* cpu) {
 	i286_mwr(cpu, cpu->es, 0, cpu->regDI, cpu->regAL);
 	cpu->regDI += cpu->flgD ? -1 : 1;
 }
-void i286_opAA(CPU* cpu) {i286_rep(cpu, i286_aa_cb);}
+void i286_opAA(CPU* cpu) {
+	unsigned short ip = cpu->regIP;
+	i286_rep(cpu, i286_aa_cb);
+	i286_rep_blk(cpu, I286_BLK_STOS, 1, ip);
+}
 
 // ab: stosw: ax->[es:di], adv di
 void i286_ab_cb(CPU* cpu) {
-	i286_mwr(cpu, cpu->es, 0, cpu->regDI, cpu->regAL);
-	i286_mwr(cpu, cpu->es, 0, cpu->regDI + 1, cpu->regAH);
+	i286_mwrw(cpu, cpu->es, 0, cpu->regDI, cpu->regAX);
 	cpu->regDI += cpu->flgD ? -2 : 2;
 }
 void i286_opAB(CPU* cpu) {
@@ -2083,7 +2274,9 @@ void i286_opAB(CPU* cpu) {
 		i286_push(cpu, 0);
 		x86_exception(cpu, I286_INT_GP, 0);
 	} else {
+		unsigned short ip = cpu->regIP;
 		i286_rep(cpu, i286_ab_cb);
+		i286_rep_blk(cpu, I286_BLK_STOS, 2, ip);
 	}
 }
 
@@ -2099,8 +2292,7 @@ void i286_opAD(CPU* cpu) {
 		i286_push(cpu, 0);
 		x86_exception(cpu, I286_INT_GP, 0);
 	} else {
-		cpu->regAL = i286_mrd(cpu, cpu->ds, 1, cpu->regSI);
-		cpu->regAH = i286_mrd(cpu, cpu->ds, 1, cpu->regSI + 1);
+		cpu->regAX = i286_mrdw(cpu, cpu->ds, 1, cpu->regSI);
 		cpu->regSI += cpu->flgD ? -2 : 2;
 	}
 }
@@ -2112,13 +2304,14 @@ void i286_ae_cb(CPU* cpu) {
 	cpu->regDI += cpu->flgD ? -1 : 1;
 }
 void i286_opAE(CPU* cpu) {
+	unsigned short ip = cpu->regIP;
 	i286_rep_fz(cpu, i286_ae_cb);
+	i286_rep_blk(cpu, I286_BLK_SCAS, 1, ip);
 }
 
 // af: scasw	cmp ax,[es:di]
 void i286_af_cb(CPU* cpu) {
-	cpu->ltw = i286_mrd(cpu, cpu->es, 0, cpu->regDI);
-	cpu->htw = i286_mrd(cpu, cpu->es, 0, cpu->regDI + 1);
+	cpu->tmpw = i286_mrdw(cpu, cpu->es, 0, cpu->regDI);
 	cpu->twrd = i286_sub16(cpu, cpu->regAX, cpu->tmpw, 0);
 	cpu->regDI += cpu->flgD ? -2 : 2;
 }
@@ -2127,7 +2320,9 @@ void i286_opAF(CPU* cpu) {
 		i286_push(cpu, 0);
 		x86_exception(cpu, I286_INT_GP, 0);
 	} else {
+		unsigned short ip = cpu->regIP;
 		i286_rep_fz(cpu, i286_af_cb);
+		i286_rep_blk(cpu, I286_BLK_SCAS, 2, ip);
 	}
 }
 
@@ -2225,10 +2420,8 @@ void i286_opC3(CPU* cpu) {
 // c4,mod: les rw,ed
 void i286_opC4(CPU* cpu) {
 	i286_rd_ea(cpu, 1);
-	cpu->ltw = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 0);		// address
-	cpu->htw = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 1);
-	cpu->lwr = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);		// segment
-	cpu->hwr = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 3);
+	cpu->tmpw = i286_mrdw(cpu, cpu->ea.seg, 1, cpu->ea.adr);		// address
+	cpu->twrd = i286_mrdw(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);		// segment
 	cpu->es = i286_cash_seg(cpu, cpu->twrd);
 	i286_set_reg(cpu, cpu->tmpw, 1);
 }
@@ -2236,10 +2429,8 @@ void i286_opC4(CPU* cpu) {
 // c5,mod: lds rw,ed (same c4 with ds)
 void i286_opC5(CPU* cpu) {
 	i286_rd_ea(cpu, 1);
-	cpu->ltw = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 0);		// address
-	cpu->htw = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 1);
-	cpu->lwr = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);		// segment
-	cpu->hwr = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 3);
+	cpu->tmpw = i286_mrdw(cpu, cpu->ea.seg, 1, cpu->ea.adr);		// address
+	cpu->twrd = i286_mrdw(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);		// segment
 	cpu->ds = i286_cash_seg(cpu, cpu->twrd);
 	i286_set_reg(cpu, cpu->tmpw, 1);
 }
@@ -2270,8 +2461,7 @@ void i286_opC8(CPU* cpu) {
 	if (cpu->tmpb > 0) {
 		while(--cpu->tmpb) {
 			cpu->regBP -= 2;
-			cpu->lwr = i286_mrd(cpu, cpu->ds, 1, cpu->regBP);		// +1T		TODO: segment override?
-			cpu->hwr = i286_mrd(cpu, cpu->ds, 1, cpu->regBP + 1);	// +1T
+			cpu->twrd = i286_mrdw(cpu, cpu->ds, 1, cpu->regBP);		// +2T		TODO: segment override?
 			i286_push(cpu, cpu->twrd);				// +2T
 		}
 		i286_push(cpu, cpu->ea.adr);					// +2T (1?)
@@ -2833,14 +3023,12 @@ void i286_opFF(CPU* cpu) {
 		case 2:	i286_push(cpu, cpu->regIP);
 			cpu->regIP = cpu->tmpw;
 			break; // call ew
-		case 3:	cpu->lwr = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);	// twrd = segment
-			cpu->hwr = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 3);
+		case 3:	cpu->twrd = i286_mrdw(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);	// twrd = segment
 			i286_callf(cpu, cpu->tmpw, cpu->twrd);
 			break; // callf ed
 		case 4: cpu->regIP = cpu->tmpw;
 			break; // jmp ew
-		case 5:	cpu->lwr = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);
-			cpu->hwr = i286_mrd(cpu, cpu->ea.seg, 1, cpu->ea.adr + 3);
+		case 5:	cpu->twrd = i286_mrdw(cpu, cpu->ea.seg, 1, cpu->ea.adr + 2);
 			i286_jmpf(cpu, cpu->tmpw, cpu->twrd);
 			break; // jmpf ed
 		case 6: i286_push(cpu, cpu->tmpw);
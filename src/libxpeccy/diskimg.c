@@ -0,0 +1,184 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "diskimg.h"
+
+#if defined(__linux) || defined(__APPLE__) || defined(__BSD)
+	#define DIMG_POSIX 1
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+xDiskImage* dimg_open(const char* path, int mode) {
+	xDiskImage* img = (xDiskImage*)malloc(sizeof(xDiskImage));
+	memset(img, 0x00, sizeof(xDiskImage));
+	img->mode = mode;
+	img->fd = -1;
+#if DIMG_POSIX
+	struct stat st;
+	void* ptr;
+	img->fd = open(path, (mode == DIMG_COW) ? O_RDONLY : O_RDWR);
+	if (img->fd < 0) {
+		free(img);
+		return NULL;
+	}
+	if (fstat(img->fd, &st) == 0)
+		img->size = st.st_size;
+	if ((img->size > 0) && ((unsigned long long)img->size <= SIZE_MAX)) {
+		// private mapping is copy-on-write by itself: unchanged pages are shared with file cache
+		ptr = mmap(NULL, img->size, PROT_READ | PROT_WRITE, (mode == DIMG_COW) ? MAP_PRIVATE : MAP_SHARED, img->fd, 0);
+		if (ptr != MAP_FAILED) {
+			img->map = ptr;
+			img->msize = img->size;
+		}
+	}
+#else
+	img->file = fopen(path, (mode == DIMG_COW) ? "rb" : "rb+");
+	if (!img->file) {
+		free(img);
+		return NULL;
+	}
+	fseek(img->file, 0, SEEK_END);
+	img->size = ftell(img->file);
+#endif
+	return img;
+}
+
+void dimg_close(xDiskImage* img) {
+	int i, j;
+	if (!img) return;
+	for (i = 0; i < img->ovlCount; i++) {
+		if (!img->ovl[i]) continue;
+		for (j = 0; j < (1 << DIMG_OVLBITS); j++)
+			free(img->ovl[i][j]);
+		free(img->ovl[i]);
+	}
+	free(img->ovl);
+#if DIMG_POSIX
+	if (img->map)
+		munmap(img->map, img->msize);
+	if (img->fd >= 0)
+		close(img->fd);
+#else
+	if (img->file)
+		fclose(img->file);
+#endif
+	free(img);
+}
+
+// file io (out of mapping)
+
+static void dimg_file_read(xDiskImage* img, long long pos, unsigned char* buf, int len) {
+	int res = 0;
+	if (pos < img->size) {
+		if (pos + len > img->size)
+			res = img->size - pos;
+		else
+			res = len;
+#if DIMG_POSIX
+		res = pread(img->fd, buf, res, pos);
+#else
+		fseek(img->file, pos, SEEK_SET);
+		res = fread(buf, 1, res, img->file);
+#endif
+		if (res < 0) res = 0;
+	}
+	if (res < len)
+		memset(buf + res, 0xff, len - res);
+}
+
+static void dimg_file_write(xDiskImage* img, long long pos, unsigned char* buf, int len) {
+#if DIMG_POSIX
+	if (pwrite(img->fd, buf, len, pos) != len) return;
+#else
+	fseek(img->file, pos, SEEK_SET);
+	if ((int)fwrite(buf, 1, len, img->file) != len) return;
+#endif
+	if (pos + len > img->size)
+		img->size = pos + len;
+}
+
+// cow overlay
+
+static unsigned char* dimg_ovl_sec(xDiskImage* img, long long sec, int add) {
+	int tab = sec >> DIMG_OVLBITS;
+	unsigned char** ptr;
+	if (tab >= img->ovlCount) {
+		if (!add) return NULL;
+		img->ovl = realloc(img->ovl, (tab + 1) * sizeof(unsigned char**));
+		memset(img->ovl + img->ovlCount, 0x00, (tab + 1 - img->ovlCount) * sizeof(unsigned char**));
+		img->ovlCount = tab + 1;
+	}
+	if (!img->ovl[tab]) {
+		if (!add) return NULL;
+		img->ovl[tab] = calloc(1 << DIMG_OVLBITS, sizeof(unsigned char*));
+	}
+	ptr = &img->ovl[tab][sec & ((1 << DIMG_OVLBITS) - 1)];
+	if (!*ptr && add) {
+		*ptr = malloc(DIMG_SEC);
+		dimg_file_read(img, sec * DIMG_SEC, *ptr, DIMG_SEC);
+	}
+	return *ptr;
+}
+
+// rest of data (out of mapping)
+static void dimg_rest(xDiskImage* img, long long pos, unsigned char* buf, int len, int wr) {
+	unsigned char* sec;
+	int off;
+	int n;
+	if (img->mode != DIMG_COW) {
+		if (wr) {
+			dimg_file_write(img, pos, buf, len);
+		} else {
+			dimg_file_read(img, pos, buf, len);
+		}
+		return;
+	}
+	while (len > 0) {
+		off = pos % DIMG_SEC;
+		n = DIMG_SEC - off;
+		if (n > len) n = len;
+		sec = dimg_ovl_sec(img, pos / DIMG_SEC, wr);
+		if (wr) {
+			memcpy(sec + off, buf, n);
+		} else if (sec) {
+			memcpy(buf, sec + off, n);
+		} else {
+			dimg_file_read(img, pos, buf, n);
+		}
+		pos += n;
+		buf += n;
+		len -= n;
+	}
+}
+
+void dimg_read(xDiskImage* img, long long pos, unsigned char* buf, int len) {
+	int n;
+	if (img->map && (pos < img->msize)) {
+		n = (pos + len > img->msize) ? img->msize - pos : len;
+		memcpy(buf, img->map + pos, n);
+		pos += n;
+		buf += n;
+		len -= n;
+	}
+	if (len > 0)
+		dimg_rest(img, pos, buf, len, 0);
+}
+
+void dimg_write(xDiskImage* img, long long pos, unsigned char* buf, int len) {
+	int n;
+	if (img->map && (pos < img->msize)) {
+		n = (pos + len > img->msize) ? img->msize - pos : len;
+		// don't touch pages if data is the same: they stay unallocated (sparse file) or shared (cow)
+		if (memcmp(img->map + pos, buf, n))
+			memcpy(img->map + pos, buf, n);
+		pos += n;
+		buf += n;
+		len -= n;
+	}
+	if (len > 0)
+		dimg_rest(img, pos, buf, len, 1);
+}
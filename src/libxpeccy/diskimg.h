@@ -0,0 +1,41 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+
+// disk image file (IDE, SD card): random access by byte position.
+// whole file is mapped into memory when it's possible, otherwise pread/pwrite (stdio on non-posix hosts) is used.
+// DIMG_COW: file is opened read-only and is never written (so it can be shared by many machines),
+// changes are kept in memory: in private mapping or in overlay of changed sectors (out of mapping).
+// reading out of file gives 0xff
+
+enum {
+	DIMG_RW = 0,
+	DIMG_COW
+};
+
+#define DIMG_SEC	512		// overlay sector size
+#define DIMG_OVLBITS	12		// sectors in one overlay table (2^N)
+
+typedef struct {
+	int mode;
+	long long size;		// file size (can grow by writing, not in cow mode)
+	int fd;
+	FILE* file;		// if there is no posix io
+	unsigned char* map;	// mapped file, NULL if not mapped
+	long long msize;	// mapped size
+	unsigned char*** ovl;	// cow overlay: [sec >> DIMG_OVLBITS][sec & mask] = changed sector, NULL if not changed
+	int ovlCount;
+} xDiskImage;
+
+xDiskImage* dimg_open(const char*, int);
+void dimg_close(xDiskImage*);
+void dimg_read(xDiskImage*, long long, unsigned char*, int);
+void dimg_write(xDiskImage*, long long, unsigned char*, int);
+
+#ifdef __cplusplus
+}
+#endif
@@ -29,6 +29,8 @@ enum {
 #define FDC_SEC		0x5f
 #define FDC_DATA	0x7f
 
+// turbo: floppy spins to next ADR/DATA mark or IDX at once, no head seek/load/motor delays,
+// transfered byte is ready right after cpu took previous one (data is lost if cpu doesn't take it in bytedelay ns)
 #define TURBOBYTE 500		// same for turbo
 #define turbo (fdcFlag & FDC_FAST)
 
@@ -152,3 +154,8 @@ void difSetHW(DiskIF*, int);
 void dif_align_flps(DiskIF*, FDC*, int, int, int, int);
 
 void add_crc_16(FDC*, unsigned char);
+
+// fdc plans by id for state
+extern void* vg93_state_ptrs[];
+extern void* upd765_state_ptrs[];
+extern void* vp1_128_state_ptrs[];
@@ -138,24 +138,27 @@ long dsk_save_track(Floppy* flp, int trk, int side, FILE* file) {
 	int mdsz = 0;
 	int rtrk = (trk << 1) | side;
 	side &= 1;
+	xTrack* tdata = flp->data[rtrk & 0xff];
+	if (!tdata)		// unformatted track
+		return 0;
 	memset(&tinf, 0, sizeof(TrackInfBlock));
 	// scan track & collect sectors info & data
 	for (pos = 0; (pos < flp->trklen) && (sec < 29); pos++) {
-		if (flp->data[rtrk].field[pos] == 1) {			// sector info
-			sdata[sec].trk = flp->data[rtrk].byte[pos++];	// C
-			sdata[sec].head = flp->data[rtrk].byte[pos++];	// H
-			sdata[sec].sec = flp->data[rtrk].byte[pos++];	// R
-			sdata[sec].sz = flp->data[rtrk].byte[pos++] & 7;// N
+		if (tdata->field[pos] == 1) {			// sector info
+			sdata[sec].trk = tdata->byte[pos++];	// C
+			sdata[sec].head = tdata->byte[pos++];	// H
+			sdata[sec].sec = tdata->byte[pos++];	// R
+			sdata[sec].sz = tdata->byte[pos++] & 7;// N
 			pos += 2;					// skip crc
 			if (sdata[sec].sz > mdsz)			// max N
 				mdsz = sdata[sec].sz;
 			dsz = 128 << sdata[sec].sz;			// sector data size
 			if (dsz > 0x1800)
 				dsz = 0x1800;
-			dps = flp->data[rtrk].map[sdata[sec].sec];	// position of sector data
+			dps = tdata->map[sdata[sec].sec];	// position of sector data
 			if (dps > 0)
-				sdata[sec].type = flp->data[rtrk].byte[dps - 1];	// sector data type (FB | F8)
-			memcpy(sdata[sec].data, flp->data[rtrk].byte + dps, dsz);	// copy sector data
+				sdata[sec].type = tdata->byte[dps - 1];	// sector data type (FB | F8)
+			memcpy(sdata[sec].data, tdata->byte + dps, dsz);	// copy sector data
 			sec++;
 		}
 	}
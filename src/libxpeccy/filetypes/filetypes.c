@@ -80,8 +80,7 @@ void loadBoot(Computer* comp, const char* path, int drv) {
 
 void diskClear(Floppy* flp) {
 	for (int i = 0; i < 168; i++) {
-		memset(flp->data[i].byte, 0, flp->trklen);
-		flpFillFields(flp, i, 0);
+		flpClearTrack(flp, i);
 	}
 }
 
@@ -126,10 +125,11 @@ void diskFormTRDTrack(Floppy* flp, int tr, unsigned char* bpos) {
 // <sdata> is list of <scount> sectors
 // TODO: calculate GAP3 len !!!
 void diskFormTrack(Floppy* flp, int tr, Sector* sdata, int scount) {
-	unsigned char *ppos = flp->data[tr].byte;
+	unsigned char *ppos;
 	int i,ln;
 	int sc;
 	if (tr > 255) return;
+	ppos = flp_trk(flp, tr)->byte;
 	int dsz = 0;
 	for (i = 0; i < scount; i++) {
 		dsz += (128 << sdata[i].sz);
@@ -165,13 +165,12 @@ void diskFormTrack(Floppy* flp, int tr, Sector* sdata, int scount) {
 		*(ppos++) = 0xf7; *(ppos++) = 0xf7;
 		/*memset(ppos, 0x4e, dsz);*/ ppos += dsz;		// 60	sync (GAP3)
 	}
-	// while ((ppos - flp->data[tr].byte) < flp->trklen) *(ppos++) = 0x4e;		// last sync (GAP4)
+	// while ((ppos - flp->data[tr]->byte) < flp->trklen) *(ppos++) = 0x4e;		// last sync (GAP4)
 	flpFillFields(flp,tr,1);
 }
 
-static unsigned char fbuf[0x100];
-
 int diskGetType(Floppy* flp) {
+	unsigned char fbuf[0x100];
 	int res = -1;
 	// trdos
 	if (diskGetSectorData(flp,0,15,fbuf,0x100)) {			// at least 16 sectors
@@ -183,6 +182,7 @@ int diskGetType(Floppy* flp) {
 }
 
 int diskCreateDescriptor(Floppy* flp,TRFile* dsc) {
+	unsigned char fbuf[0x100];
 	unsigned char files;
 	unsigned short freesec;
 	if (!diskGetSectorData(flp,0,9,fbuf,256)) return ERR_SHIT;
@@ -272,6 +272,7 @@ TRFile diskMakeDescriptor(const char* name, char ext, int start, int len) {
 }
 
 int diskGetTRCatalog(Floppy *flp, TRFile *dst) {
+	unsigned char fbuf[0x100];
 	int cnt = 0;
 	if (diskGetType(flp) == DISK_TYPE_TRD) {
 		int sc;
@@ -299,25 +300,26 @@ int diskGetTRCatalog(Floppy *flp, TRFile *dst) {
 
 unsigned char* diskGetSectorDataPtr(Floppy* flp, unsigned char tr, unsigned char sc) {
 #if 1
-	int pos = flp->data[tr].map[sc];	// input nr 1+, tab nr 0+
+	if (!flp->data[tr]) return NULL;
+	int pos = flp->data[tr]->map[sc];	// input nr 1+, tab nr 0+
 	if (pos == 0) return NULL;
-	return flp->data[tr].byte + pos;
+	return flp->data[tr]->byte + pos;
 #else
 	int tpos = 0;
 	int fnd;
 	if (!flp->insert) return NULL;
 	while (1) {
-		while (flp->data[tr].field[tpos] != 1) {
+		while (flp->data[tr]->field[tpos] != 1) {
 			if (++tpos >= TRACKLEN) return NULL;
 		}
-		fnd = (flp->data[tr].byte[tpos+2] == sc) ? 1 : 0;
+		fnd = (flp->data[tr]->byte[tpos+2] == sc) ? 1 : 0;
 		tpos += 6;
-		while ((flp->data[tr].field[tpos] != 2) && (flp->data[tr].field[tpos] != 3)) {
+		while ((flp->data[tr]->field[tpos] != 2) && (flp->data[tr]->field[tpos] != 3)) {
 			if (++tpos >= TRACKLEN) return NULL;
 		}
 		if (fnd) {
 			// printf("%i\n",tpos);	// 3190
-			return flp->data[tr].byte + tpos;
+			return flp->data[tr]->byte + tpos;
 		}
 		tpos += 0x102;
 		if (tpos >= TRACKLEN) return NULL;
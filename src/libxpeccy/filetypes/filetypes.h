@@ -69,7 +69,9 @@ enum {
 	ERR_TD0_VERSION,	// unsupported version ( <20)
 
 	ERR_NES_HEAD,		// header error
-	ERR_NES_MAPPER		// unsupported mapper
+	ERR_NES_MAPPER,		// unsupported mapper
+
+	ERR_XST_SIGN		// state signature error or state doesn't fit this build/machine
 };
 
 // spg
@@ -162,6 +164,11 @@ int loadSNA(Computer*,const char*, int);
 int saveSNA(Computer*, const char*, int);
 int loadSNA_f(Computer*, FILE*, size_t);
 
+// full machine state
+
+int loadXST(Computer*, const char*, int);
+int saveXST(Computer*, const char*, int);
+
 int loadSPG(Computer*,const char*, int);
 
 int loadT64(Computer*,const char*,int);
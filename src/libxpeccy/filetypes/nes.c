@@ -82,6 +82,7 @@ int loadNes(Computer* comp, const char* name, int drv) {
 			slot->data = realloc(slot->data, tsiz);		// PRGROM
 			slot->brkMap = realloc(slot->brkMap, tsiz);	// PRGROM breakpoints map
 			memset(slot->brkMap, 0x00, tsiz);		// init
+			slot->brkCount = 0;
 			slot->memMask = tsiz - 1;
 			slot->prglast = slot->memMask >> 14;		// last 16K page number
 			printf("PRGROM:%i x 16K, mask %X\n", hd.nprg, slot->memMask);
@@ -18,6 +18,7 @@ int loadSlot(Computer* comp, const char* name, int drv) {
 		slot->data = realloc(slot->data, tsiz);
 		slot->brkMap = realloc(slot->brkMap, tsiz);
 		memset(slot->brkMap, 0x00, tsiz);
+		slot->brkCount = 0;
 		slot->memMask = tsiz - 1;
 		slot->haveram = 0;
 		sltSetPath(slot, name);
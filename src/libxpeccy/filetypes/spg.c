@@ -56,15 +56,15 @@ int loadSPG(Computer* comp, const char* name, int drv) {
 		fread((char*)inbuf, sze, 1, file);
 		switch (blkInfo[idx + 1] & 0xc0) {
 			case 0x00:
-				memcpy(comp->mem->ramData + (pg << 14) + addr, inbuf, sze);
+				memcpy(comp->mem->ramData + ((pg << 14) & comp->mem->ramMask) + addr, inbuf, sze);
 				break;
 			case 0x40:
 				sze = demegalz(inbuf, outbuf);		// it works?
-				memcpy(comp->mem->ramData + (pg << 14) + addr, outbuf, sze);
+				memcpy(comp->mem->ramData + ((pg << 14) & comp->mem->ramMask) + addr, outbuf, sze);
 				break;
 			case 0x80:
 				sze = dehrust(inbuf, outbuf);		// no 'last 6 bytes'
-				memcpy(comp->mem->ramData + (pg << 14) + addr, outbuf, sze);
+				memcpy(comp->mem->ramData + ((pg << 14) & comp->mem->ramMask) + addr, outbuf, sze);
 				break;
 			default:
 				printf("(%.2X,%.4X,%.4X) unknown compression\n",pg,addr,sze);
@@ -81,13 +81,15 @@ int saveWAV(Computer* comp, const char* name, int drv) {
 			unsigned char amp;
 			int tPerSample = TAPTPS / hd.sampleRate;
 			TapeBlock* blk;
+			TapeSignal sig;
 			fwrite((char*)&hd, sizeof(wavHead), 1, file);
 			for (i = 0; i < comp->tape->blkCount; i++) {
 				blk = &comp->tape->blkData[i];
 				tm = 0;
 				for (pos = 0; pos < blk->sigCount; pos++) {
-					tm = blk->data[pos].size;
-					amp = blk->data[pos].vol;
+					sig = blkGetSignal(blk, pos);
+					tm = sig.size;
+					amp = sig.vol;
 					while (tm > 0) {
 						tm -= tPerSample;
 						fputc(amp, file);
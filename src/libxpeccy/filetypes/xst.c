@@ -0,0 +1,31 @@
+#include "filetypes.h"
+#include "../state.h"
+
+// full machine state
+
+int loadXST(Computer* comp, const char* name, int drv) {
+	FILE* file = fopen(name, "rb");
+	if (!file) return ERR_CANT_OPEN;
+	int err = ERR_OK;
+	size_t siz = fgetSize(file);
+	unsigned char* buf = (unsigned char*)malloc(siz);
+	if (fread(buf, 1, siz, file) != siz) {
+		err = ERR_XST_SIGN;
+	} else if (!comp_state_load(comp, buf, siz)) {
+		err = ERR_XST_SIGN;
+	}
+	free(buf);
+	fclose(file);
+	return err;
+}
+
+int saveXST(Computer* comp, const char* name, int drv) {
+	FILE* file = fopen(name, "wb");
+	if (!file) return ERR_CANT_OPEN;
+	xStateBuf buf = {NULL, 0, 0};
+	comp_state_save(comp, &buf, 0);
+	fwrite(buf.data, buf.len, 1, file);
+	fclose(file);
+	comp_state_free(&buf);
+	return ERR_OK;
+}
@@ -25,9 +25,19 @@ Floppy* flpCreate(int id, cbflpirq cb, void* p) {
 }
 
 void flpDestroy(Floppy* flp) {
+	flpClearDisk(flp);
+	free(flp->path);
 	free(flp);
 }
 
+// get track data, allocate it if track is not exists yet
+xTrack* flp_trk(Floppy* flp, int tr) {
+	tr &= 0xff;
+	if (!flp->data[tr])
+		flp->data[tr] = (xTrack*)calloc(1, sizeof(xTrack));
+	return flp->data[tr];
+}
+
 void flp_set_path(Floppy* flp, const char* path) {
 	if (path) {
 		flp->path = realloc(flp->path, strlen(path) + 1);
@@ -58,7 +68,7 @@ void flpWr(Floppy* flp, int hd, unsigned char val) {
 	if (hd & !flp->doubleSide) return;	// saving on HD1 for SS Floppy
 	if (flp->insert && flp->door) {
 		flp->changed = 1;
-		flp->data[(flp->trk << 1) | hd].byte[flp->pos] = val;
+		flp_trk(flp, (flp->trk << 1) | hd)->byte[flp->pos] = val;
 	}
 }
 
@@ -67,12 +77,14 @@ unsigned char flpRd(Floppy* flp, int hd) {
 	hd &= 1;
 	if (!(flp->insert && flp->door)) return 0x00;
 	if (hd && !flp->doubleSide) return 0x00;
-	return flp->data[(flp->trk << 1) | hd].byte[flp->pos];
+	xTrack* trk = flp->data[(flp->trk << 1) | hd];
+	return trk ? trk->byte[flp->pos] : 0x00;
 }
 
 int flp_check_marker(Floppy* flp, int hd) {
 	if (!flp->insert || !flp->door) return 0;
-	return !!(flp->data[(flp->trk << 1) | (hd & 1)].field[flp->pos] & 0x80);
+	xTrack* trk = flp->data[(flp->trk << 1) | (hd & 1)];
+	return trk ? !!(trk->field[flp->pos] & 0x80) : 0;
 }
 
 // TODO: move disk spinning here (if motor is on)
@@ -111,7 +123,7 @@ int flpNext(Floppy* flp, int fdcSide) {
 			res = 1;
 		}
 		flp->index = (flp->pos < 4) ? 1 : 0;		// ~90ms index pulse
-		flp->field = flp->data[rtrk].field[flp->pos] & 0x0f;
+		flp->field = flp->data[rtrk] ? flp->data[rtrk]->field[flp->pos] & 0x0f : 0;
 	} else {
 		flp->field = 0;
 	}
@@ -217,7 +229,7 @@ int flp_format_trk(Floppy* flp, int trk, int spt, int slen, char* data) {
 	if (trk > 255) {
 		res = 0;
 	} else {
-		res = flp_format_trk_buf(trk, spt, slen, flp->trklen, data, flp->data[trk].byte);
+		res = flp_format_trk_buf(trk, spt, slen, flp->trklen, data, flp_trk(flp, trk)->byte);
 		if (res) flpFillFields(flp, trk, 0);
 	}
 	return res;
@@ -232,36 +244,38 @@ void flpPrev(Floppy* flp, int fdcSide) {
 		} else {
 			flp->pos = flp->trklen - 1;
 		}
-		flp->field = flp->data[rtrk].field[flp->pos] & 0x0f;
+		flp->field = flp->data[rtrk] ? flp->data[rtrk]->field[flp->pos] & 0x0f : 0;
 	} else {
 		flp->field = 0;
 	}
 }
 
 void flpClearTrack(Floppy* flp,int tr) {
-	memset(flp->data[tr].byte, 0, TRKLEN_HD);
-	memset(flp->data[tr].field, 0, TRKLEN_HD);
+	tr &= 0xff;
+	free(flp->data[tr]);
+	flp->data[tr] = NULL;
 }
 
 void flpClearDisk(Floppy* flp) {
 	int i;
-	for (i = 0; i < 160; i++) flpClearTrack(flp,i);
+	for (i = 0; i < 256; i++) flpClearTrack(flp,i);
 }
 
 void flpFillFields(Floppy* flp,int tr, int flag) {
 	int i, bcnt = 0;
 	unsigned char fld = 0;
-	unsigned char* cpos = flp->data[tr].byte;
+	if ((tr > 255) || !flp->data[tr]) return;	// empty track has no fields
+	xTrack* trk = flp->data[tr];
+	unsigned char* cpos = trk->byte;
 	unsigned char* bpos = cpos;
 	unsigned short crc;
 	unsigned char scn = 0;		// sector number (1+)
 	unsigned char sct = 1;		// sector size code
-	if (tr > 255) return;
 	for (i = 0; i < 256; i++) {
-		flp->data[tr].map[i] = 0;
+		trk->map[i] = 0;
 	}
 	for (i = 0; i < flp->trklen; i++) {
-		flp->data[tr].field[i] = fld;
+		trk->field[i] = fld;
 		fld &= 0x0f;		// reset flags
 		if (flag & 1) {
 			if ((fld == 0) || (fld == 0x0f)) {
@@ -286,20 +300,20 @@ void flpFillFields(Floppy* flp,int tr, int flag) {
 				}
 			}
 		} else {					// TODO: find A1 here, then skip until !A1, this byte will be marker
-			if (flp->data[tr].byte[i] == 0xa1) {
+			if (trk->byte[i] == 0xa1) {
 				if (fld == 0) {
-					flp->data[tr].field[i] = 0x80;
+					trk->field[i] = 0x80;
 				}
 				fld = 0x0f;
 			} else {
 				if (fld == 0x0f) {
-					switch (flp->data[tr].byte[i] & 0xfe) {
+					switch (trk->byte[i] & 0xfe) {
 						case 0xfe:			// fe/ff : IDAM, head
 							cpos = bpos;
 							fld = 0x01;
 							bcnt = 4;
-							scn = flp->data[tr].byte[i+3];
-							sct = flp->data[tr].byte[i+4];
+							scn = trk->byte[i+3];
+							sct = trk->byte[i+4];
 							break;
 						// case 0xfc:			// fc/fd : IAM, index marker
 						//	break
@@ -308,7 +322,7 @@ void flpFillFields(Floppy* flp,int tr, int flag) {
 							fld = 0x02;
 							bcnt = (128 << (sct & 3));
 							if (scn > 0) {
-								flp->data[tr].map[scn] = i + 1;
+								trk->map[scn] = i + 1;
 								scn = 0;
 							}
 							break;
@@ -317,7 +331,7 @@ void flpFillFields(Floppy* flp,int tr, int flag) {
 							fld = 0x03;
 							bcnt = (128 << (sct & 3));
 							if (scn > 0) {
-								flp->data[tr].map[scn] = i + 1;
+								trk->map[scn] = i + 1;
 								scn = 0;
 							}
 							break;
@@ -354,15 +368,23 @@ void flp_eject(Floppy* flp) {
 }
 
 void flpGetTrack(Floppy* flp,int tr,unsigned char* dst) {
-	memcpy(dst,flp->data[tr].byte,flp->trklen);
+	if (flp->data[tr & 0xff]) {
+		memcpy(dst,flp->data[tr & 0xff]->byte,flp->trklen);
+	} else {
+		memset(dst,0x00,flp->trklen);
+	}
 }
 
 void flpGetTrackFields(Floppy* flp,int tr,unsigned char* dst) {
-	memcpy(dst,flp->data[tr].field,flp->trklen);
+	if (flp->data[tr & 0xff]) {
+		memcpy(dst,flp->data[tr & 0xff]->field,flp->trklen);
+	} else {
+		memset(dst,0x00,flp->trklen);
+	}
 }
 
 void flpPutTrack(Floppy* flp,int tr,unsigned char* src,int len) {
 	flpClearTrack(flp,tr);
-	memcpy(flp->data[tr].byte,src,len);
+	memcpy(flp_trk(flp, tr)->byte,src,len);
 	flpFillFields(flp,tr,0);
 }
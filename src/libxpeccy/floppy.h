@@ -33,6 +33,12 @@ typedef struct {
 
 typedef void(*cbflpirq)(int, void*);
 
+typedef struct {
+	unsigned char byte[TRKLEN_HD];
+	unsigned char field[TRKLEN_HD];
+	int map[256];		// position of sector n = 1+
+} xTrack;
+
 typedef struct {
 	unsigned trk80:1;	// fdd is 80T
 	unsigned doubleSide:1;	// fdd is DS
@@ -57,16 +63,13 @@ typedef struct {
 	int pos;
 	int trklen;		// 12500 HD, 6250 DD
 	char* path;
-	struct {
-		unsigned char byte[TRKLEN_HD];
-		unsigned char field[TRKLEN_HD];
-		int map[256];		// position of sector n = 1+
-	} data[256];
+	xTrack* data[256];	// NULL = track was never written (all zeros). use flp_trk to get it
 } Floppy;
 
 Floppy* flpCreate(int, cbflpirq, void*);
 void flpDestroy(Floppy*);
 
+xTrack* flp_trk(Floppy*, int);
 void flp_set_path(Floppy*, const char*);
 void flp_set_hd(Floppy*, int);
 void flp_sync(Floppy*, int);
@@ -262,6 +262,7 @@ void atm2_sync(Computer* comp, int ns) {
 	if (!comp->flgZ_I)
 		comp->vid->intFRAME = 0;
 	zx_sync(comp, ns);
+	comp->devDue = 0;		// INT is cut here, don't defer
 }
 
 extern keyScan keyTab[];
@@ -29,14 +29,22 @@ void dummyOut(Computer* comp, int port, int val) {
 
 // INT handle/check
 
-void zx_sync(Computer* comp, int ns) {
-	// devices
-	difSync(comp->dif, ns);
+#define ZX_DEV_DUE	64000	// ns. devices here are seen through ports and sound output only, so they can wait
+
+// sound sources (all zx_vol reads). can be synced ahead of others, see comp_snd_sync
+void zx_snd_sync(Computer* comp, int ns) {
 	gsSync(comp->gs, ns);
 	saaSync(comp->saa, ns);
 	tsSync(comp->ts, ns);
 	tapSync(comp->tape, ns);
 	bcSync(comp->beep, ns);
+}
+
+void zx_sync(Computer* comp, int ns) {
+	// devices
+	difSync(comp->dif, ns);
+	if (ns > comp->devSndNs)
+		zx_snd_sync(comp, ns - comp->devSndNs);
 	// nmi
 	if ((comp->cpu->regPC > 0x3fff) && comp->flgNMIRQ) {
 		comp->cpu->intrq |= Z80_NMI;	// request nmi
@@ -44,26 +52,37 @@ void zx_sync(Computer* comp, int ns) {
 		comp->flgROM = 1;
 		comp->hw->mapMem(comp);
 	}
+	if (!comp->flgNMIRQ) {
+		comp->devDue = ZX_DEV_DUE;
+		// playing tape: sync at next signal edge. recording: sync each time
+		if (comp->tape->on) {
+			int due = tapNextEdge(comp->tape);
+			if (due < comp->devDue)
+				comp->devDue = due;
+		}
+	}
 }
 
-extern int res4;
 
 void zx_cont_tick(Computer* comp, int adr) {
 	// sync video before this moment
-	vid_sync(comp->vid, (comp->cpu->t - res4) * comp->nsPerTick);
-	res4 = comp->cpu->t;
+	vid_sync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+	comp->vsyncT = comp->cpu->t;
 	int wns = vid_wait(comp->vid, adr);			// high memory addr
 	if (wns) {					// if there is contention zone, wait for it ends
 		comp->cpu->t += wns / comp->nsPerTick;	// add 'empty' ticks. in fact, there is no ticks at all, cpu stopped
-		vid_sync(comp->vid, (comp->cpu->t - res4) * comp->nsPerTick);
-		res4 = comp->cpu->t;
+		vid_sync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+		comp->vsyncT = comp->cpu->t;
 	}
 	// comp->cpu->t++;		// free tick
 }
 
 void zx_irq(Computer* comp, int t) {
+	int wt;
 	switch(t) {
 		case IRQ_VID_INT:			// frame int start
+			if (comp->mem->contmask != vid_cont_mask(comp->vid))	// contention pattern changed
+				mem_set_cont(comp->mem, vid_cont_mask(comp->vid));
 #if HAVEZLIB
 			if (!comp->rzx.play) {		// ignore when playing rzx
 				comp->vid->intFRAME = comp->vid->intsize;
@@ -90,24 +109,23 @@ void zx_irq(Computer* comp, int t) {
 			comp->cpu->intrq &= ~Z80_INT;
 			break;
 		case IRQ_CPU_SYNC:			// sync cpu-vid
-			// NOTE: video is already sync'ed in comp_irq
-//			vid_sync(comp->vid, (comp->cpu->t - res4) * comp->nsPerTick);
-//			res4 = comp->cpu->t;
+			// NOTE: video is sync'ed in comp_irq, unless catch-up rendering is on
 			// TODO: collect wait from devices
-			if (comp->flgCNTM) {
-				xAdr xa = mem_get_xadr(comp->mem, comp->cpu->adr);
-				if (xa.type == MEM_RAM) {
-					comp->cpu->flgWAIT = !!vid_wait(comp->vid, xa.abs);
+			comp->cpu->flgWAIT = 0;
+			if (comp->flgCNTM && mem_get_page(comp->mem, comp->cpu->adr)->cont) {
+				wt = vid_cont(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick, comp->nsPerTick);
+				if (wt < 0) {		// turbo: check wait every tick
+					vid_sync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+					comp->vsyncT = comp->cpu->t;
+					comp->cpu->flgWAIT = !!vid_wait(comp->vid, mem_get_phys_adr(comp->mem, comp->cpu->adr));
 				} else {
-					comp->cpu->flgWAIT = 0;
+					comp->cpu->t += wt;
 				}
-			} else {
-				comp->cpu->flgWAIT = 0;
 			}
 			break;
 		case IRQ_CPU_ACK:
-			vid_sync(comp->vid, (comp->cpu->t - res4) * comp->nsPerTick);
-			res4 = comp->cpu->t;
+			vid_sync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+			comp->vsyncT = comp->cpu->t;		// vid_sync draws collected dots before INT start/end, intFRAME is actual
 			comp->cpu->flgACK = !!comp->vid->intFRAME;
 			break;
 	}
@@ -122,6 +140,7 @@ void zx_init(Computer* comp) {
 //	comp->fps = 50;
 	dif_align_flps(comp->dif, comp->dif->fdc, 0, 1, 2, 3);
 	vid_upd_timings(comp->vid, comp->nsPerTick >> 1);
+	mem_set_cont(comp->mem, vid_cont_mask(comp->vid));
 	fdc_set_hd(comp->dif->fdc, 0);
 	chip_set_xdev(comp->ts->chipA, NULL, NULL, NULL);
 	kbd_set_type(comp->keyb, KBD_SPECTRUM);
@@ -597,13 +597,13 @@ int gbRamAdr(Computer* comp, int adr) {
 int gbRamRd(int adr, void* data) {
 	Computer* comp = (Computer*)data;
 	adr = gbRamAdr(comp, adr);
-	return comp->mem->ramData[adr];
+	return comp->mem->ramData[adr & comp->mem->ramMask];
 }
 
 void gbRamWr(int adr, int val, void* data) {
 	Computer* comp = (Computer*)data;
 	adr = gbRamAdr(comp, adr);
-	comp->mem->ramData[adr] = val & 0xff;
+	comp->mem->ramData[adr & comp->mem->ramMask] = val & 0xff;
 }
 
 int gbrRd(int adr, void* data) {
@@ -181,23 +181,21 @@ HardWare* findHardware(const char* name) {
 #endif
 // mem
 
-static MemPage* pg;
-extern int res4;
-static int wns;
-
-void zx_cont_mem(Computer* comp) {
+void zx_cont_mem(Computer* comp, int adr) {
+	MemPage* pg = mem_get_page(comp->mem, adr);
+	int wns;
 	if (pg->type == MEM_RAM) {
-		vid_sync(comp->vid, comp->nsPerTick * (comp->cpu->t - res4));	// before
-		res4 = comp->cpu->t;
+		vid_sync(comp->vid, comp->nsPerTick * (comp->cpu->t - comp->vsyncT));	// before
+		comp->vsyncT = comp->cpu->t;
 		wns = vid_wait(comp->vid, pg->num << 8);
 		comp->cpu->t += wns / comp->nsPerTick;
-		vid_sync(comp->vid, (comp->cpu->t - res4) * comp->nsPerTick);
-		res4 = comp->cpu->t;
+		vid_sync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+		comp->vsyncT = comp->cpu->t;
 	}
 }
 
 int stdMRd(Computer* comp, int adr, int m1) {
-	pg = mem_get_page(comp->mem, adr);	// = &comp->mem->map[(adr >> 8) & 0xff];
+	MemPage* pg = mem_get_page(comp->mem, adr);	// = &comp->mem->map[(adr >> 8) & 0xff];
 	if (m1 && (comp->dif->type == DIF_BDI)) {
 		if (comp->flgDOS && (pg->type == MEM_RAM)) {
 			comp->flgDOS = 0;
@@ -212,29 +210,113 @@ int stdMRd(Computer* comp, int adr, int m1) {
 }
 
 void stdMWr(Computer *comp, int adr, int val) {
-	pg = mem_get_page(comp->mem, adr);	// = &comp->mem->map[(adr >> 8) & 0xff];
 	memWr(comp->mem,adr,val);
 }
 
 // io
+// xPort table is scanned up to 1st entry with zero mask (default one, it catches all ports)
+// each table is compiled once per computer (on 1st in/out through it) and kept in comp->pdec slots:
+// nested dispatch (PentEvo: evo14PortMap default entry calls hwIn/hwOut with evoPortMap) uses two tables at once
+
+// add -1 terminated list to dec->lst (or find the same one), return offset
+static int hw_port_lst(struct xPortDec* dec, signed char* lst, int cnt) {
+	int pos = 0;
+	int len;
+	while (pos < dec->len) {
+		len = 0;
+		while (dec->lst[pos + len] >= 0) len++;
+		if ((len == cnt) && !memcmp(dec->lst + pos, lst, cnt)) return pos;
+		pos += len + 1;
+	}
+	if (dec->len + cnt + 1 > dec->size) {
+		dec->size = (dec->len + cnt + 1) * 2;
+		dec->lst = realloc(dec->lst, dec->size);
+	}
+	memcpy(dec->lst + pos, lst, cnt);
+	dec->lst[pos + cnt] = -1;
+	dec->len += cnt + 1;
+	assert(dec->len < 0x10000);
+	return pos;
+}
+
+static struct xPortDec* hw_port_compile(Computer* comp, xPort* ptab) {
+	struct xPortDec* dec;
+	signed char ilst[128];
+	signed char olst[128];
+	int icnt, ocnt;
+	int port;
+	int idx;
+	xPort* itm;
+	// free slot or the next one by turns (tables of previous hardware)
+	for (idx = 0; (idx < HW_PDEC_SLOTS) && comp->pdec[idx]; idx++);
+	if (idx >= HW_PDEC_SLOTS) {
+		idx = comp->pdecNext;
+		comp->pdecNext = (idx + 1) % HW_PDEC_SLOTS;
+	}
+	dec = comp->pdec[idx];
+	if (!dec) {
+		dec = (struct xPortDec*)malloc(sizeof(struct xPortDec));
+		memset(dec, 0x00, sizeof(struct xPortDec));
+		comp->pdec[idx] = dec;
+	}
+	dec->tab = ptab;
+	dec->len = 0;
+	for (port = 0; port < 0x10000; port++) {
+		icnt = 0;
+		ocnt = 0;
+		idx = 0;
+		do {
+			assert(idx < 128);
+			itm = &ptab[idx];
+			if ((port & itm->mask) == (itm->value & itm->mask)) {
+				if (itm->in) ilst[icnt++] = idx;
+				if (itm->out) olst[ocnt++] = idx;
+			}
+			idx++;
+		} while (itm->mask != 0);
+		dec->in[port] = hw_port_lst(dec, ilst, icnt);
+		dec->out[port] = hw_port_lst(dec, olst, ocnt);
+	}
+	return dec;
+}
+
+void hw_port_free(struct xPortDec* dec) {
+	if (!dec) return;
+	free(dec->lst);
+	free(dec);
+}
+
+static inline struct xPortDec* hw_port_dec(Computer* comp, xPort* ptab) {
+	int i;
+	for (i = 0; (i < HW_PDEC_SLOTS) && comp->pdec[i]; i++) {
+		if (comp->pdec[i]->tab == ptab)
+			return comp->pdec[i];
+	}
+	return hw_port_compile(comp, ptab);
+}
+
+static inline int hw_port_cond(Computer* comp, xPort* itm) {
+	return ((itm->dos & 2) || (itm->dos == comp->flgBDI)) &&\
+		((itm->rom & 2) || (itm->rom == comp->flgROM)) &&\
+		((itm->cpm & 2) || (itm->cpm == comp->flgCPM));
+}
 
 int hwIn(xPort* ptab, Computer* comp, int port) {
+	struct xPortDec* dec = hw_port_dec(comp, ptab);
 	int res = -1;
-	int idx = 0;
 	int catch = 0;
+	signed char* lst;
 	xPort* itm;
-	do {
-		itm = &ptab[idx];
-		if (((port & itm->mask) == (itm->value & itm->mask)) &&\
-				(itm->in != NULL) &&\
-				((itm->dos & 2) || (itm->dos == comp->flgBDI)) &&\
-				((itm->rom & 2) || (itm->rom == comp->flgROM)) &&\
-				((itm->cpm & 2) || (itm->cpm == comp->flgCPM))) {
+	lst = dec->lst + dec->in[port & 0xffff];
+	while (*lst >= 0) {
+		itm = &ptab[(int)*lst];
+		if (hw_port_cond(comp, itm)) {
 			res = itm->in(comp, port);
 			catch = !!itm->mask;
+			break;
 		}
-		idx++;
-	} while (!catch && (itm->mask != 0));
+		lst++;
+	}
 	if (!catch && (compflags & CFLG_PANIC)) {
 		comp_irq(IRQ_STOP, comp);
 	}
@@ -242,21 +324,19 @@ int hwIn(xPort* ptab, Computer* comp, int port) {
 }
 
 void hwOut(xPort* ptab, Computer* comp, int port, int val, int mult) {
-	int idx = 0;
+	struct xPortDec* dec = hw_port_dec(comp, ptab);
 	int catch = 0;
+	signed char* lst;
 	xPort* itm;
-	do {
-		itm = &ptab[idx];
-		if (((port & itm->mask) == (itm->value & itm->mask)) &&\
-				(itm->out != NULL) &&\
-				((itm->dos & 2) || (itm->dos == comp->flgBDI)) &&\
-				((itm->rom & 2) || (itm->rom == comp->flgROM)) &&\
-				((itm->cpm & 2) || (itm->cpm == comp->flgCPM))) {
+	lst = dec->lst + dec->out[port & 0xffff];
+	while ((*lst >= 0) && !catch) {
+		itm = &ptab[(int)*lst];
+		if (hw_port_cond(comp, itm)) {
 			itm->out(comp, port, val);
 			catch |= !mult;
 		}
-		idx++;
-	} while ((itm->mask != 0) && !catch);
+		lst++;
+	}
 	if (!catch && (compflags & CFLG_PANIC)) {
 		comp_irq(IRQ_STOP, comp);
 	}
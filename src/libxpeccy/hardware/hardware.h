@@ -79,6 +79,8 @@ typedef int(*cbHwAck)(Computer*);
 typedef void(*cbHwKey)(Computer*, keyEntry*);
 // get volume
 typedef sndPair(*cbHwVol)(Computer*, sndVolume*);
+// host ptr to memory cell for cpu TLB (adr, wr), NULL if cell must be accessed by mrd/mwr
+typedef unsigned char*(*cbHwMptr)(Computer*, int, int);
 
 typedef struct {
 	int port;
@@ -110,6 +112,7 @@ struct HardWare {
 	cbHwKey keyp;		// key press
 	cbHwKey keyr;		// key release
 	cbHwVol vol;		// read volume
+	cbHwMptr mptr;		// direct memory ptr (can be NULL)
 };
 typedef struct HardWare HardWare;
 
@@ -128,6 +131,17 @@ typedef struct {
 	int value;
 } xPortValue;
 
+// xPort table compiled to 64K dispatch: for each port, -1 terminated lists of entries catching it (by mask/value)
+// dos/rom/cpm conditions are checked at call, they can be changed by previous handler
+struct xPortDec {
+	xPort* tab;			// compiled table
+	unsigned short in[0x10000];	// offset in lst: entries with in handler
+	unsigned short out[0x10000];	// ...with out handler
+	signed char* lst;
+	int size;
+	int len;
+};
+
 typedef struct {
 	int id;
 	HardWare* core;
@@ -135,6 +149,7 @@ typedef struct {
 
 int hwIn(xPort* ptab, Computer* comp, int port);
 void hwOut(xPort* ptab, Computer* comp, int port, int val, int mult);
+void hw_port_free(struct xPortDec*);
 xPortValue* hwGetPorts(Computer*);
 
 // extern HardWare hwTab[];
@@ -175,6 +190,7 @@ void zx_reset(Computer*);
 void zx_keyp(Computer*, keyEntry*);
 void zx_keyr(Computer*, keyEntry*);
 void zx_sync(Computer*, int);
+void zx_snd_sync(Computer*, int);
 sndPair zx_vol(Computer*, sndVolume*);
 void zx_set_pal(Computer*);	// todo: called from zx_reset only
 
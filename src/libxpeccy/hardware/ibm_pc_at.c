@@ -75,6 +75,20 @@ void ibm_mwr(Computer* comp, int adr, int val) {
 		memWr(comp->mem, adr, val);
 }
 
+// ram and bios can be accessed directly, video and adapter bios - through callbacks
+unsigned char* ibm_mptr(Computer* comp, int adr, int wr) {
+	MemPage* pg;
+	if (!comp->flgA20G || !(comp->ps2c->outport & 2))
+		adr &= ~(1 << 20);
+	if (adr >= comp->mem->ramSize) return NULL;
+	pg = mem_get_page(comp->mem, adr);
+	if (pg->rd == ibm_ram_rd)
+		return comp->mem->ramData + adr;
+	if (!wr && (pg->rd == ibm_bios_rd))
+		return comp->mem->romData + (adr & comp->mem->romMask);
+	return NULL;
+}
+
 // in/out
 
 // 20 master pic command
@@ -171,6 +185,7 @@ void ibm_outKbd(Computer* comp, int adr, int val) {
 	switch(adr & 0x0f) {
 		case 0:
 			ps2c_wr(comp->ps2c, PS2_RDATA, val);
+			cpu_tlb_flush(comp->cpu);		// a20 can be switched by controller outport
 			break;
 		case 1:
 			comp->reg61 = val & 0xff;
@@ -182,6 +197,7 @@ void ibm_outKbd(Computer* comp, int adr, int val) {
 			break;
 		case 4:
 			ps2c_wr(comp->ps2c, PS2_RCMD, val);
+			cpu_tlb_flush(comp->cpu);
 			break;
 	}
 //	if (comp->debug) printf("%.4X:%.4X ps/2 out %.3X, %.2X\n",comp->cpu->cs.idx,comp->cpu->pc,adr,val);
@@ -311,6 +327,7 @@ void ibm_outPOS(Computer* comp, int adr, int val) {
 		case 2:				// port 92
 			// b1: a20 gate (0:on, 1:off)
 			comp->flgA20G = !!(val & 2);
+			cpu_tlb_flush(comp->cpu);
 			// printf("port 92: a20gate = %i\n", comp->flgA20G);
 			break;
 	}
@@ -676,4 +693,4 @@ sndPair ibm_vol(Computer* comp, sndVolume* vol) {
 static vLayout ibmLay = {{720,492},{0,0},{80,12},{640,480},{0,0},1};
 
 HardWare ibm_hw_core = {HW_IBM_PC,HWG_PC,"IBM PC","IBM PC",16,MEM_1M | MEM_2M | MEM_4M,1.0,&ibmLay,24,NULL,
-			ibm_init,ibm_mem_map,ibm_iowr,ibm_iord,ibm_mrd,ibm_mwr,ibm_irq,ibm_ack,ibm_reset,ibm_sync,ibm_keyp,ibm_keyr,ibm_vol};
+			ibm_init,ibm_mem_map,ibm_iowr,ibm_iord,ibm_mrd,ibm_mwr,ibm_irq,ibm_ack,ibm_reset,ibm_sync,ibm_keyp,ibm_keyr,ibm_vol,ibm_mptr};
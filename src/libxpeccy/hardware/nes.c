@@ -248,17 +248,16 @@ void nesSync(Computer* comp, int ns) {
 	comp->slot->irq = 0;
 }
 
-extern int res4;
 
 int nesMemRd(Computer* comp, int adr, int m1) {
-//	vidSync(comp->vid, (comp->cpu->t - res4) * comp->nsPerTick);
-//	res4 = comp->cpu->t;
+//	vidSync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+//	comp->vsyncT = comp->cpu->t;
 	return memRd(comp->mem, adr);
 }
 
 void nesMemWr(Computer* comp, int adr, int val) {
-//	vidSync(comp->vid, (comp->cpu->t - res4) * comp->nsPerTick);
-//	res4 = comp->cpu->t;
+//	vidSync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+//	comp->vsyncT = comp->cpu->t;
 	memWr(comp->mem, adr, val);
 }
 
@@ -1004,7 +1004,9 @@ void pc98xx_cpu_wr(Computer* comp, int adr, int val) {
 			// comp_brk(comp, -1);
 			break;
 		// 286+: off A20 mask
-		case 1: comp->flgA20 = 0; break;
+		case 1: comp->flgA20 = 0;
+			cpu_tlb_flush(comp->cpu);
+			break;
 		case 2: // pc9801DA only (DMA control)
 			break;
 		case 3: // 386+ A20 control
@@ -1035,6 +1037,7 @@ void pc98xx_nmi_wr(Computer* comp, int adr, int val) {
 void pc98xx_43d_wr(Computer* comp, int adr, int val) {
 	comp->flgRomIPL = !!(val & 2);
 	pc98xx_mem_map(comp);
+	cpu_tlb_flush(comp->cpu);
 }
 
 // deBUG
@@ -1122,6 +1125,17 @@ void pc98xx_mwr(Computer* comp, int adr, int val) {
 	memWr(comp->mem, adr, val);
 }
 
+unsigned char* pc98xx_mptr(Computer* comp, int adr, int wr) {
+	MemPage* pg;
+	if (comp->flgA20) adr &= ~(1 << 20);
+	pg = mem_get_page(comp->mem, adr);
+	if ((pg->rd == pc98xx_ram_rd) && (adr < comp->mem->ramSize))
+		return comp->mem->ramData + adr;
+	if (!wr && (pg->rd == pc98xx_bios_rd))
+		return comp->mem->romData + (mem_get_phys_adr(comp->mem, adr) & comp->mem->romMask);
+	return NULL;
+}
+
 // cpu: get int vector from pic
 int pc98xx_ack(Computer* comp) {
 	int t = pic_ack(comp->mpic);
@@ -1221,4 +1235,4 @@ void pc98xx_keyr(Computer* comp, keyEntry* kent) {
 static vLayout pc98xxLay = {{720,412},{0,0},{80,12},{640,400},{0,0},1};		// check
 
 HardWare p98_hw_core = {HW_PC9801,HWG_PC98XX,"PC-9801","NEC PC9801 (in progress)",16,MEM_1M,1.0,&pc98xxLay,20,NULL,
-			pc98xx_init,pc98xx_mem_map,pc98xx_iowr,pc98xx_iord,pc98xx_mrd,pc98xx_mwr,pc98xx_irq,pc98xx_ack,pc98xx_reset,pc98xx_sync,pc98xx_keyp,pc98xx_keyr,pc98xx_vol};
+			pc98xx_init,pc98xx_mem_map,pc98xx_iowr,pc98xx_iord,pc98xx_mrd,pc98xx_mwr,pc98xx_irq,pc98xx_ack,pc98xx_reset,pc98xx_sync,pc98xx_keyp,pc98xx_keyr,pc98xx_vol,pc98xx_mptr};
@@ -354,6 +354,8 @@ void tsOut27AF(Computer* comp, int port, int val) {
 	int cnt, cnt2;
 	int tmp;
 	unsigned char* ptr = NULL;
+	unsigned char* ram = comp->mem->ramData;	// addresses are wrapped by ram size
+	int msk = comp->mem->ramMask;
 	int sadr = (comp->dmaSrc.ih << 14) | (comp->dmaSrc.w & 0x3ffe); // (comp->dma.src.x << 14) | ((comp->dma.src.h & 0x3f) << 8) | (comp->dma.src.l & 0xfe);
 	int dadr = (comp->dmaDst.ih << 14) | (comp->dmaDst.w & 0x3ffe); // (comp->dma.dst.x << 14) | ((comp->dma.dst.h & 0x3f) << 8) | (comp->dma.dst.l & 0xfe);
 	int lcnt = (comp->dmaLen + 1) << 1;
@@ -363,7 +365,7 @@ void tsOut27AF(Computer* comp, int port, int val) {
 //			printf("dma ram-ram %X:%X->%X:%X, %Xx%X words, ctrl %.2X\n", comp->dmaSrc.ih, comp->dmaSrc.w, comp->dmaDst.ih, comp->dmaDst.w, comp->dmaCnt+1, comp->dmaLen+1, val);
 			for (cnt = 0; cnt <= comp->dmaCnt; cnt++) {
 				for (cnt2 = 0; cnt2 < lcnt; cnt2++) {
-					comp->mem->ramData[dadr + cnt2] = comp->mem->ramData[sadr + cnt2];
+					ram[(dadr + cnt2) & msk] = ram[(sadr + cnt2) & msk];
 				}
 				sadr += (val & 0x20) ? ((val & 0x08) ? 0x200 : 0x100) : lcnt;		// SALGN
 				dadr += (val & 0x10) ? ((val & 0x08) ? 0x200 : 0x100) : lcnt;		// DALGN
@@ -373,17 +375,17 @@ void tsOut27AF(Computer* comp, int port, int val) {
 //			printf("dma blt %X:%X->%X:%X, %Xx%X words, ctrl %.2X\n", comp->dmaSrc.ih, comp->dmaSrc.w, comp->dmaDst.ih, comp->dmaDst.w, comp->dmaCnt+1, comp->dmaLen+1, val);
 			for (cnt = 0; cnt <= comp->dmaCnt; cnt++) {
 				for (cnt2 = 0; cnt2 < lcnt; cnt2++) {
-					tmp = comp->mem->ramData[sadr + cnt2];
+					tmp = ram[(sadr + cnt2) & msk];
 					if (val & 0x08) {
-						if (tmp != 0) comp->mem->ramData[dadr + cnt2] = tmp & 0xff;
+						if (tmp != 0) ram[(dadr + cnt2) & msk] = tmp & 0xff;
 					} else {
 						if (tmp & 0xf0) {
-							comp->mem->ramData[dadr + cnt2] &= 0x0f;
-							comp->mem->ramData[dadr + cnt2] |= (tmp & 0xf0);
+							ram[(dadr + cnt2) & msk] &= 0x0f;
+							ram[(dadr + cnt2) & msk] |= (tmp & 0xf0);
 						}
 						if (tmp & 0x0f) {
-							comp->mem->ramData[dadr + cnt2] &= 0xf0;
-							comp->mem->ramData[dadr + cnt2] |= (tmp & 0x0f);
+							ram[(dadr + cnt2) & msk] &= 0xf0;
+							ram[(dadr + cnt2) & msk] |= (tmp & 0x0f);
 						}
 					}
 					// comp->mem->ramData[dadr + cnt2] = comp->mem->ramData[sadr + cnt2];
@@ -396,7 +398,7 @@ void tsOut27AF(Computer* comp, int port, int val) {
 //			printf("spi->ram\t%.2X:%.4X,%.2X:%.3X\n",comp->dma.dst.x,dadr & 0x3fff,comp->dma.num,lcnt);
 			for (cnt = 0; cnt <= comp->dmaCnt; cnt++) {
 				for (cnt2 = 0; cnt2 < lcnt; cnt2++) {
-					comp->mem->ramData[dadr + cnt2] = sdcRead(comp->sdc) & 0xff;
+					ram[(dadr + cnt2) & msk] = sdcRead(comp->sdc) & 0xff;
 				}
 				dadr += (val & 0x10) ? ((val & 0x08) ? 0x200 : 0x100) : lcnt;
 			}
@@ -404,7 +406,7 @@ void tsOut27AF(Computer* comp, int port, int val) {
 		case 0x82:		// RAM->SPI
 			for (cnt = 0; cnt <= comp->dmaCnt; cnt++) {
 				for (cnt2 = 0; cnt2 < lcnt; cnt2++) {
-					sdcWrite(comp->sdc, comp->mem->ramData[sadr + cnt2]);
+					sdcWrite(comp->sdc, ram[(sadr + cnt2) & msk]);
 				}
 				sadr += (val & 0x20) ? ((val & 0x08) ? 0x200 : 0x100) : lcnt;
 			}
@@ -413,7 +415,7 @@ void tsOut27AF(Computer* comp, int port, int val) {
 			for (cnt = 0; cnt <= comp->dmaCnt; cnt++) {
 				for (cnt2 = 0; cnt2 < lcnt; cnt2++) {
 					if (!ideIn(comp->ide, 0x00, &tmp, 1)) tmp = 0xff;
-					comp->mem->ramData[dadr + cnt2] = tmp & 0xff;
+					ram[(dadr + cnt2) & msk] = tmp & 0xff;
 				}
 				dadr += (val & 0x10) ? ((val & 0x08) ? 0x200 : 0x100) : lcnt;
 			}
@@ -421,7 +423,7 @@ void tsOut27AF(Computer* comp, int port, int val) {
 		case 0x83:		// RAM->IDE
 			for (cnt = 0; cnt <= comp->dmaCnt; cnt++) {
 				for (cnt2 = 0; cnt2 < lcnt; cnt2++) {
-					ideOut(comp->ide, 0x00, comp->mem->ramData[sadr + cnt2], 1);
+					ideOut(comp->ide, 0x00, ram[(sadr + cnt2) & msk], 1);
 				}
 				sadr += (val & 0x20) ? ((val & 0x08) ? 0x200 : 0x100) : lcnt;
 			}
@@ -429,7 +431,7 @@ void tsOut27AF(Computer* comp, int port, int val) {
 		case 0x04:		// FILL->RAM
 			for (cnt = 0; cnt <= comp->dmaCnt; cnt++) {
 				for (cnt2 = 0; cnt2 < lcnt; cnt2++) {
-					comp->mem->ramData[dadr + cnt2] = comp->mem->ramData[sadr + (cnt2 & 1)];
+					ram[(dadr + cnt2) & msk] = ram[(sadr + (cnt2 & 1)) & msk];
 				}
 				dadr += (val & 0x10) ? ((val & 0x08) ? 0x200 : 0x100) : lcnt;		// DALGN
 			}
@@ -438,7 +440,7 @@ void tsOut27AF(Computer* comp, int port, int val) {
 		case 0x85:		// RAM->SFILE
 			ptr = (val & 1) ? comp->vid->tsconf.sfile : comp->vid->tsconf.cram;
 			for (cnt2 = 0; cnt2 < lcnt; cnt2++) {
-				*(ptr + ((dadr + cnt2) & 0x1ff)) = comp->mem->ramData[sadr + cnt2];
+				*(ptr + ((dadr + cnt2) & 0x1ff)) = ram[(sadr + cnt2) & msk];
 			}
 			if (~val & 1) tslUpdatePal(comp);
 			break;
@@ -122,16 +122,15 @@ void ataSetLBA(ATADev* dev) {
 }
 
 void ataReadSector(ATADev* dev) {
-	long nps;
+	long long nps;
 	ataSetLBA(dev);
 	if (dev->lba >= dev->maxlba) {					// sector not found
 		dev->reg.state |= HDF_ERR;
 		dev->reg.err |= (HDF_ABRT | HDF_IDNF);
 	} else {
 		if (dev->file) {
-			nps = dev->lba * dev->pass.bps + dev->offset;
-			fseek(dev->file,nps,SEEK_SET);			// if filesize < nps, there will be 0xFF in buf
-			fread((char*)dev->buf.data,dev->pass.bps,1,dev->file);
+			nps = (long long)dev->lba * dev->pass.bps + dev->offset;
+			dimg_read(dev->file, nps, dev->buf.data, dev->pass.bps);	// if filesize < nps, there will be 0xFF in buf
 		} else {
 			ataClearBuf(dev);
 		}
@@ -145,9 +144,8 @@ void ataWriteSector(ATADev* dev) {
 		dev->reg.err |= (HDF_ABRT | HDF_IDNF);
 	} else {
 		if (dev->file) {
-			long pos = dev->lba * dev->pass.bps + dev->offset;
-			fseek(dev->file, pos, SEEK_SET);
-			fwrite((char*)dev->buf.data, dev->pass.bps, 1, dev->file);
+			long long pos = (long long)dev->lba * dev->pass.bps + dev->offset;
+			dimg_write(dev->file, pos, dev->buf.data, dev->pass.bps);
 		}
 	}
 }
@@ -504,27 +502,28 @@ void ideDestroy(IDE* ide) {
 // TODO: check extension
 
 void ata_load_raw(ATADev* dev) {
-	fseek(dev->file, 0, SEEK_END);
-	long fsz = ftell(dev->file);
-	long rsz = 16*63*512;			// 1 cylinder size (16 heads, 63 sectors, 512 bytes/sec)
+	long long fsz = dev->file->size;
+	long long rsz = 16*63*512;			// 1 cylinder size (16 heads, 63 sectors, 512 bytes/sec)
 	dev->maxlba = (fsz / rsz) + ((fsz % rsz) ? rsz : 0);		// in 512byte units
 	dev->pass.hds = 16;
 	dev->pass.spt = 63;
 	dev->pass.cyls = (dev->maxlba / 16 / 63);
-	rewind(dev->file);
 	dev->offset = 0;
 }
 
+static int hdi_int(unsigned char* ptr) {
+	return ptr[0] | (ptr[1] << 8) | (ptr[2] << 16) | (ptr[3] << 24);
+}
+
 void ata_load_hdi(ATADev* dev) {
-	fseek(dev->file, 8, SEEK_SET);
-	dev->offset = fgeti(dev->file);		// header size = data offset
-	fgeti(dev->file);			// data size
-	dev->pass.bps = fgeti(dev->file);	// sector size
-	dev->pass.spt = fgeti(dev->file);	// sectors/track
-	dev->pass.hds = fgeti(dev->file);	// heads
-	dev->pass.cyls = fgeti(dev->file);	// cylinders
+	unsigned char hd[32];
+	dimg_read(dev->file, 0, hd, 32);
+	dev->offset = hdi_int(hd + 8);		// header size = data offset. +12 is data size
+	dev->pass.bps = hdi_int(hd + 16);	// sector size
+	dev->pass.spt = hdi_int(hd + 20);	// sectors/track
+	dev->pass.hds = hdi_int(hd + 24);	// heads
+	dev->pass.cyls = hdi_int(hd + 28);	// cylinders
 	dev->maxlba = dev->pass.spt * dev->pass.hds * dev->pass.cyls;
-	fseek(dev->file, dev->offset, SEEK_SET);
 }
 
 typedef struct {
@@ -544,7 +543,7 @@ void ideSetImage(IDE *ide, int wut, const char *name) {
 	else if (wut == IDE_SLAVE)
 		dev = ide->slave;
 	if (dev == NULL) return;
-	if (dev->file) fclose(dev->file);
+	dimg_close(dev->file);
 	if (strlen(name) == 0) {
 		free(dev->image);
 		dev->image = NULL;
@@ -552,7 +551,7 @@ void ideSetImage(IDE *ide, int wut, const char *name) {
 	} else {
 		dev->image = realloc(dev->image,strlen(name) + 1);
 		strcpy(dev->image,name);
-		dev->file = fopen(dev->image,"rb+");
+		dev->file = dimg_open(dev->image, dev->cow ? DIMG_COW : DIMG_RW);
 		if (dev->file) {
 			const char* ptr = strrchr(dev->image, '.');
 			if (ptr) {
@@ -1235,13 +1234,13 @@ void ide_set_type(IDE* ide, int id) {
 }
 
 void ideOpenFiles(IDE* ide) {
-	if (ide->master->image) ide->master->file = fopen(ide->master->image,"rb+");		// NULL when file doesn't exist
-	if (ide->slave->image) ide->slave->file = fopen(ide->slave->image,"rb+");
+	if (ide->master->image) ide->master->file = dimg_open(ide->master->image, ide->master->cow ? DIMG_COW : DIMG_RW);	// NULL when file doesn't exist
+	if (ide->slave->image) ide->slave->file = dimg_open(ide->slave->image, ide->slave->cow ? DIMG_COW : DIMG_RW);
 }
 
 void ideCloseFiles(IDE* ide) {
-	if (ide->master->file) fclose(ide->master->file);
+	dimg_close(ide->master->file);
 	ide->master->file = NULL;
-	if (ide->slave->file) fclose(ide->slave->file);
+	dimg_close(ide->slave->file);
 	ide->slave->file = NULL;
 }
@@ -10,6 +10,7 @@ extern "C" {
 #include "defines.h"
 #include "nvram.h"
 #include "cmos.h"
+#include "diskimg.h"
 
 // IDE interface type
 enum {
@@ -112,7 +113,8 @@ typedef struct {
 	int maxlba;
 
 	char* image;
-	FILE* file;
+	xDiskImage* file;
+	int cow;		// open image in copy-on-write mode (file is not changed)
 	int offset;		// for future: data offset inside image (0 by default)
 
 	struct {
@@ -198,6 +198,10 @@ pchCore pit_mode_tab[8] = {
 	{NULL, pch_tm_m3, pch_gt_m3},		// m7 = m3
 };
 
+// channel cores by id for state (see state.c)
+void* pit_state_ptrs[] = {&pit_mode_tab[0], &pit_mode_tab[1], &pit_mode_tab[2], &pit_mode_tab[3],
+			&pit_mode_tab[4], &pit_mode_tab[5], &pit_mode_tab[6], &pit_mode_tab[7], NULL};
+
 void pch_set_mod(pitChan* ch, int mod) {
 	ch->opmod = mod & 7;
 	ch->cb = &pit_mode_tab[ch->opmod];
@@ -52,3 +52,5 @@ int pit_rd(PIT*, int);
 void pit_wr(PIT*, int, int);
 void pit_gate(PIT*, int, int);
 void pit_sync(PIT*, int);
+
+extern void* pit_state_ptrs[];
@@ -4,6 +4,14 @@
 #include <string.h>
 #include <stdio.h>
 
+#if defined(__linux) || defined(__APPLE__) || defined(__BSD)
+	#define MEM_POSIX 1
+	#include <unistd.h>
+	#include <sys/mman.h>
+#endif
+
+static void mem_rom_free(Memory*);
+
 Memory* memCreate() {
 	Memory* mem = (Memory*)malloc(sizeof(Memory));
 	memset(mem, 0x00, sizeof(Memory));
@@ -18,6 +26,9 @@ Memory* memCreate() {
 }
 
 void memDestroy(Memory* mem) {
+	free(mem->ramData);
+	mem_rom_free(mem);
+	free(mem->snapath);
 	free(mem);
 }
 
@@ -41,6 +52,38 @@ int toLimits(int src, int min, int max) {
 	return src;
 }
 
+int memStdRd(int, void*);
+void memStdWr(int, int, void*);
+
+// update direct pointers for cpu page idx
+static void mem_upd_ptr(Memory* mem, int idx) {
+	MemPage* pg = &mem->map[idx];
+	int hook = mem->adrHook[idx];
+	switch (pg->type) {
+		case MEM_RAM: hook |= mem->ramHook[pg->num & (mem->ramMask >> 8)]; break;
+		case MEM_ROM: hook |= mem->romHook[pg->num & (mem->romMask >> 8)]; break;
+	}
+	if (mem->pgshift != 8) hook = MEM_HOOK_RD | MEM_HOOK_WR | MEM_HOOK_BRK;	// 256-byte pages only
+	mem->hook[idx] = hook & 0xff;
+	mem->rptr[idx] = (!(hook & MEM_HOOK_RD) && (pg->rd == memStdRd)) ? pg->data : NULL;
+	mem->wptr[idx] = (!(hook & MEM_HOOK_WR) && (pg->wr == memStdWr)) ? pg->data : NULL;
+}
+
+// set hook flags for 256-byte page of RAM/ROM (type MEM_RAM/MEM_ROM) or cpu address space (type 0)
+void mem_set_hook(Memory* mem, int type, int page, int flag) {
+	int i;
+	unsigned char* ptr;
+	switch (type) {
+		case MEM_RAM: ptr = &mem->ramHook[page & ((MEM_4M >> 8) - 1)]; break;
+		case MEM_ROM: ptr = &mem->romHook[page & ((MEM_512K >> 8) - 1)]; break;
+		default: ptr = &mem->adrHook[page & 0xff]; break;
+	}
+	if (*ptr == flag) return;
+	*ptr = flag & 0xff;
+	for (i = 0; i < 256; i++)
+		mem_upd_ptr(mem, i);
+}
+
 void mem_set_bus(Memory* mem, int bw) {
 	bw = toLimits(bw, 8, 24);
 	mem->busmask = (1 << bw) - 1;		// FFFF for 16, FFFFF for 20, FFFFFF for 24...
@@ -52,8 +95,68 @@ void mem_set_bus(Memory* mem, int bw) {
 		mem->pgshift++;
 		sz >>= 1;
 	}
+	for (sz = 0; sz < 256; sz++)
+		mem_upd_ptr(mem, sz);
+}
+
+// resize buffer, new bytes are filled with <fill>
+// pages pointing inside old buffer are moved to the same offset (wrapped by new size) inside new one
+static unsigned char* mem_realloc(Memory* mem, unsigned char* ptr, int* cur, int sz, int fill) {
+	unsigned char* pd;
+	int off[256];
+	int i;
+	if (sz == *cur) return ptr;
+	for (i = 0; i < 256; i++) {
+		pd = (unsigned char*)mem->map[i].data;
+		off[i] = -1;
+		if (ptr && (pd >= ptr) && (pd < ptr + *cur))
+			off[i] = (pd - ptr) & (sz - 1);
+	}
+	ptr = realloc(ptr, sz);
+	if (sz > *cur)
+		memset(ptr + *cur, fill, sz - *cur);
+	for (i = 0; i < 256; i++) {
+		if (off[i] < 0) continue;
+		mem->map[i].data = ptr + off[i];
+		mem_upd_ptr(mem, i);
+	}
+	*cur = sz;
+	return ptr;
+}
+
+// rom buffer
+
+static void mem_rom_free(Memory* mem) {
+	if (mem->romMap) {
+#if MEM_POSIX
+		munmap(mem->romData, mem->romAlloc);
+#endif
+	} else {
+		free(mem->romData);
+	}
+	mem->romData = NULL;
+	mem->romMap = 0;
+}
+
+// set new rom buffer (len = 2^n), pages pointing inside old one are moved to the same offset (wrapped by new size)
+static void mem_rom_replace(Memory* mem, unsigned char* ptr, int len, int map) {
+	unsigned char* pd;
+	int i;
+	for (i = 0; i < 256; i++) {
+		pd = (unsigned char*)mem->map[i].data;
+		if (mem->romData && (pd >= mem->romData) && (pd < mem->romData + mem->romAlloc)) {
+			mem->map[i].data = ptr + ((pd - mem->romData) & (len - 1));
+			mem_upd_ptr(mem, i);
+		}
+	}
+	mem_rom_free(mem);
+	mem->romData = ptr;
+	mem->romAlloc = len;
+	mem->romMap = map;
 }
 
+// ram buffer is at least 128K: zx48 maps its 48K as pages 5,2,0 of 128K (ramMask = 128K-1)
+// rom buffer is at least 16K: some machines read boot rom by fixed 16K mask
 void memSetSize(Memory* mem, int ramSz, int romSz) {
 //	printf("setMemSize %i %i\n",ramSz,romSz);
 	if (ramSz > 0) {
@@ -61,15 +164,81 @@ void memSetSize(Memory* mem, int ramSz, int romSz) {
 		ramSz = getNearPower(ramSz);
 		mem->ramSize = ramSz;
 		mem->ramMask = ramSz - 1;
+		mem->ramData = mem_realloc(mem, mem->ramData, &mem->ramAlloc, (ramSz < MEM_128K) ? MEM_128K : ramSz, 0x00);
 	}
 	if (romSz > 0) {
 		romSz = toLimits(romSz, MEM_256, MEM_512K);
 		romSz = getNearPower(romSz);
 		mem->romSize = romSz;
 		mem->romMask = romSz - 1;
+		if (mem->romMap && (mem->romAlloc != ((romSz < MEM_16K) ? MEM_16K : romSz))) {	// mapping can't be resized: take own copy
+			unsigned char* ptr = malloc(mem->romAlloc);
+			memcpy(ptr, mem->romData, mem->romAlloc);
+			mem_rom_replace(mem, ptr, mem->romAlloc, 0);
+		}
+		mem->romData = mem_realloc(mem, mem->romData, &mem->romAlloc, (romSz < MEM_16K) ? MEM_16K : romSz, 0xff);
 	}
 }
 
+// shared rom image
+
+xRomImage* rom_image_create(unsigned char* data, int size) {
+	xRomImage* img = (xRomImage*)malloc(sizeof(xRomImage));
+	int len = toLimits(size, MEM_256, MEM_512K);
+	img->size = getNearPower(len);
+	img->len = (img->size < MEM_16K) ? MEM_16K : img->size;
+	img->data = malloc(img->len);
+	memset(img->data, 0xff, img->len);
+	memcpy(img->data, data, (size < len) ? size : len);
+	img->file = NULL;
+#if MEM_POSIX
+	img->file = tmpfile();
+	if (img->file && ((fwrite(img->data, img->len, 1, img->file) != 1) || fflush(img->file))) {
+		fclose(img->file);
+		img->file = NULL;
+	}
+	if (img->file) {		// data is in file now
+		free(img->data);
+		img->data = NULL;
+	}
+#endif
+	return img;
+}
+
+// machines with mapped image keep their mappings
+void rom_image_destroy(xRomImage* img) {
+	if (img->file)
+		fclose(img->file);
+	free(img->data);
+	free(img);
+}
+
+// set rom size and content from image
+void mem_set_rom(Memory* mem, xRomImage* img) {
+	int map = 0;
+#if MEM_POSIX
+	void* ptr = MAP_FAILED;
+	if (img->file)
+		ptr = mmap(NULL, img->len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(img->file), 0);
+	if (ptr != MAP_FAILED) {
+		mem_rom_replace(mem, ptr, img->len, 1);
+		map = 1;
+	}
+#endif
+	if (!map) {
+		memSetSize(mem, -1, img->size);
+		if (img->data) {
+			memcpy(mem->romData, img->data, img->len);
+#if MEM_POSIX
+		} else if (pread(fileno(img->file), mem->romData, img->len, 0) != img->len) {
+			memset(mem->romData, 0xff, img->len);
+#endif
+		}
+	}
+	mem->romSize = img->size;
+	mem->romMask = img->size - 1;
+}
+
 int memRd(Memory* mem, int adr) {
 	int res = -1;
 	MemPage* ptr = &mem->map[(adr >> mem->pgshift) & 0xff];
@@ -106,6 +275,7 @@ void memSetBank(Memory* mem, int page, int type, int bank, int siz, extmrd rd, e
 	MemPage pg;
 	pg.type = type;
 	pg.num = bank;
+	pg.cont = 0;
 	if (type == MEM_RAM) {
 		pg.rd = rd ? rd : (data ? NULL : memStdRd);	// (rd || data) ?
 		pg.wr = wr ? wr : (data ? NULL : memStdWr);
@@ -128,7 +298,10 @@ void memSetBank(Memory* mem, int page, int type, int bank, int siz, extmrd rd, e
 		} else {
 			pg.data = NULL;
 		}
+		if (type == MEM_RAM)
+			pg.cont = ((pg.num << mem->pgshift) & mem->contmask) ? 1 : 0;
 		mem->map[page] = pg;
+		mem_upd_ptr(mem, page);
 		page++;
 		pg.num++;
 		cnt--;
@@ -139,6 +312,17 @@ MemPage* mem_get_page(Memory* mem, int adr) {
 	return &mem->map[(adr >> mem->pgshift) & 0xff];
 }
 
+// set contended RAM pages mask and update current map
+void mem_set_cont(Memory* mem, int mask) {
+	int i;
+	MemPage* pg;
+	mem->contmask = mask;
+	for (i = 0; i < 256; i++) {
+		pg = &mem->map[i];
+		pg->cont = ((pg->type == MEM_RAM) && ((pg->num << mem->pgshift) & mask)) ? 1 : 0;
+	}
+}
+
 // set page data
 void memPutData(Memory* mem, int type, int page, int sz, char* src) {
 	if (type == MEM_RAM) {
@@ -4,6 +4,8 @@
 extern "C" {
 #endif
 
+#include <stdio.h>
+
 #include "defines.h"
 
 // mempage type
@@ -15,6 +17,11 @@ enum {
 	MEM_IO
 };
 
+// page hooks: access must go through callbacks (breakpoints, watchers)
+#define MEM_HOOK_RD	1
+#define MEM_HOOK_WR	2
+#define MEM_HOOK_BRK	4	// page has armed breakpoints (checked by computer)
+
 typedef struct {
     int type;
     int bank;
@@ -31,6 +38,7 @@ typedef struct {
 	void* data;			// ptr for rd/wr func
 	extmrd rd;			// external rd
 	extmwr wr;			// external wr
+	int cont;			// contended page (zx)
 } MemPage;
 
 typedef struct {
@@ -41,8 +49,17 @@ typedef struct {
 
 typedef struct {
 	MemPage map[256];			// 256 x 256 | 256 x 64K
-	unsigned char ramData[MEM_4M];		// 4M
-	unsigned char romData[MEM_512K];	// 512K
+	unsigned char* rptr[256];		// direct pointers to page data for reading, NULL if page needs callbacks
+	unsigned char* wptr[256];		// same for writing
+	unsigned char ramHook[MEM_4M >> 8];	// MEM_HOOK_* for each 256-byte page of RAM
+	unsigned char romHook[MEM_512K >> 8];	// ...ROM
+	unsigned char adrHook[256];		// ...cpu address space
+	unsigned char hook[256];		// all hooks for each cpu page (adrHook | ramHook/romHook)
+	unsigned char* ramData;			// allocated by memSetSize
+	unsigned char* romData;			// allocated by memSetSize or mapped by mem_set_rom
+	int ramAlloc;				// ramData/romData allocated size (>= ramMask+1, romMask+1)
+	int romAlloc;
+	int romMap;				// 1 if romData is private mapping of xRomImage file
 	int ramSize;
 	int ramMask;
 	int romSize;
@@ -51,9 +68,22 @@ typedef struct {
 	int pgmask;	// number of LSBits in address = page offset (FF or FFFF)
 	int pgshift;	// = log2(page size), 8 for 256-pages, 16 for 64K-pages
 	int busmask;	// cpu addr bus mask (todo: move to CPU)
+	int contmask;	// RAM page is contended if (abs.addr & contmask) != 0
 	char* snapath;
 } Memory;
 
+// rom image shared by many machines (same romset): it's kept in unlinked temp file,
+// every machine maps it copy-on-write, so unchanged pages are not duplicated. if mapping isn't possible, data is copied
+typedef struct {
+	int size;		// rom size (2^n)
+	int len;		// data size (>= size, >= 16K)
+	unsigned char* data;	// only if there is no file
+	FILE* file;
+} xRomImage;
+
+xRomImage* rom_image_create(unsigned char*, int);
+void rom_image_destroy(xRomImage*);
+
 Memory* memCreate(void);
 void memDestroy(Memory*);
 
@@ -61,6 +91,7 @@ int memRd(Memory*, int);
 void memWr(Memory*, int, int);
 
 void memSetSize(Memory*, int, int);
+void mem_set_rom(Memory*, xRomImage*);
 void memSetBank(Memory* mem, int page, int type, int bank, int siz, extmrd rd, extmwr wr, void* data);
 
 void memPutData(Memory*,int,int,int,char*);
@@ -72,6 +103,8 @@ void mem_set_path(Memory*, const char*);
 void mem_set_bus(Memory*, int);
 int mem_get_phys_adr(Memory*, int);
 MemPage* mem_get_page(Memory*, int);
+void mem_set_cont(Memory*, int);
+void mem_set_hook(Memory*, int, int, int);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,318 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "rewind.h"
+
+// record: regions [state][RAM][GS RAM], each region = len, mode, data
+// RW_RAW: len bytes
+// RW_DELTA: blocks count, then blocks (offset + RW_BLK bytes, last one can be shorter) differ from keyframe
+
+enum {
+	RW_RAW = 0,
+	RW_DELTA
+};
+
+#define RW_KEYINT	50
+
+xRewind* rw_create(int budget, int step) {
+	xRewind* rw = (xRewind*)malloc(sizeof(xRewind));
+	memset(rw, 0x00, sizeof(xRewind));
+	rw->budget = budget;
+	rw->step = (step < 1) ? 1 : step;
+	rw->keyint = RW_KEYINT;
+	return rw;
+}
+
+void rw_destroy(xRewind* rw) {
+	rw_clear(rw);
+	comp_state_free(&rw->buf);
+	comp_state_free(&rw->st);
+	free(rw);
+}
+
+static xRwRecord* rw_rec(xRewind* rw, int pos) {
+	return &rw->rec[(rw->head + pos) % RW_MAXREC];
+}
+
+static void rw_free_rec(xRewind* rw, xRwRecord* rec) {
+	rw->used -= rec->len;
+	free(rec->data);
+	rec->data = NULL;
+	rec->len = 0;
+}
+
+void rw_clear(xRewind* rw) {
+	while (rw->num > 0) {
+		rw->num--;
+		rw_free_rec(rw, rw_rec(rw, rw->num));
+	}
+	rw->head = 0;
+	rw->used = 0;
+	rw->fcnt = 0;
+	rw->kcnt = 0;
+	rw->comp = NULL;
+}
+
+// drop oldest keyframe and its deltas
+static void rw_drop_group(xRewind* rw) {
+	xRwRecord* rec;
+	do {
+		rw_free_rec(rw, rw_rec(rw, 0));
+		rw->head = (rw->head + 1) % RW_MAXREC;
+		rw->num--;
+		rec = rw_rec(rw, 0);
+	} while ((rw->num > 0) && (rec->key != rw->head));
+}
+
+// writing
+
+static void rw_put(xStateBuf* buf, const void* src, int len) {
+	if (len < 1) return;
+	if (buf->len + len > buf->size) {
+		buf->size = (buf->len + len) * 2;
+		buf->data = realloc(buf->data, buf->size);
+	}
+	memcpy(buf->data + buf->len, src, len);
+	buf->len += len;
+}
+
+// ref = same region of keyframe (NULL for keyframe)
+static void rw_put_region(xStateBuf* buf, unsigned char* ptr, int len, unsigned char* ref, int rlen) {
+	int mode = (ref && (rlen == len)) ? RW_DELTA : RW_RAW;
+	int pos;
+	int cnt = 0;
+	int off;
+	int sz;
+	rw_put(buf, &len, sizeof(int));
+	rw_put(buf, &mode, sizeof(int));
+	if (mode == RW_RAW) {
+		rw_put(buf, ptr, len);
+	} else {
+		pos = buf->len;
+		rw_put(buf, &cnt, sizeof(int));
+		for (off = 0; off < len; off += RW_BLK) {
+			sz = (len - off < RW_BLK) ? len - off : RW_BLK;
+			if (!memcmp(ptr + off, ref + off, sz)) continue;
+			rw_put(buf, &off, sizeof(int));
+			rw_put(buf, ptr + off, sz);
+			cnt++;
+		}
+		memcpy(buf->data + pos, &cnt, sizeof(int));
+	}
+}
+
+// reading
+
+// return ptr to region data (len, mode are filled), NULL if there is no such region
+static unsigned char* rw_region(xRwRecord* rec, int idx, int* len, int* mode) {
+	unsigned char* ptr = rec->data;
+	unsigned char* end = rec->data + rec->len;
+	int cnt;
+	int sz;
+	while (ptr + 2 * sizeof(int) <= end) {
+		memcpy(len, ptr, sizeof(int));
+		memcpy(mode, ptr + sizeof(int), sizeof(int));
+		ptr += 2 * sizeof(int);
+		if (idx == 0) return ptr;
+		if (*mode == RW_RAW) {
+			ptr += *len;
+		} else {
+			memcpy(&cnt, ptr, sizeof(int));
+			ptr += sizeof(int);
+			while (cnt > 0) {
+				memcpy(&sz, ptr, sizeof(int));	// offset
+				sz = (*len - sz < RW_BLK) ? *len - sz : RW_BLK;
+				ptr += sizeof(int) + sz;
+				cnt--;
+			}
+		}
+		idx--;
+	}
+	return NULL;
+}
+
+// dst = keyframe region data, apply delta blocks over it
+static void rw_apply(unsigned char* dst, unsigned char* ptr, int len) {
+	int cnt;
+	int off;
+	int sz;
+	memcpy(&cnt, ptr, sizeof(int));
+	ptr += sizeof(int);
+	while (cnt > 0) {
+		memcpy(&off, ptr, sizeof(int));
+		ptr += sizeof(int);
+		sz = (len - off < RW_BLK) ? len - off : RW_BLK;
+		memcpy(dst + off, ptr, sz);
+		ptr += sz;
+		cnt--;
+	}
+}
+
+// memories are regions 1,2...
+static int rw_memlist(Computer* comp, Memory** lst) {
+	int cnt = 0;
+	lst[cnt++] = comp->mem;
+	if (comp->gs->enable)
+		lst[cnt++] = comp->gs->mem;
+	return cnt;
+}
+
+// save current state as new record
+int rw_record(xRewind* rw, Computer* comp) {
+	Memory* mem[2];
+	int mcnt = rw_memlist(comp, mem);
+	xRwRecord* key = NULL;
+	xRwRecord* rec;
+	unsigned char* ref;
+	int rlen = 0;
+	int mode;
+	int slot;
+	int i;
+	if (rw->comp != comp) {
+		rw_clear(rw);
+		rw->comp = comp;
+	}
+	if ((rw->num > 0) && (rw->kcnt < rw->keyint))
+		key = &rw->rec[rw_rec(rw, rw->num - 1)->key];
+	comp_state_save(comp, &rw->st, XST_NORAM);
+	rw->buf.len = 0;
+	ref = key ? rw_region(key, 0, &rlen, &mode) : NULL;
+	rw_put_region(&rw->buf, rw->st.data, rw->st.len, ref, rlen);
+	for (i = 0; i < mcnt; i++) {
+		ref = key ? rw_region(key, i + 1, &rlen, &mode) : NULL;
+		rw_put_region(&rw->buf, mem[i]->ramData, mem[i]->ramMask + 1, ref, rlen);
+	}
+	// free space: drop old groups, but not the one new record belongs to
+	while ((rw->num > 0) && ((rw->used + rw->buf.len > rw->budget) || (rw->num >= RW_MAXREC))) {
+		if (key && (rw_rec(rw, 0) == key)) break;
+		rw_drop_group(rw);
+	}
+	if (rw->num >= RW_MAXREC) return 0;	// one group takes whole ring
+	slot = (rw->head + rw->num) % RW_MAXREC;
+	rec = &rw->rec[slot];
+	rec->key = key ? (int)(key - rw->rec) : slot;
+	rec->ticks = comp->tickCount;
+	rec->len = rw->buf.len;
+	rec->data = malloc(rec->len);
+	memcpy(rec->data, rw->buf.data, rec->len);
+	rw->used += rec->len;
+	rw->num++;
+	rw->kcnt = key ? rw->kcnt + 1 : 1;
+	return 1;
+}
+
+// call at end of each frame
+void rw_frame(xRewind* rw, Computer* comp) {
+	rw->fcnt++;
+	if (rw->fcnt < rw->step) return;
+	rw->fcnt = 0;
+	rw_record(rw, comp);
+}
+
+// restore n-th record back from current position (1 = last one, or previous if nothing was executed since last one)
+// newer records are dropped. return 1 if state restored
+int rw_back(xRewind* rw, Computer* comp, int n) {
+	Memory* mem[2];
+	int mcnt = rw_memlist(comp, mem);
+	xRwRecord* rec;
+	xRwRecord* key;
+	unsigned char* ptr;
+	unsigned char* kptr;
+	int pos;
+	int len = 0;
+	int klen = 0;
+	int mode = RW_RAW;
+	int kmode;
+	int i;
+	if ((rw->comp != comp) || (rw->num < 1) || (n < 1)) return 0;
+	pos = rw->num - n;
+	if (rw_rec(rw, rw->num - 1)->ticks == comp->tickCount) pos--;
+	if (pos < 0) pos = 0;
+	rec = rw_rec(rw, pos);
+	key = &rw->rec[rec->key];
+	// all regions must be there (delta ones in keyframe too), memory regions must fit
+	for (i = 0; i <= mcnt; i++) {
+		ptr = rw_region(rec, i, &len, &mode);
+		kptr = (ptr && (mode == RW_DELTA)) ? rw_region(key, i, &klen, &kmode) : ptr;
+		if (!ptr || !kptr || (i && (len != mem[i - 1]->ramMask + 1))) {
+			rw_clear(rw);
+			return 0;
+		}
+	}
+	// state
+	ptr = rw_region(rec, 0, &len, &mode);
+	if (mode == RW_DELTA) {
+		kptr = rw_region(key, 0, &klen, &kmode);
+		rw->st.len = 0;
+		rw_put(&rw->st, kptr, klen);
+		rw_apply(rw->st.data, ptr, len);
+		ptr = rw->st.data;
+	}
+	if (!comp_state_load(comp, ptr, len)) {
+		rw_clear(rw);
+		return 0;
+	}
+	// memory
+	for (i = 0; i < mcnt; i++) {
+		ptr = rw_region(rec, i + 1, &len, &mode);
+		if (mode == RW_DELTA) {
+			kptr = rw_region(key, i + 1, &klen, &kmode);
+			memcpy(mem[i]->ramData, kptr, len);
+			rw_apply(mem[i]->ramData, ptr, len);
+		} else {
+			memcpy(mem[i]->ramData, ptr, len);
+		}
+	}
+	// drop newer records
+	while (rw->num > pos + 1) {
+		rw->num--;
+		rw_free_rec(rw, rw_rec(rw, rw->num));
+	}
+	rw->kcnt = (rec - rw->rec - rec->key + RW_MAXREC) % RW_MAXREC + 1;
+	rw->fcnt = 0;
+	return 1;
+}
+
+// rw_back with picture: state doesn't hold video output, so one record more is restored and replayed up to
+// the wanted one (then it's recorded again). return 1 if state restored
+int rw_back_show(xRewind* rw, Computer* comp, int n) {
+	int dbg = comp->flgDBG;
+	int now;
+	if (!rw_back(rw, comp, n)) return 0;
+	now = comp->tickCount;
+	if (rw_back(rw, comp, 1) && (comp->tickCount != now)) {
+		comp->flgDBG = 1;		// no breakpoints while replaying
+		while ((int)((unsigned)now - (unsigned)comp->tickCount) > 0)
+			compExec(comp);
+		rw_record(rw, comp);
+		comp->flgDBG = dbg;
+		comp->flgBRK = 0;
+	}
+	comp->flgFRM = 0;
+	return 1;
+}
+
+// step back 1 cpu instruction (compExec call): restore previous record, count instructions up to current point
+// then restore it again and execute one instruction less. return 1 if done
+int rw_step_back(xRewind* rw, Computer* comp) {
+	int now = comp->tickCount;
+	int dbg = comp->flgDBG;
+	int cnt = 0;
+	if (!rw_back(rw, comp, 1)) return 0;
+	comp->flgDBG = 1;		// no breakpoints while replaying
+	while ((int)((unsigned)now - (unsigned)comp->tickCount) > 0) {
+		compExec(comp);
+		cnt++;
+	}
+	if (cnt > 0) {
+		rw_back(rw, comp, 1);
+		while (cnt > 1) {
+			compExec(comp);
+			cnt--;
+		}
+	}
+	comp->flgDBG = dbg;
+	comp->flgBRK = 0;
+	comp->flgFRM = 0;
+	return 1;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "spectrum.h"
+#include "state.h"
+
+// rewind ring: machine state every N frames in fixed memory budget
+// keyframe = state + whole RAM, other records = state + RAM blocks changed since keyframe
+// (found by comparing with keyframe RAM: RAM is written by cpu, dma, loaders... bypassing memWr)
+
+#define RW_MAXREC	4096
+#define RW_BLK		256	// delta block size
+
+typedef struct {
+	int key;		// index of keyframe record for this one (itself for keyframe)
+	int ticks;		// comp->tickCount at record
+	int len;
+	unsigned char* data;
+} xRwRecord;
+
+typedef struct {
+	Computer* comp;		// machine records belongs to
+	int budget;		// max bytes for all records
+	int used;
+	int step;		// record every N frames
+	int keyint;		// keyframe every N records
+	int fcnt;		// frames since last record
+	int kcnt;		// records since last keyframe
+	int head;		// oldest record
+	int num;		// records count
+	xRwRecord rec[RW_MAXREC];
+	xStateBuf st;		// state without RAM
+	xStateBuf buf;		// record being built
+} xRewind;
+
+xRewind* rw_create(int budget, int step);
+void rw_destroy(xRewind*);
+void rw_clear(xRewind*);
+void rw_frame(xRewind*, Computer*);
+int rw_record(xRewind*, Computer*);
+int rw_back(xRewind*, Computer*, int);
+int rw_back_show(xRewind*, Computer*, int);
+int rw_step_back(xRewind*, Computer*);
+
+#ifdef __cplusplus
+}
+#endif
@@ -62,7 +62,6 @@ void sdcSetImage(SDCard* sdc, const char* name) {
 	if (strlen(name) == 0) {
 		if (sdc->image) free(sdc->image);
 		sdc->image = NULL;
-		sdc->file = NULL;
 	} else {
 		sdc->image = realloc(sdc->image,strlen(name) + 1);
 		strcpy(sdc->image,name);
@@ -84,8 +83,7 @@ void sdcSetCapacity(SDCard* sdc, int cpc) {
 void sdcRdSector(SDCard* sdc) {
 //	printf("SDC read sector %i\n",sdc->addr);
 	if ((sdc->addr < sdc->maxlba) && sdc->file) {
-		fseek(sdc->file,sdc->addr << 9,SEEK_SET);
-		fread(sdc->buf.data + 1, 512, 1, sdc->file);
+		dimg_read(sdc->file, (long long)sdc->addr << 9, sdc->buf.data + 1, 512);
 	} else {
 		memset((void*)&sdc->buf.data[1],0xff,512);
 	}
@@ -94,8 +92,7 @@ void sdcRdSector(SDCard* sdc) {
 void sdcWrSector(SDCard* sdc) {
 //	printf("SDC write sector %i\n",sdc->addr);
 	if ((sdc->addr < sdc->maxlba) && sdc->file) {
-		fseek(sdc->file,sdc->addr << 9,SEEK_SET);
-		fwrite(sdc->buf.data + 1,512,1,sdc->file);
+		dimg_write(sdc->file, (long long)sdc->addr << 9, sdc->buf.data + 1, 512);
 	}
 }
 
@@ -294,11 +291,10 @@ void sdcWrite(SDCard* sdc, int val) {
 void sdcOpenFile(SDCard* sdc) {
 	sdcCloseFile(sdc);
 	if (sdc->image) {
-		sdc->file = fopen(sdc->image,"rb+");
+		sdc->file = dimg_open(sdc->image, sdc->cow ? DIMG_COW : DIMG_RW);
 		if (sdc->file) {
-			fseek(sdc->file, 0, SEEK_END);
-			int sz = ftell(sdc->file);
-			int sz2 = 256;
+			long long sz = sdc->file->size;
+			long long sz2 = 256;
 			while (sz2 < sz)
 				sz2 <<= 1;
 			sdc->capacity = sz2 >> 20;	// MegaBytes
@@ -308,7 +304,6 @@ void sdcOpenFile(SDCard* sdc) {
 }
 
 void sdcCloseFile(SDCard* sdc) {
-	if (sdc->file)
-		fclose(sdc->file);
+	dimg_close(sdc->file);
 	sdc->file = NULL;
 }
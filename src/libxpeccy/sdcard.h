@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdio.h>
+#include "diskimg.h"
 
 /*
 // mode
@@ -61,7 +62,8 @@ typedef struct {
 	int capacity;
 	unsigned int maxlba;
 	char* image;		// image file name
-	FILE* file;		// image file
+	xDiskImage* file;	// image file
+	int cow;		// open image in copy-on-write mode (file is not changed)
 	struct {		// data buffer
 		int pos;
 		unsigned char data[515];	// data packet: token(1),data(512),crc(2)
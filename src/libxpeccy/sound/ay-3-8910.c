@@ -11,6 +11,7 @@ static int ayDACvol[32] = {0x0000,0x0000,0x00D0,0x00D0,0x0130,0x0130,0x01BC,0x01
                     0x2417,0x2417,0x2D54,0x2D54,0x35E8,0x35E8,0x3FFF,0x3FFF};
 
 void ay_reset(aymChip* chip) {
+	ay_render(chip);
 	memset(chip->reg, 0x00, 256);
 	aymResetChan(&chip->chanA);
 	aymResetChan(&chip->chanB);
@@ -52,6 +53,7 @@ int ay_rd(aymChip* ay, int adr) {
 
 void ay_set_reg(aymChip* chip, int val) {
 	int tone;
+	ay_render(chip);		// passed ticks are played with old registers
 	if ((chip->curReg != 14) && (chip->curReg != 15))
 		chip->reg[chip->curReg] = val & 0xff;
 	switch (chip->curReg) {
@@ -133,56 +135,154 @@ void ay_wr(aymChip* chip, int adr, int val) {
 	}
 }
 
+static void ay_noise_step(aymChip* ay) {
+	ay->chanN.step = (ay->chanN.step << 1) | ((((ay->chanN.step >> 13) ^ (ay->chanN.step >> 16)) & 1) ^ 1);
+	ay->chanN.lev = (ay->chanN.step >> 16) & 1;
+}
+
+static void ay_env_step(aymChip* ay) {
+	ay->chanE.vol += ay->chanE.step;
+	if (ay->chanE.vol & ~31) {				// 32 || -1
+		if (ay->eForm & 8) {				// 1xxx
+			if (ay->eForm & 1) {			// 1xx1 : 9,B,D,F : stop
+				ay->chanE.vol -= ay->chanE.step;
+				ay->chanE.step = 0;
+				if (ay->eForm & 2) {		// 1x11 : B,F : invert volume
+					ay->chanE.vol ^= 0x1f;
+				}
+			} else if (ay->eForm & 2) {		// 1x10 : A,E : change direction (wave)
+				ay->chanE.step = -ay->chanE.step;
+				ay->chanE.vol += ay->chanE.step;
+			} else {				// 1x00 : 8,C : repeat (saw)
+				ay->chanE.vol &= 0x1f;
+			}
+		} else {					// 0xxx : silent, stop
+			ay->chanE.vol = 0;
+			ay->chanE.step = 0;
+		}
+	}
+}
+
+// add n ticks to counter, return 1 if it's expired (and restarted)
+static inline int ay_cnt_add(aymChan* ch, int n) {
+	ch->cnt += n;
+	if (ch->cnt < ch->per) return 0;
+	ch->cnt = 0;
+	return 1;
+}
+
+// ticks until counter expires
+static inline int ay_cnt_left(aymChan* ch) {
+	return (ch->cnt + 1 >= ch->per) ? 1 : ch->per - ch->cnt;
+}
+
+// 1 tick (used by ym2203)
 void ay_tick(aymChip* ay) {
-	if (++ay->chanA.cnt >= ay->chanA.per) {
-		ay->chanA.cnt = 0;
-		ay->chanA.lev ^= 1;
+	if (ay_cnt_add(&ay->chanA, 1)) ay->chanA.lev ^= 1;
+	if (ay_cnt_add(&ay->chanB, 1)) ay->chanB.lev ^= 1;
+	if (ay_cnt_add(&ay->chanC, 1)) ay->chanC.lev ^= 1;
+	if (ay_cnt_add(&ay->chanN, 1)) ay_noise_step(ay);
+	if (ay_cnt_add(&ay->chanE, 1)) ay_env_step(ay);
+}
+
+extern int ym_chan_vol(aymChip*, aymChan*);
+int ay_chan_vol(aymChip*, aymChan*);
+
+static void ay_acc(aymChip* ay, int n) {
+	int (*lev)(aymChip*, aymChan*) = (ay->type == SND_AY) ? ay_chan_vol : ym_chan_vol;
+	if (n < 1) return;
+	ay->accA += lev(ay, &ay->chanA) * n;
+	ay->accB += lev(ay, &ay->chanB) * n;
+	ay->accC += lev(ay, &ay->chanC) * n;
+	ay->accn += n;
+}
+
+// add n ticks to counter, return number of expirations
+static int ay_cnt_skip(aymChan* ch, int n) {
+	int k = 0;
+	if (ch->cnt >= ch->per) {	// period was decreased: expires at next tick
+		ch->cnt = 0;
+		n--;
+		k++;
 	}
-	if (++ay->chanB.cnt >= ay->chanB.per) {
-		ay->chanB.cnt = 0;
-		ay->chanB.lev ^= 1;
+	ch->cnt += n;
+	k += ch->cnt / ch->per;
+	ch->cnt %= ch->per;
+	return k;
+}
+
+// counters which can change channels output (mask: 1,2,4 = tones A,B,C; 8 = noise; 16 = envelope)
+// tone is not used with period < 0x60 (see ay_chan_vol), silent channel (volume 0, no envelope) doesn't use anything
+static int ay_used_cnt(aymChip* ay) {
+	aymChan* ch[3] = {&ay->chanA, &ay->chanB, &ay->chanC};
+	int res = 0;
+	int i;
+	for (i = 0; i < 3; i++) {
+		if (ch[i]->een) res |= 16;
+		if (!ch[i]->een && (ch[i]->vol < 2)) continue;
+		if (!ch[i]->tdis && (ch[i]->per >= 0x60)) res |= (1 << i);
+		if (!ch[i]->ndis) res |= 8;
 	}
-	if (++ay->chanC.cnt >= ay->chanC.per) {
-		ay->chanC.cnt = 0;
-		ay->chanC.lev ^= 1;
+	return res;
+}
+
+// play pending ticks. unused counters are moved at once, for others:
+// jump from one counter expiration to next one, summing channels output between them
+void ay_render(aymChip* ay) {
+	int n = ay->pend;
+	int use = ay_used_cnt(ay);
+	int seg;
+	int t;
+	if (n < 1) return;
+	ay->pend = 0;
+	if (!(use & 1) && (ay_cnt_skip(&ay->chanA, n) & 1)) ay->chanA.lev ^= 1;
+	if (!(use & 2) && (ay_cnt_skip(&ay->chanB, n) & 1)) ay->chanB.lev ^= 1;
+	if (!(use & 4) && (ay_cnt_skip(&ay->chanC, n) & 1)) ay->chanC.lev ^= 1;
+	if (!(use & 8)) {
+		t = ay_cnt_skip(&ay->chanN, n);
+		while (t-- > 0)
+			ay_noise_step(ay);
 	}
-	if (++ay->chanN.cnt >= ay->chanN.per) {
-		ay->chanN.cnt = 0;
-		ay->chanN.step = (ay->chanN.step << 1) | ((((ay->chanN.step >> 13) ^ (ay->chanN.step >> 16)) & 1) ^ 1);
-		ay->chanN.lev = (ay->chanN.step >> 16) & 1;
+	if (!(use & 16)) {
+		t = ay_cnt_skip(&ay->chanE, n);
+		while ((t-- > 0) && ay->chanE.step)		// stopped envelope doesn't change
+			ay_env_step(ay);
 	}
-	if (++ay->chanE.cnt >= ay->chanE.per) {
-		ay->chanE.cnt = 0;
-		ay->chanE.vol += ay->chanE.step;
-		if (ay->chanE.vol & ~31) {				// 32 || -1
-			if (ay->eForm & 8) {				// 1xxx
-				if (ay->eForm & 1) {			// 1xx1 : 9,B,D,F : stop
-					ay->chanE.vol -= ay->chanE.step;
-					ay->chanE.step = 0;
-					if (ay->eForm & 2) {		// 1x11 : B,F : invert volume
-						ay->chanE.vol ^= 0x1f;
-					}
-				} else if (ay->eForm & 2) {		// 1x10 : A,E : change direction (wave)
-					ay->chanE.step = -ay->chanE.step;
-					ay->chanE.vol += ay->chanE.step;
-				} else {				// 1x00 : 8,C : repeat (saw)
-					ay->chanE.vol &= 0x1f;
-				}
-			} else {					// 0xxx : silent, stop
-				ay->chanE.vol = 0;
-				ay->chanE.step = 0;
-			}
-		}
+	while (n > 0) {
+		seg = n;
+		if (use & 1) {t = ay_cnt_left(&ay->chanA); if (t < seg) seg = t;}
+		if (use & 2) {t = ay_cnt_left(&ay->chanB); if (t < seg) seg = t;}
+		if (use & 4) {t = ay_cnt_left(&ay->chanC); if (t < seg) seg = t;}
+		if (use & 8) {t = ay_cnt_left(&ay->chanN); if (t < seg) seg = t;}
+		if (use & 16) {t = ay_cnt_left(&ay->chanE); if (t < seg) seg = t;}
+		ay_acc(ay, seg - 1);		// nothing changes here
+		if ((use & 1) && ay_cnt_add(&ay->chanA, seg)) ay->chanA.lev ^= 1;
+		if ((use & 2) && ay_cnt_add(&ay->chanB, seg)) ay->chanB.lev ^= 1;
+		if ((use & 4) && ay_cnt_add(&ay->chanC, seg)) ay->chanC.lev ^= 1;
+		if ((use & 8) && ay_cnt_add(&ay->chanN, seg)) ay_noise_step(ay);
+		if ((use & 16) && ay_cnt_add(&ay->chanE, seg)) ay_env_step(ay);
+		ay_acc(ay, 1);
+		n -= seg;
+	}
+	if (ay->accn > 0x10000) {		// nobody reads output: keep average, avoid overflow
+		ay->accA >>= 1;
+		ay->accB >>= 1;
+		ay->accC >>= 1;
+		ay->accn >>= 1;
 	}
 }
 
+// ticks are counted here and rendered on register write, output reading or when there are many of them
 void ay_sync(aymChip* ay, int ns) {
+	int n;
 	if (ay->per < 1) return;
 	ay->cnt -= ns;
-	while (ay->cnt < 0) {
-		ay->cnt += ay->per;
-		ay_tick(ay);
-	}
+	if (ay->cnt >= 0) return;
+	n = (ay->per - 1 - ay->cnt) / ay->per;
+	ay->cnt += n * ay->per;
+	ay->pend += n;
+	if (ay->pend > 0x1000)
+		ay_render(ay);
 }
 
 sndPair ay_mix_stereo(int volA, int volB, int volC, int id) {
@@ -264,9 +364,26 @@ int ay_chan_vol(aymChip* ay, aymChan* ch) {
 	return vol;
 }
 
+// channels output averaged since previous call (or current one if no ticks passed)
+void ay_out(aymChip* chip, int* vol, int (*lev)(aymChip*, aymChan*)) {
+	ay_render(chip);
+	if (chip->accn > 0) {
+		vol[0] = chip->accA / chip->accn;
+		vol[1] = chip->accB / chip->accn;
+		vol[2] = chip->accC / chip->accn;
+	} else {
+		vol[0] = lev(chip, &chip->chanA);
+		vol[1] = lev(chip, &chip->chanB);
+		vol[2] = lev(chip, &chip->chanC);
+	}
+	chip->accA = 0;
+	chip->accB = 0;
+	chip->accC = 0;
+	chip->accn = 0;
+}
+
 sndPair ay_vol(aymChip* chip) {
-	int volA = ay_chan_vol(chip, &chip->chanA);
-	int volB = ay_chan_vol(chip, &chip->chanB);
-	int volC = ay_chan_vol(chip, &chip->chanC);
-	return ay_mix_stereo(volA, volB, volC, chip->stereo);
+	int vol[3];
+	ay_out(chip, vol, ay_chan_vol);
+	return ay_mix_stereo(vol[0], vol[1], vol[2], chip->stereo);
 }
@@ -40,6 +40,7 @@ void ay_reset(aymChip*);
 int ay_rd(aymChip*, int);
 void ay_wr(aymChip*, int, int);
 void ay_sync(aymChip*, int);
+void ay_render(aymChip*);
 sndPair ay_vol(aymChip*);
 
 // yamaha-2149
@@ -172,6 +173,11 @@ struct aymChip {
 	int eForm;		// envelope form
 	int per;		// period ns len
 	int cnt;		// ns countdown
+	int pend;		// ticks passed, but not rendered yet (see ay_render)
+	int accA;		// channels output summed over rendered ticks (box filter for ay_vol)
+	int accB;
+	int accC;
+	int accn;		// ticks in acc*
 
 	int pscnt;	// pre-scaler: (2,3,6) of master ticks
 	int fmcnt;	// fm: 12 pre-scaled ticks
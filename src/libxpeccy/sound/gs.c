@@ -1,12 +1,45 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "gs.h"
 #include "../cpu/Z80/z80.h"
 
 #define GS_FLUSH 1
 
+// threaded mode: gs cpu runs on worker up to host time (target).
+// zx->gs port writes are queued with host time and applied when worker reaches it.
+// reads (and anything else touching gs from host) wait until worker is idle at host time (gs_wait)
+#define GS_QSIZE	256		// write queue size
+#define GS_STEP		16000		// ns: host publishes its time with this step
+#define GS_WAKE		256000		// ns: ...and wakes sleeping worker if it's behind more than this
+#define GS_MAXLAG	1000000		// ns: host waits if worker is behind more than this
+
+typedef struct {
+	long long time;
+	int adr;
+	int val;
+} gsEvent;
+
+struct gsThread {
+	pthread_t id;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	long long now;			// host time (host only)
+	long long target;		// published host time
+	long long clock;		// worker time
+	int sleep;			// worker waits for target
+	int wait;			// host waits for worker
+	int exit;
+	unsigned head;			// queue: worker reads head, host writes tail
+	unsigned tail;
+	gsEvent queue[GS_QSIZE];
+};
+
+#define LOAD(_v) __atomic_load_n(&(_v), __ATOMIC_SEQ_CST)
+#define STORE(_v, _n) __atomic_store_n(&(_v), (_n), __ATOMIC_SEQ_CST)
+
 // internal MEMRQ
 int gsmemrd(int adr, int m1, void* ptr) {
 	GSound* gs = (GSound*)ptr;
@@ -33,6 +66,19 @@ void gsmemwr(int adr, int val, void* ptr) {
 	memWr(gs->mem, adr & 0xffff, val & 0xff);
 }
 
+// map 8000..FFFF according to rp0
+void gsMapMem(GSound* gs) {
+	int val = gs->rp0 & 0x1f;
+	if (val == 0) {
+		memSetBank(gs->mem, 0x80, MEM_ROM, 0, MEM_16K, NULL, NULL, NULL);
+		memSetBank(gs->mem, 0xc0, MEM_ROM, 1, MEM_16K, NULL, NULL, NULL);
+	} else {
+		val--;
+		memSetBank(gs->mem, 0x80, MEM_RAM, val << 1, MEM_16K, NULL, NULL, NULL);
+		memSetBank(gs->mem, 0xc0, MEM_RAM, (val << 1) + 1, MEM_16K, NULL, NULL, NULL);
+	}
+}
+
 // internal IORQ
 int gsiord(int port,void* ptr) {
 	GSound* gs = (GSound*)ptr;
@@ -60,15 +106,7 @@ void gsiowr(int port, int val, void* ptr) {
 	port &= 0x0f;
 	switch (port) {
 		case 0: gs->rp0 = val & 0xff;
-			val &= 0x1f;
-			if (val == 0) {
-				memSetBank(gs->mem, 0x80, MEM_ROM, 0, MEM_16K, NULL, NULL, NULL);
-				memSetBank(gs->mem, 0xc0, MEM_ROM, 1, MEM_16K, NULL, NULL, NULL);
-			} else {
-				val--;
-				memSetBank(gs->mem, 0x80, MEM_RAM, val << 1, MEM_16K, NULL, NULL, NULL);
-				memSetBank(gs->mem, 0xc0, MEM_RAM, (val << 1) + 1, MEM_16K, NULL, NULL, NULL);
-			}
+			gsMapMem(gs);
 			break;
 		case 1: break;
 		case 2: gs->pstate &= 0x7f;
@@ -131,6 +169,7 @@ GSound* gsCreate() {
 }
 
 void gsDestroy(GSound* gs) {
+	gs_thread(gs, 0);
 	cpuDestroy(gs->cpu);
 	memDestroy(gs->mem);
 	free(gs);
@@ -138,27 +177,157 @@ void gsDestroy(GSound* gs) {
 
 void gsReset(GSound* gs) {
 	if (!gs->reset) return;
+	gs_wait(gs);
 	cpu_reset(gs->cpu);
 }
 
+// exec 1 gs cpu command, return ns
+static int gs_exec(GSound* gs) {
+	int res = cpu_exec(gs->cpu);
+	gs->cnt += res;
+	if (gs->cnt > 320) {	// 12MHz CLK, 37.5KHz INT -> int in each 320 ticks
+		gs->cnt -= 320;
+		gs->cpu->intrq |= Z80_INT;
+	}
+	return res * gs->ns_per_tick;
+}
+
+static void gs_port_wr(GSound* gs, int adr, int data) {
+	if (adr & 8) {
+		gs->pbb_zx = data & 0xff;
+		gs->pstate |= 1;
+	} else {
+		gs->pb3_zx = data & 0xff;
+		gs->pstate |= 0x80;		// set b7,state
+	}
+}
+
+// worker
+
+static void gs_thr_wake(struct gsThread* thr, int* flag) {
+	if (!LOAD(*flag)) return;
+	pthread_mutex_lock(&thr->lock);
+	pthread_cond_broadcast(&thr->cond);
+	pthread_mutex_unlock(&thr->lock);
+}
+
+static void* gs_thr_loop(void* ptr) {
+	GSound* gs = (GSound*)ptr;
+	struct gsThread* thr = gs->thr;
+	long long clk = LOAD(thr->clock);
+	long long tgt;
+	gsEvent* ev;
+	unsigned head;
+	while (!LOAD(thr->exit)) {
+		tgt = LOAD(thr->target);
+		head = LOAD(thr->head);
+		ev = (head != LOAD(thr->tail)) ? &thr->queue[head % GS_QSIZE] : NULL;
+		if (ev && (ev->time <= clk)) {
+			gs_port_wr(gs, ev->adr, ev->val);
+			STORE(thr->head, head + 1);
+		} else if (clk < tgt) {
+			if (ev && (ev->time < tgt)) tgt = ev->time;
+			while (clk < tgt)
+				clk += gs_exec(gs);
+		} else {
+			pthread_mutex_lock(&thr->lock);
+			STORE(thr->sleep, 1);
+			if (thr->wait)
+				pthread_cond_broadcast(&thr->cond);
+			while (!LOAD(thr->exit) && (LOAD(thr->target) <= clk) && (LOAD(thr->head) == LOAD(thr->tail)))
+				pthread_cond_wait(&thr->cond, &thr->lock);
+			STORE(thr->sleep, 0);
+			pthread_mutex_unlock(&thr->lock);
+			continue;
+		}
+		STORE(thr->clock, clk);
+		gs_thr_wake(thr, &thr->wait);
+	}
+	return NULL;
+}
+
+// host
+
+static void gs_thr_publish(struct gsThread* thr) {
+	STORE(thr->target, thr->now);
+	if (thr->now - LOAD(thr->clock) >= GS_WAKE)
+		gs_thr_wake(thr, &thr->sleep);
+}
+
+// wait until worker is behind host time not more than <lag> ns. lag = 0: worker is idle, queue is empty
+static void gs_thr_wait(struct gsThread* thr, long long lag) {
+	gs_thr_publish(thr);
+	if ((thr->now - LOAD(thr->clock) <= lag) && (lag || (LOAD(thr->head) == LOAD(thr->tail)))) return;
+	pthread_mutex_lock(&thr->lock);
+	STORE(thr->wait, 1);
+	pthread_cond_broadcast(&thr->cond);
+	while ((thr->now - LOAD(thr->clock) > lag) || (!lag && ((LOAD(thr->head) != LOAD(thr->tail)) || !LOAD(thr->sleep))))
+		pthread_cond_wait(&thr->cond, &thr->lock);
+	STORE(thr->wait, 0);
+	pthread_mutex_unlock(&thr->lock);
+}
+
+// on = 1: start worker, on = 0: stop it (gs cpu runs on emulation thread)
+void gs_thread(GSound* gs, int on) {
+	struct gsThread* thr = gs->thr;
+	if (!on == !thr) return;
+	if (on) {
+		thr = (struct gsThread*)malloc(sizeof(struct gsThread));
+		memset(thr, 0x00, sizeof(struct gsThread));
+		pthread_mutex_init(&thr->lock, NULL);
+		pthread_cond_init(&thr->cond, NULL);
+		gs->thr = thr;
+		gs->time = 0;
+		if (pthread_create(&thr->id, NULL, gs_thr_loop, gs)) {
+			pthread_cond_destroy(&thr->cond);
+			pthread_mutex_destroy(&thr->lock);
+			free(thr);
+			gs->thr = NULL;
+		}
+	} else {
+		gs_thr_wait(thr, 0);
+		pthread_mutex_lock(&thr->lock);
+		STORE(thr->exit, 1);
+		pthread_cond_broadcast(&thr->cond);
+		pthread_mutex_unlock(&thr->lock);
+		pthread_join(thr->id, NULL);
+		pthread_cond_destroy(&thr->cond);
+		pthread_mutex_destroy(&thr->lock);
+		gs->time = 0;
+		gs->thr = NULL;
+		free(thr);
+	}
+}
+
+// make gs state safe to access from host: worker is stopped at current host time
+void gs_wait(GSound* gs) {
+	if (gs->thr) {
+		gs_thr_wait(gs->thr, 0);
+	} else {
+		gsFlush(gs);
+	}
+}
+
 #if GS_FLUSH
 
 void gsSync(GSound* gs, int ns) {
 	if (!gs->enable) return;
-	gs->time += ns;
+	if (gs->thr) {
+		gs->thr->now += ns;
+		if (gs->thr->now - gs->thr->target >= GS_STEP)
+			gs_thr_wait(gs->thr, GS_MAXLAG);
+	} else {
+		gs->time += ns;
+	}
 }
 
 void gsFlush(GSound* gs) {
 	if (!gs->enable) return;
-	int res;
-	while (gs->time > 0) {
-		res = cpu_exec(gs->cpu);
-		gs->time -= res * gs->ns_per_tick;
-		gs->cnt += res;
-		if (gs->cnt > 320) {	// 12MHz CLK, 37.5KHz INT -> int in each 320 ticks
-			gs->cnt -= 320;
-			gs->cpu->intrq |= Z80_INT;
-		}
+	if (gs->thr) {
+		gs_thr_wait(gs->thr, GS_MAXLAG);
+	} else {
+		while (gs->time > 0)
+			gs->time -= gs_exec(gs);
 	}
 }
 
@@ -192,21 +361,27 @@ int gsCheck(GSound* gs, int adr) {
 }
 
 int gsWrite(GSound* gs, int adr, int data) {
+	struct gsThread* thr = gs->thr;
+	gsEvent* ev;
 	if (!gsCheck(gs, adr)) return 0;
-	gsFlush(gs);
-	if (adr & 8) {
-		gs->pbb_zx = data & 0xff;
-		gs->pstate |= 1;
+	if (thr) {
+		if (thr->tail - LOAD(thr->head) >= GS_QSIZE)
+			gs_thr_wait(thr, 0);
+		ev = &thr->queue[thr->tail % GS_QSIZE];
+		ev->time = thr->now;
+		ev->adr = adr;
+		ev->val = data;
+		STORE(thr->tail, thr->tail + 1);
 	} else {
-		gs->pb3_zx = data & 0xff;
-		gs->pstate |= 0x80;		// set b7,state
+		gsFlush(gs);
+		gs_port_wr(gs, adr, data);
 	}
 	return 1;
 }
 
 int gsRead(GSound* gs, int adr, int* dptr) {
 	if (!gsCheck(gs, adr)) return 0;
-	gsFlush(gs);
+	gs_wait(gs);
 	if (adr & 8) {
 		*dptr = gs->pstate;
 	} else {
@@ -45,16 +45,20 @@ typedef struct {
 	int time;
 	int ns_per_tick;
 	long counter;
+	struct gsThread* thr;	// not NULL: gs cpu runs on worker thread (see gs_thread)
 } GSound;
 
 GSound* gsCreate();
 void gsDestroy(GSound*);
 void gsReset(GSound*);
+void gsMapMem(GSound*);
 void gsSync(GSound*, int);
 void gsFlush(GSound*);
 sndPair gsVolume(GSound*);
 int gsWrite(GSound*, int, int);
 int gsRead(GSound*, int, int*);
+void gs_thread(GSound*, int);
+void gs_wait(GSound*);
 
 #ifdef __cplusplus
 }
@@ -3,6 +3,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
+#include <pthread.h>
 
 // mixer
 #define XMAXVOL 16384
@@ -70,3 +72,108 @@ void bcSync(bitChan* ch, int ns) {
 		}
 	}
 }
+
+// band-limited resampler
+
+static int blepKernel[BLEP_PHASES][BLEP_TAPS];
+static pthread_once_t blepOnce = PTHREAD_ONCE_INIT;	// machines can be created by many threads at once
+
+// impulse = sinc with cutoff 0.9 of output nyquist, blackman window. each phase sum is exactly 1 << BLEP_BITS
+static void blepInit() {
+	double v[BLEP_TAPS];
+	double x, sum;
+	int p, k, isum;
+	for (p = 0; p < BLEP_PHASES; p++) {
+		sum = 0;
+		for (k = 0; k < BLEP_TAPS; k++) {
+			x = k - (BLEP_TAPS / 2 - 1) - (double)p / BLEP_PHASES;
+			v[k] = (x == 0) ? 1.0 : sin(M_PI * 0.9 * x) / (M_PI * 0.9 * x);
+			v[k] *= 0.42 + 0.5 * cos(M_PI * x / (BLEP_TAPS / 2)) + 0.08 * cos(2 * M_PI * x / (BLEP_TAPS / 2));
+			sum += v[k];
+		}
+		isum = 0;
+		for (k = 0; k < BLEP_TAPS; k++) {
+			blepKernel[p][k] = (int)floor(v[k] / sum * (1 << BLEP_BITS) + 0.5);
+			isum += blepKernel[p][k];
+		}
+		blepKernel[p][BLEP_TAPS / 2 - 1] += (1 << BLEP_BITS) - isum;	// no dc drift in integrator
+	}
+}
+
+sndBlep* blepCreate(int rate) {
+	sndBlep* bl = malloc(sizeof(sndBlep));
+	pthread_once(&blepOnce, blepInit);
+	memset(bl, 0x00, sizeof(sndBlep));
+	bl->rate = rate;
+	return bl;
+}
+
+void blepDestroy(sndBlep* bl) {
+	free(bl);
+}
+
+void blepClear(sndBlep* bl) {
+	int rate = bl->rate;
+	memset(bl, 0x00, sizeof(sndBlep));
+	bl->rate = rate;
+}
+
+void blepSetRate(sndBlep* bl, int rate) {
+	bl->rate = rate;
+	blepClear(bl);
+}
+
+// move time forward (ns). if nobody reads samples, buffer is dropped on overflow
+void blepSync(sndBlep* bl, int ns) {
+	int i;
+	if (ns < 1) return;
+	bl->clk += (long long)ns * bl->rate;
+	if (bl->clk < (long long)BLEP_SIZE * 1000000000) return;
+	for (i = 0; i < BLEP_SIZE + BLEP_TAPS; i++) {
+		bl->out.left += bl->bufL[i];
+		bl->out.right += bl->bufR[i];
+	}
+	memset(bl->bufL, 0x00, sizeof(bl->bufL));
+	memset(bl->bufR, 0x00, sizeof(bl->bufR));
+	bl->clk %= 1000000000;
+}
+
+// input level at current time
+void blepLevel(sndBlep* bl, sndPair lev) {
+	int dl = lev.left - bl->lev.left;
+	int dr = lev.right - bl->lev.right;
+	int pos;
+	int* ker;
+	int k;
+	if (!dl && !dr) return;
+	pos = bl->clk / 1000000000;
+	ker = blepKernel[(bl->clk % 1000000000) * BLEP_PHASES / 1000000000];
+	for (k = 0; k < BLEP_TAPS; k++) {
+		bl->bufL[pos + k] += dl * ker[k];
+		bl->bufR[pos + k] += dr * ker[k];
+	}
+	bl->lev = lev;
+}
+
+// get up to max ready samples (buf can be NULL to skip them), return count
+int blepRead(sndBlep* bl, sndPair* buf, int max) {
+	int all = bl->clk / 1000000000;
+	int cnt = (all > max) ? max : all;
+	int i;
+	if (cnt < 1) return 0;
+	for (i = 0; i < cnt; i++) {
+		bl->out.left += bl->bufL[i];
+		bl->out.right += bl->bufR[i];
+		if (buf) {
+			buf[i].left = bl->out.left >> BLEP_BITS;
+			buf[i].right = bl->out.right >> BLEP_BITS;
+		}
+	}
+	i = all - cnt + BLEP_TAPS;		// used part of buffer after read samples
+	memmove(bl->bufL, bl->bufL + cnt, i * sizeof(int));
+	memmove(bl->bufR, bl->bufR + cnt, i * sizeof(int));
+	memset(bl->bufL + i, 0x00, cnt * sizeof(int));
+	memset(bl->bufR + i, 0x00, cnt * sizeof(int));
+	bl->clk -= (long long)cnt * 1000000000;
+	return cnt;
+}
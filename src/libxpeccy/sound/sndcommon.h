@@ -15,6 +15,23 @@ typedef struct {
 	signed int right;
 } sndPair;
 
+// band-limited resampler: machine output level changes (steps) at any moment -> output samples at rate
+// each step is added to buffer as windowed-sinc impulse (for its sub-sample phase), output = integrated buffer
+#define BLEP_POLL	4	// recommended machine output polls per output sample
+#define BLEP_PHASES	32	// sub-sample positions of step
+#define BLEP_TAPS	16	// impulse length (output samples)
+#define BLEP_BITS	12	// impulse fixed point
+#define BLEP_SIZE	4096	// output samples buffer
+
+typedef struct {
+	int rate;
+	long long clk;		// time since 1st buffer sample, ns * rate (1e9 = 1 sample)
+	sndPair lev;		// current input level
+	sndPair out;		// integrator
+	int bufL[BLEP_SIZE + BLEP_TAPS];
+	int bufR[BLEP_SIZE + BLEP_TAPS];
+} sndBlep;
+
 extern char noizes[0x20000];
 
 typedef struct {
@@ -32,3 +49,11 @@ void bcDestroy(bitChan*);
 void bcSync(bitChan*, int);
 
 sndPair mixer(sndPair, sndPair);
+
+sndBlep* blepCreate(int);
+void blepDestroy(sndBlep*);
+void blepClear(sndBlep*);
+void blepSetRate(sndBlep*, int);
+void blepSync(sndBlep*, int);
+void blepLevel(sndBlep*, sndPair);
+int blepRead(sndBlep*, sndPair*, int);
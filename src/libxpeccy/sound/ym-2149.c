@@ -87,9 +87,10 @@ int ym_chan_vol(aymChip* ay, aymChan* ch) {
 	return vol;
 }
 
+extern void ay_out(aymChip*, int*, int(*)(aymChip*, aymChan*));
+
 sndPair ym_vol(aymChip* chip) {
-	int volA = ym_chan_vol(chip, &chip->chanA);
-	int volB = ym_chan_vol(chip, &chip->chanB);
-	int volC = ym_chan_vol(chip, &chip->chanC);
-	return ay_mix_stereo(volA, volB, volC, chip->stereo);
+	int vol[3];
+	ay_out(chip, vol, ym_chan_vol);
+	return ay_mix_stereo(vol[0], vol[1], vol[2], chip->stereo);
 }
@@ -5,17 +5,15 @@
 #include "spectrum.h"
 #include "filetypes/filetypes.h"
 #include "cpu/Z80/z80.h"
+#include "trace.h"
 
-static int nsTime;
-static int res2;
-int res4 = 0;		// save last T synced with video (last is res2-res4)
 
 unsigned char* comp_get_memcell_flag_ptr(Computer* comp, int adr) {
 	unsigned char* res = NULL;
 	xAdr xadr = mem_get_xadr(comp->mem, adr);
 	switch (xadr.type) {
-		case MEM_RAM: res = comp->brkRamMap + (xadr.abs & comp->mem->ramMask); break;
-		case MEM_ROM: res = comp->brkRomMap + (xadr.abs & comp->mem->romMask); break;
+		case MEM_RAM: res = comp_brk_map(comp, MEM_RAM) + (xadr.abs & comp->mem->ramMask); break;
+		case MEM_ROM: res = comp_brk_map(comp, MEM_ROM) + (xadr.abs & comp->mem->romMask); break;
 		case MEM_SLOT: if (comp->slot->brkMap) {res = comp->slot->brkMap + (xadr.abs & comp->slot->memMask);} break;
 	}
 	return res;
@@ -35,8 +33,16 @@ bpChecker comp_check_bp(Computer* comp, int adr, int mask) {
 	if (ch.t < 0) {
 		xAdr xadr = mem_get_xadr(comp->mem, adr);
 		switch (xadr.type) {
-			case MEM_RAM: xadr.abs &= comp->mem->ramMask; ch.ptr = comp->brkRamMap + xadr.abs; ch.t = BRK_MEMRAM; break;
-			case MEM_ROM: xadr.abs &= comp->mem->romMask; ch.ptr = comp->brkRomMap + xadr.abs; ch.t = BRK_MEMROM; break;
+			case MEM_RAM: if (comp->brkRamMap) {
+					xadr.abs &= comp->mem->ramMask;
+					ch.ptr = comp->brkRamMap + xadr.abs;
+					ch.t = BRK_MEMRAM;
+				} break;
+			case MEM_ROM: if (comp->brkRomMap) {
+					xadr.abs &= comp->mem->romMask;
+					ch.ptr = comp->brkRomMap + xadr.abs;
+					ch.t = BRK_MEMROM;
+				} break;
 			case MEM_SLOT: if (comp->slot->brkMap) {
 					xadr.abs &= comp->slot->memMask;
 					ch.ptr = comp->slot->brkMap + xadr.abs;
@@ -55,6 +61,145 @@ bpChecker comp_check_bp(Computer* comp, int adr, int mask) {
 	return ch;
 }
 
+// memory hooks
+// cpu reads/writes memory pages directly, except pages where memrd/memwr must see the access:
+// rd/wr breakpoints and zx screen area (catch-up video)
+
+static int comp_brk_hook(unsigned char* ptr) {
+	int res = 0;
+	int i;
+	if (!ptr) return 0;
+	for (i = 0; i < 256; i++) {
+		if (ptr[i] & MEM_BRK_RD) res |= MEM_HOOK_RD;
+		if (ptr[i] & MEM_BRK_WR) res |= MEM_HOOK_WR;
+		if (ptr[i] & MEM_BRK_ANY) res |= MEM_HOOK_BRK;
+		if (ptr[i] & MEM_BRK_TFETCH) res |= MEM_HOOK_BRK;
+	}
+	return res;
+}
+
+// type = MEM_RAM/MEM_ROM or 0 for cpu address space, page = number of 256-byte page
+void comp_upd_hook(Computer* comp, int type, int page) {
+	int flag;
+	unsigned char old;
+	switch (type) {
+		case MEM_RAM:
+			page &= (MEM_4M >> 8) - 1;
+			old = comp->mem->ramHook[page];
+			flag = comp_brk_hook(comp->brkRamMap ? comp->brkRamMap + (page << 8) : NULL);
+			if ((comp->hw->grp == HWG_ZX) && (((page >> 6) == 5) || ((page >> 6) == 7)) && ((page & 0x3f) < 0x1b))
+				flag |= MEM_HOOK_WR;
+			break;
+		case MEM_ROM:
+			page &= (MEM_512K >> 8) - 1;
+			old = comp->mem->romHook[page];
+			flag = comp_brk_hook(comp->brkRomMap ? comp->brkRomMap + (page << 8) : NULL);
+			break;
+		default:
+			page &= 0xff;
+			old = comp->mem->adrHook[page];
+			flag = comp_brk_hook(comp->brkAdrMap + (page << 8));
+			break;
+	}
+	if ((old ^ flag) & MEM_HOOK_BRK)
+		comp->brkPages += (flag & MEM_HOOK_BRK) ? 1 : -1;
+	mem_set_hook(comp->mem, type, page, flag);
+}
+
+// recheck pages with breakpoints (after clearing brk maps)
+void comp_upd_brk_pages(Computer* comp) {
+	int i;
+	for (i = 0; i < (MEM_4M >> 8); i++) {
+		if (comp->mem->ramHook[i] & MEM_HOOK_BRK)
+			comp_upd_hook(comp, MEM_RAM, i);
+	}
+	for (i = 0; i < (MEM_512K >> 8); i++) {
+		if (comp->mem->romHook[i] & MEM_HOOK_BRK)
+			comp_upd_hook(comp, MEM_ROM, i);
+	}
+	for (i = 0; i < 256; i++) {
+		if (comp->mem->adrHook[i] & MEM_HOOK_BRK)
+			comp_upd_hook(comp, 0, i);
+	}
+}
+
+// brk cell was changed. t = BRK_CPUADR/BRK_MEMRAM/BRK_MEMROM, adr = cpu/ram/rom address
+void comp_upd_brk(Computer* comp, int t, int adr) {
+	switch (t) {
+		case BRK_CPUADR: comp_upd_hook(comp, 0, adr >> 8); break;
+		case BRK_MEMRAM: comp_upd_hook(comp, MEM_RAM, adr >> 8); break;
+		case BRK_MEMROM: comp_upd_hook(comp, MEM_ROM, adr >> 8); break;
+	}
+}
+
+// slot memory has no page hooks: any armed cell in slot brk map keeps breakpoint checks on everywhere
+// set brk flags of slot cell (adr = slot memory address), slot->brkCount follows armed cells
+void comp_set_slot_brk(Computer* comp, int adr, int val) {
+	xCartridge* slot = comp->slot;
+	unsigned char* ptr;
+	int old;
+	if (!slot->brkMap) return;
+	ptr = slot->brkMap + (adr & slot->memMask);
+	old = *ptr & 0x0f;
+	*ptr = (*ptr & 0xf0) | (val & 0x0f);
+	if (!old == !(val & 0x0f)) return;
+	slot->brkCount += old ? -1 : 1;
+	if (slot->brkCount < 2)		// became 0 or 1
+		comp_upd_fast(comp);
+}
+
+// recount armed slot cells (after slot brk map was cleared or loaded as a whole)
+void comp_upd_slot_brk(Computer* comp) {
+	xCartridge* slot = comp->slot;
+	int i;
+	slot->brkCount = 0;
+	for (i = 0; slot->brkMap && (i <= slot->memMask); i++) {
+		if (slot->brkMap[i] & 0x0f)
+			slot->brkCount++;
+	}
+	comp_upd_fast(comp);
+}
+
+// there are breakpoints at cpu address adr (maybe)
+static inline int comp_brk_page(Computer* comp, int adr) {
+	if (!(comp->brkPages | comp->slot->brkCount)) return 0;
+	return comp->slot->brkCount || (comp->mem->hook[(adr >> comp->mem->pgshift) & 0xff] & MEM_HOOK_BRK);
+}
+
+void comp_upd_hooks(Computer* comp) {
+	int i;
+	for (i = 0; i < (MEM_4M >> 8); i++)
+		comp_upd_hook(comp, MEM_RAM, i);
+	for (i = 0; i < (MEM_512K >> 8); i++)
+		comp_upd_hook(comp, MEM_ROM, i);
+	for (i = 0; i < 256; i++)
+		comp_upd_hook(comp, 0, i);
+}
+
+// max time for one cpu exec call with bulk REP string ops: devices are synced after it
+#define COMP_BULK_NS	32000
+
+static unsigned char* comp_mptr(int adr, int wr, void* ptr) {
+	Computer* comp = (Computer*)ptr;
+	return comp->hw->mptr(comp, adr & comp->cpu->busmask, wr);
+}
+
+// direct memory access is possible, if hardware use standard memory callbacks and nobody watch all accesses
+void comp_upd_fast(Computer* comp) {
+	int on = (comp->hw->mrd == stdMRd) && (comp->hw->mwr == stdMWr) && !comp->flgMAP && !comp->trc;
+	comp->cpu->fmrd = on ? comp->mem->rptr : NULL;
+	comp->cpu->fmwr = on ? comp->mem->wptr : NULL;
+	comp->cpu->m1hook = (comp->dif->type == DIF_BDI);	// stdMRd: TR-DOS trap
+#ifdef HAVEZLIB
+	if (comp->rzx.play) comp->cpu->m1hook = 1;		// fetches counter
+#endif
+	// TLB for wide adr bus cpu: no memory map view, breakpoints and trace (they need memrd/memwr)
+	on = comp->hw->mptr && !comp->flgMAP && !comp->trc && !(comp->brkPages | comp->slot->brkCount);
+	comp->cpu->mptr = on ? comp_mptr : NULL;
+	comp->cpu->tlim = (on && (comp->nsPerTick > 0)) ? COMP_BULK_NS / comp->nsPerTick : 0;
+	cpu_tlb_flush(comp->cpu);
+}
+
 // video callbacks
 
 int vid_mrd_cb(int adr, void* ptr) {
@@ -72,10 +217,10 @@ int memrd(int adr, int m1, void* ptr) {
 		comp->rzx.frm.fetches--;
 	}
 #endif
-	unsigned char* fptr = comp_get_memcell_flag_ptr(comp, adr);
-	if (fptr) {
-		unsigned char flag = *fptr;
-		if (comp->flgMAP) {
+	if (comp->flgMAP) {
+		unsigned char* fptr = comp_get_memcell_flag_ptr(comp, adr);
+		if (fptr) {
+			unsigned char flag = *fptr;
 			if ((cpu_get_pc(comp->cpu)-1+comp->cpu->cs.base) == adr) {
 				flag &= 0x0f;
 				flag |= DBG_VIEW_EXEC;
@@ -86,11 +231,13 @@ int memrd(int adr, int m1, void* ptr) {
 			}
 		}
 	}
-	bpChecker ch = comp_check_bp(comp, adr, MEM_BRK_RD);
-	if (ch.t >= 0) {
-		comp->flgBRK = 1;
-		comp->brkt = ch.t;
-		comp->brka = ch.a;
+	if (comp_brk_page(comp, adr)) {
+		bpChecker ch = comp_check_bp(comp, adr, MEM_BRK_RD);
+		if (ch.t >= 0) {
+			comp->flgBRK = 1;
+			comp->brkt = ch.t;
+			comp->brka = ch.a;
+		}
 	}
 	return comp->hw->mrd(comp,adr,m1);
 }
@@ -98,15 +245,12 @@ int memrd(int adr, int m1, void* ptr) {
 void memwr(int adr, int val, void* ptr) {
 	Computer* comp = (Computer*)ptr;
 	adr &= comp->cpu->busmask;
-	unsigned char* fptr = comp_get_memcell_flag_ptr(comp, adr);
-	if (fptr) {
-		unsigned char flag = *fptr;
-		if (comp->flgMAP) {
-			if (!(flag & 0xf0)) {
-				flag |= DBG_VIEW_BYTE;
-				*fptr = flag;
-			}
-		}
+	if (comp->flgMAP) {
+		unsigned char* fptr = comp_get_memcell_flag_ptr(comp, adr);
+		if (fptr && !(*fptr & 0xf0))
+			*fptr |= DBG_VIEW_BYTE;
+	}
+	if (comp_brk_page(comp, adr)) {
 		bpChecker ch = comp_check_bp(comp, adr, MEM_BRK_WR);
 		if (ch.t >= 0) {
 			comp->flgBRK = 1;
@@ -114,7 +258,17 @@ void memwr(int adr, int val, void* ptr) {
 			comp->brka = ch.a;
 		}
 	}
+	if (comp->vid->lazlim) {			// catch-up video before writing to screen
+		MemPage* pg = mem_get_page(comp->mem, adr);
+		if ((pg->type == MEM_RAM) && ((pg->num >> 6) == comp->vid->vidPage) && ((pg->num & 0x3f) < 0x1b)) {	// pixels & attributes
+			vid_sync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+			comp->vsyncT = comp->cpu->t;
+			vid_flush(comp->vid);
+		}
+	}
 	comp->hw->mwr(comp,adr,val);
+	if (comp->trc)
+		trc_mwr(comp->trc, adr, val);
 }
 
 void zx_cont_delay(Computer* comp) {
@@ -126,13 +280,13 @@ void zx_cont_delay(Computer* comp) {
 		tns += comp->nsPerTick;
 	}
 	vid_sync(comp->vid, tns);
-	res4 = comp->cpu->t;
+	comp->vsyncT = comp->cpu->t;
 }
 
 void zx_free_ticks(Computer* comp, int t) {
 	comp->cpu->t += t;
 	vid_sync(comp->vid, t * comp->nsPerTick);
-	res4 = comp->cpu->t;
+	comp->vsyncT = comp->cpu->t;
 }
 
 // Contention on T1
@@ -189,15 +343,17 @@ void zxSetUlaPalete(Computer* comp) {
 
 int iord(int port, void* ptr) {
 	Computer* comp = (Computer*)ptr;
+	comp_dev_sync(comp);
 // TODO: zx only
 	if (comp->hw->grp == HWG_ZX) {
 		if (comp->flgCNTI && 0) {
 			zx_cont_t1(comp, port);
 			zx_cont_tn(comp, port);
 		} else {
-			vid_sync(comp->vid,(comp->cpu->t + 3 - res4) * comp->nsPerTick);
-			res4 = comp->cpu->t + 3;
+			vid_sync(comp->vid,(comp->cpu->t + 3 - comp->vsyncT) * comp->nsPerTick);
+			comp->vsyncT = comp->cpu->t + 3;
 		}
+		vid_flush(comp->vid);		// floating bus
 	}
 // play rzx
 #ifdef HAVEZLIB
@@ -228,19 +384,22 @@ int iord(int port, void* ptr) {
 
 void iowr(int port, int val, void* ptr) {
 	Computer* comp = (Computer*)ptr;
+	comp_dev_sync(comp);
 	comp->flgBDI = (comp->flgDOS && (comp->dif->type == DIF_BDI)) ? 1 : 0;
 	if (comp->hw->grp == HWG_ZX) {
 		// sync video to current T
-		vid_sync(comp->vid, (comp->cpu->t - res4) * comp->nsPerTick);
-		res4 = comp->cpu->t;
+		vid_sync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+		comp->vsyncT = comp->cpu->t;
 		if (comp->flgCNTI) {
 			zx_cont_t1(comp, port);
+			vid_flush(comp->vid);
 			comp->hw->out(comp, port, val);
 			zx_cont_tn(comp, port);
 			comp->cpu->t -= 4;
 		} else {
 			vid_sync(comp->vid, comp->nsPerTick);
-			res4++;
+			comp->vsyncT++;
+			vid_flush(comp->vid);
 			comp->hw->out(comp, port, val);
 		}
 	} else {
@@ -286,8 +445,10 @@ void comp_irq(int t, void* ptr) {
 			}
 			break;
 		case IRQ_CPU_SYNC:
-			vid_sync(comp->vid, (comp->cpu->t - res4) * comp->nsPerTick);
-			res4 = comp->cpu->t;
+			if (!comp->vid->lazlim) {		// catch-up rendering syncs video only when someone looks at it
+				vid_sync(comp->vid, (comp->cpu->t - comp->vsyncT) * comp->nsPerTick);
+				comp->vsyncT = comp->cpu->t;
+			}
 			break;
 	}
 	if (comp->hw->irq) comp->hw->irq(comp, t);
@@ -394,6 +555,7 @@ Computer* compCreate() {
 	comp->gbsnd = gbsCreate();
 	comp->saa = saaCreate();
 	comp->beep = bcCreate();
+	comp->blep = blepCreate(44100);
 	comp->nesapu = apuCreate(nes_apu_ext_rd, comp_irq, comp);
 // c64
 	comp->cia1 = cia_create(IRQ_CIA1, comp_irq, comp);
@@ -426,6 +588,7 @@ Computer* compCreate() {
 }
 
 void compDestroy(Computer* comp) {
+	int i;
 	rzxStop(comp);
 	cpuDestroy(comp->cpu);
 	memDestroy(comp->mem);
@@ -443,6 +606,7 @@ void compDestroy(Computer* comp) {
 	sdrvDestroy(comp->sdrv);
 	saaDestroy(comp->saa);
 	bcDestroy(comp->beep);
+	blepDestroy(comp->blep);
 	apuDestroy(comp->nesapu);
 	sltDestroy(comp->slot);
 	ppi_destroy(comp->ppi);
@@ -454,6 +618,10 @@ void compDestroy(Computer* comp) {
 	cia_destroy(comp->cia1);
 	cia_destroy(comp->cia2);
 	upd4990_destroy(comp->rtc);
+	free(comp->brkRamMap);
+	free(comp->brkRomMap);
+	for (i = 0; i < HW_PDEC_SLOTS; i++)
+		hw_port_free(comp->pdec[i]);
 	free(comp);
 }
 
@@ -494,6 +662,7 @@ void compReset(Computer* comp,int res) {
 	comp->cpu->ss.base = 0;
 	comp->cpu->cs.limit = 0xffff;
 	cpu_reset(comp->cpu);
+	comp_upd_fast(comp);
 }
 
 // cpu freq
@@ -538,31 +707,68 @@ int compSetHardware(Computer* comp, const char* name) {
 		hw = findHardware(name);
 	}
 	if (hw == NULL) return 0;
+	comp_dev_sync(comp);		// old hardware devices
 	comp->hw = hw;
 //	comp->cpu->nod = 0;
 	comp->vid->mrd = vid_mrd_cb;
+	comp->vid->lazy = (hw->grp == HWG_ZX) && !(compflags & CFLG_NOLAZY);
+	comp->vid->nospan = (compflags & CFLG_NOLAZY) ? 1 : 0;
 	comp->tape->xen = 0;
 	mem_set_bus(comp->mem, hw->adrbus);
 	compSetBaseFrq(comp, 0);	// recalculations
+	comp_upd_hooks(comp);
+	comp_upd_fast(comp);
 	return 1;
 }
 
 // exec 1 opcode, sync devices, return eated ns
 
+// devices (hw->sync) are synced after each cpu command, unless hw->sync set comp->devDue to defer next sync:
+// then devices time is accumulated until devDue is reached. devices must be synced before anything can see them:
+// i/o (iord/iowr), new frame, output level (hw->vol callers: sound sources only, see comp_snd_sync), debugger.
+// hw->sync defers only devices which can't do anything on their own (irq, nmi) during devDue
+void comp_dev_sync(Computer* comp) {
+	int ns = comp->devNs;
+	comp->devNs = 0;
+	comp->devDue = 0;
+	if ((ns > 0) && comp->hw && comp->hw->sync)
+		comp->hw->sync(comp, ns);
+	comp->devSndNs = 0;
+}
+
+// sync sound sources only, before output level is polled (hw->vol): it's done every few us, so full sync there
+// would cancel deferring. zx: all but FDC and NMI, they get their time at next comp_dev_sync. others: full sync
+void comp_snd_sync(Computer* comp) {
+	int ns = comp->devNs - comp->devSndNs;
+	if (!comp->hw || (comp->hw->sync != zx_sync)) {
+		comp_dev_sync(comp);
+	} else if (ns > 0) {
+		zx_snd_sync(comp, ns);
+		comp->devSndNs = comp->devNs;
+	}
+}
+
 int compExec(Computer* comp) {
+	int res2;
+	int nsTime;
+	int pcadr;
 	comp->vid->time = 0;
 // breakpoints
 	if (!comp->flgDBG) {
-		bpChecker ch = comp_check_bp(comp, cpu_get_pc(comp->cpu) + comp->cpu->cs.base, MEM_BRK_FETCH | MEM_BRK_TFETCH);
-		if (ch.t >= 0) {
-			comp->flgBRK = 1;
-			comp->brkt = ch.t;
-			comp->brka = ch.a;
-			if (*ch.ptr & MEM_BRK_TFETCH) {
-				*ch.ptr &= ~MEM_BRK_TFETCH;
-				comp->brkt = -1;		// temp (not in list)
+		pcadr = cpu_get_pc(comp->cpu) + comp->cpu->cs.base;
+		if (comp_brk_page(comp, pcadr)) {
+			bpChecker ch = comp_check_bp(comp, pcadr, MEM_BRK_FETCH | MEM_BRK_TFETCH);
+			if (ch.t >= 0) {
+				comp->flgBRK = 1;
+				comp->brkt = ch.t;
+				comp->brka = ch.a;
+				if (*ch.ptr & MEM_BRK_TFETCH) {
+					*ch.ptr &= ~MEM_BRK_TFETCH;
+					comp_upd_brk(comp, ch.t, ch.a);
+					comp->brkt = -1;		// temp (not in list)
+				}
+				return 0;
 			}
-			return 0;
 		}
 		if (comp->cpu->intrq && comp->flgIBRK) {
 			comp->flgBRK = 1;
@@ -571,12 +777,16 @@ int compExec(Computer* comp) {
 		}
 	}
 // start
-	res4 = 0;
+	comp->vsyncT = 0;
+	if (comp->trc)
+		trc_begin(comp->trc, comp);
 // exec cpu opcode OR handle interrupt. get T states back
 	res2 = cpu_exec(comp->cpu);
 // scorpion WAIT: add 1T to odd-T command
 	if (comp->flgEM1 && (res2 & 1))
 		res2++;
+	if (comp->trc)
+		trc_end(comp->trc, comp, res2);
 #ifdef HAVEZLIB
 	if (comp->rzx.play) {
 		if (comp->rzx.frm.fetches == 0) {
@@ -586,16 +796,16 @@ int compExec(Computer* comp) {
 	}
 #endif
 #if 1
-	vid_sync(comp->vid, (res2 - res4) * comp->nsPerTick);
+	vid_sync(comp->vid, (res2 - comp->vsyncT) * comp->nsPerTick);
 #else
-	if (res2 > res4) {
+	if (res2 > comp->vsyncT) {
 		if (comp->hw->grp == HWG_ZX) {
-			if (res2 > res4 + 1)
-				vid_sync(comp->vid, (res2 - res4 - 1) * comp->nsPerTick);
+			if (res2 > comp->vsyncT + 1)
+				vid_sync(comp->vid, (res2 - comp->vsyncT - 1) * comp->nsPerTick);
 			comp->cpu->flgACK = comp->vid->intFRAME ? 1 : 0;
 			vid_sync(comp->vid, comp->nsPerTick);
 		} else {
-			vid_sync(comp->vid, (res2 - res4) * comp->nsPerTick);
+			vid_sync(comp->vid, (res2 - comp->vsyncT) * comp->nsPerTick);
 		}
 	}
 #endif
@@ -603,13 +813,16 @@ int compExec(Computer* comp) {
 	nsTime = comp->vid->time;
 	comp->tickCount += res2;
 	comp->frmtCount += res2;
-// sync hardware
-	if (comp->hw->sync)
-		comp->hw->sync(comp, nsTime);
+// sync hardware (or defer it, see comp_dev_sync)
+	comp->devNs += nsTime;
+	if (comp->devNs >= comp->devDue)
+		comp_dev_sync(comp);
 // new frame
 	if (comp->vid->newFrame) {
 		comp->vid->newFrame = 0;
+		comp_dev_sync(comp);
 		comp->flgFRM = 1;
+		comp_upd_fast(comp);
 	}
 // return ns eated @ this step
 	return nsTime;
@@ -657,30 +870,55 @@ void comp_brk(Computer* comp, int t) {
 	comp->brkt = t;
 }
 
-static unsigned char dumBrk = 0x00;
+// ram/rom brk maps are allocated on first use (MEM_4M/MEM_512K, whole address range of memory)
+unsigned char* comp_brk_map(Computer* comp, int type) {
+	unsigned char* res = NULL;
+	switch (type) {
+		case MEM_RAM:
+			if (!comp->brkRamMap)
+				comp->brkRamMap = (unsigned char*)calloc(MEM_4M, 1);
+			res = comp->brkRamMap;
+			break;
+		case MEM_ROM:
+			if (!comp->brkRomMap)
+				comp->brkRomMap = (unsigned char*)calloc(MEM_512K, 1);
+			res = comp->brkRomMap;
+			break;
+	}
+	return res;
+}
 
 unsigned char* getBrkPtr(Computer* comp, int madr) {
 	xAdr xadr = mem_get_xadr(comp->mem, madr);
 	unsigned char* ptr = NULL;
 	switch (xadr.type) {
-		case MEM_RAM: ptr = comp->brkRamMap + (xadr.abs & comp->mem->ramMask); break;
-		case MEM_ROM: ptr = comp->brkRomMap + (xadr.abs & comp->mem->romMask); break;
+		case MEM_RAM: ptr = comp_brk_map(comp, MEM_RAM) + (xadr.abs & comp->mem->ramMask); break;
+		case MEM_ROM: ptr = comp_brk_map(comp, MEM_ROM) + (xadr.abs & comp->mem->romMask); break;
 		case MEM_SLOT:
 			if (comp->slot->brkMap)
 				ptr = comp->slot->brkMap + (xadr.abs & comp->slot->memMask);
 			break;
 	}
 	if (!ptr) {
-		dumBrk = 0;
-		ptr = &dumBrk;
+		comp->dumBrk = 0;
+		ptr = &comp->dumBrk;
 	}
 	return ptr;
 }
 
 void setBrk(Computer* comp, int adr, unsigned char val) {
+	xAdr xadr = mem_get_xadr(comp->mem, adr);
+	if (xadr.type == MEM_SLOT) {
+		comp_set_slot_brk(comp, xadr.abs, val);
+		return;
+	}
 	unsigned char* ptr = getBrkPtr(comp, adr);
 	if (ptr == NULL) return;
 	*ptr = (*ptr & 0xf0) | (val & 0x0f);
+	switch (xadr.type) {
+		case MEM_RAM: comp_upd_brk(comp, BRK_MEMRAM, xadr.abs & comp->mem->ramMask); break;
+		case MEM_ROM: comp_upd_brk(comp, BRK_MEMROM, xadr.abs & comp->mem->romMask); break;
+	}
 }
 
 unsigned char getBrk(Computer* comp, int adr) {
@@ -37,6 +37,9 @@ extern "C" {
 extern int compflags;
 
 #define CFLG_PANIC	1
+#define CFLG_NOLAZY	2	// disable catch-up video rendering and span drawing (video goes dot by dot)
+
+#define HW_PDEC_SLOTS	4	// compiled port tables kept per computer
 
 // hw reset rompage
 enum {
@@ -103,6 +106,10 @@ typedef struct {
 	int hCount;		// T before HALT = frmtCount @ HALT
 	int fCount;		// T in last frame
 	int nsPerTick;
+	int vsyncT;		// last T synced with video
+	int devNs;		// ns passed since last hw->sync (devices time debt)
+	int devDue;		// hw->sync is called when devNs reaches it. hw->sync can set it to defer next sync
+	int devSndNs;		// part of devNs already given to sound sources (comp_snd_sync)
 
 	bool flag[128];			// each machine have its own flags
 	bool sysflag[32];		// some common flags used by several machines or debuga
@@ -132,6 +139,7 @@ typedef struct {
 	saaChip* saa;
 	gbSound* gbsnd;
 	nesAPU* nesapu;
+	sndBlep* blep;		// output resampler
 // misc
 	PPI* ppi;			// i8255-like chip
 	PPI* ppib;
@@ -170,10 +178,15 @@ typedef struct {
 
 #endif
 
-	unsigned char brkRamMap[MEM_4M];	// ram brk/type : b0..3:brk flags, b4..7:type
-	unsigned char brkRomMap[MEM_512K];	// rom brk/type : b0..3:brk flags, b4..7:type
+	unsigned char* brkRamMap;		// ram brk/type : b0..3:brk flags, b4..7:type (MEM_4M, NULL until used)
+	unsigned char* brkRomMap;		// rom brk/type : b0..3:brk flags, b4..7:type (MEM_512K, NULL until used)
 	unsigned char brkAdrMap[MEM_64K];	// adr brk
 	unsigned char brkIOMap[MEM_64K];	// io brk
+	unsigned char dumBrk;			// brk cell for unmapped memory
+	int brkPages;				// 256-byte pages with armed breakpoints (MEM_HOOK_BRK)
+	struct xPortDec* pdec[HW_PDEC_SLOTS];	// compiled port tables, one per xPort table in use (see hwIn/hwOut)
+	int pdecNext;				// slot to reuse when all are taken
+	struct xTrace* trc;			// execution trace recorder (see trace.h), NULL if off
 	// TODO: try to move this somewhere
 	struct {
 		unsigned char Page0;
@@ -221,6 +234,16 @@ void cmsWr(Computer*, int);
 void rzxStop(Computer*);
 
 void comp_brk(Computer*, int);
+void comp_upd_hook(Computer*, int, int);
+void comp_upd_hooks(Computer*);
+void comp_upd_brk_pages(Computer*);
+void comp_upd_brk(Computer*, int, int);
+void comp_set_slot_brk(Computer*, int, int);
+void comp_upd_slot_brk(Computer*);
+void comp_upd_fast(Computer*);
+void comp_dev_sync(Computer*);
+void comp_snd_sync(Computer*);
+unsigned char* comp_brk_map(Computer*, int);
 unsigned char* getBrkPtr(Computer*, int);
 unsigned char getBrk(Computer*, int);
 void setBrk(Computer*, int, unsigned char);
@@ -0,0 +1,617 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "state.h"
+#include "cpu/x86/i80286.h"
+
+// structure is saved as raw bytes except listed fields (must be sorted by offset)
+enum {
+	ST_KEEP = 1,	// not saved, current value stays (callbacks, heap pointers, media, config)
+	ST_DATA,	// big array, zero tail is cut
+	ST_SPTR,	// pointer to static code/data, saved as id from st_ptrs lists
+	ST_REF,		// pointer to one of items in pointers array of same structure
+	ST_IPTR		// pointer inside buffer, relative to (kept) buffer pointer
+};
+
+typedef struct {
+	int type;
+	int off;
+	int size;
+	int base;	// ST_REF: pointers array, ST_IPTR: buffer pointer
+	int cnt;	// ST_REF: pointers count
+} xStField;
+
+#define ST_END			{0, 0, 0, 0, 0}
+#define ST_FLD(_tp, _s, _f)		{_tp, offsetof(_s, _f), sizeof(((_s*)0)->_f), 0, 0}
+#define ST_RNG(_tp, _s, _a, _b)		{_tp, offsetof(_s, _a), offsetof(_s, _b) - offsetof(_s, _a), 0, 0}
+#define ST_TAIL(_tp, _s, _a)		{_tp, offsetof(_s, _a), sizeof(_s) - offsetof(_s, _a), 0, 0}
+#define ST_REFS(_s, _f, _arr, _n)	{ST_REF, offsetof(_s, _f), sizeof(void*), offsetof(_s, _arr), _n}
+#define ST_INNER(_s, _f, _buf)		{ST_IPTR, offsetof(_s, _f), sizeof(void*), offsetof(_s, _buf), 0}
+
+static const xStField st_none[] = {ST_END};
+
+static const xStField st_comp[] = {
+	ST_FLD(ST_KEEP, Computer, hw),
+	ST_FLD(ST_KEEP, Computer, msg),
+	ST_RNG(ST_KEEP, Computer, cpu, cmos),		// devices, output resampler
+	ST_RNG(ST_KEEP, Computer, cia1, tsconf),	// devices, rzx, breakpoints
+	ST_END
+};
+
+static const xStField st_cpu[] = {
+	ST_RNG(ST_KEEP, CPU, libname, com),
+	ST_FLD(ST_KEEP, CPU, opTab),		// opTab, op: set by each exec call
+	ST_FLD(ST_KEEP, CPU, op),
+	ST_FLD(ST_SPTR, CPU, x86fetch),
+	ST_FLD(ST_SPTR, CPU, x86mrd),
+	ST_FLD(ST_SPTR, CPU, x86mwr),
+	ST_END
+};
+
+static const xStField st_vid[] = {
+	ST_FLD(ST_KEEP, Video, ctab),
+	ST_FLD(ST_KEEP, Video, cb),		// restored by vmode
+	ST_FLD(ST_SPTR, Video, cbCount),
+	ST_RNG(ST_KEEP, Video, mrd, fcnt),
+	ST_INNER(Video, ray.ptr, scrimg),
+	ST_INNER(Video, ray.lptr, scrimg),
+	ST_FLD(ST_SPTR, Video, pset),
+	ST_FLD(ST_SPTR, Video, col),
+	ST_FLD(ST_KEEP, Video, vga.ega_cbline),
+	ST_FLD(ST_KEEP, Video, font.data),
+	ST_FLD(ST_DATA, Video, colram),
+	ST_FLD(ST_KEEP, Video, bios),
+	ST_FLD(ST_DATA, Video, ram),
+	ST_RNG(ST_KEEP, Video, ula, zoomx),		// chips, image buffers
+	ST_END
+};
+
+static const xStField st_tape[] = {
+	ST_RNG(ST_KEEP, Tape, path, blkData),
+	ST_FLD(ST_KEEP, Tape, blkData),
+	ST_TAIL(ST_KEEP, Tape, xirq),
+	ST_END
+};
+
+static const xStField st_dif[] = {
+	ST_TAIL(ST_KEEP, DiskIF, type),
+	ST_END
+};
+
+static const xStField st_fdc[] = {
+	ST_FLD(ST_KEEP, FDC, flop),
+	ST_REFS(FDC, flp, flop, 4),
+	ST_FLD(ST_SPTR, FDC, plan),
+	ST_FLD(ST_KEEP, FDC, xirq),
+	ST_FLD(ST_KEEP, FDC, xptr),
+	ST_FLD(ST_DATA, FDC, slst),
+	ST_END
+};
+
+static const xStField st_flp[] = {
+	ST_RNG(ST_KEEP, Floppy, xirq, id),
+	ST_FLD(ST_KEEP, Floppy, path),
+	ST_FLD(ST_KEEP, Floppy, data),
+	ST_END
+};
+
+static const xStField st_ide[] = {
+	ST_FLD(ST_KEEP, IDE, type),
+	ST_FLD(ST_KEEP, IDE, master),
+	ST_FLD(ST_KEEP, IDE, slave),
+	ST_REFS(IDE, curDev, master, 2),
+	ST_FLD(ST_KEEP, IDE, core),
+	ST_FLD(ST_KEEP, IDE, smuc.cmos),
+	ST_FLD(ST_KEEP, IDE, smuc.nv),
+	ST_END
+};
+
+static const xStField st_ata[] = {
+	ST_RNG(ST_KEEP, ATADev, xirq, lba),
+	ST_RNG(ST_KEEP, ATADev, maxlba, buf),
+	ST_TAIL(ST_KEEP, ATADev, pass),
+	ST_END
+};
+
+static const xStField st_sdc[] = {
+	ST_RNG(ST_KEEP, SDCard, capacity, buf),
+	ST_END
+};
+
+static const xStField st_slot[] = {
+	ST_FLD(ST_KEEP, xCartridge, path),
+	ST_FLD(ST_DATA, xCartridge, ram),
+	ST_TAIL(ST_KEEP, xCartridge, core),
+	ST_END
+};
+
+static const xStField st_ts[] = {
+	ST_RNG(ST_KEEP, TSound, rom, curChip),
+	ST_REFS(TSound, curChip, chipA, 4),
+	ST_END
+};
+
+static const xStField st_aym[] = {
+	ST_RNG(ST_KEEP, aymChip, type, chanA),
+	ST_END
+};
+
+static const xStField st_gs[] = {
+	ST_RNG(ST_KEEP, GSound, cpu, pb3_gs),
+	ST_FLD(ST_KEEP, GSound, thr),
+	ST_END
+};
+
+static const xStField st_apu[] = {
+	ST_TAIL(ST_KEEP, nesAPU, mrd),
+	ST_END
+};
+
+static const xStField st_ppi[] = {
+	ST_RNG(ST_KEEP, PPI, a.rd, b),
+	ST_RNG(ST_KEEP, PPI, b.rd, ch),
+	ST_RNG(ST_KEEP, PPI, ch.rd, cl),
+	ST_RNG(ST_KEEP, PPI, cl.rd, ctrl),
+	ST_FLD(ST_KEEP, PPI, ptr),
+	ST_END
+};
+
+static const xStField st_cia[] = {
+	ST_RNG(ST_KEEP, CIA, pard, xirqn),
+	ST_END
+};
+
+static const xStField st_pit[] = {
+	ST_FLD(ST_SPTR, PIT, ch0.cb),
+	ST_FLD(ST_SPTR, PIT, ch1.cb),
+	ST_FLD(ST_SPTR, PIT, ch2.cb),
+	ST_TAIL(ST_KEEP, PIT, xirq),
+	ST_END
+};
+
+static const xStField st_pic[] = {
+	ST_TAIL(ST_KEEP, PIC, xirq),
+	ST_END
+};
+
+static const xStField st_ps2c[] = {
+	ST_RNG(ST_KEEP, PS2Ctrl, uarta, ram),
+	ST_END
+};
+
+static const xStField st_dma[] = {
+	ST_RNG(ST_KEEP, i8237DMA, ch[0].rd, ch[1]),
+	ST_RNG(ST_KEEP, i8237DMA, ch[1].rd, ch[2]),
+	ST_RNG(ST_KEEP, i8237DMA, ch[2].rd, ch[3]),
+	ST_RNG(ST_KEEP, i8237DMA, ch[3].rd, state),
+	ST_FLD(ST_KEEP, i8237DMA, ptr),
+	ST_END
+};
+
+static const xStField st_rtc[] = {
+	ST_TAIL(ST_KEEP, upd4990, xirq),
+	ST_END
+};
+
+static const xStField st_uart[] = {
+	ST_RNG(ST_KEEP, UART, devrd, irqn),
+	ST_RNG(ST_KEEP, UART, xirq, datar),
+	ST_END
+};
+
+// chunks
+
+enum {
+	ST_OBJ = 0,	// structure
+	ST_MEM		// Memory: ram (configured size) + contention mask
+};
+
+typedef struct {
+	char id[4];
+	int kind;
+	void* ptr;
+	int size;
+	const xStField* fld;
+} xStItem;
+
+#define ST_MAXITEMS	64
+
+static void st_add(xStItem* tab, int* cnt, const char* id, int kind, void* ptr, int size, const xStField* fld) {
+	if (!ptr) return;
+	xStItem* itm = &tab[*cnt];
+	memcpy(itm->id, id, 4);
+	itm->kind = kind;
+	itm->ptr = ptr;
+	itm->size = size;
+	itm->fld = fld;
+	(*cnt)++;
+}
+
+#define ST_ADD(_id, _p, _t, _f) st_add(tab, &cnt, _id, ST_OBJ, _p, sizeof(_t), _f)
+
+// NOTE: keyboard, mouse, joystick are host input, they are not saved
+static int st_items(Computer* comp, xStItem* tab) {
+	int cnt = 0;
+	ST_ADD("COMP", comp, Computer, st_comp);
+	ST_ADD("CPU ", comp->cpu, CPU, st_cpu);
+	st_add(tab, &cnt, "RAM ", ST_MEM, comp->mem, 0, NULL);
+	ST_ADD("VID ", comp->vid, Video, st_vid);
+	ST_ADD("ULA+", comp->vid->ula, ulaPlus, st_none);
+	ST_ADD("TXT7", comp->vid->txt7220, upd7220, st_none);
+	ST_ADD("GRF7", comp->vid->grf7220, upd7220, st_none);
+	ST_ADD("TAPE", comp->tape, Tape, st_tape);
+	ST_ADD("DIF ", comp->dif, DiskIF, st_dif);
+	ST_ADD("FDC0", comp->dif->fdc, FDC, st_fdc);
+	ST_ADD("FDC1", comp->dif->fdc2, FDC, st_fdc);
+	ST_ADD("FLP0", comp->dif->flp[0], Floppy, st_flp);
+	ST_ADD("FLP1", comp->dif->flp[1], Floppy, st_flp);
+	ST_ADD("FLP2", comp->dif->flp[2], Floppy, st_flp);
+	ST_ADD("FLP3", comp->dif->flp[3], Floppy, st_flp);
+	ST_ADD("IDE ", comp->ide, IDE, st_ide);
+	ST_ADD("ATA0", comp->ide->master, ATADev, st_ata);
+	ST_ADD("ATA1", comp->ide->slave, ATADev, st_ata);
+	ST_ADD("NVRM", comp->ide->smuc.nv, nvRam, st_none);
+	ST_ADD("SDC ", comp->sdc, SDCard, st_sdc);
+	ST_ADD("SLOT", comp->slot, xCartridge, st_slot);
+	ST_ADD("BEEP", comp->beep, bitChan, st_none);
+	ST_ADD("TS  ", comp->ts, TSound, st_ts);
+	ST_ADD("AY 0", comp->ts->chipA, aymChip, st_aym);
+	ST_ADD("AY 1", comp->ts->chipB, aymChip, st_aym);
+	ST_ADD("AY 2", comp->ts->chipC, aymChip, st_aym);
+	ST_ADD("AY 3", comp->ts->chipD, aymChip, st_aym);
+	ST_ADD("GS  ", comp->gs, GSound, st_gs);
+	if (comp->gs->enable) {
+		ST_ADD("GCPU", comp->gs->cpu, CPU, st_cpu);
+		st_add(tab, &cnt, "GRAM", ST_MEM, comp->gs->mem, 0, NULL);
+	}
+	ST_ADD("SDRV", comp->sdrv, SDrive, st_none);
+	ST_ADD("SAA ", comp->saa, saaChip, st_none);
+	ST_ADD("GBS ", comp->gbsnd, gbSound, st_none);
+	ST_ADD("APU ", comp->nesapu, nesAPU, st_apu);
+	ST_ADD("PPI0", comp->ppi, PPI, st_ppi);
+	ST_ADD("PPI1", comp->ppib, PPI, st_ppi);
+	ST_ADD("CIA0", comp->cia1, CIA, st_cia);
+	ST_ADD("CIA1", comp->cia2, CIA, st_cia);
+	ST_ADD("PIT ", comp->pit, PIT, st_pit);
+	ST_ADD("PIC0", comp->mpic, PIC, st_pic);
+	ST_ADD("PIC1", comp->spic, PIC, st_pic);
+	ST_ADD("PS2C", comp->ps2c, PS2Ctrl, st_ps2c);
+	ST_ADD("DMA0", comp->dma1, i8237DMA, st_dma);
+	ST_ADD("DMA1", comp->dma2, i8237DMA, st_dma);
+	ST_ADD("RTC ", comp->rtc, upd4990, st_rtc);
+	ST_ADD("UART", comp->uart, UART, st_uart);
+	return cnt;
+}
+
+// static pointers are saved as ids: (list << 16) | (index + 1), 0 = NULL
+// lists are kept by modules next to the code, so ids don't depend on build. lists and their items are append only
+
+static void** st_ptrs[] = {
+	x86_state_ptrs,
+	vdp_state_ptrs,
+	gbcv_state_ptrs,
+	vg93_state_ptrs,
+	upd765_state_ptrs,
+	vp1_128_state_ptrs,
+	pit_state_ptrs,
+	NULL
+};
+
+static int st_ptr_id(void* p) {
+	int l, i;
+	if (!p) return 0;
+	for (l = 0; st_ptrs[l]; l++) {
+		for (i = 0; st_ptrs[l][i]; i++) {
+			if (st_ptrs[l][i] == p)
+				return (l << 16) | (i + 1);
+		}
+	}
+	printf("state: unlisted static pointer %p\n", p);
+	return -1;
+}
+
+// return 0 if id is wrong
+static int st_id_ptr(int id, void** p) {
+	int l, i;
+	*p = NULL;
+	if (!id) return 1;
+	if ((id < 0) || !(id & 0xffff)) return 0;
+	for (l = 0; st_ptrs[l] && (l < (id >> 16)); l++);
+	if (!st_ptrs[l]) return 0;
+	for (i = 0; st_ptrs[l][i] && (i < (id & 0xffff) - 1); i++);
+	*p = st_ptrs[l][i];
+	return (*p != NULL);
+}
+
+// format key: structures layout (sizes and listed fields of all items). the same for any build with the same layout
+static long long st_key(const xStItem* tab, int cnt) {
+	uint64_t h = 0xcbf29ce484222325ULL;		// FNV-1a
+	const xStField* fld;
+	int v[4];
+	int i, k;
+	unsigned char* b;
+	for (i = 0; i < cnt; i++) {
+		v[0] = tab[i].kind;
+		v[1] = tab[i].size;
+		for (k = 0; k < 8; k++) {
+			b = (k < 4) ? (unsigned char*)tab[i].id + k : (unsigned char*)v + (k - 4);
+			h = (h ^ *b) * 0x100000001b3ULL;
+		}
+		for (fld = tab[i].fld; fld && fld->type; fld++) {
+			v[0] = fld->type;
+			v[1] = fld->off;
+			v[2] = fld->size;
+			v[3] = fld->base;
+			for (k = 0; k < (int)sizeof(v); k++)
+				h = (h ^ ((unsigned char*)v)[k]) * 0x100000001b3ULL;
+		}
+	}
+	return (long long)h;
+}
+
+typedef struct {
+	char sign[4];
+	int version;
+	long long key;		// format key (see st_key)
+	char hw[32];		// hardware name
+} xStHead;
+
+// writing
+
+static void st_put(xStateBuf* buf, const void* src, int len) {
+	if (len < 1) return;
+	if (buf->len + len > buf->size) {
+		buf->size = (buf->len + len) * 2;
+		buf->data = realloc(buf->data, buf->size);
+	}
+	memcpy(buf->data + buf->len, src, len);
+	buf->len += len;
+}
+
+static int st_trim(const unsigned char* ptr, int len) {
+	uint64_t w;
+	while (len >= 8) {
+		memcpy(&w, ptr + len - 8, 8);
+		if (w) break;
+		len -= 8;
+	}
+	while ((len > 0) && !ptr[len - 1])
+		len--;
+	return len;
+}
+
+static void st_save_obj(xStateBuf* buf, const xStItem* itm) {
+	unsigned char* obj = (unsigned char*)itm->ptr;
+	const xStField* fld;
+	int pos = 0;
+	int len;
+	long long v;
+	char* p;
+	char* b;
+	int i;
+	st_put(buf, &itm->size, sizeof(int));
+	for (fld = itm->fld; fld->type; fld++) {
+		st_put(buf, obj + pos, fld->off - pos);
+		switch (fld->type) {
+			case ST_DATA:
+				len = st_trim(obj + fld->off, fld->size);
+				st_put(buf, &len, sizeof(int));
+				st_put(buf, obj + fld->off, len);
+				break;
+			case ST_SPTR:
+				memcpy(&p, obj + fld->off, sizeof(void*));
+				v = st_ptr_id(p);
+				st_put(buf, &v, sizeof(v));
+				break;
+			case ST_REF:
+				memcpy(&p, obj + fld->off, sizeof(void*));
+				v = p ? -2 : -1;		// -1:NULL, -2:not in array (keep current)
+				for (i = 0; p && (i < fld->cnt); i++) {
+					memcpy(&b, obj + fld->base + i * sizeof(void*), sizeof(void*));
+					if (b == p) {
+						v = i;
+						break;
+					}
+				}
+				st_put(buf, &v, sizeof(v));
+				break;
+			case ST_IPTR:
+				memcpy(&p, obj + fld->off, sizeof(void*));
+				memcpy(&b, obj + fld->base, sizeof(void*));
+				v = p - b;
+				st_put(buf, &v, sizeof(v));
+				break;
+		}
+		pos = fld->off + fld->size;
+	}
+	st_put(buf, obj + pos, itm->size - pos);
+}
+
+// whole ram reachable by mask (zx48 has 64K ramSize, but 128K mask)
+static void st_save_mem(xStateBuf* buf, Memory* mem) {
+	int siz = mem->ramMask + 1;
+	st_put(buf, &siz, sizeof(int));
+	st_put(buf, &mem->contmask, sizeof(int));
+	st_put(buf, mem->ramData, siz);
+}
+
+// return size of state (bytes)
+int comp_state_save(Computer* comp, xStateBuf* buf, int flags) {
+	xStItem tab[ST_MAXITEMS];
+	xStHead hd;
+	int cnt = st_items(comp, tab);
+	int i;
+	int pos;
+	int len;
+	vid_flush(comp->vid);		// draw pending dots: there is no 'pending' in state
+	gs_wait(comp->gs);		// gs worker must be stopped at current time
+	buf->len = 0;
+	memset(&hd, 0x00, sizeof(xStHead));
+	memcpy(hd.sign, "XPST", 4);
+	hd.version = XST_VERSION;
+	hd.key = st_key(tab, cnt);
+	strncpy(hd.hw, comp->hw->name, sizeof(hd.hw) - 1);
+	st_put(buf, &hd, sizeof(xStHead));
+	for (i = 0; i < cnt; i++) {
+		if ((tab[i].kind == ST_MEM) && (flags & XST_NORAM)) continue;
+		st_put(buf, tab[i].id, 4);
+		pos = buf->len;
+		st_put(buf, &pos, sizeof(int));		// size placeholder
+		if (tab[i].kind == ST_MEM) {
+			st_save_mem(buf, (Memory*)tab[i].ptr);
+		} else {
+			st_save_obj(buf, &tab[i]);
+		}
+		len = buf->len - pos - sizeof(int);
+		memcpy(buf->data + pos, &len, sizeof(int));
+	}
+	return buf->len;
+}
+
+void comp_state_free(xStateBuf* buf) {
+	if (buf->data) free(buf->data);
+	buf->data = NULL;
+	buf->size = 0;
+	buf->len = 0;
+}
+
+// reading
+
+typedef struct {
+	unsigned char* data;
+	int len;
+	int pos;
+} xStReader;
+
+static int st_get(xStReader* rd, void* dst, int len, int apply) {
+	if (len < 0) return 0;
+	if (rd->pos + len > rd->len) return 0;
+	if (apply && dst && len)
+		memcpy(dst, rd->data + rd->pos, len);
+	rd->pos += len;
+	return 1;
+}
+
+// apply = 0 : check only
+static int st_load_obj(xStReader* rd, const xStItem* itm, int apply) {
+	unsigned char* obj = (unsigned char*)itm->ptr;
+	const xStField* fld;
+	int pos = 0;
+	int len;
+	long long v;
+	char* p;
+	if (!st_get(rd, &len, sizeof(int), 1)) return 0;
+	if (len != itm->size) return 0;				// other layout
+	for (fld = itm->fld; fld->type; fld++) {
+		if (!st_get(rd, obj + pos, fld->off - pos, apply)) return 0;
+		switch (fld->type) {
+			case ST_DATA:
+				if (!st_get(rd, &len, sizeof(int), 1)) return 0;
+				if ((len < 0) || (len > fld->size)) return 0;
+				if (!st_get(rd, obj + fld->off, len, apply)) return 0;
+				if (apply) memset(obj + fld->off + len, 0x00, fld->size - len);
+				break;
+			case ST_SPTR:
+				if (!st_get(rd, &v, sizeof(v), 1)) return 0;
+				if ((v < INT32_MIN) || (v > INT32_MAX) || !st_id_ptr((int)v, (void**)&p)) return 0;
+				if (apply) memcpy(obj + fld->off, &p, sizeof(void*));
+				break;
+			case ST_REF:
+				if (!st_get(rd, &v, sizeof(v), 1)) return 0;
+				if (v >= fld->cnt) return 0;
+				if (!apply || (v == -2)) break;
+				if (v < 0) {
+					p = NULL;
+				} else {
+					memcpy(&p, obj + fld->base + v * sizeof(void*), sizeof(void*));
+				}
+				memcpy(obj + fld->off, &p, sizeof(void*));
+				break;
+			case ST_IPTR:
+				if (!st_get(rd, &v, sizeof(v), 1)) return 0;
+				if (!apply) break;
+				memcpy(&p, obj + fld->base, sizeof(void*));
+				p += v;
+				memcpy(obj + fld->off, &p, sizeof(void*));
+				break;
+		}
+		pos = fld->off + fld->size;
+	}
+	return st_get(rd, obj + pos, itm->size - pos, apply);
+}
+
+static int st_load_mem(xStReader* rd, Memory* mem, int apply) {
+	int siz;
+	int mask;
+	if (!st_get(rd, &siz, sizeof(int), 1)) return 0;
+	if (!st_get(rd, &mask, sizeof(int), 1)) return 0;
+	if (siz != mem->ramMask + 1) return 0;
+	if (!st_get(rd, mem->ramData, siz, apply)) return 0;
+	if (apply) mem->contmask = mask;
+	return 1;
+}
+
+static int st_load_chunks(xStReader* rd, xStItem* tab, int cnt, int apply) {
+	xStReader chk;
+	char id[4];
+	int len;
+	int i;
+	int res = 1;
+	while (res && (rd->pos < rd->len)) {
+		if (!st_get(rd, id, 4, 1)) return 0;
+		if (!st_get(rd, &len, sizeof(int), 1)) return 0;
+		chk.data = rd->data + rd->pos;
+		chk.len = len;
+		chk.pos = 0;
+		if (!st_get(rd, NULL, len, 0)) return 0;
+		for (i = 0; (i < cnt) && memcmp(tab[i].id, id, 4); i++);
+		if (i >= cnt) continue;			// unknown chunk: skip it
+		if (tab[i].kind == ST_MEM) {
+			res = st_load_mem(&chk, (Memory*)tab[i].ptr, apply);
+		} else {
+			res = st_load_obj(&chk, &tab[i], apply);
+		}
+		res = res && (chk.pos == chk.len);
+	}
+	return res;
+}
+
+// return 1 if state loaded, 0 if it doesn't fit this build/machine (nothing changed then)
+int comp_state_load(Computer* comp, unsigned char* data, int len) {
+	xStItem tab[ST_MAXITEMS];
+	xStReader rd;
+	xStHead hd;
+	int cnt = st_items(comp, tab);
+	bool brk = comp->flgBRK;
+	bool dbg = comp->flgDBG;
+	bool map = comp->flgMAP;
+	rd.data = data;
+	rd.len = len;
+	rd.pos = 0;
+	gs_wait(comp->gs);
+	if (!st_get(&rd, &hd, sizeof(xStHead), 1)) return 0;
+	if (memcmp(hd.sign, "XPST", 4) || (hd.version != XST_VERSION) || (hd.key != st_key(tab, cnt))) return 0;
+	if (strncmp(hd.hw, comp->hw->name, sizeof(hd.hw) - 1)) return 0;
+	if (!st_load_chunks(&rd, tab, cnt, 0)) return 0;
+	rd.pos = sizeof(xStHead);
+	st_load_chunks(&rd, tab, cnt, 1);
+	// debugger flags belong to host
+	comp->flgBRK = brk;
+	comp->flgDBG = dbg;
+	comp->flgMAP = map;
+	// rebuild derived things
+	if (comp->tape->block >= comp->tape->blkCount) {
+		comp->tape->block = 0;
+		comp->tape->pos = 0;
+		comp->tape->on = 0;
+	}
+	comp->vid->ctkey = -1;
+	vid_upd_core(comp->vid);
+	comp->hw->mapMem(comp);
+	if (comp->gs->enable)
+		gsMapMem(comp->gs);
+	comp_upd_fast(comp);
+	return 1;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "spectrum.h"
+
+// full machine state (versioned, chunked, host layout)
+// header: "XPST", version, format key, hw name. then chunks: id[4], size, data
+// state is bound to structures layout (format key, any build with the same layout fits) and machine config
+// (hw, devices types, ram size). pointers to static code/data are saved as ids from modules lists.
+// media (disk/tape/hdd/cartridge images) and host input devices are not part of state.
+
+#define XST_VERSION	2
+
+// comp_state_save flags
+#define XST_NORAM	1	// don't save RAM chunks (load keeps current RAM then)
+
+typedef struct {
+	unsigned char* data;
+	int size;		// allocated
+	int len;		// used
+} xStateBuf;
+
+int comp_state_save(Computer*, xStateBuf*, int);
+int comp_state_load(Computer*, unsigned char*, int);
+void comp_state_free(xStateBuf*);
+
+#ifdef __cplusplus
+}
+#endif
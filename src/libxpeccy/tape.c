@@ -22,10 +22,8 @@ Tape* tape_create(cbirq cb, void* p) {
 }
 
 void tape_destroy(Tape* tap) {
-	if (tap->path) free(tap->path);
-	tapEject(tap);
-	if (tap->tmpBlock.data)
-		free(tap->tmpBlock.data);
+	tapEject(tap);		// frees path too
+	blkClear(&tap->tmpBlock);
 	free(tap);
 }
 
@@ -41,11 +39,102 @@ void tape_set_path(Tape* tap, const char* path) {
 
 // blocks
 
-void blkClear(TapeBlock *blk) {
-	if (blk->data) {
-		free(blk->data);
-		blk->data = NULL;
+static void blk_free_data(TapeData* td) {
+	if (!td) return;
+	free(td->run);
+	free(td->bits);
+	free(td);
+}
+
+static TapeData* blk_copy_data(TapeData* td) {
+	TapeData* res;
+	if (!td) return NULL;
+	res = malloc(sizeof(TapeData));
+	*res = *td;
+	res->cur = 0;
+	res->run = malloc(td->count * sizeof(TapeRun) + 1);
+	memcpy(res->run, td->run, td->count * sizeof(TapeRun));
+	res->bits = malloc((td->bitCount >> 3) + 1);
+	if (td->bits)
+		memcpy(res->bits, td->bits, td->bitCount >> 3);
+	return res;
+}
+
+static TapeRun* blk_last_run(TapeBlock* blk) {
+	return (blk->data && (blk->data->count > 0)) ? &blk->data->run[blk->data->count - 1] : NULL;
+}
+
+static TapeRun* blk_new_run(TapeBlock* blk) {
+	TapeData* td = blk->data;
+	TapeRun* run;
+	if (!td) {
+		td = calloc(1, sizeof(TapeData));
+		blk->data = td;
 	}
+	if ((td->count & 0xff) == 0) {
+		td->run = realloc(td->run, (td->count + 0x100) * sizeof(TapeRun));	// allocate mem for next 0x100 runs
+	}
+	run = &td->run[td->count++];
+	memset(run, 0x00, sizeof(TapeRun));
+	run->pos = blk->sigCount;
+	return run;
+}
+
+// total block time (ticks)
+static long long blk_ticks(TapeBlock* blk) {
+	TapeData* td = blk->data;
+	TapeRun* run;
+	long long res = 0;
+	int i, b, ones;
+	if (!td) return 0;
+	for (i = 0; i < td->count; i++) {
+		run = &td->run[i];
+		if (run->size1) {
+			ones = 0;
+			for (b = run->boff; b < run->boff + (run->count >> 1); b++) {
+				if (td->bits[b >> 3] & (0x80 >> (b & 7)))
+					ones++;
+			}
+			res += (long long)ones * 2 * run->size1 + (long long)((run->count >> 1) - ones) * 2 * run->size;
+		} else {
+			res += (long long)run->count * run->size;
+		}
+	}
+	return res;
+}
+
+// drop last signal
+static void blk_del_last(TapeBlock* blk) {
+	TapeRun* run = blk_last_run(blk);
+	if (!run) return;
+	run->count--;
+	if (run->count < 1)
+		blk->data->count--;
+	blk->sigCount--;
+}
+
+// make last signal longer, return its new size
+static unsigned int blk_grow_last(TapeBlock* blk, int len) {
+	TapeRun* run = blk_last_run(blk);
+	TapeSignal sig;
+	if (!run) return 0;
+	if (!run->size1 && (run->count == 1)) {
+		run->size += len;
+		return run->size;
+	}
+	sig = blkGetSignal(blk, blk->sigCount - 1);
+	blk_del_last(blk);
+	run = blk_new_run(blk);
+	run->size = sig.size + len;
+	run->vol[0] = sig.vol;
+	run->count = 1;
+	blk->sigCount++;
+	return run->size;
+}
+
+void blkClear(TapeBlock *blk) {
+	blk_free_data(blk->data);
+	blk->data = NULL;
 	blk->breakPoint = 0;
 	blk->isHeader = 0;
 	blk->hasBytes = 0;
@@ -53,15 +142,60 @@ void blkClear(TapeBlock *blk) {
 	blk->dataPos = -1;
 }
 
+// signal #pos of block
+TapeSignal blkGetSignal(TapeBlock* blk, int pos) {
+	TapeSignal sig = {0, 0x80};
+	TapeData* td = blk->data;
+	TapeRun* run;
+	int lo, hi, mid;
+	int bit;
+	if (!td || (pos < 0) || (pos >= blk->sigCount)) return sig;
+	// reading is sequential mostly: check current and next runs first
+	lo = td->cur;
+	if ((lo >= td->count) || (pos < td->run[lo].pos)) {
+		lo = 0;
+	} else if ((pos >= td->run[lo].pos + td->run[lo].count) && (lo + 1 < td->count)) {
+		lo++;
+	}
+	run = &td->run[lo];
+	if ((pos < run->pos) || (pos >= run->pos + run->count)) {
+		lo = 0;
+		hi = td->count - 1;
+		while (lo < hi) {
+			mid = (lo + hi + 1) >> 1;
+			if (td->run[mid].pos <= pos) {
+				lo = mid;
+			} else {
+				hi = mid - 1;
+			}
+		}
+		run = &td->run[lo];
+	}
+	td->cur = lo;
+	pos -= run->pos;
+	sig.vol = run->vol[pos & 1];
+	sig.size = run->size;
+	if (run->size1) {
+		bit = run->boff + (pos >> 1);
+		if (td->bits[bit >> 3] & (0x80 >> (bit & 7)))
+			sig.size = run->size1;
+	}
+	return sig;
+}
+
 // add signal (1 level change)
 void blkAddPulse(TapeBlock* blk, int len, int vol) {
-	if ((blk->sigCount & 0xffff) == 0) {
-		blk->data = realloc(blk->data,(blk->sigCount + 0x10000) * sizeof(TapeSignal));	// allocate mem for next 0x10000 signals
-	}
+	TapeRun* run = blk_last_run(blk);
 	if (vol < 0)
 		vol = blk->vol ? 0xb0 : 0x50;
-	blk->data[blk->sigCount].size = len;
-	blk->data[blk->sigCount].vol = vol & 0xff;
+	vol &= 0xff;
+	// continue last run if it's same pulses with same levels
+	if (!run || run->size1 || (run->size != (unsigned int)len) || ((run->count > 1) && (run->vol[run->count & 1] != vol))) {
+		run = blk_new_run(blk);
+		run->size = len;
+	}
+	run->vol[run->count & 1] = vol;
+	run->count++;
 	blk->vol = (vol & 0x80) ? 0 : 1;
 	blk->sigCount++;
 }
@@ -81,25 +215,48 @@ void blkAddWave(TapeBlock* blk, int len) {
 
 // add byte. b0len/b1len = duration of 0/1 bits. When 0, it takes from block signals data
 void blkAddByte(TapeBlock* blk, unsigned char data, int b0len, int b1len) {
+	TapeRun* run;
+	TapeData* td;
+	int vol;
 	if (b0len == 0) b0len = blk->len0;
 	if (b1len == 0) b1len = blk->len1;
-	for (int i = 0; i < 8; i++) {
-		blkAddWave(blk, (data & 0x80) ? b1len : b0len);
-		data <<= 1;
+	if ((b0len == b1len) || (b0len < 1) || (b1len < 1)) {
+		for (int i = 0; i < 8; i++) {
+			blkAddWave(blk, (data & 0x80) ? b1len : b0len);
+			data <<= 1;
+		}
+		return;
+	}
+	// bits run: 2 pulses per bit, levels are vol,~vol for each bit
+	vol = blk->vol ? 0xb0 : 0x50;
+	run = blk_last_run(blk);
+	if (!run || (run->size != (unsigned int)b0len) || (run->size1 != (unsigned int)b1len) || (run->vol[0] != vol)) {
+		run = blk_new_run(blk);
+		run->size = b0len;
+		run->size1 = b1len;
+		run->boff = blk->data->bitCount;
+		run->vol[0] = vol;
+		run->vol[1] = vol ^ 0xe0;
 	}
+	td = blk->data;
+	if ((td->bitCount & 0x7fff) == 0) {
+		td->bits = realloc(td->bits, (td->bitCount >> 3) + 0x1000);
+	}
+	td->bits[td->bitCount >> 3] = data;
+	td->bitCount += 8;
+	run->count += 16;
+	blk->sigCount += 16;
 }
 
 // current time in block
 // NOTE: not full time of block
 int tapGetBlockTime(Tape* tape, int blk, int pos) {
-	long totsz = 0;
-	int i;
+	long long totsz;
 	if (pos > tape->blkData[blk].sigCount)
 		pos = tape->blkData[blk].sigCount;
 	else if (pos < 0)
 		pos = tape->blkData[blk].sigCount;
-	for (i = 0; i < tape->blkData[blk].sigCount; i++)
-		totsz += tape->blkData[blk].data[i].size;
+	totsz = blk_ticks(&tape->blkData[blk]);
 	return (totsz / TAPTPS);			// mks -> sec
 }
 
@@ -123,7 +280,7 @@ unsigned char tapGetBlockByte(TapeBlock* block, int bytePos) {
 	for (i = 0; i < 8; i++) {
 		res <<= 1;
 		if (sigPos < (int)(block->sigCount - 1)) {
-			if ((block->data[sigPos].size == block->len1) && (block->data[sigPos + 1].size == block->len1)) {
+			if ((blkGetSignal(block, sigPos).size == block->len1) && (blkGetSignal(block, sigPos + 1).size == block->len1)) {
 				res |= 1;
 			}
 			sigPos += 2;
@@ -194,17 +351,26 @@ int tapGetBlocksInfo(Tape* tap, TapeBlockInfo* dst, int type) {
 	return cnt;
 }
 
+static unsigned int tap_norm_len(TapeBlock* block, unsigned int size) {
+	int low = size - 3;
+	int hi = size + 3;
+	if ((block->plen > low) && (block->plen < hi)) size = block->plen;
+	if ((block->s1len > low) && (block->s1len < hi)) size = block->s1len;
+	if ((block->s2len > low) && (block->s2len < hi)) size = block->s2len;
+	if ((block->len0 > low) && (block->len0 < hi)) size = block->len0;
+	if ((block->len1 > low) && (block->len1 < hi)) size = block->len1;
+	return size;
+}
+
 void tapNormSignals(TapeBlock* block) {
-	int low,hi;
+	TapeRun* run;
 	int i;
-	for (i = 0; i < (int)block->sigCount; i++) {
-		low = block->data[i].size - 3;
-		hi = block->data[i].size + 3;
-		if ((block->plen > low) && (block->plen < hi)) block->data[i].size = block->plen;
-		if ((block->s1len > low) && (block->s1len < hi)) block->data[i].size = block->s1len;
-		if ((block->s2len > low) && (block->s2len < hi)) block->data[i].size = block->s2len;
-		if ((block->len0 > low) && (block->len0 < hi)) block->data[i].size = block->len0;
-		if ((block->len1 > low) && (block->len1 < hi)) block->data[i].size = block->len1;
+	if (!block->data) return;
+	for (i = 0; i < block->data->count; i++) {
+		run = &block->data->run[i];
+		run->size = tap_norm_len(block, run->size);
+		if (run->size1)
+			run->size1 = tap_norm_len(block, run->size1);
 	}
 }
 
@@ -219,10 +385,8 @@ void tapSwapBlocks(Tape* tap, int b1, int b2) {
 void tapDelBlock(Tape* tap, int blk) {
 	if (blk < tap->blkCount) {
 		int idx = blk;
-		if (tap->blkData[idx].data) {
-			free(tap->blkData[idx].data);
-			tap->blkData[idx].data = NULL;
-		}
+		blk_free_data(tap->blkData[idx].data);
+		tap->blkData[idx].data = NULL;
 		while (idx < tap->blkCount - 1) {
 			tap->blkData[idx] = tap->blkData[idx+1];
 			idx++;
@@ -235,32 +399,37 @@ void tapDelBlock(Tape* tap, int blk) {
 
 // FIXME: non-zx must skip this part (do only tapAddBlock + blkClear + wait=1)
 void tapStoreBlock(Tape* tap) {
-	unsigned int i,j;
+	unsigned int i,j,k;
 	int same;
 	int diff;
 	int siglens[11];
+	unsigned int size;
+	TapeRun* run;
 	for (i = 0; i < 11; i++) siglens[i]=0;
 	int cnt = 0;
 	TapeBlock* tblk = &tap->tmpBlock;
 	if (tblk->sigCount < 1) return;
 	if (!tblk->data) return;
-	for (i = 0; i < tblk->sigCount; i++) {
-		same = 0;
-		for (j = 0; j < cnt; j++) {
-			if (siglens[j] > 0) {
-//				printf("%i %i %p %i\n",i,j,tblk->data,tblk->data->size);
-				diff = (tblk->data[i].size - siglens[j]) * 100 / siglens[j];
-//				printf("%i\n",diff);
-				if ((diff > -5) && (diff < 5)) {
+	// all pulses in run have same length (or one of two for bits run)
+	for (i = 0; i < tblk->data->count; i++) {
+		run = &tblk->data->run[i];
+		for (k = 0; k < (run->size1 ? 2 : 1); k++) {
+			size = k ? run->size1 : run->size;
+			same = 0;
+			for (j = 0; j < cnt; j++) {
+				if (siglens[j] > 0) {
+					diff = (size - siglens[j]) * 100 / siglens[j];
+					if ((diff > -5) && (diff < 5)) {
+						same = 1;
+					}
+				} else {
 					same = 1;
 				}
-			} else {
-				same = 1;
 			}
-		}
-		if ((same == 0) && (cnt < 10)) {
-			siglens[cnt] = tblk->data[i].size;
-			cnt++;
+			if ((same == 0) && (cnt < 10)) {
+				siglens[cnt] = size;
+				cnt++;
+			}
 		}
 	}
 //	tblk->data[tblk->sigCount-1].size = 1e6;		// last signal is 1 sec (pause)
@@ -303,7 +472,7 @@ void tapStoreBlock(Tape* tap) {
 #if 1
 	tapNormSignals(tblk);
 	i = 1;
-	while ((i < tblk->sigCount) && (tblk->data[i].size != tblk->s2len))
+	while ((i < tblk->sigCount) && (blkGetSignal(tblk, i).size != tblk->s2len))
 		i++;
 	if (i < tblk->sigCount)
 		tblk->dataPos = i + 1;
@@ -326,15 +495,14 @@ void tapEject(Tape* tap) {
 	tape_set_path(tap, NULL);
 	if (tap->blkData) {
 		for (i = 0; i < tap->blkCount; i++) {
-			if (tap->blkData[i].data) {
-				free(tap->blkData[i].data);
-				tap->blkData[i].data = NULL;
-			}
+			blk_free_data(tap->blkData[i].data);
+			tap->blkData[i].data = NULL;
 		}
 		free(tap->blkData);
 	}
 	tap->blkCount = 0;
 	tap->blkData = NULL;
+	tap->due = 0;
 }
 
 void tapStop(Tape* tap) {
@@ -343,6 +511,7 @@ void tapStop(Tape* tap) {
 		if (tap->rec)
 			tapStoreBlock(tap);
 		tap->volPlay = (tap->volPlay & 0x80) ? 0x7f : 0x81;
+		tap->due = 0;
 		//tap->volPlay = 0x80;
 		// tap->pos = 0;
 	}
@@ -354,6 +523,7 @@ int tapPlay(Tape* tap) {
 		tap->on = 1;
 		tap->blkData[tap->block].vol = 0;
 		tap->sigLen = TAPTPS / 2;	// .5 sec
+		tap->due = 0;
 		// tap->volPlay = (tap->volPlay & 0x80) ? 0x7f : 0x81;
 	}
 	return tap->on;
@@ -365,6 +535,7 @@ void tapRec(Tape* tap) {
 	tap->wait = 1;
 	tap->levRec = 1;
 	tap->oldRec = 1;
+	tap->due = 0;
 	blkClear(&tap->tmpBlock);
 }
 
@@ -375,12 +546,23 @@ void tapRewind(Tape* tap, int blk) {
 	} else {
 		tap->on = 0;
 	}
+	tap->due = 0;
+}
+
+// ns until current signal ends (tapSync has nothing to do before). 0 if tape must be synced each time (recording)
+int tapNextEdge(Tape* tap) {
+	if (tap->rec || (tap->due < 1) || (tap->speed < 1)) return 0;
+	if (tap->time >= tap->due) return 0;
+	return (long long)(tap->due - tap->time) * 100 / tap->speed;
 }
 
 void tapSync(Tape* tap, int ns) {
 	tap->time += (ns * tap->speed / 100);
+	// nothing changes until current signal ends: just count time
+	if (!tap->rec && (tap->time < tap->due)) return;
 	int mks = tap->time / TAPTICKNS;
 	int sig;
+	TapeSignal nsig;
 	tap->time %= TAPTICKNS;
 	if (tap->on) {
 		if (tap->rec) {
@@ -395,9 +577,8 @@ void tapSync(Tape* tap, int ns) {
 					tap->oldRec = tap->levRec;
 					blkAddPulse(&tap->tmpBlock,mks,-1);
 				} else if (tap->tmpBlock.sigCount > 0) {
-					tap->tmpBlock.data[tap->tmpBlock.sigCount - 1].size += mks;
-					if (tap->tmpBlock.data[tap->tmpBlock.sigCount - 1].size > TAPTPS / 5) {		// 20000 mks ~ .2sec
-						tap->tmpBlock.sigCount--;
+					if (blk_grow_last(&tap->tmpBlock, mks) > TAPTPS / 5) {		// 20000 mks ~ .2sec
+						blk_del_last(&tap->tmpBlock);
 						tapStoreBlock(tap);
 					}
 				}
@@ -417,8 +598,9 @@ void tapSync(Tape* tap, int ns) {
 					tap->xirq(IRQ_TAP_BLK, tap->xptr);
 				} else {
 					sig = tap->volPlay;
-					tap->sigLen += tap->blkData[tap->block].data[tap->pos].size;
-					tap->volPlay = tap->blkData[tap->block].data[tap->pos].vol;
+					nsig = blkGetSignal(&tap->blkData[tap->block], tap->pos);
+					tap->sigLen += nsig.size;
+					tap->volPlay = nsig.vol;
 					tap->pos++;
 					if (tap->xen && ((sig ^ tap->volPlay) & 0x80)) {	// signal changed
 						tap->xirq(tap->volPlay & 0x80 ? IRQ_TAP_1 : IRQ_TAP_0, tap->xptr);
@@ -442,12 +624,19 @@ void tapSync(Tape* tap, int ns) {
 			tap->sigLen += TAPTPS / 2; // 5e5;	// .5 sec
 		}
 	}
+	// next time to look at tape (long signals are split to keep it in range)
+	if (tap->rec || (tap->sigLen < 1)) {
+		tap->due = 0;
+	} else {
+		tap->due = ((tap->sigLen < TAPTPS / 2) ? tap->sigLen : TAPTPS / 2) * TAPTICKNS;
+	}
 }
 
 void tapNextBlock(Tape* tap) {
 	tap->block++;
 	tap->pos = 0;
 	tap->blkChange = 1;
+	tap->due = 0;
 	if (tap->block < tap->blkCount) {
 		tap->blkData[tap->block].vol = 0;
 		tap->volPlay = 0x7f;
@@ -531,13 +720,8 @@ void tapAddFile(Tape* tap, const char* nm, int tp, unsigned short st, unsigned s
 void tap_add_block(Tape* tap, TapeBlock block) {
 	if (block.sigCount == 0) return;
 	TapeBlock blk = block;
-	blk.data = malloc(blk.sigCount * sizeof(TapeSignal));
-	memcpy(blk.data, block.data, blk.sigCount * sizeof(TapeSignal));
-
-	blk.time = 0;
-	for (int i = 0; i < blk.sigCount; i++)
-		blk.time += blk.data[i].size;		// total time (ticks)
-	blk.time /= TAPTPS;				// seconds
+	blk.data = blk_copy_data(block.data);
+	blk.time = blk_ticks(&blk) / TAPTPS;		// total time (seconds)
 
 	tap->blkCount++;
 	tap->blkData = (TapeBlock*)realloc(tap->blkData,tap->blkCount * sizeof(TapeBlock));
@@ -49,6 +49,25 @@ typedef struct {
 	unsigned char vol;
 } TapeSignal;
 
+// block signals are stored as runs: pulses with same length (pilot, pauses, recorded data)
+// or bits (2 pulses per bit, length by bit value: blkAddByte). pulses levels alternate vol[0],vol[1]
+typedef struct {
+	int pos;		// 1st pulse number in block
+	int count;		// pulses in run
+	unsigned int size;	// pulse length. bits run: '0' pulse length
+	unsigned int size1;	// bits run: '1' pulse length, 0 for pulses run
+	int boff;		// bits run: 1st bit in TapeData::bits
+	unsigned char vol[2];	// even/odd pulses level
+} TapeRun;
+
+typedef struct {
+	int count;		// runs
+	int cur;		// last accessed run (for sequential reading)
+	TapeRun* run;
+	int bitCount;
+	unsigned char* bits;
+} TapeData;
+
 typedef struct {
 	unsigned breakPoint:1;
 	unsigned hasBytes:1;
@@ -65,7 +84,7 @@ typedef struct {
 	int sigCount;
 	int time;
 	int crc;
-	TapeSignal* data;
+	TapeData* data;
 } TapeBlock;
 
 typedef struct {
@@ -84,6 +103,7 @@ typedef struct {
 	int block;
 	int pos;
 	int sigLen;
+	int due;	// tapSync does nothing until time reaches it (next edge). 0 = recalculate
 	char* path;
 	TapeBlock tmpBlock;
 	int blkCount;
@@ -106,6 +126,7 @@ void tapStop(Tape*);
 void tapRewind(Tape*,int);
 
 void tapSync(Tape*,int);
+int tapNextEdge(Tape*);
 void tapNextBlock(Tape*);
 
 TapeBlockInfo tapGetBlockInfo(Tape*,int,int);
@@ -121,6 +142,7 @@ void tapAddFile(Tape*,const char*,int,unsigned short,unsigned short,unsigned sho
 TapeBlock makeTapeBlock(unsigned char*, int, int);
 
 void blkClear(TapeBlock*);
+TapeSignal blkGetSignal(TapeBlock*, int);
 void blkAddPulse(TapeBlock* blk, int len, int vol);
 void blkAddWave(TapeBlock*, int);
 void blkAddByte(TapeBlock*, unsigned char, int, int);
@@ -0,0 +1,300 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace.h"
+
+static unsigned char* trc_ptr(xTrace* trc, int idx) {
+	return trc->buf + idx * trc->head.recsize;
+}
+
+// visible registers and flags (flags are hidden in debuga register list, but are important for trace)
+static int trc_reg_size(CPU* cpu, xRegDsc* rd) {
+	if (!rd->get) return 0;
+	if (rd->id != REG_EMPTY) return rd->size;
+	if ((rd->flag & REG_TYPE_M) != REG_FLG) return 0;
+	return (cpu->core->databus > 8) ? REG_WORD : REG_BYTE;
+}
+
+static void trc_flush(xTrace* trc) {
+	if (trc->file && (trc->count > 0)) {
+		fwrite(trc->buf, trc->head.recsize, trc->count, trc->file);
+		trc->count = 0;
+		trc->pos = 0;
+	}
+}
+
+// path = NULL: ring of nrec last records, otherwise file (nrec = buffer size, 0 = default)
+// trace is attached to comp and recording starts at once
+xTrace* trc_create(Computer* comp, const char* path, int nrec) {
+	xTrace* trc;
+	xRegDsc* rd;
+	FILE* file = NULL;
+	int idx;
+	int sz;
+	if (path) {
+		file = fopen(path, "wb");
+		if (!file) return NULL;
+		if (nrec < 1) nrec = TRC_BUFREC;
+	}
+	if (nrec < 1) nrec = 1;
+	trc = (xTrace*)malloc(sizeof(xTrace));
+	memset(trc, 0x00, sizeof(xTrace));
+	trc->comp = comp;
+	trc->file = file;
+	trc->size = nrec;
+	memcpy(trc->head.magic, TRC_MAGIC, 4);
+	trc->head.version = TRC_VERSION;
+	trc->head.cputype = comp->cpu->core->type;
+	strncpy(trc->head.cpuname, comp->cpu->core->name, 31);
+	trc->head.regsize = 2;
+	rd = comp->cpu->core->rdsctab;
+	for (idx = 0; (rd[idx].id != REG_EOT) && (trc->head.nreg < TRC_MAXREG); idx++) {
+		sz = trc_reg_size(comp->cpu, &rd[idx]);
+		if (!sz) continue;
+		if (sz > REG_WORD)
+			trc->head.regsize = 4;
+		trc->rdsc[trc->head.nreg] = &rd[idx];
+		trc->head.regidx[trc->head.nreg] = idx;
+		trc->head.nreg++;
+	}
+	trc->head.recsize = sizeof(xTraceRec) + trc->head.nreg * trc->head.regsize;
+	trc->buf = malloc(trc->size * trc->head.recsize);
+	if (file)
+		fwrite(&trc->head, sizeof(xTraceHead), 1, file);
+	comp->trc = trc;
+	comp_upd_fast(comp);		// memory writes must go through memwr
+	return trc;
+}
+
+void trc_destroy(xTrace* trc) {
+	if (!trc) return;
+	if (trc->comp && (trc->comp->trc == trc)) {
+		trc->comp->trc = NULL;
+		comp_upd_fast(trc->comp);
+	}
+	if (trc->file) {
+		trc_flush(trc);
+		fclose(trc->file);
+	}
+	free(trc->buf);
+	free(trc);
+}
+
+// save ring to file, oldest record first. return 0 if failed
+int trc_save(xTrace* trc, const char* path) {
+	FILE* file;
+	int beg;
+	if (trc->file) return 0;
+	file = fopen(path, "wb");
+	if (!file) return 0;
+	fwrite(&trc->head, sizeof(xTraceHead), 1, file);
+	beg = (trc->pos - trc->count + trc->size) % trc->size;
+	if (beg + trc->count > trc->size) {
+		fwrite(trc_ptr(trc, beg), trc->head.recsize, trc->size - beg, file);
+		fwrite(trc->buf, trc->head.recsize, trc->pos, file);
+	} else {
+		fwrite(trc_ptr(trc, beg), trc->head.recsize, trc->count, file);
+	}
+	fclose(file);
+	return 1;
+}
+
+// recording
+
+// same as debugger view: no side effects, no breakpoints
+static int trc_mrd(Computer* comp, int adr) {
+	MemPage* pg;
+	int fadr;
+	int res = 0xff;
+	if (comp->cpu->core->group == CPUG_X86)
+		return comp->hw->mrd(comp, adr, 0) & 0xff;
+	adr &= comp->mem->busmask;
+	pg = mem_get_page(comp->mem, adr);
+	fadr = mem_get_phys_adr(comp->mem, adr);
+	switch (pg->type) {
+		case MEM_ROM: res = comp->mem->romData[fadr & comp->mem->romMask]; break;
+		case MEM_RAM: res = comp->mem->ramData[fadr & comp->mem->ramMask]; break;
+		case MEM_SLOT: res = memRd(comp->mem, adr); break;
+	}
+	return res;
+}
+
+// call before cpu_exec
+void trc_begin(xTrace* trc, Computer* comp) {
+	CPU* cpu = comp->cpu;
+	int i;
+	trc->rec.tick = comp->tickCount;
+	trc->rec.pc = cpu_get_pc(cpu) & 0xffff;
+	trc->rec.adr = cpu_get_pc(cpu) + cpu->cs.base;
+	trc->rec.flag = (cpu->intrq & cpu->inten) ? TRC_IRQ : 0;
+	trc->rec.nwr = 0;
+	for (i = 0; i < 8; i++)
+		trc->rec.op[i] = trc_mrd(comp, trc->rec.adr + i);
+	trc->act = 1;
+}
+
+void trc_mwr(xTrace* trc, int adr, int val) {
+	if (!trc->act) return;
+	if (trc->rec.nwr < TRC_MAXWR) {
+		trc->rec.wadr[trc->rec.nwr] = adr;
+		trc->rec.wval[trc->rec.nwr] = val & 0xff;
+	}
+	if (trc->rec.nwr < 0xff)
+		trc->rec.nwr++;
+}
+
+// call after cpu_exec, t = T eaten. registers are taken here (state after command)
+void trc_end(xTrace* trc, Computer* comp, int t) {
+	unsigned char* ptr = trc_ptr(trc, trc->pos);
+	unsigned short rw;
+	int rv;
+	int i;
+	trc->act = 0;
+	trc->rec.t = (t > 0xffff) ? 0xffff : t;
+	memcpy(ptr, &trc->rec, sizeof(xTraceRec));
+	ptr += sizeof(xTraceRec);
+	for (i = 0; i < trc->head.nreg; i++) {
+		rv = trc->rdsc[i]->get(comp->cpu);
+		if (trc->head.regsize == 2) {
+			rw = rv & 0xffff;
+			memcpy(ptr, &rw, 2);
+		} else {
+			memcpy(ptr, &rv, 4);
+		}
+		ptr += trc->head.regsize;
+	}
+	trc->total++;
+	trc->pos++;
+	if (trc->count < trc->size)
+		trc->count++;
+	if (trc->pos >= trc->size) {
+		if (trc->file) {
+			trc_flush(trc);
+		} else {
+			trc->pos = 0;
+		}
+	}
+}
+
+// decoding
+
+typedef struct {
+	int adr;
+	unsigned char* op;
+} xTrcDasm;
+
+static int trc_dasm_rd(int adr, void* ptr) {
+	xTrcDasm* ds = (xTrcDasm*)ptr;
+	int off = (adr - ds->adr) & 0xffff;		// cpuDisasm can wrap address to 16 bits
+	return (off < 8) ? ds->op[off] : 0xff;
+}
+
+// some cores disasm through cpu->mrd
+static int trc_dasm_mrd(int adr, int m1, void* ptr) {
+	return trc_dasm_rd(adr, ptr);
+}
+
+static void trc_put_reg(FILE* out, int size, int val) {
+	switch (size) {
+		case REG_BYTE: fprintf(out, "%.2X", val & 0xff); break;
+		case REG_WORD: fprintf(out, "%.4X", val & 0xffff); break;
+		case REG_24: fprintf(out, "%.6X", val & 0xffffff); break;
+		case REG_32: fprintf(out, "%.8X", val); break;
+		default: fprintf(out, "%i", val); break;		// bit, im
+	}
+}
+
+// render trace file to out. csv: comma separated with header line, otherwise text columns
+// return records count, -1 if file isn't a trace
+long long trc_decode(const char* path, FILE* out, int csv) {
+	FILE* file = fopen(path, "rb");
+	xTraceHead head;
+	xTraceRec rec;
+	xTrcDasm ds;
+	xRegDsc* rd[TRC_MAXREG];
+	CPU* cpu;
+	unsigned char* buf;
+	unsigned char* ptr;
+	char mnem[256];
+	unsigned short rw;
+	long long cnt = 0;
+	xMnem mn;
+	int rsz[TRC_MAXREG];
+	int rcnt;
+	int rv;
+	int i;
+	if (!file) return -1;
+	if ((fread(&head, sizeof(xTraceHead), 1, file) != 1) || memcmp(head.magic, TRC_MAGIC, 4) || (head.version != TRC_VERSION)
+		|| (head.nreg < 0) || (head.nreg > TRC_MAXREG) || (head.recsize != (int)sizeof(xTraceRec) + head.nreg * head.regsize)) {
+		fclose(file);
+		return -1;
+	}
+	head.cpuname[31] = 0;
+	cpu = cpuCreate(head.cputype, trc_dasm_mrd, NULL, NULL, NULL, NULL, NULL, &ds);
+	cpu_set_type(cpu, head.cpuname, NULL, NULL);		// built-in core by name if type id differs
+	for (rcnt = 0; cpu->core->rdsctab[rcnt].id != REG_EOT; rcnt++);
+	for (i = 0; i < head.nreg; i++) {
+		rd[i] = ((head.regidx[i] >= 0) && (head.regidx[i] < rcnt)) ? &cpu->core->rdsctab[head.regidx[i]] : NULL;
+		rsz[i] = rd[i] ? trc_reg_size(cpu, rd[i]) : REG_32;
+	}
+	if (csv) {
+		fprintf(out, "tick,adr,bytes,command,t");
+		for (i = 0; i < head.nreg; i++)
+			fprintf(out, ",%s", rd[i] ? rd[i]->name : "?");
+		fprintf(out, ",writes\n");
+	}
+	buf = malloc(head.recsize);
+	while (fread(buf, head.recsize, 1, file) == 1) {
+		memcpy(&rec, buf, sizeof(xTraceRec));
+		ds.adr = rec.adr;
+		ds.op = rec.op;
+		mn = cpuDisasm(cpu, rec.adr, mnem, trc_dasm_rd, &ds);
+		if ((mn.len < 1) || (mn.len > 8)) mn.len = 8;
+		if (csv) {
+			fprintf(out, "%i,%.6X,", rec.tick, rec.adr);
+		} else {
+			fprintf(out, "%10i %.6X%c ", rec.tick, rec.adr, (rec.flag & TRC_IRQ) ? '*' : ' ');
+		}
+		for (i = 0; i < 8; i++) {
+			if (i < mn.len) {
+				fprintf(out, "%.2X", rec.op[i]);
+			} else if (!csv) {
+				fprintf(out, "  ");
+			}
+		}
+		if (csv) {
+			fprintf(out, ",\"%s\",%i", mnem, rec.t);
+		} else {
+			fprintf(out, " %-24s %3i ", mnem, rec.t);
+		}
+		ptr = buf + sizeof(xTraceRec);
+		for (i = 0; i < head.nreg; i++) {
+			if (head.regsize == 2) {
+				memcpy(&rw, ptr, 2);
+				rv = rw;
+			} else {
+				memcpy(&rv, ptr, 4);
+			}
+			ptr += head.regsize;
+			if (csv) {
+				fputc(',', out);
+			} else {
+				fprintf(out, " %s:", rd[i] ? rd[i]->name : "?");
+			}
+			trc_put_reg(out, rsz[i], rv);
+		}
+		fputc(csv ? ',' : ' ', out);
+		for (i = 0; (i < rec.nwr) && (i < TRC_MAXWR); i++)
+			fprintf(out, "%s%.6X=%.2X", i ? " " : (csv ? "" : " ["), rec.wadr[i], rec.wval[i]);
+		if (rec.nwr > TRC_MAXWR)
+			fprintf(out, " +%i", rec.nwr - TRC_MAXWR);
+		if (!csv && rec.nwr)
+			fputc(']', out);
+		fputc('\n', out);
+		cnt++;
+	}
+	free(buf);
+	cpuDestroy(cpu);
+	fclose(file);
+	return cnt;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+
+#include "spectrum.h"
+
+// execution trace: fixed-size binary record for each compExec call, taken inside the core (no disasm/formatting at run time)
+// records go to file (buffered, written by whole buffer) or to in-memory ring (last N records, saved by trc_save)
+// trc_decode renders trace file as text or csv, using cpu disassembler of the same type as recorded one
+// file: xTraceHead, then records [xTraceRec][nreg x regsize register values]
+
+#define TRC_MAGIC	"XTRC"
+#define TRC_VERSION	1
+#define TRC_MAXREG	32
+#define TRC_MAXWR	4		// memory writes kept in record (nwr counts all of them)
+#define TRC_BUFREC	4096		// records in file buffer
+
+#define TRC_IRQ		1		// interrupt was pending before command (it could be handled instead)
+
+typedef struct {
+	char magic[4];
+	int version;
+	int cputype;
+	char cpuname[32];
+	int nreg;			// registers in record
+	int regsize;			// 2 or 4 bytes
+	int recsize;			// whole record size
+	int regidx[TRC_MAXREG];		// registers index in cpu core rdsctab
+} xTraceHead;
+
+typedef struct {
+	int tick;			// comp->tickCount before command
+	int adr;			// pc + cs.base
+	unsigned short pc;
+	unsigned short t;		// T eaten by command
+	unsigned char flag;
+	unsigned char nwr;		// memory writes count
+	unsigned char op[8];		// opcode bytes @ adr
+	unsigned char wval[TRC_MAXWR];
+	int wadr[TRC_MAXWR];
+} xTraceRec;
+
+typedef struct xTrace {
+	Computer* comp;			// machine trace is attached to
+	xTraceHead head;
+	xRegDsc* rdsc[TRC_MAXREG];
+	FILE* file;			// NULL: ring
+	int size;			// records in buffer
+	int pos;			// next record
+	int count;			// records in buffer (ring: valid ones)
+	long long total;		// all records taken
+	int act;			// command is executing (catch memory writes)
+	xTraceRec rec;			// current record
+	unsigned char* buf;
+} xTrace;
+
+xTrace* trc_create(Computer*, const char*, int);
+void trc_destroy(xTrace*);
+int trc_save(xTrace*, const char*);
+void trc_begin(xTrace*, Computer*);
+void trc_end(xTrace*, Computer*, int);
+void trc_mwr(xTrace*, int, int);
+long long trc_decode(const char*, FILE*, int);
+
+#ifdef __cplusplus
+}
+#endif
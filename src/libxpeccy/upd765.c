@@ -95,6 +95,9 @@ int uGetByte(FDC* fdc) {
 				flpNext(fdc->flp, fdc->side);
 				fdc->tns = 0;
 				res = 1;
+			} else {
+				fdc->wait = fdc->bytedelay - fdc->tns + 1;	// check when data will be lost, reading data cut this
+				return 0;
 			}
 		} else {			// data is ready
 			fdc->tmp = flpRd(fdc->flp, fdc->side);
@@ -324,15 +327,17 @@ void uread01(FDC* fdc) {
 }
 
 int ureadCHK(FDC* fdc, int rt, int wt) {
-	fdc->tmp = flpRd(fdc->flp, fdc->side);
-	flpNext(fdc->flp, fdc->side);
 	fdc->wait += turbo ? TRBBYTE : fdc->bytedelay;
-	if (fdc->flp->field == rt) return 1;
-	if ((fdc->flp->field == wt) && (~fdc->com & F_COM_SK)) {	// wrong data field type, skip off: set b4,sr2, read sector & terminate execution
-		fdc->sr2 |= 0x40;
-		return 1;
-	}
-	fdc->cnt--;
+	do {					// turbo: all bytes at once
+		fdc->tmp = flpRd(fdc->flp, fdc->side);
+		flpNext(fdc->flp, fdc->side);
+		if (fdc->flp->field == rt) return 1;
+		if ((fdc->flp->field == wt) && (~fdc->com & F_COM_SK)) {	// wrong data field type, skip off: set b4,sr2, read sector & terminate execution
+			fdc->sr2 |= 0x40;
+			return 1;
+		}
+		fdc->cnt--;
+	} while (turbo && (fdc->cnt > 0));
 	if (fdc->cnt > 0) return 0;	// seek in progress
 	fdc->sr0 |= 0x40;		// error
 	fdc->sr1 |= 0x04;		// no data
@@ -629,6 +634,10 @@ void uwrdat01(FDC* fdc) {
 // wait sector data
 void uwrdat02(FDC* fdc) {
 	flpNext(fdc->flp, fdc->side);
+	while (turbo && (fdc->cnt > 1) && (fdc->flp->field != 2) && (fdc->flp->field != 3)) {	// turbo: skip to data at once
+		flpNext(fdc->flp, fdc->side);
+		fdc->cnt--;
+	}
 	if ((fdc->flp->field == 2) || (fdc->flp->field == 3)) {		// data filed (excluding A1 A1 A1 F8(FB))
 		flpPrev(fdc->flp, fdc->side);				// to data mark (F8 | FB)
 		fdc->crc = 0;						// form crc for A1 A1 A1
@@ -660,6 +669,10 @@ void uwrdat02(FDC* fdc) {
 // write data
 
 void uwrdat03(FDC* fdc) {
+	if (turbo && fdc->drq && !fdc->mr && (fdc->tns <= fdc->bytedelay)) {
+		fdc->wait = fdc->bytedelay - fdc->tns + 1;	// turbo: wait byte from cpu until it's overrun
+		return;
+	}
 	if (fdc->mr) {
 		flpWr(fdc->flp, fdc->side, 0x00);
 	} else {
@@ -669,7 +682,8 @@ void uwrdat03(FDC* fdc) {
 		flpWr(fdc->flp, fdc->side, fdc->data);
 	}
 	flpNext(fdc->flp, fdc->side);
-	fdc->wait += fdc->bytedelay;
+	fdc->wait += turbo ? 1 : fdc->bytedelay;
+	fdc->tns = 0;
 	fdc->cnt--;
 	if (fdc->cnt < 1) {
 		fdc->pos++;
@@ -744,7 +758,11 @@ void utrkfrm00(FDC* fdc) {
 }
 
 void utrkfrm01(FDC* fdc) {		// wait for index
-	flpNext(fdc->flp, fdc->side);
+	int cnt = turbo ? fdc->flp->trklen : 1;		// turbo: spin to index at once
+	do {
+		flpNext(fdc->flp, fdc->side);
+		cnt--;
+	} while (!fdc->flp->index && (cnt > 0));
 	fdc->wait += fdc->bytedelay; // turbo ? TRBBYTE : fdc->bytedelay;
 	if (fdc->flp->index) {
 		fdc->cnt = 0;
@@ -806,12 +824,16 @@ void utrkfrm03(FDC* fdc) {		// emulate whole track writing
 	// immediate next step
 	fdc->pos++;
 #else
-	// wait for next index
-	if (flpNext(fdc->flp, fdc->side)) {
-		fdc->pos++;
-	} else {
-		fdc->wait += fdc->bytedelay;
+	// wait for next index (turbo: at once)
+	int cnt = turbo ? fdc->flp->trklen : 1;
+	while (cnt > 0) {
+		if (flpNext(fdc->flp, fdc->side)) {
+			fdc->pos++;
+			return;
+		}
+		cnt--;
 	}
+	fdc->wait += fdc->bytedelay;
 #endif
 }
 
@@ -870,6 +892,10 @@ static uCom uComTab[] = {
 	{0x00, 0x00, 0, uInvalid}	// -------- invalid op
 };
 
+// plans by id for state (see state.c), new items go to the end
+void* upd765_state_ptrs[] = {utermTab, uSpecify, uDrvStat, uCalib, uSeek, uReadID, uReadD01, uRdData, uRdTrk, uScan, uWrData,
+			uFormat, uInvalid, uSenseInt, NULL};
+
 // 1)'sense interrupt status' com must be sent after 'seek' and 'recalibrate'; otherwise, fdc will consider next com as invalid
 // 2)issuing 'sense interrupt status' com without interrupt pending is treated as invalid com
 // 3)'seek' and 'recalibrate' doesn't have result phase, 'sense interrupt status' must be used to effectively terminate them
@@ -912,6 +938,7 @@ void uWrite(FDC* fdc, int adr, unsigned char val) {
 	} else if (fdc->drq && !fdc->dir) {	// data cpu->fdc
 		fdc->data = val;
 		fdc->drq = 0;
+		if (turbo && fdc->irq) fdc->wait = 0;		// turbo: take it at next sync
 	} else if (val == 0x04) {
 		printf("sense drive status\n");
 	}
@@ -926,6 +953,7 @@ unsigned char uRead(FDC* fdc, int adr) {
 			if (fdc->irq) {			// execution: transfer data
 				res = fdc->data;
 				fdc->drq = 0;
+				if (turbo) fdc->wait = 0;	// turbo: next byte at next sync
 			} else if (fdc->resCnt > 0) {	// result phase
 				fdc->intr = 0;		// reset interrupt @ reading [TODO: on 1st byte of result]
 				res = fdc->resBuf[fdc->resPos];
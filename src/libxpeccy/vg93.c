@@ -39,7 +39,14 @@ void wrCRC(FDC* fdc) {
 // wait ADR
 // return: 0 : not ADR, 1 : ADR, 2 : IDX
 int waitADR(FDC* fdc) {
-	fdc->wait += turbo ? TURBOBYTE : fdc->bytedelay;
+	if (turbo) {				// turbo: spin to ADR or IDX at once
+		fdc->wait += TURBOBYTE;
+		do {
+			if (flpNext(fdc->flp, fdc->side)) return 2;
+		} while ((fdc->flp->field != 1) && fdc->flp->insert && fdc->flp->door);
+		return (fdc->flp->field == 1) ? 1 : 0;
+	}
+	fdc->wait += fdc->bytedelay;
 	if (flpNext(fdc->flp, fdc->side)) return 2;	// 2:IDX
 	if (fdc->flp->field != 1) return 0;		// 0:not ADR
 	return 1;
@@ -81,7 +88,8 @@ int vgSendByte(FDC* fdc) {
 			fdc->tns = 1;
 			res = 1;
 		}
-		fdc->wait = 1;
+		// next check when data will be lost, writing to FDC_DATA cut this
+		fdc->wait = fdc->bytedelay - fdc->tns + 1;
 	} else {
 		if (fdc->drq) {			// time to write byte, but isn't get it from CPU
 			fdc->state |= 0x04;
@@ -119,7 +127,8 @@ int vgGetByte(FDC* fdc) {
 			fdc->tns = 0;
 			res = 1;
 		}
-		fdc->wait = 1;				// check every time (no delay)
+		// next check when data will be lost, reading FDC_DATA cut this
+		fdc->wait = fdc->bytedelay - fdc->tns + 1;
 	} else {
 		if (fdc->drq) {
 			fdc->state |= 0x04;		// data lost - time to read next byte, but previous is not transfered
@@ -137,7 +146,7 @@ int vgGetByte(FDC* fdc) {
 // wait fdc->cnt ms & spin flop if motor is on
 void vgwait(FDC* fdc) {
 	fdc->cnt -= fdc->bytedelay;
-	if (fdc->cnt < 0) {
+	if ((fdc->cnt < 0) || turbo) {
 		fdc->pos++;
 	} else {
 		fdc->wait += fdc->bytedelay;
@@ -232,7 +241,7 @@ void vgres00(FDC* fdc) {
 	fdc->trk = 0xff;
 	fdc->cnt = 1000000;		// delay for BV
 	if (fdc->com & 8) {		// if h=1 : start motor, pause 15 ms
-		fdc->wait += turbo ? 5000 : 15000;
+		fdc->wait += turbo ? 1 : 15000;
 		fdc->flp->motor = 1;
 	}
 	fdc->pos++;
@@ -273,11 +282,11 @@ void vgseek01(FDC* fdc) {
 	} else if (fdc->trk < fdc->data) {
 		flpStep(fdc->flp, FLP_FORWARD);
 		fdc->trk++;
-		fdc->wait += turbo ? TURBOBYTE : fdc->bytedelay;
+		fdc->wait += turbo ? 1 : fdc->bytedelay;
 	} else {
 		flpStep(fdc->flp, FLP_BACK);
 		fdc->trk--;
-		fdc->wait += turbo ? TURBOBYTE : fdc->bytedelay;
+		fdc->wait += turbo ? 1 : fdc->bytedelay;
 	}
 }
 
@@ -328,7 +337,7 @@ void vgrds00(FDC* fdc) {
 		vgstp(fdc);
 	} else {
 		fdc->flp->motor = 1;
-		if (fdc->com & 4) fdc->wait += 15000;	// if (e=0) pause 15ms
+		if (fdc->com & 4) fdc->wait += turbo ? 1 : 15000;	// if (e=0) pause 15ms
 		fdc->cnt = 5;				// seek sector in 5 spins
 		fdc->pos++;
 	}
@@ -365,15 +374,18 @@ void vgrds01(FDC* fdc) {
 // seek sector DATA in next CNT bytes, else - array not found
 void vgrds02(FDC* fdc) {
 	if (fdc->cnt > 0) {
-		fdc->tmp = flpRd(fdc->flp, fdc->side);
-		flpNext(fdc->flp, fdc->side);
+		do {				// turbo: all bytes at once
+			fdc->tmp = flpRd(fdc->flp, fdc->side);
+			flpNext(fdc->flp, fdc->side);
+			fdc->cnt--;
+			if ((fdc->flp->field == 2) || (fdc->flp->field == 3)) {
+				fdc->buf[4] = fdc->tmp;
+				fdc->pos++;
+				fdc->wait = 0;
+				return;
+			}
+		} while (turbo && (fdc->cnt > 0));
 		fdc->wait += turbo ? TURBOBYTE : fdc->bytedelay;
-		if ((fdc->flp->field == 2) || (fdc->flp->field == 3)) {
-			fdc->buf[4] = fdc->tmp;
-			fdc->pos++;
-			fdc->wait = 0;
-		}
-		fdc->cnt--;
 	} else {
 		fdc->state |= 0x10;		// sector not found (array not found)
 		vgstp(fdc);
@@ -526,9 +538,23 @@ static fdcCall vgRdAdr[] = {&vgrds00,&vgrda00,&vgrda01,&vgchk02,&vgstp};
 // read track
 
 // wait IDX
+// turbo: spin to IDX at once
+static int vg_wait_idx(FDC* fdc) {
+	int cnt = fdc->flp->trklen;
+	if (!turbo) {
+		fdc->wait += fdc->bytedelay;
+		return flpNext(fdc->flp, fdc->side);
+	}
+	fdc->wait += TURBOBYTE;
+	while (cnt > 0) {
+		if (flpNext(fdc->flp, fdc->side)) return 1;
+		cnt--;
+	}
+	return 0;
+}
+
 void vgrdt00(FDC* fdc) {
-	fdc->wait += turbo ? TURBOBYTE : fdc->bytedelay;
-	if (flpNext(fdc->flp, fdc->side)) {
+	if (vg_wait_idx(fdc)) {
 		fdc->drq = 0;
 		fdc->dir = 1;
 		fdc->pos++;
@@ -545,8 +571,7 @@ static fdcCall vgRdTrk[] = {&vgrds00,&vgrdt00,&vgrdt01,&vgstp};
 // write track
 
 void vgwrt00(FDC* fdc) {
-	fdc->wait += turbo ? TURBOBYTE : fdc->bytedelay;
-	if (flpNext(fdc->flp, fdc->side)) {
+	if (vg_wait_idx(fdc)) {
 		fdc->pos++;
 		fdc->wait = fdc->bytedelay;
 	}
@@ -587,6 +612,9 @@ static vgComItem vgComTab[] = {
 	{0x00, 0x00, vgStop}		// othercom - do nothing
 };
 
+// plans by id for state (see state.c), new items go to the end
+void* vg93_state_ptrs[] = {vgStop, vgCheck, vgRest, vgSeek, vgStepF, vgStepB, vgStep, vgRdSec, vgWrSec, vgRdAdr, vgRdTrk, vgWrTrk, NULL};
+
 void vgExec(FDC* fdc, unsigned char com) {
 	int idx;
 	// printf("com:%.2X trk:%.2X sec:%.2X dat:%.2X\n",com,fdc->trk,fdc->sec,fdc->data);
@@ -627,6 +655,7 @@ void vgWrite(FDC* fdc, int adr, unsigned char val) {
 		case FDC_DATA:
 			fdc->data = val;
 			fdc->drq = 0;
+			if (turbo && !fdc->idle) fdc->wait = 0;		// turbo: next byte at next sync
 			break;
 	}
 }
@@ -661,6 +690,7 @@ unsigned char vgRead(FDC* fdc, int adr) {
 		case FDC_DATA:
 			res = fdc->data;
 			fdc->drq = 0;
+			if (turbo && !fdc->idle) fdc->wait = 0;
 //			printf("%.2X ",res);
 			break;
 	}
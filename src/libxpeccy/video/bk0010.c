@@ -2,12 +2,6 @@
 
 #include <string.h>
 
-static int xadr;
-static unsigned char sbyte;
-static unsigned char cola;
-static unsigned char colb;
-static int xscr;
-static int yscr;
 
 // b/w mode
 // 1bit = 1dot
@@ -16,22 +10,22 @@ static int yscr;
 // pal: 0-black 1-white
 void bk_bw_dot(Video* vid) {
 	if (vid->hbrd || vid->vbrd || (vid->cutscr && (vid->ray.ys > 0x3f))) {
-		cola = 0;
-		colb = 0;
+		vid->dr.cola = 0;
+		vid->dr.colb = 0;
 	} else {
-		xscr = vid->ray.xs;
+		vid->dr.xscr = vid->ray.xs;
 		if ((vid->ray.x & 3) == 0) {
-			yscr = (vid->ray.ys + vid->sc.y - 0xd8) & 0xff;
-			xadr = ((vid->vidPage ? 7 : 1) << 14) | (yscr << 6) | ((xscr >> 2) & 0x3f);
-			if (vid->cutscr) xadr |= 0x3000;
-			sbyte = vid->mrd(xadr, vid->xptr);
+			vid->dr.yscr = (vid->ray.ys + vid->sc.y - 0xd8) & 0xff;
+			vid->dr.xadr = ((vid->vidPage ? 7 : 1) << 14) | (vid->dr.yscr << 6) | ((vid->dr.xscr >> 2) & 0x3f);
+			if (vid->cutscr) vid->dr.xadr |= 0x3000;
+			vid->dr.sbyte = vid->mrd(vid->dr.xadr, vid->xptr);
 		}
-		cola = (sbyte & 0x01) ? 0x15 : 0x14;
-		colb = (sbyte & 0x02) ? 0x15 : 0x14;
-		sbyte >>= 2;
+		vid->dr.cola = (vid->dr.sbyte & 0x01) ? 0x15 : 0x14;
+		vid->dr.colb = (vid->dr.sbyte & 0x02) ? 0x15 : 0x14;
+		vid->dr.sbyte >>= 2;
 	}
-	vid_dot_half(vid, cola);
-	vid_dot_half(vid, colb);
+	vid_dot_half(vid, vid->dr.cola);
+	vid_dot_half(vid, vid->dr.colb);
 }
 
 // color mode
@@ -41,17 +35,17 @@ void bk_bw_dot(Video* vid) {
 // pal: 0-black, 1-red, 2-green 3-blue
 void bk_col_dot(Video* vid) {
 	if (vid->hbrd || vid->vbrd || (vid->cutscr && (vid->ray.ys > 0x3f))) {
-		cola = 0;
+		vid->dr.cola = 0;
 	} else {
-		xscr = vid->ray.xs;
+		vid->dr.xscr = vid->ray.xs;
 		if ((vid->ray.x & 3) == 0) {
-			yscr = (vid->ray.ys + vid->sc.y - 0xd8) & 0xff;
-			xadr = ((vid->vidPage ? 7 : 1) << 14) | (yscr << 6) | ((xscr >> 2) & 0x3f);
-			if (vid->cutscr) xadr |= 0x3000;
-			sbyte = vid->mrd(xadr, vid->xptr);
+			vid->dr.yscr = (vid->ray.ys + vid->sc.y - 0xd8) & 0xff;
+			vid->dr.xadr = ((vid->vidPage ? 7 : 1) << 14) | (vid->dr.yscr << 6) | ((vid->dr.xscr >> 2) & 0x3f);
+			if (vid->cutscr) vid->dr.xadr |= 0x3000;
+			vid->dr.sbyte = vid->mrd(vid->dr.xadr, vid->xptr);
 		}
-		cola = sbyte & 3;
-		sbyte >>= 2;
+		vid->dr.cola = vid->dr.sbyte & 3;
+		vid->dr.sbyte >>= 2;
 	}
-	vid_dot_full(vid, cola | vid->paln);
+	vid_dot_full(vid, vid->dr.cola | vid->paln);
 }
@@ -192,6 +192,9 @@ void gbcvMode3(Video* vid) {
 	vid->cbCount = gbcvMode0;
 }
 
+// busy callbacks by id for state (see state.c)
+void* gbcv_state_ptrs[] = {gbcvMode0, gbcvMode3, NULL};
+
 void gbcvMode2(Video* vid) {
 	if (vid->vblank) {
 		vid->intrq = 0;
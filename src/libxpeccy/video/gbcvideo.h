@@ -10,3 +10,5 @@ void gbcvVBL(Video*);
 
 void gbcv_wr(Video*, int, int);
 int gbcv_rd(Video*, int);
+
+extern void* gbcv_state_ptrs[];
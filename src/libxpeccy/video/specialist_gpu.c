@@ -1,8 +1,5 @@
 #include "video.h"
 
-static int adr;
-static int scrbyte;
-static unsigned char col;
 
 void spcv_ini(Video* vid) {
 	xColor blk = {0,0,0};
@@ -13,10 +10,10 @@ void spcv_ini(Video* vid) {
 
 void spc_dot(Video* vid) {
 	if ((vid->ray.x & 7) == 0) {					// every 8 dots
-		adr = (vid->ray.y & 0xff) | (vid->ray.x << 5);		// 0x9000 + y + (x / 8 * 256)
-		scrbyte = vid->mrd(adr, vid->xptr);
+		vid->dr.adr = (vid->ray.y & 0xff) | (vid->ray.x << 5);		// 0x9000 + y + (x / 8 * 256)
+		vid->dr.scrbyte = vid->mrd(vid->dr.adr, vid->xptr);
 	}
-	col = (scrbyte & 0x80) ? 1 : 0;
-	scrbyte <<= 1;
-	vid_dot_full(vid, col);
+	vid->dr.col = (vid->dr.scrbyte & 0x80) ? 1 : 0;
+	vid->dr.scrbyte <<= 1;
+	vid_dot_full(vid, vid->dr.col);
 }
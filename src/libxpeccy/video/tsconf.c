@@ -5,69 +5,63 @@
 
 // tsconf sprites & tiles
 
-static int adr,xscr,yscr;
-static unsigned char col, ink, pap, scrbyte, nxtbyte;
 
 void vidDrawByteDD(Video*);
 
-static int fadr;
-static int tile;
-static int sadr;	// adr in sprites dsc
-static int xadr;	// = pos with XFlip
 
 // render tiles
 int vidTSLRenderTiles(Video* vid, int lay, unsigned short yoffs, unsigned short xoffs, unsigned char gpage, unsigned char palhi) {
 	int j;
 	int res = 0;
-	yscr = vid->ray.y - vid->tsconf.yPos + yoffs;						// line in TMap
-	adr = (vid->tsconf.TMPage << 14) | ((yscr & 0x1f8) << 5) | (lay ? 0x80 : 0x00);		// start of TMap line (full.adr)
-	xscr = (0x200 - xoffs) & 0x1ff;								// pos in line buf
-	xadr = vid->tsconf.tconfig & (lay ? 8 : 4);
+	vid->dr.yscr = vid->ray.y - vid->tsconf.yPos + yoffs;						// line in TMap
+	vid->dr.adr = (vid->tsconf.TMPage << 14) | ((vid->dr.yscr & 0x1f8) << 5) | (lay ? 0x80 : 0x00);		// start of TMap line (full.adr)
+	vid->dr.xscr = (0x200 - xoffs) & 0x1ff;								// pos in line buf
+	vid->dr.xadr = vid->tsconf.tconfig & (lay ? 8 : 4);
 	do {											// 64 tiles in row
-		tile = vid->mrd(adr, vid->xptr) | (vid->mrd(adr + 1, vid->xptr) << 8);		// tile dsc
-		adr += 2;
+		vid->dr.tile = vid->mrd(vid->dr.adr, vid->xptr) | (vid->mrd(vid->dr.adr + 1, vid->xptr) << 8);		// tile dsc
+		vid->dr.adr += 2;
 
-		if ((tile & 0xfff) || xadr) {							// !0 or (0 enabled)
-			fadr = gpage << 14;
-			fadr += ((tile & 0xfc0) << 5) | ((yscr & 7) << 8) | ((tile & 0x3f) << 2);	// full addr of row of this tile
-			if (tile & 0x8000) fadr ^= 0x0700;						// YFlip
+		if ((vid->dr.tile & 0xfff) || vid->dr.xadr) {							// !0 or (0 enabled)
+			vid->dr.fadr = gpage << 14;
+			vid->dr.fadr += ((vid->dr.tile & 0xfc0) << 5) | ((vid->dr.yscr & 7) << 8) | ((vid->dr.tile & 0x3f) << 2);	// full addr of row of this tile
+			if (vid->dr.tile & 0x8000) vid->dr.fadr ^= 0x0700;						// YFlip
 			res += 2;			// 8 dots, 2 memory readings
-			col = palhi | ((tile >> 8) & 0x30);					// palette (b7..4 of color)
-			if (tile & 0x4000) {							// XFlip
-				xscr += 8;
+			vid->dr.col = palhi | ((vid->dr.tile >> 8) & 0x30);					// palette (b7..4 of color)
+			if (vid->dr.tile & 0x4000) {							// XFlip
+				vid->dr.xscr += 8;
 				for (j = 0; j < 4; j++) {
-					col &= 0xf0;
-					col |= (vid->mrd(fadr, vid->xptr) & 0xf0) >> 4;		// left pixel
-					xscr--;
-					if (col & 0x0f) vid->line[xscr & 0x1ff] = col;
-					col &= 0xf0;
-					col |= vid->mrd(fadr, vid->xptr) & 0x0f;			// right pixel
-					xscr--;
-					if (col & 0x0f) vid->line[xscr & 0x1ff] = col;
-					fadr++;
+					vid->dr.col &= 0xf0;
+					vid->dr.col |= (vid->mrd(vid->dr.fadr, vid->xptr) & 0xf0) >> 4;		// left pixel
+					vid->dr.xscr--;
+					if (vid->dr.col & 0x0f) vid->line[vid->dr.xscr & 0x1ff] = vid->dr.col;
+					vid->dr.col &= 0xf0;
+					vid->dr.col |= vid->mrd(vid->dr.fadr, vid->xptr) & 0x0f;			// right pixel
+					vid->dr.xscr--;
+					if (vid->dr.col & 0x0f) vid->line[vid->dr.xscr & 0x1ff] = vid->dr.col;
+					vid->dr.fadr++;
 				}
-				xscr += 8;
+				vid->dr.xscr += 8;
 			} else {								// no XFlip
 				for (j = 0; j < 4; j++) {
-					col &= 0xf0;
-					col |= (vid->mrd(fadr, vid->xptr) & 0xf0) >> 4;				// left pixel
-					if (col & 0x0f) {
-						vid->line[xscr & 0x1ff] = col;
+					vid->dr.col &= 0xf0;
+					vid->dr.col |= (vid->mrd(vid->dr.fadr, vid->xptr) & 0xf0) >> 4;				// left pixel
+					if (vid->dr.col & 0x0f) {
+						vid->line[vid->dr.xscr & 0x1ff] = vid->dr.col;
 					}
-					xscr++;
-					col &= 0xf0;
-					col |= vid->mrd(fadr, vid->xptr) & 0x0f;					// right pixel
-					if (col & 0x0f) {
-						vid->line[xscr & 0x1ff] = col;
+					vid->dr.xscr++;
+					vid->dr.col &= 0xf0;
+					vid->dr.col |= vid->mrd(vid->dr.fadr, vid->xptr) & 0x0f;					// right pixel
+					if (vid->dr.col & 0x0f) {
+						vid->line[vid->dr.xscr & 0x1ff] = vid->dr.col;
 					}
-					xscr++;
-					fadr++;
+					vid->dr.xscr++;
+					vid->dr.fadr++;
 				}
 			}
 		} else {
-			xscr += 8;
+			vid->dr.xscr += 8;
 		}
-	} while (adr & 0x7f);
+	} while (vid->dr.adr & 0x7f);
 	return res;
 }
 
@@ -91,8 +85,8 @@ int vidTSLRenderSprites(Video* vid) {
 	unsigned char* ptr;
 	TSpr spr;
 	int res = 0;
-	while (sadr < (0x200 - 6)) {
-		ptr = &vid->tsconf.sfile[sadr];
+	while (vid->dr.sadr < (0x200 - 6)) {
+		ptr = &vid->tsconf.sfile[vid->dr.sadr];
 		spr.y = ptr[0];
 		spr.y |= (ptr[1] & 1) << 8;
 		spr.ys = (ptr[1] & 0x0e) >> 1;
@@ -109,36 +103,36 @@ int vidTSLRenderSprites(Video* vid) {
 		spr.tnum |= (ptr[5] & 0x0f) << 8;
 		spr.pal = (ptr[5] & 0xf0) >> 4;
 		if (spr.act) {
-			adr = spr.y;
-			xscr = (spr.ys + 1) << 3;		// Ysize - 000:8; 001:16; 010:24; ...
-			yscr = vid->ray.y - vid->tsconf.yPos;	// line on screen
-			if (((yscr - adr) & 0x1ff) < xscr) {	// if sprite visible on current line
-				res += xscr >> 2;		// 1/4 : 4 dots each memory access
-				yscr -= adr;			// line inside sprite;
-				if (spr.yf) yscr = xscr - yscr - 1;	// YFlip (Ysize - norm.pos - 1)
-				tile = spr.tnum + ((yscr & 0x1f8) << 3);	// shift to current tile line
+			vid->dr.adr = spr.y;
+			vid->dr.xscr = (spr.ys + 1) << 3;		// Ysize - 000:8; 001:16; 010:24; ...
+			vid->dr.yscr = vid->ray.y - vid->tsconf.yPos;	// line on screen
+			if (((vid->dr.yscr - vid->dr.adr) & 0x1ff) < vid->dr.xscr) {	// if sprite visible on current line
+				res += vid->dr.xscr >> 2;		// 1/4 : 4 dots each memory access
+				vid->dr.yscr -= vid->dr.adr;			// line inside sprite;
+				if (spr.yf) vid->dr.yscr = vid->dr.xscr - vid->dr.yscr - 1;	// YFlip (Ysize - norm.pos - 1)
+				vid->dr.tile = spr.tnum + ((vid->dr.yscr & 0x1f8) << 3);	// shift to current tile line
 
-				fadr = vid->tsconf.SGPage << 14;
-				fadr += ((tile & 0xfc0) << 5) | ((yscr & 7) << 8) | ((tile & 0x3f) << 2);	// fadr = adr of pix line to put in buf
+				vid->dr.fadr = vid->tsconf.SGPage << 14;
+				vid->dr.fadr += ((vid->dr.tile & 0xfc0) << 5) | ((vid->dr.yscr & 7) << 8) | ((vid->dr.tile & 0x3f) << 2);	// fadr = adr of pix line to put in buf
 
-				col = spr.pal << 4;
-				xadr = (spr.xs + 1) << 3;	// xsoze
-				adr = spr.x;			// xpos
-				if (spr.xf) adr += xadr - 1;	// xpos of right pixel (xflip)
-				for (xscr = xadr; xscr > 0; xscr -= 2) {
-					col &= 0xf0;
-					col |= ((vid->mrd(fadr, vid->xptr) & 0xf0) >> 4);		// left pixel;
-					if (col & 0x0f) vid->line[adr & 0x1ff] = col;
-					if (spr.xf) adr--; else adr++;
-					col &= 0xf0;
-					col |= (vid->mrd(fadr, vid->xptr) & 0x0f);		// right pixel
-					if (col & 0x0f) vid->line[adr & 0x1ff] = col;
-					if (spr.xf) adr--; else adr++;
-					fadr++;
+				vid->dr.col = spr.pal << 4;
+				vid->dr.xadr = (spr.xs + 1) << 3;	// xsoze
+				vid->dr.adr = spr.x;			// xpos
+				if (spr.xf) vid->dr.adr += vid->dr.xadr - 1;	// xpos of right pixel (xflip)
+				for (vid->dr.xscr = vid->dr.xadr; vid->dr.xscr > 0; vid->dr.xscr -= 2) {
+					vid->dr.col &= 0xf0;
+					vid->dr.col |= ((vid->mrd(vid->dr.fadr, vid->xptr) & 0xf0) >> 4);		// left pixel;
+					if (vid->dr.col & 0x0f) vid->line[vid->dr.adr & 0x1ff] = vid->dr.col;
+					if (spr.xf) vid->dr.adr--; else vid->dr.adr++;
+					vid->dr.col &= 0xf0;
+					vid->dr.col |= (vid->mrd(vid->dr.fadr, vid->xptr) & 0x0f);		// right pixel
+					if (vid->dr.col & 0x0f) vid->line[vid->dr.adr & 0x1ff] = vid->dr.col;
+					if (spr.xf) vid->dr.adr--; else vid->dr.adr++;
+					vid->dr.fadr++;
 				}
 			}
 		}
-		sadr += 6;
+		vid->dr.sadr += 6;
 		if (spr.leap) break;		// LEAP
 	}
 	return res;
@@ -146,56 +140,56 @@ int vidTSLRenderSprites(Video* vid) {
 
 //render 4bpp mode line
 int vidTSLRender16c(Video* vid) {
-	xscr = vid->tsconf.xOffset & 0x1ff;
-	yscr = (vid->tsconf.scrLine + vid->tsconf.yOffset) & 0x1ff;
-	adr = ((vid->vidPage & 0xf8) << 14) + (yscr << 8) + (xscr >> 1);
-	xadr = adr & ~0xff;
-	fadr = 0;
-	while (fadr < vid->scrsize.x) {
-		scrbyte = vid->mrd(adr, vid->xptr);
-		adr = ((adr + 1) & 0xff) | xadr;
-		vid->linb[fadr] = vid->tsconf.scrPal | ((scrbyte >> 4) & 0x0f);
-		fadr++;
-		vid->linb[fadr] = vid->tsconf.scrPal | (scrbyte & 0x0f);
-		fadr++;
+	vid->dr.xscr = vid->tsconf.xOffset & 0x1ff;
+	vid->dr.yscr = (vid->tsconf.scrLine + vid->tsconf.yOffset) & 0x1ff;
+	vid->dr.adr = ((vid->vidPage & 0xf8) << 14) + (vid->dr.yscr << 8) + (vid->dr.xscr >> 1);
+	vid->dr.xadr = vid->dr.adr & ~0xff;
+	vid->dr.fadr = 0;
+	while (vid->dr.fadr < vid->scrsize.x) {
+		vid->dr.scrbyte = vid->mrd(vid->dr.adr, vid->xptr);
+		vid->dr.adr = ((vid->dr.adr + 1) & 0xff) | vid->dr.xadr;
+		vid->linb[vid->dr.fadr] = vid->tsconf.scrPal | ((vid->dr.scrbyte >> 4) & 0x0f);
+		vid->dr.fadr++;
+		vid->linb[vid->dr.fadr] = vid->tsconf.scrPal | (vid->dr.scrbyte & 0x0f);
+		vid->dr.fadr++;
 	}
 	return vid->scrsize.x >> 2;		// 1/4
 }
 
 // render 8bpp mode line
 int vidTSLRender256c(Video* vid) {
-	xscr = vid->tsconf.xOffset & 0x1ff;
-	yscr = (vid->tsconf.scrLine + vid->tsconf.yOffset) & 0x1ff;
-	adr = ((vid->vidPage & 0xf0) << 14) + (yscr << 9) + xscr;
-	xadr = adr & ~0x1ff;
-	fadr = 0;
-	while (fadr < vid->scrsize.x) {
-		vid->linb[fadr] = vid->mrd(adr, vid->xptr);
-		fadr++;
-		adr = ((adr + 1) & 0x1ff) | xadr;
+	vid->dr.xscr = vid->tsconf.xOffset & 0x1ff;
+	vid->dr.yscr = (vid->tsconf.scrLine + vid->tsconf.yOffset) & 0x1ff;
+	vid->dr.adr = ((vid->vidPage & 0xf0) << 14) + (vid->dr.yscr << 9) + vid->dr.xscr;
+	vid->dr.xadr = vid->dr.adr & ~0x1ff;
+	vid->dr.fadr = 0;
+	while (vid->dr.fadr < vid->scrsize.x) {
+		vid->linb[vid->dr.fadr] = vid->mrd(vid->dr.adr, vid->xptr);
+		vid->dr.fadr++;
+		vid->dr.adr = ((vid->dr.adr + 1) & 0x1ff) | vid->dr.xadr;
 	}
 	return vid->scrsize.x >> 1;		// 1/2
 }
 
 // render text mode line
 int vidTSLRenderText(Video* vid) {
-	xscr = vid->tsconf.xOffset & 0x1ff;
-	yscr = (vid->tsconf.scrLine + vid->tsconf.yOffset) & 0x1ff;
-	adr = (vid->vidPage << 14) + ((yscr & 0x1f8) << 5) + (xscr >> 2);
-	xadr = adr & ~0x7f;
-	fadr = 0;
-	while (fadr < (vid->scrsize.x << 1)) {
-		tile = vid->mrd(adr, vid->xptr);		// char nr
-		col = vid->mrd(adr | 0x80, vid->xptr);
-		adr = ((adr + 1) & 0x7f) | xadr;
-		ink = (col & 0x0f) | (vid->tsconf.scrPal);
-		pap = ((col & 0xf0) >> 4)  | (vid->tsconf.scrPal);
-		scrbyte = vid->mrd(MADR(vid->vidPage ^ 1, (tile << 3) | (yscr & 7)), vid->xptr);	// char line data (8 dots)
+	vid->dr.xscr = vid->tsconf.xOffset & 0x1ff;
+	vid->dr.yscr = (vid->tsconf.scrLine + vid->tsconf.yOffset) & 0x1ff;
+	vid->dr.adr = (vid->vidPage << 14) + ((vid->dr.yscr & 0x1f8) << 5) + (vid->dr.xscr >> 2);
+	vid->dr.xadr = vid->dr.adr & ~0x7f;
+	vid->dr.fadr = 0;
+	while (vid->dr.fadr < (vid->scrsize.x << 1)) {
+		vid->dr.tile = vid->mrd(vid->dr.adr, vid->xptr);		// char nr
+		vid->dr.col = vid->mrd(vid->dr.adr | 0x80, vid->xptr);
+		vid->dr.adr = ((vid->dr.adr + 1) & 0x7f) | vid->dr.xadr;
+		vid->dr.ink = (vid->dr.col & 0x0f) | (vid->tsconf.scrPal);
+		vid->dr.pap = ((vid->dr.col & 0xf0) >> 4)  | (vid->tsconf.scrPal);
+		vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage ^ 1, (vid->dr.tile << 3) | (vid->dr.yscr & 7)), vid->xptr);	// char line data (8 dots)
 		do {
-			vid->linb[fadr & 0x3ff] = (scrbyte & 0x80) ? ink : pap;
-			scrbyte <<= 1;
-			fadr++;
-		} while (fadr & 7);
+			vid->linb[vid->dr.fadr & 0x3ff] = (vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap;
+			vid->dr.scrbyte <<= 1;
+			vid->dr.fadr++;
+		} while (vid->dr.fadr & 7);
 	}
 	return 0;
 }
@@ -204,9 +198,9 @@ int vidTSLRenderText(Video* vid) {
 int vidTSRender(Video* vid) {
 	int res = 0;
 // tilemap reading
-	yscr = (vid->ray.y - vid->tsconf.yPos + 8);
-	if (yscr < 0) yscr += vid->full.y;
-	if  (yscr < vid->scrsize.y) {
+	vid->dr.yscr = (vid->ray.y - vid->tsconf.yPos + 8);
+	if (vid->dr.yscr < 0) vid->dr.yscr += vid->full.y;
+	if  (vid->dr.yscr < vid->scrsize.y) {
 		if (vid->tsconf.tconfig & 0x20) res += 8;
 		if (vid->tsconf.tconfig & 0x40) res += 8;
 	}
@@ -214,7 +208,7 @@ int vidTSRender(Video* vid) {
 	if (vid->ray.y < vid->tsconf.yPos) return res;
 	if (vid->ray.y >= (vid->tsconf.yPos + vid->scrsize.y)) return res;
 // prepare layers
-	sadr = 0x000;					// adr inside SFILE
+	vid->dr.sadr = 0x000;					// adr inside SFILE
 	memset(vid->line,0x00,0x200);		// clear tile-sprite line
 	memset(vid->linb,0x00,0x200);
 // bitplane/text (render to vid->linb)
@@ -296,86 +290,86 @@ void vts_frame(Video* vid) {
 }
 
 void scanExtLine(Video* vid) {
-	xscr = vid->ray.x - vid->tsconf.xPos;
-	yscr = vid->ray.y - vid->tsconf.yPos;
-	if ((yscr >= 0) && (yscr < vid->scrsize.y) && (xscr >= 0) && (xscr < vid->scrsize.x)) {
+	vid->dr.xscr = vid->ray.x - vid->tsconf.xPos;
+	vid->dr.yscr = vid->ray.y - vid->tsconf.yPos;
+	if ((vid->dr.yscr >= 0) && (vid->dr.yscr < vid->scrsize.y) && (vid->dr.xscr >= 0) && (vid->dr.xscr < vid->scrsize.x)) {
 		if (((vid->vmode == VID_TSL_16) || (vid->vmode == VID_TSL_256)) && !vid->nogfx)		// put bitmap pixel
-			col = vid->linb[xscr];
-		if (vid->line[xscr] & 0x0f)							// put not-transparent tiles/sprites pixel
-			col = vid->line[xscr];
+			vid->dr.col = vid->linb[vid->dr.xscr];
+		if (vid->line[vid->dr.xscr] & 0x0f)							// put not-transparent tiles/sprites pixel
+			vid->dr.col = vid->line[vid->dr.xscr];
 	}
 }
 
 // tsconf normal screen (separated 'cuz of palette)
 
 void vidDrawTSLNormal(Video* vid) {
-	xscr = vid->ray.x - vid->bord.x;
-	yscr = vid->ray.y - vid->bord.y;
-	if ((yscr < 0) || (yscr >= vid->scrn.y) || vid->nogfx) {
-		col = vid->brdcol;
+	vid->dr.xscr = vid->ray.x - vid->bord.x;
+	vid->dr.yscr = vid->ray.y - vid->bord.y;
+	if ((vid->dr.yscr < 0) || (vid->dr.yscr >= vid->scrn.y) || vid->nogfx) {
+		vid->dr.col = vid->brdcol;
 	} else {
-		if ((xscr & 7) == 4) {
-			adr = ((yscr & 0xc0) << 5) | ((yscr & 7) << 8) | ((yscr & 0x38) << 2) | (((xscr + 4) & 0xf8) >> 3);
-			nxtbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
+		if ((vid->dr.xscr & 7) == 4) {
+			vid->dr.adr = ((vid->dr.yscr & 0xc0) << 5) | ((vid->dr.yscr & 7) << 8) | ((vid->dr.yscr & 0x38) << 2) | (((vid->dr.xscr + 4) & 0xf8) >> 3);
+			vid->dr.nxtbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
 		}
-		if ((xscr < 0) || (xscr >= vid->scrn.x)) {
-			col = vid->brdcol;
+		if ((vid->dr.xscr < 0) || (vid->dr.xscr >= vid->scrn.x)) {
+			vid->dr.col = vid->brdcol;
 		} else {
-			if ((xscr & 7) == 0) {
-				scrbyte = nxtbyte;
-				adr = 0x1800 | ((yscr & 0xc0) << 2) | ((yscr & 0x38) << 2) | (((xscr + 4) & 0xf8) >> 3);
-				vid->atrbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
-				if ((vid->atrbyte & 0x80) && vid->flash) scrbyte ^= 0xff;
-				ink = (vid->atrbyte & 0x07) | ((vid->atrbyte & 0x40) >> 3);
-				pap = (vid->atrbyte & 0x78) >> 3;
+			if ((vid->dr.xscr & 7) == 0) {
+				vid->dr.scrbyte = vid->dr.nxtbyte;
+				vid->dr.adr = 0x1800 | ((vid->dr.yscr & 0xc0) << 2) | ((vid->dr.yscr & 0x38) << 2) | (((vid->dr.xscr + 4) & 0xf8) >> 3);
+				vid->atrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+				if ((vid->atrbyte & 0x80) && vid->flash) vid->dr.scrbyte ^= 0xff;
+				vid->dr.ink = (vid->atrbyte & 0x07) | ((vid->atrbyte & 0x40) >> 3);
+				vid->dr.pap = (vid->atrbyte & 0x78) >> 3;
 			}
-			col = vid->tsconf.scrPal | ((scrbyte & 0x80) ? ink : pap);
-			scrbyte <<= 1;
+			vid->dr.col = vid->tsconf.scrPal | ((vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap);
+			vid->dr.scrbyte <<= 1;
 		}
 	}
 	scanExtLine(vid);
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 // tsconf extend mode (out pre-rendered bitmap/TSU layers)
 // 16c/256c: mix tile/sprite, bitmap & border colors
 void vidDrawTSLExt(Video* vid) {
 #if 1
-	xscr = vid->ray.x - vid->tsconf.xPos;
-	yscr = vid->ray.y - vid->tsconf.yPos;
-	if ((yscr >= 0) && (yscr < vid->scrsize.y) && (xscr >= 0) && (xscr < vid->scrsize.x)) {
-		if (vid->line[xscr] & 0x0f) {
-			col = vid->line[xscr];
+	vid->dr.xscr = vid->ray.x - vid->tsconf.xPos;
+	vid->dr.yscr = vid->ray.y - vid->tsconf.yPos;
+	if ((vid->dr.yscr >= 0) && (vid->dr.yscr < vid->scrsize.y) && (vid->dr.xscr >= 0) && (vid->dr.xscr < vid->scrsize.x)) {
+		if (vid->line[vid->dr.xscr] & 0x0f) {
+			vid->dr.col = vid->line[vid->dr.xscr];
 		} else if (vid->nogfx) {
-			col = vid->brdcol;
+			vid->dr.col = vid->brdcol;
 		} else {
-			col = vid->linb[xscr];
+			vid->dr.col = vid->linb[vid->dr.xscr];
 		}
 	} else {
-		col = vid->brdcol;
+		vid->dr.col = vid->brdcol;
 	}
 #else
-	col = vid->brdcol;
+	vid->dr.col = vid->brdcol;
 	scanExtLine(vid);
 #endif
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 // tsconf text
 
 void vidDrawTSLText(Video* vid) {
-	xscr = vid->ray.x - vid->tsconf.xPos;
-	yscr = vid->ray.y - vid->tsconf.yPos;
-	if ((xscr < 0) || (xscr >= vid->scrsize.x) || (yscr < 0) || (yscr >= vid->scrsize.y)) {
+	vid->dr.xscr = vid->ray.x - vid->tsconf.xPos;
+	vid->dr.yscr = vid->ray.y - vid->tsconf.yPos;
+	if ((vid->dr.xscr < 0) || (vid->dr.xscr >= vid->scrsize.x) || (vid->dr.yscr < 0) || (vid->dr.yscr >= vid->scrsize.y)) {
 		vid_dot_full(vid, vid->brdcol);
 	} else {
-		if (vid->line[xscr] & 0x0f) {
-			vid_dot_full(vid, vid->line[xscr]);
+		if (vid->line[vid->dr.xscr] & 0x0f) {
+			vid_dot_full(vid, vid->line[vid->dr.xscr]);
 		} else {
-			xscr <<= 1;
-			vid_dot_half(vid, vid->linb[xscr] ? vid->linb[xscr] : vid->brdcol);
-			xscr++;
-			vid_dot_half(vid, vid->linb[xscr] ? vid->linb[xscr] : vid->brdcol);
+			vid->dr.xscr <<= 1;
+			vid_dot_half(vid, vid->linb[vid->dr.xscr] ? vid->linb[vid->dr.xscr] : vid->brdcol);
+			vid->dr.xscr++;
+			vid_dot_half(vid, vid->linb[vid->dr.xscr] ? vid->linb[vid->dr.xscr] : vid->brdcol);
 		}
 	}
 }
@@ -15,10 +15,7 @@
 // 192:  | 13 border | 192 screen | 12 border | 96 blank | = 313 (PAL)
 // 212:  | 11 border | 212 screen | 10 border | 80 blank | = 313 (PAL)
 
-static int xscr, yscr, adr;
-static unsigned char scrbyte, atrbyte, col, ink, pap;
 static unsigned char m2lev[8] = {0x00,0x33,0x5c,0x7f,0xa2,0xc1,0xe1,0xff};
-static unsigned char tbyte;
 
 // colors was taken from wikipedia article
 // https://en.wikipedia.org/wiki/List_of_8-bit_computer_hardware_palettes#Original_MSX
@@ -275,124 +272,126 @@ void vdp_linex(Video* gpu) {
 
 void vdpText1(Video* vid) {
 	if (vid->vbrd || vid->hbrd || !(vid->reg[1] & 0x40) || (vid->ray.xs > 240)) {
-		col = vid->reg[7] & 0x0f;
+		vid->dr.col = vid->reg[7] & 0x0f;
 	} else {
-		yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
+		vid->dr.yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
 		if ((vid->ray.xs % 6) == 0) {
-			adr = vid->ram[((yscr & 0xf8) * 5) + (vid->ray.xs / 6)];
-			scrbyte = vid->ram[0x800 | (adr << 3) | (yscr & 7)];
-			ink = (vid->reg[7] & 0xf0) >> 4;
-			pap = vid->reg[7] & 0x0f;
+			vid->dr.adr = vid->ram[((vid->dr.yscr & 0xf8) * 5) + (vid->ray.xs / 6)];
+			vid->dr.scrbyte = vid->ram[0x800 | (vid->dr.adr << 3) | (vid->dr.yscr & 7)];
+			vid->dr.ink = (vid->reg[7] & 0xf0) >> 4;
+			vid->dr.pap = vid->reg[7] & 0x0f;
 		}
-		col = (scrbyte & 0x80) ? ink : pap;
-		scrbyte <<= 1;
+		vid->dr.col = (vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap;
+		vid->dr.scrbyte <<= 1;
 	}
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 // v9918 G1
 
 void vdpGra1(Video* vid) {
 	if (vid->vbrd || vid->hbrd || !(vid->reg[1] & 0x40)) {
-		col = vid->reg[7] & 0x0f;
+		vid->dr.col = vid->reg[7] & 0x0f;
 	} else {
-		yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
+		vid->dr.yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
 		if (!(vid->ray.xs & 7)) {
-			adr = vid->ram[vid->BGMap + (vid->ray.xs >> 3) + ((yscr & 0xf8) << 2)];
-			scrbyte = vid->ram[vid->BGTiles + (adr << 3) + (yscr & 7)];
-			atrbyte = vid->ram[vid->BGColors + (adr >> 3)];
-			ink = (atrbyte & 0xf0) >> 4;
-			pap = atrbyte & 0x0f;
+			vid->dr.adr = vid->ram[vid->BGMap + (vid->ray.xs >> 3) + ((vid->dr.yscr & 0xf8) << 2)];
+			vid->dr.scrbyte = vid->ram[vid->BGTiles + (vid->dr.adr << 3) + (vid->dr.yscr & 7)];
+			vid->dr.atrbyte = vid->ram[vid->BGColors + (vid->dr.adr >> 3)];
+			vid->dr.ink = (vid->dr.atrbyte & 0xf0) >> 4;
+			vid->dr.pap = vid->dr.atrbyte & 0x0f;
 		}
-		col = vid->line[vid->ray.xs & 0x1ff];
-		if (!col)
-			col = (scrbyte & 0x80) ? ink : pap;
-		scrbyte <<= 1;
+		vid->dr.col = vid->line[vid->ray.xs & 0x1ff];
+		if (!vid->dr.col)
+			vid->dr.col = (vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap;
+		vid->dr.scrbyte <<= 1;
 
 	}
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 // v9918 G2 (256 x 192)
 
 void vdpGra2(Video* vid) {
 	if (vid->vbrd || vid->hbrd || !(vid->reg[1] & 0x40)) {
-		col = vid->reg[7] & 0x0f;
+		vid->dr.col = vid->reg[7] & 0x0f;
 	} else {
-		yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
+		vid->dr.yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
 		if ((vid->ray.xs & 7) == 0) {
-			adr = vid->ram[vid->BGMap | (vid->ray.xs >> 3) | ((yscr & 0xf8) << 2)] | ((yscr & 0xc0) << 2);	// tile nr
-			scrbyte = vid->ram[(vid->BGTiles & ~0x1fff) | (adr << 3) | (yscr & 7)];
-			atrbyte = vid->ram[(vid->BGColors & ~0x1fff) | (adr << 3) | (yscr & 7)];
-			ink = (atrbyte >> 4) & 0x0f;
-			pap = atrbyte & 0x0f;
+			vid->dr.adr = vid->ram[vid->BGMap | (vid->ray.xs >> 3) | ((vid->dr.yscr & 0xf8) << 2)] | ((vid->dr.yscr & 0xc0) << 2);	// tile nr
+			vid->dr.scrbyte = vid->ram[(vid->BGTiles & ~0x1fff) | (vid->dr.adr << 3) | (vid->dr.yscr & 7)];
+			vid->dr.atrbyte = vid->ram[(vid->BGColors & ~0x1fff) | (vid->dr.adr << 3) | (vid->dr.yscr & 7)];
+			vid->dr.ink = (vid->dr.atrbyte >> 4) & 0x0f;
+			vid->dr.pap = vid->dr.atrbyte & 0x0f;
 		}
-		col = vid->line[vid->ray.xs & 0x1ff];
-		if (!col)
-			col = (scrbyte & 0x80) ? ink : pap;
-		scrbyte <<= 1;
+		vid->dr.col = vid->line[vid->ray.xs & 0x1ff];
+		if (!vid->dr.col)
+			vid->dr.col = (vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap;
+		vid->dr.scrbyte <<= 1;
 	}
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 // v9918 MC (multicolor)
 
 void vdpMultcol(Video* vid) {
 	if (vid->vbrd || vid->hbrd || !(vid->reg[1] & 0x40)) {
-		col = vid->reg[7] & 0x0f;
+		vid->dr.col = vid->reg[7] & 0x0f;
 	} else {
-		yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
-		adr = vid->ram[vid->BGMap | (vid->ray.xs >> 3) | ((yscr & 0xf8) << 2)];		// color index
-		adr = vid->BGTiles | (adr << 3) | ((yscr & 0x18) >> 2) | ((yscr & 4) >> 2);	// color adr
-		col = vid->ram[adr];								// color for 2 dots
-		if (!(xscr & 4)) {
-			col >>= 4;
+		vid->dr.yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
+		vid->dr.adr = vid->ram[vid->BGMap | (vid->ray.xs >> 3) | ((vid->dr.yscr & 0xf8) << 2)];		// color index
+		vid->dr.adr = vid->BGTiles | (vid->dr.adr << 3) | ((vid->dr.yscr & 0x18) >> 2) | ((vid->dr.yscr & 4) >> 2);	// color adr
+		vid->dr.col = vid->ram[vid->dr.adr];								// color for 2 dots
+		if (!(vid->dr.xscr & 4)) {
+			vid->dr.col >>= 4;
 		}
-		col &= 0x0f;
+		vid->dr.col &= 0x0f;
 		if (vid->line[vid->ray.xs & 0x1ff])
-			col = vid->line[vid->ray.xs & 0x1ff];
+			vid->dr.col = vid->line[vid->ray.xs & 0x1ff];
 	}
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 // v9938 G4 (256x212 4bpp)
 
 void vdpGra4(Video* vid) {
 	if (vid->vbrd || vid->hbrd || !(vid->reg[1] & 0x40)) {
-		col = vid->reg[7] & 0x0f;
+		vid->dr.col = vid->reg[7] & 0x0f;
 	} else {
 		if (vid->ray.xs & 1) {
-			col = ink & 0x0f;
+			vid->dr.col = vid->dr.ink & 0x0f;
 		} else {
-			yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
-			adr = (vid->BGMap & ~0x7fff) | (vid->ray.xs >> 1) | (yscr << 7);
-			ink = vid->ram[adr & vid->memMask];		// color byte
-			col = (ink >> 4) & 15;
+			vid->dr.yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
+			vid->dr.adr = (vid->BGMap & ~0x7fff) | (vid->ray.xs >> 1) | (vid->dr.yscr << 7);
+			vid->dr.ink = vid->ram[vid->dr.adr & vid->memMask];		// color byte
+			vid->dr.col = (vid->dr.ink >> 4) & 15;
 		}
 		if (vid->line[vid->ray.xs & 0x1ff])
-			col = vid->line[vid->ray.xs & 0x1ff];
+			vid->dr.col = vid->line[vid->ray.xs & 0x1ff];
 	}
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 void vdpG4pset(Video* vid, int x, int y, unsigned char col) {
-	adr = ((x >> 1) | (y << 7)) & vid->memMask;
-	tbyte = vid->ram[adr];
+	unsigned char tbyte;
+	vid->dr.adr = ((x >> 1) | (y << 7)) & vid->memMask;
+	tbyte = vid->ram[vid->dr.adr];
 	if (x & 1) {
-		pap = tbyte & 15;
-		col = vdp_mix_col(col, pap, vid->reg[0x2e] & 15);
+		vid->dr.pap = tbyte & 15;
+		col = vdp_mix_col(col, vid->dr.pap, vid->reg[0x2e] & 15);
 		tbyte = (tbyte & 0xf0) | (col & 0x0f);
 	} else {
-		pap = (tbyte >> 4) & 15;
-		col = vdp_mix_col(col, pap, vid->reg[0x2e] & 15);
+		vid->dr.pap = (tbyte >> 4) & 15;
+		col = vdp_mix_col(col, vid->dr.pap, vid->reg[0x2e] & 15);
 		tbyte = (tbyte & 0x0f) | ((col << 4) & 0xf0);
 	}
-	vid->ram[adr] = tbyte;
+	vid->ram[vid->dr.adr] = tbyte;
 }
 
 unsigned char vdpG4col(Video* vid, int x, int y) {
-	adr = ((x >> 1) | (y << 7)) & vid->memMask;
-	tbyte = vid->ram[adr];
+	unsigned char tbyte;
+	vid->dr.adr = ((x >> 1) | (y << 7)) & vid->memMask;
+	tbyte = vid->ram[vid->dr.adr];
 	return (x & 1) ? tbyte & 0x0f : (tbyte >> 4) & 0x0f;
 }
 
@@ -402,38 +401,40 @@ void vdpGra5(Video* vid) {
 	if (vid->vbrd || vid->hbrd || !(vid->reg[1] & 0x40)) {
 		vid_dot_full(vid, vid->reg[7] & 3);
 	} else {
-		yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
+		vid->dr.yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
 		if (vid->ray.xs & 1) {
-			adr = (vid->BGMap & ~0x7fff) | (vid->ray.xs >> 1) | (yscr << 7);
-			col = vid->ram[adr];
+			vid->dr.adr = (vid->BGMap & ~0x7fff) | (vid->ray.xs >> 1) | (vid->dr.yscr << 7);
+			vid->dr.col = vid->ram[vid->dr.adr];
 		}
 		if (vid->line[vid->ray.xs & 0x1ff]) {
 			vid_dot_full(vid, vid->line[vid->ray.xs & 0x1ff]);
 		} else {
-			vid_dot_half(vid, (col & 0xc0) >> 6);
-			vid_dot_half(vid, (col & 0x30) >> 4);
+			vid_dot_half(vid, (vid->dr.col & 0xc0) >> 6);
+			vid_dot_half(vid, (vid->dr.col & 0x30) >> 4);
 		}
-		col <<= 4;
+		vid->dr.col <<= 4;
 	}
 }
 
 void vdpG5pset(Video* vid, int x, int y, unsigned char col) {
-	adr = ((x >> 2) | (y << 7)) & vid->memMask;
-	tbyte = vid->ram[adr];
-	pap = (tbyte  >> ((~x & 3) << 1)) & 3;
-	col = vdp_mix_col(col, pap, vid->reg[0x2e] & 3);
+	unsigned char tbyte;
+	vid->dr.adr = ((x >> 2) | (y << 7)) & vid->memMask;
+	tbyte = vid->ram[vid->dr.adr];
+	vid->dr.pap = (tbyte  >> ((~x & 3) << 1)) & 3;
+	col = vdp_mix_col(col, vid->dr.pap, vid->reg[0x2e] & 3);
 	switch (x & 3) {
 		case 0: tbyte = (tbyte & 0x3f) | ((col << 6) & 0xc0); break;
 		case 1: tbyte = (tbyte & 0xcf) | ((col << 4) & 0x30); break;
 		case 2: tbyte = (tbyte & 0xf3) | ((col << 2) & 0x0c); break;
 		case 3: tbyte = (tbyte & 0xfc) | (col & 3); break;
 	}
-	vid->ram[adr] = tbyte;
+	vid->ram[vid->dr.adr] = tbyte;
 }
 
 unsigned char vdpG5col(Video* vid, int x, int y) {
-	adr = (x >> 2) | (y << 7);
-	tbyte = vid->ram[adr & vid->memMask];
+	unsigned char tbyte;
+	vid->dr.adr = (x >> 2) | (y << 7);
+	tbyte = vid->ram[vid->dr.adr & vid->memMask];
 	return (tbyte  >> ((~x & 3) << 1)) & 3;
 }
 
@@ -443,71 +444,72 @@ void vdpGra6(Video* vid) {
 	if (vid->vbrd || vid->hbrd || !(vid->reg[1] & 0x40)) {
 		vid_dot_full(vid, vid->reg[7]);
 	} else {
-		yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
-		adr = (vid->BGMap & ~0xffff) | vid->ray.xs | (yscr << 8);
-		col = vid->ram[adr];
+		vid->dr.yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
+		vid->dr.adr = (vid->BGMap & ~0xffff) | vid->ray.xs | (vid->dr.yscr << 8);
+		vid->dr.col = vid->ram[vid->dr.adr];
 		if (vid->line[vid->ray.xs & 0x1ff]) {
 			vid_dot_full(vid, vid->line[vid->ray.xs & 0x1ff]);
 		} else {
-			vid_dot_half(vid, (col & 0xf0) >> 4);
-			vid_dot_half(vid, col & 0x0f);
+			vid_dot_half(vid, (vid->dr.col & 0xf0) >> 4);
+			vid_dot_half(vid, vid->dr.col & 0x0f);
 		}
 	}
 }
 
 void vdpG6pset(Video* vid, int x, int y, unsigned char col) {
-	adr = (x | (y << 8)) & vid->memMask;
-	tbyte = vid->ram[adr];
-	pap = (tbyte >> ((~x & 1) << 2)) & 0x0f;
-	col = vdp_mix_col(col, pap, vid->reg[0x2e] & 15);
+	unsigned char tbyte;
+	vid->dr.adr = (x | (y << 8)) & vid->memMask;
+	tbyte = vid->ram[vid->dr.adr];
+	vid->dr.pap = (tbyte >> ((~x & 1) << 2)) & 0x0f;
+	col = vdp_mix_col(col, vid->dr.pap, vid->reg[0x2e] & 15);
 	if (x & 1) {
 		tbyte = (tbyte & 0xf0) | (col & 0x0f);
 	} else {
-		tbyte = (tbyte & 0x0f) | ((col << 4) & 0x0f);
+		tbyte = (tbyte & 0x0f) | ((col << 4) & 0xf0);
 	}
-	vid->ram[adr] = tbyte;
+	vid->ram[vid->dr.adr] = tbyte;
 }
 
 unsigned char vdpG6col(Video* vid, int x, int y) {
-	adr = (x | (y << 8)) & vid->memMask;
-	tbyte = vid->ram[adr];
+	unsigned char tbyte;
+	vid->dr.adr = (x | (y << 8)) & vid->memMask;
+	tbyte = vid->ram[vid->dr.adr];
 	return (tbyte >> ((~x & 1) << 2)) & 0x0f;
 }
 
 // v9938 G6 (256x212 8bpp)
 // note:sprites color is different
 
-static xColor txc;
-
 void vdpGra7(Video* vid) {
+	xColor txc;
 	if (vid->vbrd || vid->hbrd || !(vid->reg[1] & 0x40)) {
-		col = vid->reg[7];
+		vid->dr.col = vid->reg[7];
 	} else {
-		yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
-		adr = ((vid->reg[2] & 0x20) ? 0x10000 : 0) | vid->ray.xs | (yscr << 8);
+		vid->dr.yscr = (vid->ray.ys + vid->reg[0x17]) & 0xff;
+		vid->dr.adr = ((vid->reg[2] & 0x20) ? 0x10000 : 0) | vid->ray.xs | (vid->dr.yscr << 8);
 		if (vid->line[vid->ray.xs & 0x1ff]) {
-			col = vid->line[vid->ray.xs & 0x1ff];
-			col = ((col & 4) ? 0xe0 : 0) | ((col & 2) ? 0x1c : 0) | ((col & 1) ? 3 : 0);
+			vid->dr.col = vid->line[vid->ray.xs & 0x1ff];
+			vid->dr.col = ((vid->dr.col & 4) ? 0xe0 : 0) | ((vid->dr.col & 2) ? 0x1c : 0) | ((vid->dr.col & 1) ? 3 : 0);
 		} else {
-			col = vid->ram[adr & vid->memMask];
+			vid->dr.col = vid->ram[vid->dr.adr & vid->memMask];
 		}
-		txc.r = (col << 3) & 0xe0;
-		txc.g = col & 0xe0;
-		txc.b = (col << 6) & 0xe0;
+		txc.r = (vid->dr.col << 3) & 0xe0;
+		txc.g = vid->dr.col & 0xe0;
+		txc.b = (vid->dr.col << 6) & 0xe0;
 		vid_set_col(vid, 0xff, txc);
-		col = 0xff;
+		vid->dr.col = 0xff;
 	}
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 void vdpG7pset(Video* vid, int x, int y, unsigned char col) {
-	adr = x | (y << 8);
-	vid->ram[adr & vid->memMask] = col;
+	vid->dr.adr = x | (y << 8);
+	vid->ram[vid->dr.adr & vid->memMask] = col;
 }
 
 unsigned char vdpG7col(Video* vid, int x, int y) {
-	adr = x | (y << 8);
-	return vid->ram[adr & vid->memMask];
+	vid->dr.adr = x | (y << 8);
+	return vid->ram[vid->dr.adr & vid->memMask];
 }
 
 // dummy
@@ -579,6 +581,8 @@ void vdpReset(Video* vid) {
 	vid->vadr = 0;
 	vid->high = 0;
 	vid->palhi = 0;
+	vid->busy = 0;
+	vid->cbCount = NULL;
 }
 
 void vdpSend(Video* vid, unsigned char val) {
@@ -613,8 +617,8 @@ unsigned char vdpGet(Video* vid) {
 
 void vdpCopy(Video* vid) {
 	if (vid->col && vid->pset) {
-		col = vid->col(vid, vid->src.x, vid->src.y);
-		vid->pset(vid, vid->dst.x, vid->dst.y, col);
+		vid->dr.col = vid->col(vid, vid->src.x, vid->src.y);
+		vid->pset(vid, vid->dst.x, vid->dst.y, vid->dr.col);
 	}
 	vid->sr[2] |= 0x80;
 	vid->src.x += vid->step.x;
@@ -634,8 +638,8 @@ void vdpCopy(Video* vid) {
 unsigned char vdpReadSR(Video* vid) {
 	unsigned char idx = vid->reg[0x0f] & 0x0f;
 	unsigned char res = vid->sr[idx];
-	xscr = vid->ray.x - vid->scrn.x;
-	yscr = vid->ray.y - vid->scrn.y;
+	vid->dr.xscr = vid->ray.x - vid->scrn.x;
+	vid->dr.yscr = vid->ray.y - vid->scrn.y;
 	switch (idx) {
 		case 0:
 			vid->sr[0] &= 0x7f;		// reset VINT flag
@@ -649,10 +653,10 @@ unsigned char vdpReadSR(Video* vid) {
 			if (vid->vbrd) res |= 0x40;
 			// if (vid->busy) res |= 0x01;
 			break;
-		case 3: res = xscr & 0xff; break;
-		case 4: res = (xscr >> 8) & 1; break;
-		case 5: res = yscr & 0xff; break;
-		case 6: res = (yscr >> 8) & 3; break;
+		case 3: res = vid->dr.xscr & 0xff; break;
+		case 4: res = (vid->dr.xscr >> 8) & 1; break;
+		case 5: res = vid->dr.yscr & 0xff; break;
+		case 6: res = (vid->dr.yscr >> 8) & 3; break;
 		case 7: if (vid->sr[2] & 0x80) {
 				vid->sr[7] = vdpGet(vid);
 			}
@@ -730,17 +734,162 @@ xVDPArgs vdp_get_hcom(Video* vid, vCoord crd, vCoord rect) {
 // ~ E : move right side of lines up
 //   F : put rect (bytes)
 
-// TODO: block commands executed line by line
-
 void vdp_com_info(Video* vid) {
 	printf("vdp9938 command %.2X, arg %.2X\n",vid->com, vid->arg);
 	printf("src:%i %i\ndst:%i %i\nrct:%i %i\n", vid->src.x, vid->src.y, vid->dst.x, vid->dst.y, vid->rct.x, vid->rct.y);
 }
 
+// command engine
+// rect commands are done at once: row by row over vram (memset/memmove where dots are byte aligned, else dot loop
+// specialized by logical operation). CE (S#2 b0) stays set for modelled command time: vid->busy dots, then vdp_com_end
+
+// VDP clocks (21.477MHz) per byte|dot and per line, display & sprites on (approximate)
+#define VDP_CLK_HMMV	48
+#define VDP_CLK_YMMM	64
+#define VDP_CLK_HMMM	88
+#define VDP_CLK_LMMV	104
+#define VDP_CLK_LMMM	136
+#define VDP_CLK_LINE	88
+#define VDP_CLK_ROW	64
+
+static void vdp_com_end(Video* vid) {
+	vid->busy = 0;
+	vid->cbCount = NULL;
+	vid->sr[2] &= ~0x81;
+}
+
+// callbacks by id for state (see state.c), new items go to the end
+void* vdp_state_ptrs[] = {vdpG4pset, vdpG4col, vdpG5pset, vdpG5col, vdpG6pset, vdpG6col, vdpG7pset, vdpG7col, vdp_com_end, NULL};
+
+// command is done, keep CE for clk VDP clocks
+static void vdp_com_time(Video* vid, int clk) {
+	vid->sr[2] &= ~0x80;
+	vid->busy = (vid->nsPerDot > 0) ? (int)((long long)clk * 46561 / 1000 / vid->nsPerDot) : 0;	// 46.561 ns per clock
+	if (vid->busy > 0) {
+		vid->sr[2] |= 1;
+		vid->cbCount = vdp_com_end;
+	} else {
+		vdp_com_end(vid);
+	}
+}
+
+// bitmap mode geometry
+typedef struct {
+	int wid;	// dots in line
+	int sh;		// log2(dots per byte)
+	int lsh;	// log2(bytes per line)
+	int bpp;
+	int cm;		// dot mask
+} xVDPGeom;
+
+static int vdp_geom(Video* vid, xVDPGeom* g) {
+	switch (vid->vmode) {
+		case VDP_GRA4: g->wid = 256; g->sh = 1; g->lsh = 7; break;
+		case VDP_GRA5: g->wid = 512; g->sh = 2; g->lsh = 7; break;
+		case VDP_GRA6: g->wid = 512; g->sh = 1; g->lsh = 8; break;
+		case VDP_GRA7: g->wid = 256; g->sh = 0; g->lsh = 8; break;
+		default: return 0;
+	}
+	g->bpp = 8 >> g->sh;
+	g->cm = (1 << g->bpp) - 1;
+	return 1;
+}
+
+// dots in row from x by step stx until screen edge (max n)
+static int vdp_clip(xVDPGeom* g, int x, int stx, int n) {
+	int lim = (stx > 0) ? g->wid - x : x + 1;
+	if (lim < 0) lim = 0;
+	return (n < lim) ? n : lim;
+}
+
+// s = src dot, d = dst dot
+#define VDP_DOT_LOOP(expr) \
+	for (; n > 0; n--, sx += stx, dx += stx) {\
+		if (col < 0) {\
+			sa = (sy | (sx >> g->sh)) & vid->memMask;\
+			s = (vid->ram[sa] >> (((~sx) & dm) * g->bpp)) & g->cm;\
+		}\
+		da = (dy | (dx >> g->sh)) & vid->memMask;\
+		ds = ((~dx) & dm) * g->bpp;\
+		d = (vid->ram[da] >> ds) & g->cm;\
+		expr;\
+		vid->ram[da] = (vid->ram[da] & ~(g->cm << ds)) | ((d & g->cm) << ds);\
+	}
+
+// one row of logical command. col < 0 : copy from (sx,sy), else fill with col. sy,dy are line addresses
+static void vdp_lrow(Video* vid, xVDPGeom* g, int sx, int sy, int dx, int dy, int n, int stx, int op, int col) {
+	int dm = (1 << g->sh) - 1;
+	int sa, da, ds;
+	int s = col;
+	int d;
+	n = vdp_clip(g, dx, stx, n);
+	if (col < 0) n = vdp_clip(g, sx, stx, n);
+	if (n < 1) return;
+	if ((op & 8) && (col == 0)) return;			// transparent fill
+	if (((op & 7) == 0) && ((op == 0) || (col > 0)) && !(((stx > 0) ? (dx | n) : ((dx + 1) | n)) & dm) && !((col < 0) && (((stx > 0) ? sx : sx + 1) & dm))) {
+		// IMP, byte aligned
+		if (stx < 0) {
+			dx = dx - n + 1;
+			sx = sx - n + 1;
+		}
+		da = (dy | (dx >> g->sh)) & vid->memMask;
+		if (col >= 0) {
+			for (d = 1; d < (1 << g->sh); d++)
+				col |= col << (d * g->bpp);
+			memset(vid->ram + da, col & 0xff, n >> g->sh);
+			return;
+		}
+		sa = (sy | (sx >> g->sh)) & vid->memMask;
+		// dots are copied one by one: overlapped copy against direction repeats dots, memmove doesn't
+		if ((da + (n >> g->sh) <= sa) || (sa + (n >> g->sh) <= da) || ((stx > 0) ? (da <= sa) : (da >= sa))) {
+			memmove(vid->ram + da, vid->ram + sa, n >> g->sh);
+			return;
+		}
+		if (stx < 0) {
+			dx = dx + n - 1;
+			sx = sx + n - 1;
+		}
+	}
+	switch (op) {
+		case 0x00: VDP_DOT_LOOP(d = s); break;				// IMP
+		case 0x01: VDP_DOT_LOOP(d &= s); break;				// AND
+		case 0x02: VDP_DOT_LOOP(d |= s); break;				// OR
+		case 0x03: VDP_DOT_LOOP(d ^= s); break;				// EOR
+		case 0x04: VDP_DOT_LOOP(d = ~s); break;				// NOT
+		case 0x08: VDP_DOT_LOOP(if (s) d = s); break;			// T*: src 0 is transparent
+		case 0x09: VDP_DOT_LOOP(if (s) d &= s); break;
+		case 0x0a: VDP_DOT_LOOP(if (s) d |= s); break;
+		case 0x0b: VDP_DOT_LOOP(if (s) d ^= s); break;
+		case 0x0c: VDP_DOT_LOOP(if (s) d = ~s); break;
+		default: break;							// dst is not changed
+	}
+}
+
+// LMMV (col >= 0), LMMM (col < 0)
+static void vdp_lcom(Video* vid, int col) {
+	xVDPGeom g;
+	int w = (vid->rct.x < 1) ? 1 : vid->rct.x;
+	int h = (vid->rct.y < 1) ? 1 : vid->rct.y;
+	int i;
+	if (vdp_geom(vid, &g)) {
+		if (col >= 0) col &= g.cm;
+		for (i = 0; i < h; i++) {
+			vdp_lrow(vid, &g, vid->src.x, vid->src.y << g.lsh, vid->dst.x, vid->dst.y << g.lsh, w, vid->step.x, vid->reg[0x2e] & 15, col);
+			vid->src.y = (vid->src.y + vid->step.y) & 0x3ff;
+			vid->dst.y = (vid->dst.y + vid->step.y) & 0x3ff;
+		}
+	}
+	vid->rct.x = vid->rctx;
+	vid->rct.y = 0;
+	vdp_com_time(vid, w * h * ((col < 0) ? VDP_CLK_LMMM : VDP_CLK_LMMV) + h * VDP_CLK_ROW);
+}
+
 // static unsigned char cbuf[512];
 
 void vdpExec(Video* vid) {
 //	int spx,dpx;
+	if (vid->busy && (vid->cbCount == vdp_com_end))
+		vdp_com_end(vid);			// previous command is still timed: vram is done already, so finish it
 	if ((vid->sr[2] & 1) && vid->com) return;	// busy & not stop command
 
 	xVDPArgs darg;
@@ -748,6 +897,7 @@ void vdpExec(Video* vid) {
 	unsigned char xcol;
 	int xpos;
 	int ypos;
+	int rows;
 
 	vid->step.x = (vid->reg[0x2d] & 4) ? -1 : 1;
 	vid->step.y = (vid->reg[0x2d] & 8) ? -1 : 1;
@@ -755,7 +905,7 @@ void vdpExec(Video* vid) {
 	vid->sr[2] |= 1;
 	switch (vid->com) {
 		case 0x00:
-			vid->sr[2] &= ~0x81;			// stop
+			vdp_com_end(vid);			// stop
 			break;
 		case 0x04:					// color
 			vid->sr[7] = vdpGet(vid);
@@ -808,20 +958,13 @@ void vdpExec(Video* vid) {
 			} while (vid->count > 0);
 			vid->dst.x = xpos >> 4;
 			vid->dst.y = ypos >> 4;
-			vid->sr[2] &= ~0x81;
+			vdp_com_time(vid, ((vid->rct.x > vid->rct.y) ? vid->rct.x : vid->rct.y) * VDP_CLK_LINE);
 			break;
 		case 0x08:					// fill rect (dots)
-			do {
-				vdpSend(vid, vid->reg[0x2c]);
-			} while (vid->sr[2] & 1);
-			vid->sr[2] &= ~0x81;
+			vdp_lcom(vid, vid->reg[0x2c]);
 			break;
 		case 0x09:					// copy rect (dots) src->dst
-			vid->busy = 96 * vid->rct.x * vid->rct.y;
-			do {
-				vdpCopy(vid);
-			} while (vid->sr[2] & 0x80);
-			vid->sr[2] &= ~1;
+			vdp_lcom(vid, -1);
 			break;
 		case 0x0a:				// get rect (dots)
 			vid->sr[7] = vdpGet(vid);
@@ -832,8 +975,8 @@ void vdpExec(Video* vid) {
 			vdpSend(vid, vid->reg[0x2c]);
 			break;
 		case 0x0c:				// fill rect (bytes)
-			vid->busy = 64 * vid->rct.x * vid->rct.y;
 			darg = vdp_get_hcom(vid, vid->dst, vid->rct);
+			rows = (vid->rct.y < 1) ? 1 : vid->rct.y;
 			if (darg.bpl) {
 				if (vid->reg[0x2d] & 4)
 					darg.adr = (darg.adr - darg.dx + 1);	// move to left edge
@@ -843,27 +986,28 @@ void vdpExec(Video* vid) {
 					vid->rct.y--;
 				} while (vid->rct.y > 0);
 			}
-			vid->sr[2] &= ~0x81;
+			vdp_com_time(vid, rows * (darg.dx * VDP_CLK_HMMV + VDP_CLK_ROW));
 			break;
 		case 0x0e:						// copy right (left) rect
 			vid->src.x = vid->dst.x;
 			vid->rct.x = (vid->step.x < 0) ? vid->dst.x : (vid->scrsize.x - vid->dst.x);
 		case 0x0d:						// copy rect (bytes) src->dst
-			vid->busy = 96 * vid->rct.x * vid->rct.y;
 			sarg = vdp_get_hcom(vid, vid->src, vid->rct);
 			darg = vdp_get_hcom(vid, vid->dst, vid->rct);
+			rows = (vid->rct.y < 1) ? 1 : vid->rct.y;
 			if (sarg.bpl) {
 				if (vid->reg[0x2d] & 4) {
 					sarg.adr = (sarg.adr - sarg.dx + 1);
 					darg.adr = (darg.adr - darg.dx + 1);
 				}
 				do {
-					memcpy(vid->ram + (darg.adr & vid->memMask), vid->ram + (sarg.adr & vid->memMask), sarg.dx);
+					// rows can overlap (YMMM moves area in place)
+					memmove(vid->ram + (darg.adr & vid->memMask), vid->ram + (sarg.adr & vid->memMask), sarg.dx);
 					sarg.adr += vid->step.y;
 					darg.adr += vid->step.y;
 				} while (--vid->rct.y > 0);
 			}
-			vid->sr[2] &= ~0x81;
+			vdp_com_time(vid, rows * (sarg.dx * ((vid->com == 0x0e) ? VDP_CLK_YMMM : VDP_CLK_HMMM) + VDP_CLK_ROW));
 			break;
 		default:
 			printf("vdp9938 command %.2X, arg %.2X\n",vid->com, vid->arg);
@@ -997,8 +1141,8 @@ void vdpRegWr(Video* vid, int reg, unsigned char val) {
 // 20150923
 
 void vdpHBlk(Video* vid) {
-	yscr = vid->ray.x - vid->bord.y;
-	if (yscr == vid->intp.y) {		// HINT
+	vid->dr.yscr = vid->ray.x - vid->bord.y;
+	if (vid->dr.yscr == vid->intp.y) {		// HINT
 		if (vid->reg[0] & VDP_IE1) {
 			vid->sr[1] |= 1;
 			vid->inth = vid->blank.x;
@@ -1037,9 +1181,8 @@ unsigned char vdpRead(Video* vid, int port) {
 	return res;
 }
 
-static xColor txc;
-
 void vdpWrite(Video* vid, int port, unsigned char val) {
+	xColor txc;
 	int num;
 	switch (port & 3) {
 		case 0:
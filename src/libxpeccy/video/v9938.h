@@ -27,3 +27,5 @@ void vdp_line(Video*);
 void vdp_linex(Video*);
 void vdpHBlk(Video*);
 void vdpVBlk(Video*);
+
+extern void* vdp_state_ptrs[];
@@ -10,8 +10,6 @@
 #define VIC_IRQ_SPRSPR	0x04
 #define VIC_IRQ_LPEN	0x08
 
-static int xscr,yscr,adr;
-static unsigned char col,ink,pap,scrbyte,atrbyte;
 
 void vic_irq(Video* vid, int mask) {
 	unsigned char irq = vid->intrq;
@@ -91,47 +89,47 @@ void vic_wr(Video* vid, unsigned short adr, unsigned char val) {
 // text mode
 void vidC64TDraw(Video* vid) {
 	if (vid->reg[0x11] & 0x10) {
-		yscr = vid->ray.y - vid->bord.y;
-		if ((yscr < 0) || (yscr >= vid->scrn.y) || !(vid->reg[0x11] & 0x10)) {
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		if ((vid->dr.yscr < 0) || (vid->dr.yscr >= vid->scrn.y) || !(vid->reg[0x11] & 0x10)) {
 			if (vid->line[vid->ray.xb] != 0xff) {
-				col = vid->line[vid->ray.xb];
+				vid->dr.col = vid->line[vid->ray.xb];
 			} else if (vid->linb[vid->ray.x] != 0xff) {
-				col = vid->linb[vid->ray.xb];
+				vid->dr.col = vid->linb[vid->ray.xb];
 			} else {
-				col = vid->reg[0x20];				// border color
+				vid->dr.col = vid->reg[0x20];				// border color
 			}
 		} else {
-			xscr = vid->ray.x - vid->bord.x;
-			if ((xscr < 0) || (xscr >= vid->scrn.x)) {
-				col = vid->reg[0x20];			// border color
+			vid->dr.xscr = vid->ray.x - vid->bord.x;
+			if ((vid->dr.xscr < 0) || (vid->dr.xscr >= vid->scrn.x)) {
+				vid->dr.col = vid->reg[0x20];			// border color
 			} else {
-				if ((xscr & 7) == 0) {
-					adr = ((yscr >> 3) * 40) + (xscr >> 3);
-					ink = vid->mrd(adr | ((vid->reg[0x18] & 0xf0) << 6), vid->xptr);				// tile nr
+				if ((vid->dr.xscr & 7) == 0) {
+					vid->dr.adr = ((vid->dr.yscr >> 3) * 40) + (vid->dr.xscr >> 3);
+					vid->dr.ink = vid->mrd(vid->dr.adr | ((vid->reg[0x18] & 0xf0) << 6), vid->xptr);				// tile nr
 					if ((~vid->vbank & 1) && ((vid->reg[0x18] & 0x0c) == 0x04)) {
-						scrbyte = vid_fnt_rd(vid, (ink << 3) | (yscr & 7));	// vid->font[(ink << 3) | (yscr & 7)];	// from char rom
+						vid->dr.scrbyte = vid_fnt_rd(vid, (vid->dr.ink << 3) | (vid->dr.yscr & 7));	// vid->font[(ink << 3) | (yscr & 7)];	// from char rom
 					} else {
-						scrbyte = vid->mrd(((vid->reg[0x18] & 0x0e) << 10) | (ink << 3) | (yscr & 7), vid->xptr);	// tile row data
+						vid->dr.scrbyte = vid->mrd(((vid->reg[0x18] & 0x0e) << 10) | (vid->dr.ink << 3) | (vid->dr.yscr & 7), vid->xptr);	// tile row data
 					}
-					ink = vid->colram[adr & 0x3ff];			// tile color
-					pap = vid->reg[0x21];				// background color
+					vid->dr.ink = vid->colram[vid->dr.adr & 0x3ff];			// tile color
+					vid->dr.pap = vid->reg[0x21];				// background color
 				}
 				if (vid->line[vid->ray.xb] != 0xff) {
-					col = vid->line[vid->ray.xb];
-				} else if (scrbyte & 0x80) {
-					col = ink;
+					vid->dr.col = vid->line[vid->ray.xb];
+				} else if (vid->dr.scrbyte & 0x80) {
+					vid->dr.col = vid->dr.ink;
 				} else if (vid->linb[vid->ray.x] != 0xff) {
-					col = vid->linb[vid->ray.xb];
+					vid->dr.col = vid->linb[vid->ray.xb];
 				} else {
-					col = pap;
+					vid->dr.col = vid->dr.pap;
 				}
-				scrbyte <<= 1;
+				vid->dr.scrbyte <<= 1;
 			}
 		}
 	} else {
-		col = vid->reg[0x20];
+		vid->dr.col = vid->reg[0x20];
 	}
-	vid_dot_full(vid, col & 0x0f);
+	vid_dot_full(vid, vid->dr.col & 0x0f);
 }
 
 // multicolor text
@@ -139,148 +137,148 @@ void vidC64TDraw(Video* vid) {
 // if bit 4 in color ram = 0, this is common cell
 
 void vidC64TMDraw(Video* vid) {
-	yscr = vid->ray.y - vid->bord.y;
-	if ((yscr < 0) || (yscr >= vid->scrn.y) || !(vid->reg[0x11] & 0x10)) {
+	vid->dr.yscr = vid->ray.y - vid->bord.y;
+	if ((vid->dr.yscr < 0) || (vid->dr.yscr >= vid->scrn.y) || !(vid->reg[0x11] & 0x10)) {
 		if (vid->line[vid->ray.xb] != 0xff) {
-			col = vid->line[vid->ray.xb];
+			vid->dr.col = vid->line[vid->ray.xb];
 		} else if (vid->linb[vid->ray.xb] != 0xff) {
-			col = vid->linb[vid->ray.xb];
+			vid->dr.col = vid->linb[vid->ray.xb];
 		} else {
-			col = vid->reg[0x20];				// border color
+			vid->dr.col = vid->reg[0x20];				// border color
 		}
 	} else {
-		xscr = vid->ray.x - vid->bord.x;
-		if ((xscr < 0) || (xscr >= vid->scrn.x)) {
-			col = vid->reg[0x20];			// border color
+		vid->dr.xscr = vid->ray.x - vid->bord.x;
+		if ((vid->dr.xscr < 0) || (vid->dr.xscr >= vid->scrn.x)) {
+			vid->dr.col = vid->reg[0x20];			// border color
 		} else {
-			if ((xscr & 7) == 0) {
-				adr = ((yscr >> 3) * 40) + (xscr >> 3);						// offset to tile
-				ink = vid->mrd(adr | ((vid->reg[0x18] & 0xf0) << 6), vid->xptr);		// tile nr
+			if ((vid->dr.xscr & 7) == 0) {
+				vid->dr.adr = ((vid->dr.yscr >> 3) * 40) + (vid->dr.xscr >> 3);						// offset to tile
+				vid->dr.ink = vid->mrd(vid->dr.adr | ((vid->reg[0x18] & 0xf0) << 6), vid->xptr);		// tile nr
 				if ((~vid->vbank & 1) && ((vid->reg[0x18] & 0x0c) == 0x04)) {
-					scrbyte = vid_fnt_rd(vid, (ink << 3) | (yscr & 7));	// vid->font[(ink << 3) | (yscr & 7)];
+					vid->dr.scrbyte = vid_fnt_rd(vid, (vid->dr.ink << 3) | (vid->dr.yscr & 7));	// vid->font[(ink << 3) | (yscr & 7)];
 				} else {
-					scrbyte = vid->mrd(((vid->reg[0x18] & 0x0e) << 10) | (ink << 3) | (yscr & 7), vid->xptr);
+					vid->dr.scrbyte = vid->mrd(((vid->reg[0x18] & 0x0e) << 10) | (vid->dr.ink << 3) | (vid->dr.yscr & 7), vid->xptr);
 				}
-				atrbyte = vid->colram[adr & 0x3ff];			// tile color
-				pap = vid->reg[0x21];				// background color
+				vid->dr.atrbyte = vid->colram[vid->dr.adr & 0x3ff];			// tile color
+				vid->dr.pap = vid->reg[0x21];				// background color
 			}
-			if (vid->line[xscr] != 0xff) {
-				col = vid->line[xscr] & 0x0f;
-			} else if (atrbyte & 8) {
-				switch (scrbyte & 0xc0) {
+			if (vid->line[vid->dr.xscr] != 0xff) {
+				vid->dr.col = vid->line[vid->dr.xscr] & 0x0f;
+			} else if (vid->dr.atrbyte & 8) {
+				switch (vid->dr.scrbyte & 0xc0) {
 					case 0x00:
 						if (vid->linb[vid->ray.xb] != 0xff) {
-							col = vid->linb[vid->ray.xb] & 0x0f;
+							vid->dr.col = vid->linb[vid->ray.xb] & 0x0f;
 						} else {
-							col = vid->reg[0x21];
+							vid->dr.col = vid->reg[0x21];
 						}
 						break;
 					case 0x40:
-						col = vid->reg[0x22];
+						vid->dr.col = vid->reg[0x22];
 						break;
 					case 0x80:
-						col = vid->reg[0x23];
+						vid->dr.col = vid->reg[0x23];
 						break;
 					case 0xc0:
-						col = atrbyte & 7;	// only colors 0..7
+						vid->dr.col = vid->dr.atrbyte & 7;	// only colors 0..7
 						break;
 				}
-				if (xscr & 1) scrbyte <<= 2;
+				if (vid->dr.xscr & 1) vid->dr.scrbyte <<= 2;
 			} else {			// not multicolor
 				if (vid->line[vid->ray.xb] != 0xff) {
-					col = vid->line[vid->ray.xb];
-				} else if (scrbyte & 0x80) {
-					col = atrbyte;
+					vid->dr.col = vid->line[vid->ray.xb];
+				} else if (vid->dr.scrbyte & 0x80) {
+					vid->dr.col = vid->dr.atrbyte;
 				} else if (vid->linb[vid->ray.xb] != 0xff) {
-					col = vid->linb[vid->ray.xb];
+					vid->dr.col = vid->linb[vid->ray.xb];
 				} else {
-					col = pap;
+					vid->dr.col = vid->dr.pap;
 				}
-				scrbyte <<= 1;
+				vid->dr.scrbyte <<= 1;
 			}
 		}
 	}
-	vid_dot_full(vid, col & 0x0f);
+	vid_dot_full(vid, vid->dr.col & 0x0f);
 }
 
 // bitmap
 void vidC64BDraw(Video* vid) {
 	if (vid->reg[0x11] & 0x10) {
-		yscr = vid->ray.y - vid->bord.y;
-		if ((yscr < 0) || (yscr >= vid->scrn.y)) {
-			col = vid->reg[0x20];
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		if ((vid->dr.yscr < 0) || (vid->dr.yscr >= vid->scrn.y)) {
+			vid->dr.col = vid->reg[0x20];
 		} else {
-			xscr = vid->ray.x - vid->bord.x;
-			if ((xscr < 0) || (xscr >= vid->scrn.x)) {
-				col = vid->reg[0x20];
+			vid->dr.xscr = vid->ray.x - vid->bord.x;
+			if ((vid->dr.xscr < 0) || (vid->dr.xscr >= vid->scrn.x)) {
+				vid->dr.col = vid->reg[0x20];
 			} else {
-				if ((xscr & 7) == 0) {
-					adr = (yscr >> 3) * 320 + (xscr & ~7) + (yscr & 7);
-					scrbyte = vid->mrd(adr | ((vid->reg[0x18] & 0x08) << 10), vid->xptr);
-					adr = (yscr >> 3) * 40 + (xscr >> 3);
-					ink = vid->mrd(adr | ((vid->reg[0x18] & 0xf0) << 6), vid->xptr);
-					pap = ink & 0x0f;		// 0
-					ink = (ink >> 4) & 0x0f;	// 1
+				if ((vid->dr.xscr & 7) == 0) {
+					vid->dr.adr = (vid->dr.yscr >> 3) * 320 + (vid->dr.xscr & ~7) + (vid->dr.yscr & 7);
+					vid->dr.scrbyte = vid->mrd(vid->dr.adr | ((vid->reg[0x18] & 0x08) << 10), vid->xptr);
+					vid->dr.adr = (vid->dr.yscr >> 3) * 40 + (vid->dr.xscr >> 3);
+					vid->dr.ink = vid->mrd(vid->dr.adr | ((vid->reg[0x18] & 0xf0) << 6), vid->xptr);
+					vid->dr.pap = vid->dr.ink & 0x0f;		// 0
+					vid->dr.ink = (vid->dr.ink >> 4) & 0x0f;	// 1
 				}
 				if (vid->line[vid->ray.x] != 0xff) {
-					col = vid->line[vid->ray.x];
-				} else if (scrbyte & 0x80) {
-					col = ink;
+					vid->dr.col = vid->line[vid->ray.x];
+				} else if (vid->dr.scrbyte & 0x80) {
+					vid->dr.col = vid->dr.ink;
 				} else if (vid->linb[vid->ray.x] != 0xff) {
-					col = vid->linb[vid->ray.x];
+					vid->dr.col = vid->linb[vid->ray.x];
 				} else {
-					col = pap;
+					vid->dr.col = vid->dr.pap;
 				}
 				// col = (scrbyte & 0x80) ? ink : pap;
-				scrbyte <<= 1;
+				vid->dr.scrbyte <<= 1;
 			}
 		}
 	} else {
-		col = vid->reg[0x20];
+		vid->dr.col = vid->reg[0x20];
 	}
-	vid_dot_full(vid, col & 0x0f);
+	vid_dot_full(vid, vid->dr.col & 0x0f);
 }
 
 // multicolor bitmap
 void vidC64BMDraw(Video* vid) {
 	if (vid->reg[0x11] & 0x10) {
-		yscr = vid->ray.y - vid->bord.y;
-		if ((yscr < 0) || (yscr >= vid->scrn.y)) {
-			col = vid->reg[0x20];
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		if ((vid->dr.yscr < 0) || (vid->dr.yscr >= vid->scrn.y)) {
+			vid->dr.col = vid->reg[0x20];
 		} else {
-			xscr = vid->ray.x - vid->bord.x;
-			if ((xscr < 0) || (xscr >= vid->scrn.x)) {
-				col = vid->reg[0x20];
+			vid->dr.xscr = vid->ray.x - vid->bord.x;
+			if ((vid->dr.xscr < 0) || (vid->dr.xscr >= vid->scrn.x)) {
+				vid->dr.col = vid->reg[0x20];
 			} else {
-				if ((xscr & 7) == 0) {
-					adr = (yscr >> 3) * 320 + (xscr & 0xf8) + (yscr & 7);
-					scrbyte = vid->mrd(adr | ((vid->reg[0x18] & 0x08) << 10), vid->xptr);
+				if ((vid->dr.xscr & 7) == 0) {
+					vid->dr.adr = (vid->dr.yscr >> 3) * 320 + (vid->dr.xscr & 0xf8) + (vid->dr.yscr & 7);
+					vid->dr.scrbyte = vid->mrd(vid->dr.adr | ((vid->reg[0x18] & 0x08) << 10), vid->xptr);
 				}
-				adr = (yscr >> 3) * 40 + (xscr >> 3);
-				ink = vid->mrd(adr | ((vid->reg[0x18] & 0xf0) << 6), vid->xptr);
-				if ((xscr & 1) == 0) {
-					switch (scrbyte & 0xc0) {
+				vid->dr.adr = (vid->dr.yscr >> 3) * 40 + (vid->dr.xscr >> 3);
+				vid->dr.ink = vid->mrd(vid->dr.adr | ((vid->reg[0x18] & 0xf0) << 6), vid->xptr);
+				if ((vid->dr.xscr & 1) == 0) {
+					switch (vid->dr.scrbyte & 0xc0) {
 						case 0x00:
-							col = vid->reg[0x21];
+							vid->dr.col = vid->reg[0x21];
 							break;
 						case 0x40:
-							col = (ink >> 4) & 0x0f;
+							vid->dr.col = (vid->dr.ink >> 4) & 0x0f;
 							break;
 						case 0x80:
-							col = ink & 0x0f;
+							vid->dr.col = vid->dr.ink & 0x0f;
 							break;
 						case 0xc0:
-							col = vid->colram[adr & 0x3ff] >> 4;
+							vid->dr.col = vid->colram[vid->dr.adr & 0x3ff] >> 4;
 							break;
 					}
-					scrbyte <<= 2;
+					vid->dr.scrbyte <<= 2;
 				}
 			}
 		}
 	} else {
-		col = vid->reg[0x20];
+		vid->dr.col = vid->reg[0x20];
 	}
-	vid_dot_full(vid, col & 0x0f);
+	vid_dot_full(vid, vid->dr.col & 0x0f);
 }
 
 void vidC64Fram(Video* vid) {
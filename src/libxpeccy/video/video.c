@@ -6,12 +6,6 @@
 
 #include "video.h"
 
-#if defined(USEOPENGL)
-#define SCRBUF_SIZE	2048*768*4
-#else
-#define SCRBUF_SIZE	3700*2050*4
-#endif
-
 int bytesPerLine = 768;
 int greyScale = 0;
 int noflic = 0;
@@ -19,11 +13,6 @@ int noflicMode = 0;
 float noflicGamma = 2.2f;
 int scanlines = 0;
 
-static unsigned char bufa[SCRBUF_SIZE];
-static unsigned char bufb[SCRBUF_SIZE];
-unsigned char* scrimg = bufa;			// current screen (raw/bw)
-unsigned char* bufimg = bufb;			// previous screen (mixed)
-static int curbuf = 0;
 int bufSize = 3;
 
 int xstep = 0x100;
@@ -34,16 +23,6 @@ int rigSkip = 0;
 int topSkip = 0;
 int botSkip = 0;
 
-// Ring buffer is used for antiflicker to store the history of frames.
-// At least 5 frames are required to perform basic 3-Color mode detection.
-#define RING_FRAMES 5
-unsigned char pscr[SCRBUF_SIZE*RING_FRAMES] __attribute__((aligned(4)));
-
-#if !defined(USEOPENGL)
-static int xpos = 0;
-static int ypos = 0;
-#endif
-
 typedef void(*cbdot)(Video*, unsigned char);
 
 int vid_visible(Video* vid) {
@@ -54,20 +33,19 @@ int vid_visible(Video* vid) {
 	return 1;
 }
 
-static int32_t outcol;
-
 inline void vid_dot_full(Video* vid, unsigned char idx) {
+	int32_t outcol;
 	if (vid->hvis && vid->vvis) {
-		outcol = greyScale ? vid->gpal[idx] : vid->pal[idx];
+		outcol = vid->grey ? vid->gpal[idx] : vid->pal[idx];
 #if defined(USEOPENGL)
 		*(int32_t*)(vid->ray.ptr) = outcol;
 		vid->ray.ptr += 4;
 		*(int32_t*)(vid->ray.ptr) = outcol;
 		vid->ray.ptr += 4;
 #else
-		xpos += xstep;
-		while (xpos > 0xff) {
-			xpos -= 0x100;
+		vid->zoomx += xstep;
+		while (vid->zoomx > 0xff) {
+			vid->zoomx -= 0x100;
 			*(int32_t*)(vid->ray.ptr) = outcol;
 			vid->ray.ptr += 4;
 		}
@@ -76,15 +54,16 @@ inline void vid_dot_full(Video* vid, unsigned char idx) {
 }
 
 inline void vid_dot_half(Video* vid, unsigned char idx) {
+	int32_t outcol;
 	if (vid->hvis && vid->vvis) {
-		outcol = greyScale ? vid->gpal[idx] : vid->pal[idx];
+		outcol = vid->grey ? vid->gpal[idx] : vid->pal[idx];
 #if defined(USEOPENGL)
 		*(int32_t*)(vid->ray.ptr) = outcol;
 		vid->ray.ptr += 4;
 #else
-		xpos += xstep/2;
-		while (xpos > 0xff) {
-			xpos -= 0x100;
+		vid->zoomx += xstep/2;
+		while (vid->zoomx > 0xff) {
+			vid->zoomx -= 0x100;
 			*(int32_t*)(vid->ray.ptr) = outcol;
 			vid->ray.ptr += 4;
 		}
@@ -111,23 +90,23 @@ void vid_line(Video* vid) {
 	}
 	vid->ray.lptr += bytesPerLine;
 #if !defined(USEOPENGL)
-	ypos += ystep;
-	if (vid->linedbl) ypos += ystep;
-	ypos -= 0x100;		// 1 line is already drawn
-	xpos = 0;
+	vid->zoomy += ystep;
+	if (vid->linedbl) vid->zoomy += ystep;
+	vid->zoomy -= 0x100;		// 1 line is already drawn
+	vid->zoomx = 0;
 	if (scanlines) {
 		int x;
 		double rs = 1.0 - 128.0 / ystep;
-		while (ypos > 0) {
-			ypos -= 0x100;
+		while (vid->zoomy > 0) {
+			vid->zoomy -= 0x100;
 			for (x = 0; x < bytesPerLine; x++) {
 				*(vid->ray.lptr + x) = *(vid->ray.lptr + x - bytesPerLine) * rs;
 			}
 			vid->ray.lptr += bytesPerLine;
 		}
 	} else {
-		while (ypos > 0) {
-			ypos -= 0x100;
+		while (vid->zoomy > 0) {
+			vid->zoomy -= 0x100;
 			memcpy(vid->ray.lptr, vid->ray.lptr - bytesPerLine, bytesPerLine);
 			vid->ray.lptr += bytesPerLine;
 		}
@@ -141,7 +120,7 @@ void vid_line(Video* vid) {
 void vid_line_fill(Video* vid) {
 	// TODO: apply scanlines here
 #if !defined(USEOPENGL)
-	int ytmp = ypos;
+	int ytmp = vid->zoomy;
 	unsigned char* ptr = vid->ray.lptr;
 	ytmp += ystep;
 	while (ytmp > 0x100) {
@@ -158,13 +137,13 @@ void vid_frame(Video* vid) {
 	}
 // scanlines TODO: bad @ fullscreen
 #if !defined(USEOPENGL)
-	ypos = 0;
+	vid->zoomy = 0;
 	/*
 	int x,y,ys;
 	double p, ps;
 	unsigned char* ptr;
 	if (scanlines) {
-		ptr = scrimg;
+		ptr = vid->scrimg;
 		p = 0.0;
 		ps = 256.0 / ystep;
 		ys = 0;
@@ -183,14 +162,16 @@ void vid_frame(Video* vid) {
 */
 #endif
 	if (!vid->debug) {
-		scrimg = curbuf ? bufb : bufa;
-		bufimg = curbuf ? bufa : bufb;
-		curbuf = !curbuf;
+		vid->bufsz.x = bytesPerLine >> 2;
+		vid->bufsz.y = vid->vsze.y;
+		vid->bufimg = vid->fbuf[vid->curbuf];
+		vid->curbuf ^= 1;
+		vid->scrimg = vid->fbuf[vid->curbuf];
 	}
 	if (topSkip > 0) {
-		vid_fill_black(scrimg, topSkip * bytesPerLine);
+		vid_fill_black(vid->scrimg, topSkip * bytesPerLine);
 	}
-	vid->ray.lptr = scrimg + topSkip * bytesPerLine;
+	vid->ray.lptr = vid->scrimg + topSkip * bytesPerLine;
 	if (lefSkip > 0)
 		vid_fill_black(vid->ray.lptr, lefSkip);
 	vid->ray.ptr = vid->ray.lptr + lefSkip;
@@ -227,9 +208,15 @@ Video* vidCreate(cbxrd cb, cbirq ci, void* dptr) {
 	vid->ray.x = 0;
 	vid->ray.y = 0;
 	vid->idx = 0;
+	vid->grey = greyScale ? 1 : 0;
 
-	vid->ray.ptr = scrimg;
-	vid->ray.lptr = scrimg;
+	vid->fbuf[0] = (unsigned char*)malloc(SCRBUF_SIZE);
+	vid->fbuf[1] = (unsigned char*)malloc(SCRBUF_SIZE);
+	vid->curbuf = 0;
+	vid->scrimg = vid->fbuf[0];
+	vid->bufimg = vid->fbuf[1];
+	vid->ray.ptr = vid->scrimg;
+	vid->ray.lptr = vid->scrimg;
 
 	return vid;
 }
@@ -238,6 +225,9 @@ void vidDestroy(Video* vid) {
 	ula_destroy(vid->ula);
 	upd7220_destroy(vid->txt7220);
 	upd7220_destroy(vid->grf7220);
+	free(vid->fbuf[0]);
+	free(vid->fbuf[1]);
+	free(vid->ctab);
 	free(vid);
 }
 
@@ -253,6 +243,7 @@ void vid_upd_timings(Video* vid, int nspd) {
 // TODO: for zx only?
 void vid_reset(Video* vid) {
 	int i;
+	vid_flush(vid);
 	for (i = 0; i<16; i++) {
 		vid_reset_col(vid, i);
 	}
@@ -283,7 +274,11 @@ void vid_set_ray(Video* vid, int dots) {
 	dots %= vid->dotPerFrame;
 	vid->ray.y = dots / vid->full.x;
 	vid->ray.x = dots % vid->full.x;
-	vid->ray.ptr = scrimg + (dots * 6);
+	vid->ray.ptr = vid->scrimg + (dots * 6);
+	vid->vvis = (vid->ray.y >= vid->lcut.y) && (vid->ray.y < vid->rcut.y);
+	vid->vbrd = (vid->ray.y < vid->bord.y) || (vid->ray.y >= vid->send.y);
+	vid->hvis = (vid->ray.x >= vid->lcut.x) && (vid->ray.x < vid->rcut.x);
+	vid->hbrd = (vid->ray.x < vid->bord.x) || (vid->ray.x >= vid->send.x);
 }
 
 // new layout:
@@ -306,6 +301,8 @@ void vid_upd_layout(Video* vid) {
 	vid->send.y = vid->bord.y + vid->scrn.y;		// screen end line
 	vid->vBytes = vid->vsze.x * vid->vsze.y * 8;		// real size of image buffer (4 bytes/dot x2:x1)
 	vid->dotPerFrame = vid->full.y * vid->full.x;
+	vid->lazlim = 0;
+	vid->ctkey = -1;
 	vid_upd_timings(vid, vid->nsPerDot);
 }
 
@@ -380,21 +377,12 @@ void vid_fnt_wr(Video* vid, int adr, int val) {
 	}
 }
 
-static int xscr = 0;
-static int yscr = 0;
-static int adr = 0;
-static unsigned char col = 0;
-static unsigned char ink = 0;
-static unsigned char pap = 0;
-static unsigned char scrbyte = 0;
-static unsigned char nxtbyte = 0;
-static unsigned char nxtatr = 0;
 
 void vid_dark_tail(Video* vid) {
 	if (vid->tail) return;				// no filling while current fill is active (till end of frame)
 	unsigned char* ptr = vid->ray.ptr;		// fill current line till EOL
-	unsigned char* zptr = bufimg + (vid->ray.ptr - scrimg); // ptr to prev.frame (place is same as ray at cur.frame)
-	unsigned char* btr = scrimg;			// begin of current buffer
+	unsigned char* zptr = vid->bufimg + (vid->ray.ptr - vid->scrimg); // ptr to prev.frame (place is same as ray at cur.frame)
+	unsigned char* btr = vid->scrimg;			// begin of current buffer
 	// current line
 	while (ptr - vid->ray.lptr < bytesPerLine) {	// dark tail from prev.frame to cur.frame
 		*ptr = ((*zptr - 0x80) >> 2) + 0x80;
@@ -404,7 +392,7 @@ void vid_dark_tail(Video* vid) {
 #if !defined(USEOPENGL)
 	// copy current line
 	vid_line_fill(vid);				// copy filled line due zoom value
-	int ytmp = ypos + ystep;
+	int ytmp = vid->zoomy + ystep;
 	// ptr = vid->ray.lptr;				// move ptr to start of next real line
 	while(ytmp > 0x100) {
 		ytmp -= 0x100;
@@ -423,8 +411,8 @@ void vid_dark_tail(Video* vid) {
 	vid->tail = 1;
 }
 
-void vid_dark_all() {
-	unsigned char* ptr = scrimg;
+void vid_dark_all(Video* vid) {
+	unsigned char* ptr = vid->scrimg;
 	int len = bufSize;
 	while (len > 0) {
 		*ptr = ((*ptr - 0x80) >> 2) + 0x80;
@@ -499,6 +487,7 @@ static int contTabB[] = {2,1,0,0,14,13,12,11,10,9,8,7,6,5,4,3};		// +2A +3 (bank
 
 int vid_wait(Video* vid, int adr) {
 	int* contTab = NULL;
+	if (vid->pend) vid_flush(vid);
 	switch (vid->ula->conttype) {
 		case CONT_PATA:
 			adr &= 0x4000;			// pages 1,3,5,7
@@ -512,15 +501,72 @@ int vid_wait(Video* vid, int adr) {
 	if (!contTab) return 0;				// unknown patern
 	if (!adr) return 0;				// address not in contention limits
 	if (vid->vbrd) return 0;			// border (vertical)
-	xscr = vid->ray.x - vid->bord.x;
-	xscr += vid->ula->early ? 6 : 4;		// 4 for starting @14336, 6 for @14335 (late/early timing?) -> for classic48 screen layout
-	if (xscr < 0) return 0;				// line before contention
-	if (xscr >= vid->scrn.x) return 0;		// line after contention
-	return contTab[xscr & 0x0f] * vid->nsPerDot;	// return time (ns)
+	vid->dr.xscr = vid->ray.x - vid->bord.x;
+	vid->dr.xscr += vid->ula->early ? 6 : 4;		// 4 for starting @14336, 6 for @14335 (late/early timing?) -> for classic48 screen layout
+	if (vid->dr.xscr < 0) return 0;				// line before contention
+	if (vid->dr.xscr >= vid->scrn.x) return 0;		// line after contention
+	return contTab[vid->dr.xscr & 0x0f] * vid->nsPerDot;	// return time (ns)
+}
+
+// contended RAM address mask for current pattern
+int vid_cont_mask(Video* vid) {
+	switch (vid->ula->conttype) {
+		case CONT_PATA: return 0x4000;
+		case CONT_PATB: return 0x10000;
+	}
+	return 0;
+}
+
+// same as vid_wait for dot #pos of frame, in dots
+static int vid_cont_dots(Video* vid, int* contTab, int pos) {
+	int y = pos / vid->full.x;
+	int x = pos % vid->full.x;
+	if ((y < vid->bord.y) || (y >= vid->send.y)) return 0;
+	x -= vid->bord.x;
+	x += vid->ula->early ? 6 : 4;
+	if ((x < 0) || (x >= vid->scrn.x)) return 0;
+	return contTab[x & 0x0f];
 }
 
-void vid_set_grey(int f) {
-	greyScale = f;
+// for each dot: how many cpu ticks (step dots each) cpu waits until vid_wait gives 0
+static void vid_cont_build(Video* vid, int step, int key) {
+	int* contTab = (vid->ula->conttype == CONT_PATB) ? contTabB : contTabA;
+	int size = vid->dotPerFrame;
+	int pos, p, k;
+	if (size != vid->ctsize) {
+		vid->ctab = (unsigned char*)realloc(vid->ctab, size);
+		vid->ctsize = size;
+	}
+	for (pos = 0; pos < size; pos++) {
+		k = 0;
+		p = pos;
+		while ((k < 0xff) && vid_cont_dots(vid, contTab, p)) {
+			k++;
+			p += step;
+			if (p >= size) p -= size;
+		}
+		vid->ctab[pos] = k & 0xff;
+	}
+	vid->ctkey = key;
+}
+
+// cpu ticks to wait on contended memory access, which happens ns after last vid_sync (nspt = ns per cpu tick)
+// return -1 if cpu tick is not a whole number of dots (use vid_wait each tick then)
+int vid_cont(Video* vid, int ns, int nspt) {
+	int step = nspt / vid->nsPerDot;
+	int key;
+	int pos;
+	if ((step < 1) || (step * vid->nsPerDot != nspt)) return -1;
+	key = vid->ula->conttype | (vid->ula->early << 2) | (step << 3);
+	if (key != vid->ctkey)
+		vid_cont_build(vid, step, key);
+	pos = vid->ray.y * vid->full.x + vid->ray.x + vid->pend + (vid->nsDraw + ns) / vid->nsPerDot;
+	if (pos >= vid->ctsize) pos %= vid->ctsize;
+	return vid->ctab[pos];
+}
+
+void vid_set_grey(Video* vid, int f) {
+	vid->grey = f ? 1 : 0;
 }
 
 // palette
@@ -538,6 +584,7 @@ xColor vid_get_col(Video* vid, int i) {
 }
 
 void vid_set_col(Video* vid, int i, xColor xcol) {
+	int32_t outcol;
 	vid->pal[i & 0xff] = xcol.r | (xcol.g << 8) | (xcol.b << 16) | (0xff << 24);
 	outcol = (xcol.b * 30 + xcol.r * 76 + xcol.g * 148) >> 8;
 	vid->gpal[i & 0xff] = outcol | (outcol << 8) | (outcol << 16) | (0xff << 24);
@@ -580,256 +627,407 @@ void vidDrawBorder(Video* vid) {
 }
 
 // ZX Screen 256 x 192
+// catch-up helpers
+
+static inline void vid_adv(Video* vid, int n) {
+	vid->ray.x += n;
+	vid->ray.xb += n;
+	vid->ray.xs += n;
+}
+
+// put n dots of one color
+static inline void vid_dots(Video* vid, unsigned char idx, int n) {
+	int32_t outcol;
+	if (!(vid->hvis && vid->vvis)) return;
+	outcol = vid->grey ? vid->gpal[idx] : vid->pal[idx];
+#if defined(USEOPENGL)
+	n <<= 1;
+#else
+	vid->zoomx += xstep * n;
+	n = vid->zoomx >> 8;
+	vid->zoomx &= 0xff;
+#endif
+	while (n > 0) {
+		*(int32_t*)(vid->ray.ptr) = outcol;
+		vid->ray.ptr += 4;
+		n--;
+	}
+}
+
+// border dots. brdcol can be changed only at first dots of span
+static void zx_brd_span(Video* vid, int n, cbvid dot) {
+	while ((n > 0) && (vid->brdcol != vid->nextbrd)) {
+		if ((vid->ray.x & vid->brdstep) == 0)
+			vid->brdcol = vid->nextbrd;
+		dot(vid);
+		vid_adv(vid, 1);
+		n--;
+	}
+	if (n > 0) {
+		vid->dr.col = vid->brdcol;
+		if (vid->ula->active) vid->dr.col |= 8;
+		vid->atrbyte = 0xff;
+		vid_dots(vid, vid->dr.col, n);
+		vid_adv(vid, n);
+	}
+}
+
+static inline void zx_box_colors(Video* vid) {
+	if (vid->ula->active) {
+		vid->dr.ink = ((vid->atrbyte & 0xc0) >> 2) | (vid->atrbyte & 7);
+		vid->dr.pap = ((vid->atrbyte & 0xc0) >> 2) | ((vid->atrbyte & 0x38) >> 3) | 8;
+	} else {
+		if ((vid->atrbyte & 0x80) && vid->flash) vid->dr.scrbyte ^= 0xff;
+		vid->dr.ink = (vid->atrbyte & 0x07) | ((vid->atrbyte & 0x40) >> 3);
+		vid->dr.pap = (vid->atrbyte & 0x78) >> 3;
+	}
+}
+
 void vidDrawNormal(Video* vid) {
 	if (vid->vbrd) {
-		col = vid->brdcol;
-		if (vid->ula->active) col |= 8;
+		vid->dr.col = vid->brdcol;
+		if (vid->ula->active) vid->dr.col |= 8;
 		vid->atrbyte = 0xff;
 	} else {
-		xscr = vid->ray.x - vid->bord.x;
-		yscr = vid->ray.y - vid->bord.y;
-		if ((xscr & 7) == 3) {
-			adr = (vid->idx & 0x181f) | ((vid->idx & 0x700) >> 3) | ((vid->idx & 0xe0) << 3);
-			nxtbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
+		vid->dr.xscr = vid->ray.x - vid->bord.x;
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		if ((vid->dr.xscr & 7) == 3) {
+			vid->dr.adr = (vid->idx & 0x181f) | ((vid->idx & 0x700) >> 3) | ((vid->idx & 0xe0) << 3);
+			vid->dr.nxtbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
 		}
 		if (vid->hbrd) {
-			col = vid->brdcol;
-			if (vid->ula->active) col |= 8;
+			vid->dr.col = vid->brdcol;
+			if (vid->ula->active) vid->dr.col |= 8;
 			vid->atrbyte = 0xff;
 		} else {
-			if ((xscr & 7) == 0) {
-				scrbyte = nxtbyte;
-				adr = 0x1800 | ((vid->idx & 0x1f00) >> 3) | (vid->idx & 0x1f);
-				vid->atrbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
+			if ((vid->dr.xscr & 7) == 0) {
+				vid->dr.scrbyte = vid->dr.nxtbyte;
+				vid->dr.adr = 0x1800 | ((vid->idx & 0x1f00) >> 3) | (vid->idx & 0x1f);
+				vid->atrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
 				if (vid->idx < 0x1b00) vid->idx++;
 				if (vid->ula->active) {
-					ink = ((vid->atrbyte & 0xc0) >> 2) | (vid->atrbyte & 7);
-					pap = ((vid->atrbyte & 0xc0) >> 2) | ((vid->atrbyte & 0x38) >> 3) | 8;
+					vid->dr.ink = ((vid->atrbyte & 0xc0) >> 2) | (vid->atrbyte & 7);
+					vid->dr.pap = ((vid->atrbyte & 0xc0) >> 2) | ((vid->atrbyte & 0x38) >> 3) | 8;
 				} else {
-					if ((vid->atrbyte & 0x80) && vid->flash) scrbyte ^= 0xff;
-					ink = (vid->atrbyte & 0x07) | ((vid->atrbyte & 0x40) >> 3);
-					pap = (vid->atrbyte & 0x78) >> 3;
+					if ((vid->atrbyte & 0x80) && vid->flash) vid->dr.scrbyte ^= 0xff;
+					vid->dr.ink = (vid->atrbyte & 0x07) | ((vid->atrbyte & 0x40) >> 3);
+					vid->dr.pap = (vid->atrbyte & 0x78) >> 3;
 				}
 			}
-			col = (scrbyte & 0x80) ? ink : pap;
-			scrbyte <<= 1;
+			vid->dr.col = (vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap;
+			vid->dr.scrbyte <<= 1;
+		}
+	}
+	vid_dot_full(vid, vid->dr.col);
+}
+
+static inline void zx_normal_fetch(Video* vid) {
+	vid->dr.adr = (vid->idx & 0x181f) | ((vid->idx & 0x700) >> 3) | ((vid->idx & 0xe0) << 3);
+	vid->dr.nxtbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+}
+
+void vidNormalSpan(Video* vid, int n) {
+	int i;
+	if (vid->vbrd) {
+		zx_brd_span(vid, n, vidDrawNormal);
+	} else if (vid->hbrd) {
+		vid->dr.xscr = vid->ray.x - vid->bord.x;
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		for (i = 0; i < n; i++) {			// idx is not changed in border, last fetch is enough
+			if (((vid->dr.xscr + i) & 7) == 3) {
+				zx_normal_fetch(vid);
+				break;
+			}
 		}
+		zx_brd_span(vid, n, vidDrawNormal);
+		vid->dr.xscr = vid->ray.x - 1 - vid->bord.x;
+	} else {
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		while (n > 0) {
+			vid->dr.xscr = vid->ray.x - vid->bord.x;
+			if ((vid->ray.x & vid->brdstep) == 0)
+				vid->brdcol = vid->nextbrd;
+			switch (vid->dr.xscr & 7) {
+				case 3:
+					zx_normal_fetch(vid);
+					break;
+				case 0:
+					vid->dr.scrbyte = vid->dr.nxtbyte;
+					vid->dr.adr = 0x1800 | ((vid->idx & 0x1f00) >> 3) | (vid->idx & 0x1f);
+					vid->atrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+					if (vid->idx < 0x1b00) vid->idx++;
+					zx_box_colors(vid);
+					break;
+			}
+			vid->dr.col = (vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap;
+			vid->dr.scrbyte <<= 1;
+			vid_dots(vid, vid->dr.col, 1);
+			vid_adv(vid, 1);
+			n--;
+		}
+	}
+}
+
+static inline void ula_fetch(Video* vid) {
+	switch(vid->dr.xscr & 15) {
+		case 12:
+			vid->dr.adr = (vid->idx & 0x181f) | ((vid->idx & 0x700) >> 3) | ((vid->idx & 0xe0) << 3);
+			vid->dr.nxtbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+			break;		// 4dots before each even box: box pix
+		case 14:
+			vid->dr.adr = 0x1800 | ((vid->idx & 0x1f00) >> 3) | (vid->idx & 0x1f);
+			vid->dr.nxtatr = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+			break;		// 2dots before each even box: box atr
+		case 0:
+			vid->dr.scrbyte = vid->dr.nxtbyte;
+			vid->atrbyte = vid->dr.nxtatr;
+			vid->idx++;		// lame (idx is still not updated, but we need address of next box)
+			vid->dr.adr = (vid->idx & 0x181f) | ((vid->idx & 0x700) >> 3) | ((vid->idx & 0xe0) << 3);
+			vid->dr.nxtbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+			vid->idx--;
+			break;		// start of even box: next (odd) box pix
+		case 1:
+			vid->dr.adr = 0x1800 | ((vid->idx & 0x1f00) >> 3) | (vid->idx & 0x1f);
+			vid->dr.nxtatr = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+			break;		// 2nd dot of even box: next (odd) box atr
+		case 8:
+			vid->dr.scrbyte = vid->dr.nxtbyte;
+			vid->atrbyte = vid->dr.nxtatr;
+			break;		// odd box start
 	}
-	vid_dot_full(vid, col);
 }
 
 // this mode default for ZX48K ULA (defferent moments of pix/atr read)
 void ula_dot(Video* vid) {
 	if (vid->vbrd) {
-		col = vid->brdcol;
-		if (vid->ula->active) col |= 8;
+		vid->dr.col = vid->brdcol;
+		if (vid->ula->active) vid->dr.col |= 8;
 		vid->atrbyte = 0xff;
 	} else {
-		xscr = vid->ray.x - vid->bord.x;
-		yscr = vid->ray.y - vid->bord.y;
-		switch(xscr & 15) {
-			case 12:
-				adr = (vid->idx & 0x181f) | ((vid->idx & 0x700) >> 3) | ((vid->idx & 0xe0) << 3);
-				nxtbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
-				break;		// 4dots before each even box: box pix
-			case 14:
-				adr = 0x1800 | ((vid->idx & 0x1f00) >> 3) | (vid->idx & 0x1f);
-				nxtatr = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
-				break;		// 2dots before each even box: box atr
-			case 0:
-				scrbyte = nxtbyte;
-				vid->atrbyte = nxtatr;
-				vid->idx++;		// lame (idx is still not updated, but we need address of next box)
-				adr = (vid->idx & 0x181f) | ((vid->idx & 0x700) >> 3) | ((vid->idx & 0xe0) << 3);
-				nxtbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
-				vid->idx--;
-				break;		// start of even box: next (odd) box pix
-			case 1:
-				adr = 0x1800 | ((vid->idx & 0x1f00) >> 3) | (vid->idx & 0x1f);
-				nxtatr = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
-				break;		// 2nd dot of even box: next (odd) box atr
-			case 8:
-				scrbyte = nxtbyte;
-				vid->atrbyte = nxtatr;
-				break;		// odd box start
-		}
+		vid->dr.xscr = vid->ray.x - vid->bord.x;
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		ula_fetch(vid);
 		if (vid->hbrd) {
-			col = vid->brdcol;
-			if (vid->ula->active) col |= 8;
+			vid->dr.col = vid->brdcol;
+			if (vid->ula->active) vid->dr.col |= 8;
 			vid->atrbyte = 0xff;
 		} else {
-			if ((xscr & 7) == 0) {
+			if ((vid->dr.xscr & 7) == 0) {
 				if (vid->idx < 0x1b00) vid->idx++;
 				if (vid->ula->active) {
-					ink = ((vid->atrbyte & 0xc0) >> 2) | (vid->atrbyte & 7);
-					pap = ((vid->atrbyte & 0xc0) >> 2) | ((vid->atrbyte & 0x38) >> 3) | 8;
+					vid->dr.ink = ((vid->atrbyte & 0xc0) >> 2) | (vid->atrbyte & 7);
+					vid->dr.pap = ((vid->atrbyte & 0xc0) >> 2) | ((vid->atrbyte & 0x38) >> 3) | 8;
 				} else {
-					if ((vid->atrbyte & 0x80) && vid->flash) scrbyte ^= 0xff;
-					ink = (vid->atrbyte & 0x07) | ((vid->atrbyte & 0x40) >> 3);
-					pap = (vid->atrbyte & 0x78) >> 3;
+					if ((vid->atrbyte & 0x80) && vid->flash) vid->dr.scrbyte ^= 0xff;
+					vid->dr.ink = (vid->atrbyte & 0x07) | ((vid->atrbyte & 0x40) >> 3);
+					vid->dr.pap = (vid->atrbyte & 0x78) >> 3;
 				}
 			}
-			col = (scrbyte & 0x80) ? ink : pap;
-			scrbyte <<= 1;
+			vid->dr.col = (vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap;
+			vid->dr.scrbyte <<= 1;
+		}
+	}
+	vid_dot_full(vid, vid->dr.col);
+}
+
+void ula_span(Video* vid, int n) {
+	if (vid->vbrd) {
+		zx_brd_span(vid, n, ula_dot);
+	} else if (vid->hbrd) {
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		while ((n > 0) && (vid->brdcol != vid->nextbrd)) {
+			if ((vid->ray.x & vid->brdstep) == 0)
+				vid->brdcol = vid->nextbrd;
+			ula_dot(vid);
+			vid_adv(vid, 1);
+			n--;
+		}
+		if (n > 0) {
+			vid->dr.col = vid->brdcol;
+			if (vid->ula->active) vid->dr.col |= 8;
+			vid_dots(vid, vid->dr.col, n);
+			while (n > 0) {
+				vid->dr.xscr = vid->ray.x - vid->bord.x;
+				ula_fetch(vid);
+				vid_adv(vid, 1);
+				n--;
+			}
+			vid->atrbyte = 0xff;
+		}
+	} else {
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		while (n > 0) {
+			vid->dr.xscr = vid->ray.x - vid->bord.x;
+			if ((vid->ray.x & vid->brdstep) == 0)
+				vid->brdcol = vid->nextbrd;
+			ula_fetch(vid);
+			if ((vid->dr.xscr & 7) == 0) {
+				if (vid->idx < 0x1b00) vid->idx++;
+				zx_box_colors(vid);
+			}
+			vid->dr.col = (vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap;
+			vid->dr.scrbyte <<= 1;
+			vid_dots(vid, vid->dr.col, 1);
+			vid_adv(vid, 1);
+			n--;
 		}
 	}
-	vid_dot_full(vid, col);
 }
 
 // alco 16col
 void vidDrawAlco(Video* vid) {
 	if (vid->vbrd || vid->hbrd) {
-		col = vid->brdcol;
+		vid->dr.col = vid->brdcol;
 	} else {
-		yscr = vid->ray.y - vid->bord.y;
-		xscr = vid->ray.x - vid->bord.x;
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		vid->dr.xscr = vid->ray.x - vid->bord.x;
 //		if ((xscr < 0) || (xscr > 255)) {
 //			col = vid->brdcol;
 //		} else {
-			adr = ((yscr & 0xc0) << 5) | ((yscr & 7) << 8) | ((yscr & 0x38) << 2) | ((xscr & 0xf8) >> 3);
-			switch (xscr & 7) {
+			vid->dr.adr = ((vid->dr.yscr & 0xc0) << 5) | ((vid->dr.yscr & 7) << 8) | ((vid->dr.yscr & 0x38) << 2) | ((vid->dr.xscr & 0xf8) >> 3);
+			switch (vid->dr.xscr & 7) {
 				case 0:
-					scrbyte = vid->mrd(MADR(vid->vidPage ^ 1, adr), vid->xptr);
-					col = (scrbyte & 7) | ((scrbyte & 0x40) >> 3);
+					vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage ^ 1, vid->dr.adr), vid->xptr);
+					vid->dr.col = (vid->dr.scrbyte & 7) | ((vid->dr.scrbyte & 0x40) >> 3);
 					break;
 				case 2:
-					scrbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
-					col = (scrbyte & 7) | ((scrbyte & 0x40) >> 3);
+					vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+					vid->dr.col = (vid->dr.scrbyte & 7) | ((vid->dr.scrbyte & 0x40) >> 3);
 					break;
 				case 4:
-					scrbyte = vid->mrd(MADR(vid->vidPage ^ 1, adr + 0x2000), vid->xptr);
-					col = (scrbyte & 7) | ((scrbyte & 0x40) >> 3);
+					vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage ^ 1, vid->dr.adr + 0x2000), vid->xptr);
+					vid->dr.col = (vid->dr.scrbyte & 7) | ((vid->dr.scrbyte & 0x40) >> 3);
 					break;
 				case 6:
-					scrbyte = vid->mrd(MADR(vid->vidPage, adr + 0x2000), vid->xptr);
-					col = (scrbyte & 7) | ((scrbyte & 0x40) >> 3);
+					vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr + 0x2000), vid->xptr);
+					vid->dr.col = (vid->dr.scrbyte & 7) | ((vid->dr.scrbyte & 0x40) >> 3);
 					break;
 				default:
-					col = ((scrbyte & 0x38)>>3) | ((scrbyte & 0x80)>>4);
+					vid->dr.col = ((vid->dr.scrbyte & 0x38)>>3) | ((vid->dr.scrbyte & 0x80)>>4);
 					break;
 
 			}
 //		}
 	}
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 // hardware multicolor
 void vidDrawHwmc(Video* vid) {
 	if (vid->vbrd) {
-		col = vid->brdcol;
+		vid->dr.col = vid->brdcol;
 	} else {
-		xscr = vid->ray.x - vid->bord.x;
-		yscr = vid->ray.y - vid->bord.y;
-		if ((xscr & 7) == 4) {
-			adr = ((yscr & 0xc0) << 5) | ((yscr & 7) << 8) | ((yscr & 0x38) << 2) | (((xscr + 4) & 0xf8) >> 3);
-			nxtbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
+		vid->dr.xscr = vid->ray.x - vid->bord.x;
+		vid->dr.yscr = vid->ray.y - vid->bord.y;
+		if ((vid->dr.xscr & 7) == 4) {
+			vid->dr.adr = ((vid->dr.yscr & 0xc0) << 5) | ((vid->dr.yscr & 7) << 8) | ((vid->dr.yscr & 0x38) << 2) | (((vid->dr.xscr + 4) & 0xf8) >> 3);
+			vid->dr.nxtbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
 		}
 		if (vid->hbrd) {
-			col = vid->brdcol;
+			vid->dr.col = vid->brdcol;
 		} else {
-			if ((xscr & 7) == 0) {
-				scrbyte = nxtbyte;
-				adr = ((yscr & 0xc0) << 5) | ((yscr & 7) << 8) | ((yscr & 0x38) << 2) | ((xscr & 0xf8) >> 3);
-				vid->atrbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
-				if ((vid->atrbyte & 0x80) && vid->flash) scrbyte ^= 0xff;
-				ink = (vid->atrbyte & 0x07) | ((vid->atrbyte & 0x40) >> 3);
-				pap = (vid->atrbyte & 0x78) >> 3;
+			if ((vid->dr.xscr & 7) == 0) {
+				vid->dr.scrbyte = vid->dr.nxtbyte;
+				vid->dr.adr = ((vid->dr.yscr & 0xc0) << 5) | ((vid->dr.yscr & 7) << 8) | ((vid->dr.yscr & 0x38) << 2) | ((vid->dr.xscr & 0xf8) >> 3);
+				vid->atrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+				if ((vid->atrbyte & 0x80) && vid->flash) vid->dr.scrbyte ^= 0xff;
+				vid->dr.ink = (vid->atrbyte & 0x07) | ((vid->atrbyte & 0x40) >> 3);
+				vid->dr.pap = (vid->atrbyte & 0x78) >> 3;
 			}
-			col = (scrbyte & 0x80) ? ink : pap;
-			scrbyte <<= 1;
+			vid->dr.col = (vid->dr.scrbyte & 0x80) ? vid->dr.ink : vid->dr.pap;
+			vid->dr.scrbyte <<= 1;
 		}
 	}
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 // atm ega
 void vidDrawATMega(Video* vid) {
-	yscr = vid->ray.y - 76 + 32;	// ???
-	xscr = vid->ray.x - 96 + 64;
-	if ((yscr < 0) || (yscr > 199) || (xscr < 0) || (xscr > 319)) {
-		col = vid->brdcol;
+	vid->dr.yscr = vid->ray.y - 76 + 32;	// ???
+	vid->dr.xscr = vid->ray.x - 96 + 64;
+	if ((vid->dr.yscr < 0) || (vid->dr.yscr > 199) || (vid->dr.xscr < 0) || (vid->dr.xscr > 319)) {
+		vid->dr.col = vid->brdcol;
 	} else {
-		adr = (yscr * 40) + (xscr >> 3);
-		switch (xscr & 7) {
+		vid->dr.adr = (vid->dr.yscr * 40) + (vid->dr.xscr >> 3);
+		switch (vid->dr.xscr & 7) {
 			case 0:
-				scrbyte = vid->mrd(MADR(vid->vidPage ^ 4, adr), vid->xptr) & 0xff;
-				col = (scrbyte & 7) | ((scrbyte & 0x40) >> 3); // inkTab[scrbyte & 0x7f];
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage ^ 4, vid->dr.adr), vid->xptr) & 0xff;
+				vid->dr.col = (vid->dr.scrbyte & 7) | ((vid->dr.scrbyte & 0x40) >> 3); // inkTab[scrbyte & 0x7f];
 				break;
 			case 2:
-				scrbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr) & 0xff;
-				col = (scrbyte & 7) | ((scrbyte & 0x40) >> 3);
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr) & 0xff;
+				vid->dr.col = (vid->dr.scrbyte & 7) | ((vid->dr.scrbyte & 0x40) >> 3);
 				break;
 			case 4:
-				scrbyte = vid->mrd(MADR(vid->vidPage ^ 4, adr + 0x2000), vid->xptr) & 0xff;
-				col = (scrbyte & 7) | ((scrbyte & 0x40) >> 3);
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage ^ 4, vid->dr.adr + 0x2000), vid->xptr) & 0xff;
+				vid->dr.col = (vid->dr.scrbyte & 7) | ((vid->dr.scrbyte & 0x40) >> 3);
 				break;
 			case 6:
-				scrbyte = vid->mrd(MADR(vid->vidPage, adr + 0x2000), vid->xptr) & 0xff;
-				col = (scrbyte & 7) | ((scrbyte & 0x40) >> 3);
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr + 0x2000), vid->xptr) & 0xff;
+				vid->dr.col = (vid->dr.scrbyte & 7) | ((vid->dr.scrbyte & 0x40) >> 3);
 				break;
 			default:
-				col = ((scrbyte & 0x38) >> 3) | ((scrbyte & 0x80) >> 4);
+				vid->dr.col = ((vid->dr.scrbyte & 0x38) >> 3) | ((vid->dr.scrbyte & 0x80) >> 4);
 				break;
 		}
 	}
-	vid_dot_full(vid, col);
+	vid_dot_full(vid, vid->dr.col);
 }
 
 // atm text
 
 void vidDrawByteDD(Video* vid) {		// draw byte $scrbyte with colors $ink,$pap at double-density mode
 	for (int i = 0x80; i > 0; i >>= 1) {
-		vid_dot_half(vid, (scrbyte & i) ? ink : pap);
+		vid_dot_half(vid, (vid->dr.scrbyte & i) ? vid->dr.ink : vid->dr.pap);
 	}
 }
 
 void vidATMDoubleDot(Video* vid,unsigned char colr) {
-	ink = (colr & 0x07) | ((colr & 0x40) >> 3);
-	pap = ((colr & 0x38) >> 3) | ((colr & 0x80) >> 4);
+	vid->dr.ink = (colr & 0x07) | ((colr & 0x40) >> 3);
+	vid->dr.pap = ((colr & 0x38) >> 3) | ((colr & 0x80) >> 4);
 	vidDrawByteDD(vid);
 }
 
 void vidDrawATMtext(Video* vid) {
-	yscr = vid->ray.y - 76 + 32;
-	xscr = vid->ray.x - 96 + 64;
-	if ((yscr < 0) || (yscr > 199) || (xscr < 0) || (xscr > 319)) {
+	vid->dr.yscr = vid->ray.y - 76 + 32;
+	vid->dr.xscr = vid->ray.x - 96 + 64;
+	if ((vid->dr.yscr < 0) || (vid->dr.yscr > 199) || (vid->dr.xscr < 0) || (vid->dr.xscr > 319)) {
 		vid_dot_full(vid, vid->brdcol);
 	} else {
-		adr = 0x1c0 + ((yscr & 0xf8) << 3) + (xscr >> 3);
-		if ((xscr & 3) == 0) {
-			if ((xscr & 7) == 0) {
-				scrbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr) & 0xff;
-				col = vid->mrd(MADR(vid->vidPage ^ 4, adr ^ 0x2000), vid->xptr) & 0xff;
+		vid->dr.adr = 0x1c0 + ((vid->dr.yscr & 0xf8) << 3) + (vid->dr.xscr >> 3);
+		if ((vid->dr.xscr & 3) == 0) {
+			if ((vid->dr.xscr & 7) == 0) {
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr) & 0xff;
+				vid->dr.col = vid->mrd(MADR(vid->vidPage ^ 4, vid->dr.adr ^ 0x2000), vid->xptr) & 0xff;
 			} else {
-				scrbyte = vid->mrd(MADR(vid->vidPage, adr ^ 0x2000), vid->xptr) & 0xff;
-				col = vid->mrd(MADR(vid->vidPage ^ 4, adr + 1), vid->xptr) & 0xff;
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr ^ 0x2000), vid->xptr) & 0xff;
+				vid->dr.col = vid->mrd(MADR(vid->vidPage ^ 4, vid->dr.adr + 1), vid->xptr) & 0xff;
 			}
-			scrbyte = vid_fnt_rd(vid, (scrbyte << 3) | (yscr & 7));	// vid->font[(scrbyte << 3) | (yscr & 7)];
-			vidATMDoubleDot(vid,col);
+			vid->dr.scrbyte = vid_fnt_rd(vid, (vid->dr.scrbyte << 3) | (vid->dr.yscr & 7));	// vid->font[(scrbyte << 3) | (yscr & 7)];
+			vidATMDoubleDot(vid,vid->dr.col);
 		}
 	}
 }
 
 // atm hardware multicolor
 void vidDrawATMhwmc(Video* vid) {
-	yscr = vid->ray.y - 76 + 32;
-	xscr = vid->ray.x - 96 + 64;
-	if ((yscr < 0) || (yscr > 199) || (xscr < 0) || (xscr > 319)) {
+	vid->dr.yscr = vid->ray.y - 76 + 32;
+	vid->dr.xscr = vid->ray.x - 96 + 64;
+	if ((vid->dr.yscr < 0) || (vid->dr.yscr > 199) || (vid->dr.xscr < 0) || (vid->dr.xscr > 319)) {
 		vid_dot_full(vid, vid->brdcol);
 	} else {
 		//xscr = vid->ray.x - 96;
 		//yscr = vid->ray.y - 76;
-		adr = (yscr * 40) + (xscr >> 3);
-		if ((xscr & 3) == 0) {
-			if ((xscr & 7) == 0) {
-				scrbyte = vid->mrd(MADR(vid->vidPage, adr), vid->xptr);
-				col = vid->mrd(MADR(vid->vidPage ^ 4, adr), vid->xptr);
+		vid->dr.adr = (vid->dr.yscr * 40) + (vid->dr.xscr >> 3);
+		if ((vid->dr.xscr & 3) == 0) {
+			if ((vid->dr.xscr & 7) == 0) {
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr), vid->xptr);
+				vid->dr.col = vid->mrd(MADR(vid->vidPage ^ 4, vid->dr.adr), vid->xptr);
 			} else {
-				scrbyte = vid->mrd(MADR(vid->vidPage, adr + 0x2000), vid->xptr);
-				col = vid->mrd(MADR(vid->vidPage ^ 4, adr + 0x2000), vid->xptr);
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage, vid->dr.adr + 0x2000), vid->xptr);
+				vid->dr.col = vid->mrd(MADR(vid->vidPage ^ 4, vid->dr.adr + 0x2000), vid->xptr);
 			}
-			vidATMDoubleDot(vid,col);
+			vidATMDoubleDot(vid,vid->dr.col);
 		}
 		//vid->ray.ptr++;
 		//if (vidFlag & VF_DOUBLE) vid->ray.ptr++;
@@ -839,22 +1037,22 @@ void vidDrawATMhwmc(Video* vid) {
 // baseconf text
 
 void vidDrawEvoText(Video* vid) {
-	yscr = vid->ray.y - 76;
-	xscr = vid->ray.x - 96;
-	if ((yscr < 0) || (yscr > 199) || (xscr < 0) || (xscr > 319)) {
+	vid->dr.yscr = vid->ray.y - 76;
+	vid->dr.xscr = vid->ray.x - 96;
+	if ((vid->dr.yscr < 0) || (vid->dr.yscr > 199) || (vid->dr.xscr < 0) || (vid->dr.xscr > 319)) {
 		vid_dot_full(vid, vid->brdcol);
 	} else {
-		if ((xscr & 3) == 0) {
-			adr = 0x1c0 + ((yscr & 0xf8) << 3) + (xscr >> 3);
-			if ((xscr & 7) == 0) {
-				scrbyte = vid->mrd(MADR(vid->vidPage + 3, adr), vid->xptr);
-				col = vid->mrd(MADR(vid->vidPage + 3, adr + 0x3000), vid->xptr);
+		if ((vid->dr.xscr & 3) == 0) {
+			vid->dr.adr = 0x1c0 + ((vid->dr.yscr & 0xf8) << 3) + (vid->dr.xscr >> 3);
+			if ((vid->dr.xscr & 7) == 0) {
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage + 3, vid->dr.adr), vid->xptr);
+				vid->dr.col = vid->mrd(MADR(vid->vidPage + 3, vid->dr.adr + 0x3000), vid->xptr);
 			} else {
-				scrbyte = vid->mrd(MADR(vid->vidPage + 3, adr + 0x1000), vid->xptr);
-				col = vid->mrd(MADR(vid->vidPage + 3, adr + 0x2001), vid->xptr);
+				vid->dr.scrbyte = vid->mrd(MADR(vid->vidPage + 3, vid->dr.adr + 0x1000), vid->xptr);
+				vid->dr.col = vid->mrd(MADR(vid->vidPage + 3, vid->dr.adr + 0x2001), vid->xptr);
 			}
-			scrbyte = vid_fnt_rd(vid, (scrbyte << 3) | (yscr & 7)); // vid->font[(scrbyte << 3) | (yscr & 7)];
-			vidATMDoubleDot(vid,col);
+			vid->dr.scrbyte = vid_fnt_rd(vid, (vid->dr.scrbyte << 3) | (vid->dr.yscr & 7)); // vid->font[(scrbyte << 3) | (yscr & 7)];
+			vidATMDoubleDot(vid,vid->dr.col);
 		}
 	}
 }
@@ -862,31 +1060,31 @@ void vidDrawEvoText(Video* vid) {
 // profi 512x240
 
 void vidProfiScr(Video* vid) {
-	yscr = vid->ray.y - vid->bord.y + 24;	// (240-192)/2 = 24
-	if ((yscr < 0) || (yscr > 239)) {
+	vid->dr.yscr = vid->ray.y - vid->bord.y + 24;	// (240-192)/2 = 24
+	if ((vid->dr.yscr < 0) || (vid->dr.yscr > 239)) {
 		vid_dot_full(vid, vid->brdcol);
 	} else {
-		xscr = vid->ray.x - vid->bord.x;
-		if ((xscr < 0) || (xscr > 255)) {
+		vid->dr.xscr = vid->ray.x - vid->bord.x;
+		if ((vid->dr.xscr < 0) || (vid->dr.xscr > 255)) {
 			vid_dot_full(vid, vid->brdcol);
 		} else {
-			if ((xscr & 3) == 0) {
+			if ((vid->dr.xscr & 3) == 0) {
 				//adr = scrAdrs[vid->idx & 0x1fff] & 0x1fff;
-				adr = (vid->idx & 0x181f) | ((vid->idx & 0x700) >> 3) | ((vid->idx & 0xe0) << 3);
-				if (xscr & 4) {
+				vid->dr.adr = (vid->idx & 0x181f) | ((vid->idx & 0x700) >> 3) | ((vid->idx & 0xe0) << 3);
+				if (vid->dr.xscr & 4) {
 					vid->idx++;
 				} else {
-					adr |= 0x2000;
+					vid->dr.adr |= 0x2000;
 				}
 				if (vid->vidPage == 7) {
-					scrbyte = vid->mrd(MADR(6, adr), vid->xptr);
-					col = vid->mrd(MADR(0x3a, adr), vid->xptr);		// b0..2 ink, b3..5 pap, b6 inkBR, b7 papBR
+					vid->dr.scrbyte = vid->mrd(MADR(6, vid->dr.adr), vid->xptr);
+					vid->dr.col = vid->mrd(MADR(0x3a, vid->dr.adr), vid->xptr);		// b0..2 ink, b3..5 pap, b6 inkBR, b7 papBR
 				} else {
-					scrbyte = vid->mrd(MADR(4, adr), vid->xptr);
-					col = vid->mrd(MADR(0x38, adr), vid->xptr);
+					vid->dr.scrbyte = vid->mrd(MADR(4, vid->dr.adr), vid->xptr);
+					vid->dr.col = vid->mrd(MADR(0x38, vid->dr.adr), vid->xptr);
 				}
-				ink = (col & 0x07) | ((col & 0x40) >> 3);
-				pap = (col & 0x78) >> 3;
+				vid->dr.ink = (vid->dr.col & 0x07) | ((vid->dr.col & 0x40) >> 3);
+				vid->dr.pap = (vid->dr.col & 0x78) >> 3;
 				vidDrawByteDD(vid);
 			}
 		}
@@ -950,8 +1148,8 @@ void vga_ghi_ini(Video*);
 
 // id,(@on),(@every_visible_dot),(@HBlank),(@LineStart),(@VBlank),(@Frame)
 static xVideoMode vidModeTab[] = {
-	{VID_NORMAL, NULL, vidDrawNormal, NULL, NULL, NULL, NULL},
-	{VID_ULA_SCR, NULL, ula_dot, NULL, NULL, NULL, NULL},
+	{VID_NORMAL, NULL, vidDrawNormal, NULL, NULL, NULL, NULL, vidNormalSpan},
+	{VID_ULA_SCR, NULL, ula_dot, NULL, NULL, NULL, NULL, ula_span},
 	{VID_ALCO, NULL, vidDrawAlco, NULL, NULL, NULL, NULL},
 	{VID_HWMC, NULL, vidDrawHwmc, NULL, NULL, NULL, NULL},
 	{VID_ATM_EGA, NULL, vidDrawATMega, NULL, NULL, NULL, NULL},
@@ -1008,13 +1206,22 @@ void vid_set_core(Video* vid, xVideoMode* xvm) {
 		xvm->init(vid);
 }
 
-void vid_set_mode(Video* vid, int mode) {
-	vid->vmode = mode;
+static xVideoMode* vid_find_core(int mode) {
 	int i = 0;
 	while ((vidModeTab[i].id != VID_UNKNOWN) && (vidModeTab[i].id != mode)) {
 		i++;
 	}
-	vid_set_core(vid, &vidModeTab[i]);
+	return &vidModeTab[i];
+}
+
+void vid_set_mode(Video* vid, int mode) {
+	vid->vmode = mode;
+	vid_set_core(vid, vid_find_core(mode));
+}
+
+// mode callbacks for current vmode, without core init (state was loaded)
+void vid_upd_core(Video* vid) {
+	vid->cb = vid_find_core(vid->vmode);
 }
 
 // NOTE: VBlank starts after last HBlank
@@ -1053,7 +1260,7 @@ void vid_tick(Video* vid) {
 				vid->cb->frm(vid);
 			vid->tail = 0;
 			if (vid->debug)
-				vid_dark_all();
+				vid_dark_all(vid);
 		}
 		if (vid->cb->line)
 			vid->cb->line(vid);
@@ -1097,11 +1304,96 @@ void vid_tick(Video* vid) {
 	if (vid->intf > 0) vid->intf--;
 }
 
+// catch-up rendering
+// vid_sync only counts dots, they are drawn when someone looks at video (vid_flush) or some video event is coming
+// (INT start/end, end of frame). all dots between x-positions where vid_tick changes something, are drawn in a tight loop
+
+// number of dots, that can be drawn without vid_tick bookkeeping
+static int vid_span(Video* vid) {
+	int x = vid->ray.x;
+	int b = vid->full.x;
+	int n;
+	if ((vid->bord.x > x) && (vid->bord.x < b)) b = vid->bord.x;
+	if ((vid->send.x > x) && (vid->send.x < b)) b = vid->send.x;
+	if ((vid->vend.x > x) && (vid->vend.x < b)) b = vid->vend.x;
+	if ((vid->lcut.x > x) && (vid->lcut.x < b)) b = vid->lcut.x;
+	if ((vid->rcut.x > x) && (vid->rcut.x < b)) b = vid->rcut.x;
+	n = b - x - 1;
+	if (vid->intFRAME) {
+		if (n >= vid->intFRAME) n = vid->intFRAME - 1;
+	} else if ((vid->ray.yb == vid->intp.y) && (vid->intp.x > vid->ray.xb) && (vid->inten & 1)) {
+		if (n >= vid->intp.x - vid->ray.xb) n = vid->intp.x - vid->ray.xb - 1;
+	}
+	return n;
+}
+
+static void vid_run(Video* vid, int dots) {
+	cbvid dot = vid->cb->dot;
+	int n;
+	while (dots > 0) {
+		if (!dot || vid->nospan || vid->debug || vid->busy || vid->inth || vid->intf) {
+			n = 0;
+		} else {
+			n = vid_span(vid);
+			if (n > dots) n = dots;
+		}
+		if (n > 0) {
+			dots -= n;
+			if (vid->intFRAME) vid->intFRAME -= n;
+			if (vid->cb->span) {
+				vid->cb->span(vid, n);
+				n = 0;
+			}
+			while (n > 0) {
+				if ((vid->ray.x & vid->brdstep) == 0)
+					vid->brdcol = vid->nextbrd;
+				dot(vid);
+				vid->ray.x++;
+				vid->ray.xb++;
+				vid->ray.xs++;
+				n--;
+			}
+		} else {
+			vid_tick(vid);
+			dots--;
+			dot = vid->cb->dot;
+		}
+	}
+}
+
+// how many dots can be collected before drawing
+static int vid_lazy_limit(Video* vid) {
+	int lim;
+	int dis;
+	if (!vid->lazy || vid->debug || vid->busy || vid->inth || vid->intf) return 0;
+	if ((vid->vmode != VID_NORMAL) && (vid->vmode != VID_ULA_SCR)) return 0;
+	if (vid->intFRAME) return vid->intFRAME;
+	lim = (vid->full.y - vid->ray.y - 1) * vid->full.x + vid->full.x - vid->ray.x;		// end of frame
+	if (vid->inten & 1) {
+		dis = (vid->intp.y - vid->ray.yb) * vid->full.x + vid->intp.x - vid->ray.xb;	// INT position
+		if (dis <= 0) dis += vid->dotPerFrame;
+		if (dis < lim) lim = dis;
+	}
+	return lim;
+}
+
+// draw all collected dots
+void vid_flush(Video* vid) {
+	int dots = vid->pend;
+	vid->pend = 0;
+	if (dots > 0)
+		vid_run(vid, dots);
+	vid->lazlim = vid_lazy_limit(vid);
+}
+
 void vid_sync(Video* vid, int ns) {
+	int dots;
 	vid->nsDraw += ns;
-	while (vid->nsDraw >= vid->nsPerDot) {
-		vid->nsDraw -= vid->nsPerDot;
-		vid->time += vid->nsPerDot;
-		vid_tick(vid);
-	}
+	if (vid->nsDraw < vid->nsPerDot) return;
+	dots = vid->nsDraw / vid->nsPerDot;
+	vid->nsDraw -= dots * vid->nsPerDot;
+	vid->time += dots * vid->nsPerDot;
+	vid->pend += dots;
+	if (vid->pend >= vid->lazlim)
+		vid_flush(vid);
 }
@@ -78,18 +78,22 @@ enum {
 	VID_PC98XX
 };
 
+#if defined(USEOPENGL)
+#define SCRBUF_SIZE	2048*768*4
+#else
+#define SCRBUF_SIZE	3700*2050*4
+#endif
+
+// output settings, shared by all Video instances
+// NOTE: change them only while emulation is stopped
 extern int bufSize;
 extern int bytesPerLine;
-extern int greyScale;
+extern int greyScale;		// default for new Video
 //extern int scanlines;
 extern int noflic;
 extern int noflicMode;
 extern float noflicGamma;
 
-extern unsigned char* scrimg;
-extern unsigned char* bufimg;
-extern unsigned char pscr[];
-
 extern int xstep;
 extern int ystep;
 extern int lefSkip;
@@ -104,6 +108,7 @@ void vid_dot_half(Video*, unsigned char);
 //typedef int(*vcbmrd)(int, void*);
 //typedef void(*vcbmwr)(int, int, void*);
 typedef void(*cbvid)(Video*);
+typedef void(*cbspan)(Video*, int);
 typedef void(*vcbptr)(void*);
 
 typedef struct {
@@ -114,6 +119,7 @@ typedef struct {
 	cbvid line;		// visible line start
 	cbvid vbl;		// @vblank (right after last line)
 	cbvid frm;		// @1st visible line (called before cbLine)
+	cbspan span;		// N dots w/o line/frame events (catch-up), NULL = dot by dot
 } xVideoMode;
 
 struct Video {
@@ -139,11 +145,19 @@ struct Video {
 
 	unsigned hvis:1;
 	unsigned vvis:1;
+	unsigned grey:1;	// output in greyscale (gpal)
+	unsigned lazy:1;	// catch-up rendering allowed
+	unsigned nospan:1;	// draw dot by dot through vid_tick (reference path)
 
 	int nsPerFrame;
 	int nsPerLine;
 	int nsPerDot;
 	int nsDraw;
+	int pend;		// dots collected, but not drawn yet (catch-up)
+	int lazlim;		// draw collected dots when there is so many of them
+	unsigned char* ctab;	// contention: cpu ticks to wait for each dot of frame
+	int ctkey;		// pattern/layout/step ctab was built for
+	int ctsize;
 	int time;		// +nsPerDot each dot
 	int busy;		// (cycles) to emulate busy period
 	int intTime;
@@ -190,6 +204,7 @@ struct Video {
 	vCoord lcut;
 	vCoord rcut;
 	vCoord vsze;		// visible area size (cutted)
+	vCoord bufsz;		// bufimg size in pixels (row = bytesPerLine when it was drawn), set at frame end
 	vCoord intp;		// intp.y = gbc lyc = 9938 iLine
 	int intsize;
 	vCoord res;		// current resolution (-1 = from layout)
@@ -351,6 +366,34 @@ struct Video {
 	ulaPlus* ula;
 	upd7220* txt7220;
 	upd7220* grf7220;
+
+	// output image
+	unsigned char* scrimg;			// current screen (being drawn)
+	unsigned char* bufimg;			// previous screen (complete)
+	unsigned char* fbuf[2];
+	int curbuf;
+	int zoomx;				// zoom counters (xstep/ystep)
+	int zoomy;
+	// renderer temporary values
+	struct {
+		int xscr;
+		int yscr;
+		int adr;
+		int fadr;
+		int sadr;
+		int xadr;
+		int tile;
+		unsigned char col;
+		unsigned char ink;
+		unsigned char pap;
+		unsigned char cola;
+		unsigned char colb;
+		unsigned char scrbyte;
+		unsigned char atrbyte;
+		unsigned char nxtbyte;
+		unsigned char nxtatr;
+		unsigned char sbyte;
+	} dr;
 };
 
 Video* vidCreate(cbxrd, cbirq, void*);
@@ -358,12 +401,16 @@ void vidDestroy(Video*);
 
 void vid_reset(Video*);
 void vid_sync(Video*,int);
+void vid_flush(Video*);
 // void vid_irq(Video*, int);
 void vid_set_mode(Video*,int);
+void vid_upd_core(Video*);
 void vid_reset_ray(Video*);
 void vid_set_ray(Video*, int);
 
 int vid_wait(Video*, int);
+int vid_cont_mask(Video*);
+int vid_cont(Video*, int, int);
 void vid_dark_tail(Video*);
 
 void vid_set_layout(Video*, vLayout*);
@@ -374,7 +421,7 @@ void vid_upd_timings(Video*, int);
 
 void vid_get_screen(Video*, unsigned char*, int, int, int);
 
-void vid_set_grey(int);
+void vid_set_grey(Video*, int);
 xColor vid_get_col(Video*, int);
 void vid_set_col(Video*, int, xColor);
 void vid_set_red(Video*, int, int);
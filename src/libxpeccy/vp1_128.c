@@ -57,6 +57,9 @@ void vpwrite(FDC* fdc) {
 
 static fdcCall vpSpin[] = {vpseek, vpread, vpwrite, NULL};
 
+// plans by id for state (see state.c)
+void* vp1_128_state_ptrs[] = {vpSpin, NULL};
+
 // extern
 
 void vp1_reset(FDC* fdc) {
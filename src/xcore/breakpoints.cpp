@@ -177,18 +177,24 @@ void brkDelete(xBrkPoint dbrk) {
 
 void brk_clear_tmp(Computer* comp) {
 	int i;
-	for (i = 0; i < MEM_4M; i++) {
+	for (i = 0; comp->brkRamMap && (i < MEM_4M); i++) {
 		comp->brkRamMap[i] &= ~MEM_BRK_TFETCH;
 	}
-	for (i = 0; i < MEM_512K; i++) {
+	for (i = 0; comp->brkRomMap && (i < MEM_512K); i++) {
 		comp->brkRomMap[i] &= ~MEM_BRK_TFETCH;
 	}
 	for (i = 0; i < MEM_64K; i++) {
 		comp->brkAdrMap[i] &= ~MEM_BRK_TFETCH;
 	}
+	for (i = 0; comp->slot->brkMap && (i <= comp->slot->memMask); i++) {
+		comp->slot->brkMap[i] &= ~MEM_BRK_TFETCH;
+	}
+	comp_upd_slot_brk(comp);
+	comp_upd_brk_pages(comp);
 }
 
 void clearMap(unsigned char* ptr, int siz) {
+	if (!ptr) return;
 	while (siz > 0) {
 		*ptr &= 0xf0;
 		ptr++;
@@ -201,6 +207,7 @@ void brkInstall(xBrkPoint* brk, int del) {
 		brkDelete(*brk);
 	} else {
 		unsigned char* ptr = NULL;
+		unsigned char* bmap = NULL;
 		Computer* comp = conf.prof.cur->zx;
 		unsigned char msk = 0;
 		std::map<int, xBrkPoint*>* map = NULL;
@@ -231,21 +238,26 @@ void brkInstall(xBrkPoint* brk, int del) {
 				}
 				break;
 			case BRK_CPUADR:
+				bmap = comp->brkAdrMap;
 				ptr = comp->brkAdrMap + (brk->adr & 0xffff);
 				cnt = brk->eadr - brk->adr + 1;
 				break;
 			case BRK_MEMRAM:
-				ptr = comp->brkRamMap + (brk->adr & comp->mem->ramMask);
+				bmap = comp_brk_map(comp, MEM_RAM);
+				ptr = bmap + (brk->adr & comp->mem->ramMask);
 				cnt = brk->eadr - brk->adr + 1;
 				break;
 			case BRK_MEMROM:
-				ptr = comp->brkRomMap + (brk->adr & comp->mem->romMask);
+				bmap = comp_brk_map(comp, MEM_ROM);
+				ptr = bmap + (brk->adr & comp->mem->romMask);
 				cnt = brk->eadr - brk->adr + 1;
 				break;
 			case BRK_MEMSLT:
 				if (!comp->slot->brkMap) break;
-				ptr = comp->slot->brkMap + (brk->adr & comp->slot->memMask);
-				cnt = brk->eadr - brk->adr + 1;
+				for (adr = brk->adr; adr <= brk->eadr; adr++) {
+					comp_set_slot_brk(comp, adr, msk);
+					if (map) (*map)[adr] = brk;
+				}
 				break;
 			case BRK_IRQ:
 				comp->flgIBRK = !brk->off;
@@ -258,7 +270,10 @@ void brkInstall(xBrkPoint* brk, int del) {
 				*ptr &= 0xf0;
 				*ptr |= (msk & 0x0f);
 				ptr++;
-				if (map) (*map)[adr++] = brk;
+				if (map) (*map)[adr] = brk;
+				if (bmap && ((((ptr - bmap) & 0xff) == 0) || (cnt == 1)))	// page done: update summary
+					comp_upd_brk(comp, brk->type, ptr - bmap - 1);
+				adr++;
 				cnt--;
 			}
 		}
@@ -283,6 +298,8 @@ void brkInstallAll() {
 		clearMap(comp->slot->brkMap, comp->slot->memMask + 1);
 	prf->brk.map.clear();
 	comp->flgIBRK = 0;
+	comp_upd_slot_brk(comp);
+	comp_upd_brk_pages(comp);
 #if 1
 	brkInstallList(&prf->brk.list);
 	brkInstallList(&prf->brk.list_sys);
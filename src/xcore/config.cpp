@@ -107,6 +107,9 @@ void conf_init(char* wpath, char* confdir) {
 	conf.boot = 1;
 	conf.emu.pause = 0;
 	conf.emu.fast = 0;
+	conf.emu.rewind = 0;		// rewind ring MB, 0 = off
+	conf.emu.back = 0;
+	conf.emu.rwd = NULL;
 	conf.gpctrl = new xGamepadController;
 	addProfile("default","xpeccy.conf");
 
@@ -127,6 +130,7 @@ void saveConfig() {
 	fprintf(cfile, "addboot = %s\n", YESNO(conf.boot));
 	fprintf(cfile, "exit.confirm = %s\n",YESNO(conf.confexit));
 	fprintf(cfile, "port = %i\n", conf.port);
+	fprintf(cfile, "rewind = %i\n", conf.emu.rewind);
 	fprintf(cfile, "winpos = %i,%i\n",conf.xpos,conf.ypos);
 	fprintf(cfile, "flpinterleave = %i\n", flp_get_interleave());
 	fprintf(cfile, "style = %s\n", conf.style.c_str());
@@ -450,7 +454,7 @@ void loadConfig() {
 						if (noflicGamma < 1) noflicGamma = 1;
 						if (noflicGamma > 3) noflicGamma = 3;
 					}
-					if (pnam=="greyscale") vid_set_grey(arg.b);
+					if (pnam=="greyscale") greyScale = arg.b ? 1 : 0;
 					if (pnam=="shader") conf.vid.shader = pval;
 					break;
 				case SECT_ROMSETS:
@@ -538,6 +542,7 @@ void loadConfig() {
 					if (pnam=="savepaths") conf.storePaths = arg.b;
 					if (pnam == "fdcturbo") setFlagBit(arg.b, &fdcFlag, FDC_FAST);
 					if (pnam == "port") conf.port = arg.i & 0xffff;
+					if (pnam == "rewind") conf.emu.rewind = getRanged(arg.s, 0, 1024);
 					if (pnam == "winpos") {
 						vect = splitstr(pval, ",");
 						if (vect.size() > 1) {
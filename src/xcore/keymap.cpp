@@ -440,11 +440,13 @@ static xShortcut short_tab[] = {
 //	{SCG_MAIN, XCUT_TVLINES, "key.scanlines", "Switch scanlines", QKeySequence(), QKeySequence()},
 	{SCG_MAIN, XCUT_WAV_OUT, "key.write.wav", "Start/stop wav output", QKeySequence(), QKeySequence()},
 	{SCG_MAIN, XCUT_RELOAD_SHD, "key.reload.shader", "Reload shader", QKeySequence(), QKeySequence()},
+	{SCG_MAIN, XCUT_REWIND, "key.rewind", "Rewind", QKeySequence(), QKeySequence(Qt::ALT | Qt::Key_B)},
 
 	{SCG_DEBUGA, XCUT_STEPIN, "key.dbg.stepin", "DeBUGa: Step in", QKeySequence(), QKeySequence(Qt::Key_F7)},
 	{SCG_DEBUGA, XCUT_STEPOVER, "key.dbg.stepover", "DeBUGa: Step over", QKeySequence(), QKeySequence(Qt::Key_F8)},
 	{SCG_DEBUGA, XCUT_STEPOUT, "key.dbg.stepout", "DeBUGa: Step out", QKeySequence(), QKeySequence(Qt::Key_F6)},
 	{SCG_DEBUGA, XCUT_FASTSTEP, "key.dbg.faststep", "DeBUGa: Fast step", QKeySequence(), QKeySequence(Qt::ALT | Qt::Key_F7)},
+	{SCG_DEBUGA, XCUT_STEPBACK, "key.dbg.stepback", "DeBUGa: Step back", QKeySequence(), QKeySequence(Qt::SHIFT | Qt::Key_F7)},
 	{SCG_DEBUGA, XCUT_TMPBRK, "key.dbg.runtohere", "DeBUGa: Stop here", QKeySequence(), QKeySequence(Qt::Key_F9)},
 	{SCG_DEBUGA, XCUT_TRACE, "key.dbg.trace", "DeBUGa: Trace", QKeySequence(), QKeySequence(Qt::CTRL | Qt::Key_T)},
 	{SCG_DEBUGA, XCUT_OPEN_DUMP, "key.dbg.opendump", "DeBUGa: Load dump", QKeySequence(), QKeySequence(Qt::CTRL | Qt::Key_O)},
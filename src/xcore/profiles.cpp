@@ -63,7 +63,7 @@ xProfile* addProfile(std::string nm, std::string fp) {
 	nprof->name = nm;
 	nprof->file = fp;
 	nprof->layName = std::string("default");
-//	nprof->zx = compCreate();			// TODO: delayed
+	nprof->zx = NULL;				// created when profile becomes current (see prfSetCurrent)
 	nprof->curlabset = nullptr;
 	std::string fname;
 	fname = conf.path.prfDir + SLASH + nprof->name;
@@ -72,9 +72,6 @@ xProfile* addProfile(std::string nm, std::string fp) {
 #elif defined(__WIN32)
 	mkdir(fname.c_str());
 #endif
-//	prf_load_cmos(nprof, conf.path.prfDir + SLASH + nprof->name + SLASH + nprof->name + ".cmos");	// TODO: delayed
-//	prf_load_nvram(nprof, conf.path.prfDir + SLASH + nprof->name + SLASH + nprof->name + ".nvram");	// TODO: delayed
-//	prfSetHardware(nprof,"Dummy");			// TODO: delayed
 	conf.prof.list.push_back(nprof);
 	return nprof;
 }
@@ -130,7 +127,8 @@ int delProfile(std::string nm) {
 			cpath = cdir + prf->name + ".nvram";
 			remove(cpath.c_str());					// remove nvram dump
 			rmdir(cdir.c_str());					// remove directory (leave it if there is files)
-			compDestroy(prf->zx);					// delete computer
+			if (prf->zx)
+				compDestroy(prf->zx);				// delete computer
 			delete(prf);
 			conf.prof.list.erase(conf.prof.list.begin() + i);
 		}
@@ -143,6 +141,8 @@ bool prfSetCurrent(std::string nm) {
 	xProfile* nprf = findProfile(nm);
 	if (nprf == NULL) return false;
 	prfClose();
+	if (conf.emu.rwd)
+		rw_clear(conf.emu.rwd);
 	conf.prof.cur = nprf;
 	if (nprf->initrq) {
 		conf.emu.pause |= PR_EXTRA;
@@ -239,54 +239,12 @@ void prfSetRomset(xProfile* prf, std::string rnm) {
 	prf->rsName = rnm;
 	xRomset* rset = findRomset(rnm);
 	std::string fpath;
-	int romsz = MEM_256; // prf->zx->mem->romSize;	// 0?
-	int foff;
-	int fsze;
-	int roff;
 	FILE* file;
 	if (rset) {
-		memset(prf->zx->mem->romData, 0xff, MEM_512K);
-		foreach(xRomFile xrf, rset->roms) {
-			foff = xrf.foffset * 1024;
-			roff = xrf.roffset * 1024;
-			fpath = conf.path.romDir + SLASH + xrf.name;
-			file = fopen(fpath.c_str(), "rb");
-			if (file) {
-				if (xrf.fsize <= 0) {			// check part size
-					fseek(file, 0, SEEK_END);
-					fsze = ftell(file);
-					rewind(file);
-				} else {
-					fsze = xrf.fsize * 1024;
-				}
-				if (roff + fsze > romsz) {	// check crossing rom top
-					romsz = toLimits(roff + fsze, MEM_256, MEM_512K);
-					romsz = toPower(romsz);
-				}
-				if (roff + fsze > romsz)	// check again (if 512K limit)
-					fsze = romsz - roff;
-				if ((foff >= 0) && (roff >= 0) && (roff < MEM_512K) && (fsze > 0)) {	// load rom if all is ok
-					fseek(file, foff, SEEK_SET);
-					fread(prf->zx->mem->romData + roff, fsze, 1, file);
-				}
-				fclose(file);
-			} else {
-				printf("Can't load rom file '%s'\n",fpath.c_str());
-			}
-		}
-		memSetSize(prf->zx->mem, -1, romsz);
+		mem_set_rom(prf->zx->mem, romsetImage(rset));		// shared with other profiles
 // load GS ROM
-		if (!rset->gsFile.empty()) {
-			fpath = conf.path.romDir + SLASH + rset->gsFile;
-			file = fopen(fpath.c_str(), "rb");
-			if (file) {
-				fread(prf->zx->gs->mem->romData, MEM_32K, 1, file);
-				fclose(file);
-			} else {
-				printf("Can't load gs rom '%s' (profile %s)\n", fpath.c_str(), prf->name.c_str());
-				memset((char*)prf->zx->gs->mem->romData, 0xff, MEM_32K);
-			}
-		}
+		if (!rset->gsFile.empty())
+			mem_set_rom(prf->zx->gs->mem, romsetGsImage(rset));
 // load font data
 		if (!rset->fntFile.empty()) {
 			fpath = conf.path.romDir + SLASH + rset->fntFile;
@@ -422,6 +380,7 @@ int prf_load_conf(xProfile* prf, std::string cfname, int flag) {
 					if (pnam == "gs") comp->gs->enable = arg.b;
 					if (pnam == "gs.reset") comp->gs->reset = arg.b;
 					if (pnam == "gs.stereo") comp->gs->stereo = arg.b ? GS_12_34 : GS_MONO;
+					if (pnam == "gs.thread") gs_thread(comp->gs, arg.b);
 
 					if (pnam == "ts.type") comp->ts->type = arg.i;
 					if (pnam == "soundrive_type") comp->sdrv->type = arg.i;
@@ -473,6 +432,7 @@ int prf_load_conf(xProfile* prf, std::string cfname, int flag) {
 					}
 					if (pnam == "contmem") comp->flgCNTM = arg.b;
 					if (pnam == "contio") comp->flgCNTI = arg.b;
+					if (pnam == "cpu.cache") cpu_set_cache(comp->cpu, arg.b);
 					if (pnam == "scrp.wait") comp->flgEM1 = arg.b;
 					if (pnam == "lastdir") prf->lastDir = pval;
 					break;
@@ -570,6 +530,7 @@ int prf_load_conf(xProfile* prf, std::string cfname, int flag) {
 int prfLoad(std::string nm) {
 	xProfile* prf = findProfile(nm);
 	if (prf == NULL) return PLOAD_NF;
+	if (prf->initrq) return PLOAD_OK;		// not created yet, config will be loaded when it becomes current
 	//char cfname[FILENAME_MAX];
 	std::string cfname = conf.path.prfDir + SLASH + prf->name + SLASH + prf->file;		// new location: $CONFDIR/profiles/$PROFILENAME/$FILENAME
 	std::string ofname = conf.path.confDir + SLASH + prf->file;				// old location: $CONFDIR/$FILENAME
@@ -654,6 +615,7 @@ int prfSave(std::string nm) {
 		fprintf(file, "cpu.type = %s\n", comp->cpu->core->name);
 	}
 	fprintf(file, "cpu.frq = %i\n", int(comp->cpuFrq * 1e6));
+	fprintf(file, "cpu.cache = %s\n", YESNO(comp->cpu->cache));
 	fprintf(file, "frq.mul = %f\n", comp->frqMul);
 	fprintf(file, "scrp.wait = %s\n", YESNO(comp->flgEM1));
 	fprintf(file, "contio = %s\n", YESNO(comp->flgCNTI));
@@ -693,6 +655,7 @@ int prfSave(std::string nm) {
 	fprintf(file, "gs = %s\n", YESNO(comp->gs->enable));
 	fprintf(file, "gs.reset = %s\n", YESNO(comp->gs->stereo));
 	fprintf(file, "gs.stereo = %i\n", comp->gs->stereo);
+	fprintf(file, "gs.thread = %s\n", YESNO(comp->gs->thr));
 
 	fprintf(file, "soundrive_type = %i\n", comp->sdrv->type);
 
@@ -1,6 +1,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <fstream>
+#include <map>
+#include <vector>
+#include <sys/stat.h>
 
 #include "xcore.h"
 
@@ -29,7 +32,145 @@ bool addRomset(xRomset rs) {
 	return true;
 }
 
+static void rs_image_drop(const std::string&);
+
 void delRomset(int idx) {
+	rs_image_drop(conf.rsList[idx].name);
 	conf.rsList.erase(conf.rsList.begin() + idx);
 	sortRomsetList();
 }
+
+// romset images: loaded once, shared by all profiles with the same romset (see mem_set_rom)
+// key = files with offsets/sizes and modification time, so changed romset or file gives new image
+// every romset holds one image (and gs one): image is destroyed when no romset holds it anymore
+
+typedef struct {
+	xRomImage* img;
+	int refs;		// romsets holding it
+} xRsImage;
+
+static std::map<std::string, xRsImage> rsImages;	// key : image
+static std::map<std::string, std::string> rsHolds;	// romset name (gs|name for gs) : key of its image
+
+static void rs_image_release(const std::string& key) {
+	std::map<std::string, xRsImage>::iterator it = rsImages.find(key);
+	if (it == rsImages.end()) return;
+	it->second.refs--;
+	if (it->second.refs < 1) {
+		rom_image_destroy(it->second.img);
+		rsImages.erase(it);
+	}
+}
+
+// image with this key for holder, previous image of holder is released. NULL if there is no such image yet
+static xRomImage* rs_image_find(const std::string& hold, const std::string& key) {
+	std::map<std::string, std::string>::iterator hit = rsHolds.find(hold);
+	std::map<std::string, xRsImage>::iterator it;
+	if (hit != rsHolds.end()) {
+		if (hit->second == key)
+			return rsImages[key].img;
+		rs_image_release(hit->second);
+		rsHolds.erase(hit);
+	}
+	it = rsImages.find(key);
+	if (it == rsImages.end()) return NULL;
+	it->second.refs++;
+	rsHolds[hold] = key;
+	return it->second.img;
+}
+
+// romset is deleted: release its images
+static void rs_image_drop(const std::string& name) {
+	std::map<std::string, std::string>::iterator hit;
+	std::string hold[2] = {name, "gs|" + name};
+	for (int i = 0; i < 2; i++) {
+		hit = rsHolds.find(hold[i]);
+		if (hit == rsHolds.end()) continue;
+		rs_image_release(hit->second);
+		rsHolds.erase(hit);
+	}
+}
+
+static xRomImage* rs_image_add(const std::string& hold, const std::string& key, xRomImage* img) {
+	xRsImage rsi;
+	rsi.img = img;
+	rsi.refs = 1;
+	rsImages[key] = rsi;
+	rsHolds[hold] = key;
+	return img;
+}
+
+static std::string rs_file_key(std::string name) {
+	struct stat st;
+	std::string fpath = conf.path.romDir + SLASH + name;
+	char buf[64];
+	if (stat(fpath.c_str(), &st) != 0) {
+		st.st_mtime = 0;
+		st.st_size = 0;
+	}
+	snprintf(buf, 63, ":%lli:%lli|", (long long)st.st_mtime, (long long)st.st_size);
+	return name + buf;
+}
+
+xRomImage* romsetImage(xRomset* rset) {
+	std::string key;
+	std::string fpath;
+	std::vector<unsigned char> buf(MEM_512K, 0xff);
+	int romsz = MEM_256;
+	int foff;
+	int fsze;
+	int roff;
+	FILE* file;
+	xRomImage* img;
+	foreach(xRomFile xrf, rset->roms) {
+		key += rs_file_key(xrf.name) + std::to_string(xrf.foffset) + ":" + std::to_string(xrf.fsize) + ":" + std::to_string(xrf.roffset) + "|";
+	}
+	img = rs_image_find(rset->name, key);
+	if (img) return img;
+	foreach(xRomFile xrf, rset->roms) {
+		foff = xrf.foffset * 1024;
+		roff = xrf.roffset * 1024;
+		fpath = conf.path.romDir + SLASH + xrf.name;
+		file = fopen(fpath.c_str(), "rb");
+		if (file) {
+			if (xrf.fsize <= 0) {			// check part size
+				fseek(file, 0, SEEK_END);
+				fsze = ftell(file);
+				rewind(file);
+			} else {
+				fsze = xrf.fsize * 1024;
+			}
+			if (roff + fsze > romsz) {	// check crossing rom top
+				romsz = toLimits(roff + fsze, MEM_256, MEM_512K);
+				romsz = toPower(romsz);
+			}
+			if (roff + fsze > romsz)	// check again (if 512K limit)
+				fsze = romsz - roff;
+			if ((foff >= 0) && (roff >= 0) && (roff < MEM_512K) && (fsze > 0)) {	// load rom if all is ok
+				fseek(file, foff, SEEK_SET);
+				fread(buf.data() + roff, fsze, 1, file);
+			}
+			fclose(file);
+		} else {
+			printf("Can't load rom file '%s'\n",fpath.c_str());
+		}
+	}
+	return rs_image_add(rset->name, key, rom_image_create(buf.data(), romsz));
+}
+
+xRomImage* romsetGsImage(xRomset* rset) {
+	std::string key = "gs|" + rs_file_key(rset->gsFile);
+	std::string fpath = conf.path.romDir + SLASH + rset->gsFile;
+	std::vector<unsigned char> buf(MEM_32K, 0xff);
+	FILE* file;
+	xRomImage* img = rs_image_find("gs|" + rset->name, key);
+	if (img) return img;
+	file = fopen(fpath.c_str(), "rb");
+	if (file) {
+		fread(buf.data(), MEM_32K, 1, file);
+		fclose(file);
+	} else {
+		printf("Can't load gs rom '%s' (romset %s)\n", fpath.c_str(), rset->name.c_str());
+	}
+	return rs_image_add("gs|" + rset->name, key, rom_image_create(buf.data(), MEM_32K));
+}
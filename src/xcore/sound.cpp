@@ -1,8 +1,5 @@
 #include <stdio.h>
 
-#define _USE_MATH_DEFINES
-#include <cmath>
-
 #include "sound.h"
 #include "xcore.h"
 
@@ -21,84 +18,63 @@ static int smpCount = 0;
 OutSys *sndOutput = NULL;
 // static int sndChunks = 882;
 
-#define DISCRATE 32
-int nsPerSample = 22675;
-// static int disCount = 0;
-static sndPair tmpLev = {0, 0};
-static sndPair sndLev;
+int nsPerSample = 22675 / BLEP_POLL;		// machine output polling period
+static sndPair sndLev;				// last output level
 
 OutSys* findOutSys(const char*);
 
-static long double H[DISCRATE] = {0};
-
-static int sb_pos = 0;
-static int sp_pos = 0;
-static sndPair smpBuf[128] = {{0,0}};
-
 #if defined(HAVESDL2)
 static SDL_AudioDeviceID sdldevid;
 #endif
 
 // output
 
-#define USEKIH 0
-
+// called every nsPerSample: poll machine output level, get ready samples from resampler
 // return 1 when buffer is full
 // NOTE: need sync|flush devices if debug
 int sndSync(Computer* comp) {
+	sndBlep* bl = comp->blep;
+	sndPair smp[16];
+	sndPair lev;
+	int cnt;
+	int i;
 	if (!conf.emu.pause || comp->flgDBG) {
+		comp_snd_sync(comp);
 		if (comp->hw->grp == HWG_ZX)
 			gsFlush(comp->gs);
 //		saaFlush(comp->saa);
 		if (!conf.emu.fast && !conf.emu.pause) {
-			sndLev = comp->hw->vol(comp, &conf.snd.vol);
-			sndLev.left = sndLev.left * conf.snd.vol.master / 100;
-			sndLev.right = sndLev.right * conf.snd.vol.master / 100;
-			if (sndLev.left > 0x7fff) sndLev.left = 0x7fff;
-			if (sndLev.right > 0x7fff) sndLev.right = 0x7fff;
-
-			smpBuf[sb_pos & 127] = sndLev;
-			sb_pos++;
-			if ((sb_pos % DISCRATE) == 0) {
-				tmpLev.left = 0;
-				tmpLev.right = 0;
-#if USEKIH
-				sp_pos = sb_pos - DISCRATE;
-				for (int i = 0; i < DISCRATE; i++) {
-					tmpLev.left += smpBuf[sp_pos & 127].left * H[i];
-					tmpLev.right += smpBuf[sp_pos & 127].right * H[i];
-					sp_pos++;
-				}
-#else
-				sp_pos = sb_pos - DISCRATE;
-				for (int i = 0; i < DISCRATE; i++) {
-					tmpLev.left += smpBuf[sp_pos & 127].left;
-					tmpLev.right += smpBuf[sp_pos & 127].right;
-					sp_pos++;
+			if (bl->rate != conf.snd.rate)
+				blepSetRate(bl, conf.snd.rate);
+			lev = comp->hw->vol(comp, &conf.snd.vol);
+			lev.left = lev.left * conf.snd.vol.master / 100;
+			lev.right = lev.right * conf.snd.vol.master / 100;
+			if (lev.left > 0x7fff) lev.left = 0x7fff;
+			if (lev.right > 0x7fff) lev.right = 0x7fff;
+			blepSync(bl, nsPerSample);
+			blepLevel(bl, lev);
+			while ((cnt = blepRead(bl, smp, 16)) > 0) {
+				for (i = 0; i < cnt; i++) {
+					sndLev = smp[i];
+					if (sndLev.left > 0x7fff) sndLev.left = 0x7fff;		// filter overshoot
+					if (sndLev.left < -0x8000) sndLev.left = -0x8000;
+					if (sndLev.right > 0x7fff) sndLev.right = 0x7fff;
+					if (sndLev.right < -0x8000) sndLev.right = -0x8000;
+					if (!conf.snd.enabled) {
+						sndLev.left = 0;
+						sndLev.right = 0;
+					}
+					if (conf.snd.need > 0)
+						conf.snd.need--;
+					sbuf[posf & 0x3fff] = sndLev.left & 0xff;
+					posf++;
+					sbuf[posf & 0x3fff] = (sndLev.left >> 8) & 0xff;
+					posf++;
+					sbuf[posf & 0x3fff] = sndLev.right & 0xff;
+					posf++;
+					sbuf[posf & 0x3fff] = (sndLev.right >> 8) & 0xff;
+					posf++;
 				}
-				tmpLev.left /= DISCRATE;
-				tmpLev.right /= DISCRATE;
-#endif
-				sndLev = tmpLev;
-				tmpLev.left = 0;
-				tmpLev.right = 0;
-//				disCount = 0;
-
-				if (!conf.snd.enabled) {
-					sndLev.left = 0;
-					sndLev.right = 0;
-				}
-				if (conf.snd.need > 0)
-					conf.snd.need--;
-
-				sbuf[posf & 0x3fff] = sndLev.left & 0xff;
-				posf++;
-				sbuf[posf & 0x3fff] = (sndLev.left >> 8) & 0xff;
-				posf++;
-				sbuf[posf & 0x3fff] = sndLev.right & 0xff;
-				posf++;
-				sbuf[posf & 0x3fff] = (sndLev.right >> 8) & 0xff;
-				posf++;
 			}
 			smpCount++;
 		}
@@ -133,7 +109,7 @@ void setOutput(const char* name) {
 		printf("Can't open sound system '%s'. Reset to NULL\n",name);
 		setOutput("NULL");
 	}
-	nsPerSample = 1e9 / conf.snd.rate / DISCRATE;
+	nsPerSample = 1e9 / conf.snd.rate / BLEP_POLL;
 }
 
 void sndClose() {
@@ -305,28 +281,6 @@ OutSys* findOutSys(const char* name) {
 	return res;
 }
 
-void init_kih() {
-	long double Fd = conf.snd.rate * DISCRATE;
-	long double Fs = 20;
-	long double Fx = 40;
-	long double H_id [DISCRATE] = {0};
-	long double W[DISCRATE] = {0};
-	long double Fc = (Fs + Fx) / (2 * Fd);
-	int i;
-	for (i = 0; i < DISCRATE; i++) {
-		if (i == 0) {
-			H_id[i] = 2 * M_PI * Fc;
-		} else {
-			H_id[i] = sinl(2 * M_PI * Fc * i) / (M_PI * i);
-		}
-		W[i] = 0.42 + 0.5 * cosl((2 * M_PI * i) / (DISCRATE - 1)) + 0.08 * cosl((4 * M_PI * i) / (DISCRATE - 1));
-		H[i] = H_id[i] * W[i];
-	}
-	double sum = 0;
-	for (i = 0; i < DISCRATE; i++) sum += H[i];
-	for (i = 0; i < DISCRATE; i++) H[i] /= sum;
-}
-
 void sndInit() {
 	conf.snd.rate = 44100;
 	conf.snd.chans = 2;
@@ -339,7 +293,6 @@ void sndInit() {
 	conf.snd.wavout = 0;
 	conf.snd.wavfile = NULL;
 	initNoise();
-	init_kih();
 }
 
 // output to wav
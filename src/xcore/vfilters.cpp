@@ -1,6 +1,13 @@
 #include <QColor>
 #include <math.h>
+#include <string.h>
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	#include <arm_neon.h>
+#endif
 #include "vfilters.h"
+#include "../libxpeccy/video/video.h"
 
 // Linear->sRGB conversion table
 static unsigned char linear_to_srgb[256];
@@ -12,7 +19,11 @@ static inline float clampf(float x, float lo, float hi) {
 	return fminf(fmaxf(x, lo), hi);
 }
 
+// Ring buffer is used for antiflicker to store the history of frames.
+// At least 5 frames are required to perform basic 3-Color mode detection.
 #define RING_FRAMES 5
+unsigned char pscr[SCRBUF_SIZE*RING_FRAMES] __attribute__((aligned(4)));
+
 float last_gamma = 0;
 uint32_t *ring_base = NULL;
 static int ring_head = 0; // last frame idx
@@ -50,47 +61,47 @@ static void rebuild_gamma_lut(float gamma) {
 }
 
 // - Blending functions --------------------------------------------------------
-// Gigascreen blending via LUTs
-static uint32_t blend_2c(uint32_t p0, uint32_t p1, float ratio) {
+// Blending tables: float math is done once per ratio/gamma change, pixels are mixed by lookups only.
+// mix2c[frame1][frame0]: sRGB components in, 2C blend in linear light (sRGB) out
+// mix3c[avg][frame0]: linear components in (avg = average of 3 frames), 3C blend out
+static unsigned char mix2c[256][256];
+static unsigned char mix3c[256][256];
+static float last_ratio = -1;
+
+static int mix_index(int c1, int c0, float ratio) {
 	const double ratio_rev = 1.0 - ratio;
+	int v = int(c1 * ratio + c0 * ratio_rev);
+	return (v < 0) ? 0 : ((v > 255) ? 255 : v);
+}
 
-	// Extract RGB pixel components for current frame (RGBA packed format)
-	unsigned char frame0_r = srgb_to_linear[p0 & 0xFF];
-	unsigned char frame0_b = srgb_to_linear[(p0 >> 16) & 0xFF];
-	unsigned char frame0_g = srgb_to_linear[(p0 >> 8) & 0xFF];
-
-	// Extract RGB pixel components for previous frame (RGBA packed format)
-	unsigned char frame1_r = srgb_to_linear[p1 & 0xFF];
-	unsigned char frame1_g = srgb_to_linear[(p1 >> 8) & 0xFF];
-	unsigned char frame1_b = srgb_to_linear[(p1 >> 16) & 0xFF];
+static void rebuild_mix_lut(float ratio) {
+	const float ratio_x2 = ratio * 2.0;
+	for (int c1 = 0; c1 < 256; c1++) {
+		for (int c0 = 0; c0 < 256; c0++) {
+			mix2c[c1][c0] = linear_to_srgb[mix_index(srgb_to_linear[c1], srgb_to_linear[c0], ratio)];
+			mix3c[c1][c0] = linear_to_srgb[mix_index(c1, c0, ratio_x2)];
+		}
+	}
+	last_ratio = ratio;
+}
 
-	// Look up precomputed blended components in encoded (8-bit) space
-	return 	linear_to_srgb[int(frame1_r * ratio + frame0_r * ratio_rev)] |
-			linear_to_srgb[int(frame1_g * ratio + frame0_g * ratio_rev)] << 8 |
-			linear_to_srgb[int(frame1_b * ratio + frame0_b * ratio_rev)] << 16;
+// Gigascreen blending via LUTs
+static inline uint32_t blend_2c(uint32_t p0, uint32_t p1) {
+	return	mix2c[p1 & 0xFF][p0 & 0xFF] |
+		mix2c[(p1 >> 8) & 0xFF][(p0 >> 8) & 0xFF] << 8 |
+		mix2c[(p1 >> 16) & 0xFF][(p0 >> 16) & 0xFF] << 16;
 }
 
 // 3-Color blending in linear light using LUTs
-static uint32_t blend_3c(uint32_t p0, uint32_t p1, uint32_t p2, float ratio) {
-	const double ratio_rev = 1.0 - ratio;
-
-	// Decode RGB components from RGBA encoded space to linear colorspace (sRGB -> linear)
-	unsigned char frame0_r = srgb_to_linear[p0 & 0xFF];
-	unsigned char frame0_b = srgb_to_linear[(p0 >> 16) & 0xFF];
-	unsigned char frame0_g = srgb_to_linear[(p0 >> 8) & 0xFF];
-
-	unsigned char frame1_r = srgb_to_linear[p1 & 0xFF];
-	unsigned char frame1_g = srgb_to_linear[(p1 >> 8) & 0xFF];
-	unsigned char frame1_b = srgb_to_linear[(p1 >> 16) & 0xFF];
-
-	unsigned char frame2_r = srgb_to_linear[p2 & 0xFF];
-	unsigned char frame2_g = srgb_to_linear[(p2 >> 8) & 0xFF];
-	unsigned char frame2_b = srgb_to_linear[(p2 >> 16) & 0xFF];
-
-	// Encode averaged linear components back to RGBA encoded space (linear -> sRGB)
-	return 	linear_to_srgb[int((frame0_r + frame1_r + frame2_r) / 3 * ratio + frame0_r * ratio_rev)] |
-			linear_to_srgb[int((frame0_g + frame1_g + frame2_g) / 3 * ratio + frame0_g * ratio_rev)] << 8 |
-			linear_to_srgb[int((frame0_b + frame1_b + frame2_b) / 3 * ratio + frame0_b * ratio_rev)] << 16;
+static inline uint32_t blend_3c(uint32_t p0, uint32_t p1, uint32_t p2) {
+	uint32_t res = 0;
+	for (int sh = 0; sh < 24; sh += 8) {
+		int c0 = srgb_to_linear[(p0 >> sh) & 0xFF];
+		int c1 = srgb_to_linear[(p1 >> sh) & 0xFF];
+		int c2 = srgb_to_linear[(p2 >> sh) & 0xFF];
+		res |= mix3c[(c0 + c1 + c2) / 3][c0] << sh;
+	}
+	return res;
 }
 
 // Check if RGBA pixel has more than one color component
@@ -105,86 +116,96 @@ static bool rgb_has_multi_component(uint32_t c) {
 	return ((r != 0) + (g != 0) + (b != 0)) > 1;
 }
 
-// blend src into dst with weight `mass` in linear space (sRGB-correct),
-// then store original dst back to src for the next frame.
-// sRGB colorspace in Gigascreen reference: https://hype.retroscene.org/blog/graphics/808.html
-void scrMix(unsigned char* src, unsigned char* dst, int size, double ratio, float gamma, int mode) {
-	const double ratio_x2 = ratio * 2.0;
-
-	// Init ring buffer pointer if not set yet
-	if (ring_base == NULL) { ring_base = (uint32_t *)src; }
-	// Rebuild gamma LUTs if Gamma value has changed
-	if (last_gamma != gamma) { rebuild_gamma_lut(gamma); }
-
-#undef LEGACY_ANTIFLICK
-#ifdef LEGACY_ANTIFLICK
-	unsigned char cur;
-	const double ratio_rev = 1.0 - ratio;
+// is next 4 pixels are the same in 3 last frames: all modes keep them
+static inline bool mix_static4(const uint32_t* p0, const uint32_t* p1, const uint32_t* p2) {
+#if defined(__SSE2__)
+	__m128i v0 = _mm_loadu_si128((const __m128i*)p0);
+	__m128i eq = _mm_and_si128(_mm_cmpeq_epi32(v0, _mm_loadu_si128((const __m128i*)p1)),
+				   _mm_cmpeq_epi32(v0, _mm_loadu_si128((const __m128i*)p2)));
+	return _mm_movemask_epi8(eq) == 0xFFFF;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	uint32x4_t v0 = vld1q_u32(p0);
+	uint32x4_t eq = vandq_u32(vceqq_u32(v0, vld1q_u32(p1)), vceqq_u32(v0, vld1q_u32(p2)));
+	return vminvq_u32(eq) == 0xFFFFFFFF;
+#else
+	return (p0[0] == p1[0]) && (p0[0] == p2[0]) && (p0[1] == p1[1]) && (p0[1] == p2[1])
+		&& (p0[2] == p1[2]) && (p0[2] == p2[2]) && (p0[3] == p1[3]) && (p0[3] == p2[3]);
+#endif
+}
 
-	while (size > 0) {
-		cur = *dst;
-		if (size %4 != 1)
-		*dst = linear_to_srgb[int(srgb_to_linear[*src] * ratio + srgb_to_linear[*dst] * ratio_rev)];
-		*src = cur;
-		src++;
-		dst++;
-		size--;
+// last blended colors: neighbour pixels are mostly the same
+typedef struct {
+	uint32_t c0, c1, c2;
+	uint32_t res;
+} xMixMemo;
+
+static inline uint32_t blend_2c_memo(xMixMemo* m, uint32_t c0, uint32_t c1) {
+	if ((m->c0 != c0) || (m->c1 != c1)) {
+		m->c0 = c0;
+		m->c1 = c1;
+		m->res = blend_2c(c0, c1);
 	}
-#else
+	return m->res;
+}
 
-	// screen is in GL_RGBA 32-bit format: Red,Green,Blue,Alpha
-	size /= 4;
-	// re-cast pointer to uint32_t* as we're going to process RGB-data at once
-	uint32_t *p0 = reinterpret_cast<uint32_t*>(dst);
-	uint32_t *p1 = ring_get_frame(0, size);
-	uint32_t *p2 = ring_get_frame(1, size);
-	uint32_t *p3 = ring_get_frame(2, size);
-	uint32_t *p4 = ring_get_frame(3, size);
-	uint32_t *p5 = ring_get_frame(4, size);
-	ring_rotate();
+static inline uint32_t blend_3c_memo(xMixMemo* m, uint32_t c0, uint32_t c1, uint32_t c2) {
+	if ((m->c0 != c0) || (m->c1 != c1) || (m->c2 != c2)) {
+		m->c0 = c0;
+		m->c1 = c1;
+		m->c2 = c2;
+		m->res = blend_3c(c0, c1, c2);
+	}
+	return m->res;
+}
 
-	while (size > 0) {
+// mix cnt pixels, mode is resolved at compile time
+template <int MODE>
+static void mix_line(uint32_t* p0, uint32_t* p1, uint32_t* p2, uint32_t* p3, uint32_t* p4, uint32_t* p5, int cnt) {
+	// memos start as black blended with black, that is black
+	xMixMemo m2 = {0, 0, 0, 0};
+	xMixMemo m3 = {0, 0, 0, 0};
+	while (cnt > 0) {
+		// static pixels by 4: only store to ring
+		if ((cnt >= 4) && mix_static4(p0, p1, p2)) {
+			memcpy(p5, p0, 4 * sizeof(uint32_t));
+			p0 += 4; p1 += 4; p2 += 4; p3 += 4; p4 += 4; p5 += 4;
+			cnt -= 4;
+			continue;
+		}
 		const uint32_t c0 = *p0; // current pixel color
 		const uint32_t c1 = *p1;
 		const uint32_t c2 = *p2;
-		const uint32_t c3 = *p3;
-		const uint32_t c4 = *p4;
-		const uint32_t c5 = *p5;
 		uint32_t output_color = c0;
-		bool multi_components;
 
-		switch (mode) {
+		switch (MODE) {
 		// 2C+3C (adaptive)
 		case AF_3C_ADAPTIVE:
 			// skip static pixels
 			if (c0 == c1 && c0 == c2)
 				break;
 
-			// 3Color simple check
-			multi_components =	rgb_has_multi_component(c0) ||
-								rgb_has_multi_component(c1) ||
-								rgb_has_multi_component(c2);
-			// static RGB-image check
-			if (!multi_components && c0 == c3 && c1 == c4 && c2 == c5) {
-				output_color = blend_3c(c0, c1, c2, ratio_x2);
+			// 3Color simple check + static RGB-image check
+			if (!rgb_has_multi_component(c0) && !rgb_has_multi_component(c1) && !rgb_has_multi_component(c2)
+				&& c0 == *p3 && c1 == *p4 && c2 == *p5) {
+				output_color = blend_3c_memo(&m3, c0, c1, c2);
 			} else {
 				// fallback to 2C blending
 				if (c0 == c2 && c0 != c1)
-					output_color = blend_2c(c0, c1, ratio);
+					output_color = blend_2c_memo(&m2, c0, c1);
 			}
 			break;
 
 		// 2C only (adaptive)
 		case AF_2C_ADAPTIVE:
 			if (c0 == c2 && c0 != c1)
-				output_color = blend_2c(c0, c1, ratio);
+				output_color = blend_2c_memo(&m2, c0, c1);
 			break;
 
 		// 2C only (fullscreen)
 		case AF_2C_FULL:
 			// blend only on changed pixel
 			if (c0 != c1)
-				output_color = blend_2c(c0, c1, ratio);
+				output_color = blend_2c_memo(&m2, c0, c1);
 			break;
 
 		// 3C only (fullscreen)
@@ -193,10 +214,7 @@ void scrMix(unsigned char* src, unsigned char* dst, int size, double ratio, floa
 			if (c0 == c1 && c0 == c2)
 				break;
 
-			output_color = blend_3c(c0, c1, c2, ratio_x2);
-			break;
-
-		default:
+			output_color = blend_3c_memo(&m3, c0, c1, c2);
 			break;
 		}
 
@@ -206,7 +224,53 @@ void scrMix(unsigned char* src, unsigned char* dst, int size, double ratio, floa
 		p2++;
 		p3++;
 		p4++;
-		size--;
+		cnt--;
+	}
+}
+
+// blend src into dst with weight `mass` in linear space (sRGB-correct),
+// then store original dst back to src for the next frame.
+// sRGB colorspace in Gigascreen reference: https://hype.retroscene.org/blog/graphics/808.html
+// Screen is processed by lines: lines which are the same in 3 last frames are only stored to ring.
+void scrMix(unsigned char* src, unsigned char* dst, int size, double ratio, float gamma, int mode) {
+	// Init ring buffer pointer if not set yet
+	if (ring_base == NULL) { ring_base = (uint32_t *)src; }
+	// Rebuild LUTs if Gamma or ratio value has changed
+	if (last_gamma != gamma) { rebuild_gamma_lut(gamma); last_ratio = -1; }
+	if (last_ratio != (float)ratio) { rebuild_mix_lut(ratio); }
+
+	// screen is in GL_RGBA 32-bit format: Red,Green,Blue,Alpha
+	size /= 4;
+	// re-cast pointer to uint32_t* as we're going to process RGB-data at once
+	uint32_t *p0 = reinterpret_cast<uint32_t*>(dst);
+	uint32_t *p1 = ring_get_frame(0, size);
+	uint32_t *p2 = ring_get_frame(1, size);
+	uint32_t *p3 = ring_get_frame(2, size);
+	uint32_t *p4 = ring_get_frame(3, size);
+	uint32_t *p5 = ring_get_frame(4, size);
+	ring_rotate();
+
+	const int line = (bytesPerLine >= 4) ? bytesPerLine / 4 : size;
+	while (size > 0) {
+		const int cnt = (size < line) ? size : line;
+		const size_t len = cnt * sizeof(uint32_t);
+		if (!memcmp(p0, p1, len) && !memcmp(p0, p2, len)) {
+			memcpy(p5, p0, len);
+		} else {
+			switch (mode) {
+				case AF_3C_ADAPTIVE: mix_line<AF_3C_ADAPTIVE>(p0, p1, p2, p3, p4, p5, cnt); break;
+				case AF_2C_ADAPTIVE: mix_line<AF_2C_ADAPTIVE>(p0, p1, p2, p3, p4, p5, cnt); break;
+				case AF_2C_FULL: mix_line<AF_2C_FULL>(p0, p1, p2, p3, p4, p5, cnt); break;
+				case AF_3C_FULL: mix_line<AF_3C_FULL>(p0, p1, p2, p3, p4, p5, cnt); break;
+				default: memcpy(p5, p0, len); break;
+			}
+		}
+		p0 += cnt;
+		p1 += cnt;
+		p2 += cnt;
+		p3 += cnt;
+		p4 += cnt;
+		p5 += cnt;
+		size -= cnt;
 	}
-#endif
 }
@@ -7,4 +7,6 @@ enum {
 	AF_3C_ADAPTIVE
 };
 
+extern unsigned char pscr[];
+
 void scrMix(unsigned char *src, unsigned char *p0, int size, double mass, float gamma, int mode);
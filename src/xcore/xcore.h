@@ -17,9 +17,12 @@
 #include <QFont>
 #include <QSize>
 #include <QMap>
+#include <QAtomicInt>
 
 #include "../libxpeccy/spectrum.h"
 #include "../libxpeccy/filetypes/filetypes.h"
+#include "../libxpeccy/rewind.h"
+#include "../libxpeccy/trace.h"
 #include "gamepad.h"
 
 #ifndef USEMUTEX
@@ -303,11 +306,13 @@ enum {
 //	XCUT_TVLINES,
 	XCUT_WAV_OUT,
 	XCUT_RELOAD_SHD,
+	XCUT_REWIND,
 
 	XCUT_STEPIN,
 	XCUT_STEPOVER,
 	XCUT_STEPOUT,
 	XCUT_FASTSTEP,
+	XCUT_STEPBACK,
 	XCUT_TMPBRK,
 	XCUT_TRACE,
 	XCUT_OPEN_DUMP,
@@ -392,6 +397,8 @@ typedef struct {
 xRomset* findRomset(std::string);
 bool addRomset(xRomset);
 void delRomset(int);
+xRomImage* romsetImage(xRomset*);
+xRomImage* romsetGsImage(xRomset*);
 
 // layouts
 
@@ -432,6 +439,9 @@ struct xConfig {
 	struct {
 		unsigned fast:1;
 		int pause;
+		int rewind;		// rewind ring size, MB (0 = off)
+		QAtomicInt back;	// rewind steps requested by gui, done in emulation thread
+		xRewind* rwd;
 	} emu;
 	struct {
 		QList<xProfile*> list;
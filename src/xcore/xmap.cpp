@@ -59,16 +59,16 @@ void load_xmap(QString path) {
 				len = qfgeti(file);
 				if (!memcmp(buf, "ramflags", 8)) {
 					if (len <= MEM_4M) {
-						file.read((char*)comp->brkRamMap, len);
+						file.read((char*)comp_brk_map(comp, MEM_RAM), len);
 					} else {
-						file.read((char*)comp->brkRamMap, MEM_4M);
+						file.read((char*)comp_brk_map(comp, MEM_RAM), MEM_4M);
 						file.seek(file.pos() + len - MEM_4M);
 					}
 				} else if (!memcmp(buf, "romflags", 8)) {
 					if (len <= MEM_512K) {
-						file.read((char*)comp->brkRomMap, len);
+						file.read((char*)comp_brk_map(comp, MEM_ROM), len);
 					} else {
-						file.read((char*)comp->brkRomMap, MEM_512K);
+						file.read((char*)comp_brk_map(comp, MEM_ROM), MEM_512K);
 						file.seek(file.pos() + len - MEM_512K);
 					}
 				} else if (!memcmp(buf, "sltflags", 8)) {
@@ -79,6 +79,7 @@ void load_xmap(QString path) {
 							file.read((char*)comp->slot->brkMap, comp->slot->memMask + 1);
 							file.seek(file.pos() + len - comp->slot->memMask - 1);
 						}
+						comp_upd_slot_brk(comp);
 					}
 				} else if (!memcmp(buf, "labels  ", 8)) {
 					set = newLabelSet(QString("xmap.%0").arg(cnt));
@@ -182,11 +183,11 @@ void save_xmap(QString path) {
 			// ram map
 			file.write("ramflags", 8);
 			qfputi(file, comp->mem->ramMask + 1);				// to aviod zx48k with 64K ram and 128K mask
-			file.write((char*)comp->brkRamMap, comp->mem->ramMask + 1);
+			file.write((char*)comp_brk_map(comp, MEM_RAM), comp->mem->ramMask + 1);
 			// rom map
 			file.write("romflags", 8);
 			qfputi(file, comp->mem->romSize);
-			file.write((char*)comp->brkRomMap, comp->mem->romSize);
+			file.write((char*)comp_brk_map(comp, MEM_ROM), comp->mem->romSize);
 			// cartrige map
 			file.write("sltflags", 8);
 			if (comp->slot->brkMap) {
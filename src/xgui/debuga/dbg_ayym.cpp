@@ -92,6 +92,7 @@ void xAYWidget::draw() {
 		case 3: chp = comp->ts->chipD; break;
 		default: chp = comp->ts->chipA; break;
 	}
+	ay_render(chp);			// play pending ticks: counters/levels are actual then
 	ui.leToneA->setText(gethexword(((chp->reg[1] << 8) | chp->reg[0]) & 0x0fff));
 	ui.leToneB->setText(gethexword(((chp->reg[3] << 8) | chp->reg[2]) & 0x0fff));
 	ui.leToneC->setText(gethexword(((chp->reg[5] << 8) | chp->reg[4]) & 0x0fff));
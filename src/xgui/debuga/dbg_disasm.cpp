@@ -369,7 +369,7 @@ QList<dasmData> getDisasm(Computer* comp, int& adr) {
 			xadr.bank = page << 6;
 			xadr.adr = adr & 0x3fff;
 			xadr.abs = xadr.adr | (page << 14);
-			drow.flag = comp->brkRamMap[xadr.abs & comp->mem->ramMask];
+			drow.flag = comp_brk_map(comp, MEM_RAM)[xadr.abs & comp->mem->ramMask];
 			drow.ispc = ((xadr.type == pct) && (abs == xadr.abs)) ? 1 : 0;
 			break;
 		case XVIEW_ROM:
@@ -377,7 +377,7 @@ QList<dasmData> getDisasm(Computer* comp, int& adr) {
 			xadr.bank = page << 6;
 			xadr.adr = adr & 0x3fff;
 			xadr.abs = xadr.adr | (page << 14);
-			drow.flag = comp->brkRomMap[xadr.abs & comp->mem->romMask];
+			drow.flag = comp_brk_map(comp, MEM_ROM)[xadr.abs & comp->mem->romMask];
 			drow.ispc = ((xadr.type == pct) && (abs == xadr.abs)) ? 1 : 0;
 			break;
 		default:
@@ -86,7 +86,7 @@ QVariant xDiskDumpModel::data(const QModelIndex& idx, int role) const {
 			if (col > 8) break;
 			if (offset >= flp->trklen) break;
 			if (!flp->insert) break;
-			ch = flp->data[trk].field[offset];
+			ch = flp_trk(flp, trk)->field[offset];
 			switch(ch & 0x0f) {
 				case 1:			// id
 					res = QColor(220, 220, 255);
@@ -118,7 +118,7 @@ QVariant xDiskDumpModel::data(const QModelIndex& idx, int role) const {
 				pos = 0;
 				while (pos < 8) {
 					if (adr < flp->trklen) {
-						ch = flp->data[trk].byte[adr];
+						ch = flp_trk(flp, trk)->byte[adr];
 						if ((ch < 32) || (ch > 127))
 							ch = '.';
 					} else {
@@ -130,7 +130,7 @@ QVariant xDiskDumpModel::data(const QModelIndex& idx, int role) const {
 				buf[pos] = 0;
 			} else if (offset < flp->trklen) {
 				if (flp->insert) {
-					sprintf(buf, "%.2X", flp->data[trk].byte[offset]);
+					sprintf(buf, "%.2X", flp_trk(flp, trk)->byte[offset]);
 				} else {
 					strcpy(buf, "FF");
 				}
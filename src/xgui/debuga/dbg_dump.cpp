@@ -59,14 +59,14 @@ int xDumpModel::mrd(int adr) const {
 			case XVIEW_RAM:
 				adr &= 0x3fff;
 				adr |= (page << 14);
-				res = comp->mem->ramData[adr & 0x3fffff];
-				res |= comp->brkRamMap[adr & 0x3fffff] << 8;
+				res = comp->mem->ramData[adr & comp->mem->ramMask];
+				res |= comp_brk_map(comp, MEM_RAM)[adr & 0x3fffff] << 8;
 				break;
 			case XVIEW_ROM:
 				adr &= 0x3fff;
 				adr |= (page << 14);
-				res = comp->mem->romData[adr & 0x7ffff];
-				res |= comp->brkRomMap[adr & 0x7ffff] << 8;
+				res = comp->mem->romData[adr & comp->mem->romMask];
+				res |= comp_brk_map(comp, MEM_ROM)[adr & 0x7ffff] << 8;
 				break;
 		}
 	}
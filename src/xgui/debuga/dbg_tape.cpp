@@ -17,7 +17,8 @@ void xTapeWidget::draw() {
 	Tape* tape = comp->tape;
 	drawHBar(ui.labTapein, tape->volPlay, 256);
 	drawHBar(ui.labTapeout, tape->levRec, 1);
-	ui.labSigLen->setText(tape->on ? QString("%0 mks").arg(tape->sigLen) : "");
+	int sigLen = tape->sigLen - tape->time / TAPTICKNS;		// tapSync counts time only until signal ends
+	ui.labSigLen->setText(tape->on ? QString("%0 mks").arg(sigLen) : "");
 	ui.labTapeState->setText(tape->on ? (tape->rec ? "rec" : "play") : "stop");
 	ui.labTapePos->setText(tape->on ? QString::number(tape->pos - 1) : "--");
 	// draw tape diagram
@@ -42,7 +43,7 @@ void xTapeWidget::draw() {
 		bnr = tape->block;
 		blk = &tape->blkData[bnr];
 		pos = tape->pos;
-		time = tape->sigLen + (wid / 2) * XTDSTEP;
+		time = sigLen + (wid / 2) * XTDSTEP;
 		while ((time >= 0) && (blk != NULL)) {
 			pos--;
 			if (pos < 0) {
@@ -54,7 +55,7 @@ void xTapeWidget::draw() {
 					pos = blk->sigCount - 1;
 				}
 			} else {
-				time -= blk->data[pos].size;
+				time -= blkGetSignal(blk, pos).size;
 			}
 		}
 		if (blk == NULL) {
@@ -62,14 +63,14 @@ void xTapeWidget::draw() {
 			pos = 0;
 			blk = &tape->blkData[bnr];
 			x = time / XTDSTEP;		// skip
-			time = blk->data[pos].size;
+			time = blkGetSignal(blk, pos).size;
 		} else {
 			x = 0;
-			time += blk->data[pos].size;	// remaining time
+			time += blkGetSignal(blk, pos).size;	// remaining time
 		}
 		while (x < wid) {
 			if (pos < blk->sigCount) {
-				amp = hei - blk->data[pos].vol * hei / 256;
+				amp = hei - blkGetSignal(blk, pos).vol * hei / 256;
 				if (oamp < 0)
 					oamp = amp;
 				while ((time > 0) && (x < wid)) {
@@ -80,13 +81,13 @@ void xTapeWidget::draw() {
 				}
 				pos++;
 				if (pos < blk->sigCount)
-					time += blk->data[pos].size;
+					time += blkGetSignal(blk, pos).size;
 			} else {
 				bnr++;
 				if (bnr < tape->blkCount) {
 					blk = &tape->blkData[bnr];
 					pos = 0;
-					time += blk->data[pos].size;
+					time += blkGetSignal(blk, pos).size;
 				} else {
 					x = wid;
 				}
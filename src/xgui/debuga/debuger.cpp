@@ -155,6 +155,7 @@ void DebugWin::start() {
 		activateWindow();
 		return;
 	}
+	endTraceLog();
 	blockStart = -1;
 	blockEnd = -1;
 	save_mem_map();
@@ -162,6 +163,7 @@ void DebugWin::start() {
 	if (comp->hw->grp != tabMode) {
 		onPrfChange();		// update tabs
 	}
+	vid_flush(comp->vid);
 	if (!comp->vid->tail)
 		vid_dark_tail(comp->vid);
 
@@ -198,6 +200,7 @@ void DebugWin::stop() {
 	comp->flgDBG = 0;		// back to normal work, turn breakpoints on
 	comp->vid->debug = 0;
 	comp->flgMAP = ui_asm.actMaping->isChecked() ? 1 : 0;
+	comp_upd_fast(comp);
 	stopTrace();
 
 	memViewer->vis = memViewer->isVisible() ? 1 : 0;
@@ -657,7 +660,10 @@ void DebugWin::chDumpView() {
 }
 */
 
-static QFile logfile;
+// DBG_TRACE_LOG: binary trace is recorded by core to logpath.trc while emulation runs freely (debugger is closed),
+// it's rendered to csv logpath when debugger is opened again (by user or breakpoint)
+static xTrace* tracer = NULL;
+static QString logpath;
 
 void DebugWin::doStep() {
 	Computer* comp = conf.prof.cur->zx;
@@ -682,19 +688,10 @@ void DebugWin::doTrace(QAction* act) {
 	if (traceType == DBG_TRACE_LOG) {
 		QString path = QFileDialog::getSaveFileName(this, "Log file",QString(),QString(),nullptr,QFileDialog::DontUseNativeDialog);
 		if (path.isEmpty()) return;
-		logfile.setFileName(path);
-		if (!logfile.open(QFile::WriteOnly)) return;
-		logfile.write("addr|command");
-		xRegBunch regs = cpuGetRegs(conf.prof.cur->zx->cpu);
-		int i = 0;
-		while (regs.regs[i].id != REG_EOT) {
-			if (regs.regs[i].id != REG_EMPTY) {
-				logfile.write("|");
-				logfile.write(regs.regs[i].name);
-			}
-			i++;
-		}
-		logfile.write("\n");
+		logpath = path;
+		tracer = trc_create(conf.prof.cur->zx, QString(path).append(".trc").toLocal8Bit().data(), 0);
+		if (tracer) stop();
+		return;
 	}
 
 	trace = 1;
@@ -706,7 +703,20 @@ void DebugWin::doTrace(QAction* act) {
 void DebugWin::stopTrace() {
 	trace = 0;
 	ui_asm.tbTrace->setEnabled(true);
-	if (logfile.isOpen()) logfile.close();
+}
+
+void DebugWin::endTraceLog() {
+	if (tracer) {
+		trc_destroy(tracer);
+		tracer = NULL;
+		QString trcpath = QString(logpath).append(".trc");
+		FILE* file = fopen(logpath.toLocal8Bit().data(), "wb");
+		if (file) {
+			trc_decode(trcpath.toLocal8Bit().data(), file, 1);
+			fclose(file);
+		}
+		QFile::remove(trcpath);
+	}
 }
 
 void DebugWin::reload() {
@@ -762,7 +772,7 @@ void DebugWin::keyPressEvent(QKeyEvent* ev) {
 			len = dasmSome(comp, pc + comp->cpu->cs.base, drow);
 			if (drow.oflag & OF_SKIPABLE) {
 				ptr = getBrkPtr(comp, pc + comp->cpu->cs.base + len);
-				*ptr |= MEM_BRK_TFETCH;
+				setBrk(comp, pc + comp->cpu->cs.base + len, *ptr | MEM_BRK_TFETCH);
 				stop();
 			} else {
 				doStep();
@@ -773,6 +783,11 @@ void DebugWin::keyPressEvent(QKeyEvent* ev) {
 			comp->cpu->regCallCnt = 0;
 			stop();
 			break;
+		case XCUT_STEPBACK:
+			if (!conf.emu.rwd || !rw_step_back(conf.emu.rwd, comp)) break;
+			if (!fillAll())
+				ui_asm.dasmTable->setAdr(cpu_get_pc(comp->cpu) + comp->cpu->cs.base);
+			break;
 		case XCUT_FASTSTEP:
 			for (i = 10; i > 0; i--)
 				doStep();
@@ -783,7 +798,7 @@ void DebugWin::keyPressEvent(QKeyEvent* ev) {
 			i = ui_asm.dasmTable->getData(idx.row(), 0, Qt::UserRole).toInt();
 			ptr = getBrkPtr(comp, i);
 			stop();
-			*ptr |= MEM_BRK_TFETCH;
+			setBrk(comp, i, *ptr | MEM_BRK_TFETCH);
 			break;
 		case XCUT_RESET:
 			rzxStop(comp);
@@ -838,51 +853,11 @@ void DebugWin::keyReleaseEvent(QKeyEvent* ev) {
 	}
 }
 
-static xRegBunch traceregs;
-static QString tracestr;
-static dasmData tracemnm;
-extern int dasmrd(int, void*);
-
 void DebugWin::customEvent(QEvent* ev) {
 	Computer* comp = conf.prof.cur->zx;
-	int pcadr = cpu_get_pc(comp->cpu);
 	switch(ev->type()) {
 		case DBG_EVENT_STEP:
-			if ((traceType == DBG_TRACE_LOG) && logfile.isOpen()) {
-				dasmSome(comp, pcadr + comp->cpu->cs.base, tracemnm);
-				tracestr = "\"";			// to avoid numbers conversion, like 3e4->3000
-				if (comp->cpu->core->group == CPUG_X86) {
-					tracestr.append(cpu_get_regtype(comp->cpu, REG_CS)); //  gethexword(comp->cpu->cs.idx));
-					tracestr.append(":");
-					tracestr.append(gethexword(pcadr));
-				} else {
-					tracestr.append(gethexword(pcadr));
-				}
-				tracestr.append("\"|");
-				doStep();
-				traceregs = cpuGetRegs(comp->cpu);
-				tracestr.append(tracemnm.command);
-				int i = 0;
-				while (traceregs.regs[i].id != REG_EOT) {
-					if (traceregs.regs[i].id != REG_EMPTY) {			// mustn't be visible
-						tracestr.append("|\"");
-						// tracestr.append(traceregs.regs[i].name).append(":");
-						switch(traceregs.regs[i].size) {
-							case REG_BIT: tracestr.append(traceregs.regs[i].value ? "1" : "0"); break;
-							case REG_BYTE: tracestr.append(gethexbyte(traceregs.regs[i].value)); break;
-							case REG_WORD: tracestr.append(gethexword(traceregs.regs[i].value)); break;
-							case REG_24: tracestr.append(gethex6(traceregs.regs[i].value)); break;
-							case REG_32: tracestr.append(gethexint(traceregs.regs[i].value)); break;
-						}
-						tracestr.append("\"");
-					}
-					i++;
-				}
-				tracestr.append("\n");
-				logfile.write(tracestr.toUtf8());
-			} else {
-				doStep();
-			}
+			doStep();
 			switch(traceType) {
 				case DBG_TRACE_INT:
 					if (comp->cpu->intrq & comp->cpu->inten)
@@ -925,6 +900,7 @@ void DebugWin::fillTabs() {
 
 void DebugWin::fillNotCPU() {
 	Computer* comp = conf.prof.cur->zx;
+	comp_dev_sync(comp);		// devices state for widgets
 	ui_asm.labTcount->setText(QString("%0 / %1").arg(comp->tickCount - tCount).arg(comp->frmtCount));
 
 	fillMem();
@@ -1379,10 +1355,12 @@ void DebugWin::dumpChadr(int adr) {
 void DebugWin::mapClear() {
 	if (!areSure("Clear memory mapping?")) return;
 	Computer* comp = conf.prof.cur->zx;
+	unsigned char* ram = comp_brk_map(comp, MEM_RAM);
+	unsigned char* rom = comp_brk_map(comp, MEM_ROM);
 	int adr;
 	for (adr = 0; adr < 0x400000; adr++) {
-		comp->brkRamMap[adr] &= 0x0f;
-		if (adr < 0x80000) comp->brkRomMap[adr] &= 0x0f;
+		ram[adr] &= 0x0f;
+		if (adr < 0x80000) rom[adr] &= 0x0f;
 		if (comp->slot->data && (adr <= comp->slot->memMask))
 			comp->slot->brkMap[adr] &= 0x0f;
 	}
@@ -196,6 +196,7 @@ class DebugWin : public QMainWindow {
 		void doTrace(QAction*);
 		void doTraceHere();
 		void stopTrace();
+		void endTraceLog();
 
 		void doOpenDump();
 //		void doSaveDump();
@@ -275,6 +275,7 @@ SetupWin::SetupWin(QWidget* par):QDialog(par) {
 		ui.outbox->addItem(QString::fromLocal8Bit(sndTab[i].name));
 		i++;
 	}
+	ui.ratbox->addItem("96000",96000);
 	ui.ratbox->addItem("48000",48000);
 	ui.ratbox->addItem("44100",44100);
 	ui.ratbox->addItem("22050",22050);
@@ -791,7 +792,11 @@ void SetupWin::apply() {
 	noflic = ui.sldNoflic->value();
 	noflicMode = ui.cbNoflicMode->currentIndex();
 	noflicGamma = ui.sbNoflicGamma->value();
-	vid_set_grey(ui.grayscale->isChecked() ? 1 : 0);
+	greyScale = ui.grayscale->isChecked() ? 1 : 0;
+	foreach(xProfile* prf, conf.prof.list) {
+		if (prf->zx)
+			vid_set_grey(prf->zx->vid, greyScale);
+	}
 //	scanlines = ui.cbScanlines->isChecked() ? 1 : 0;
 	conf.scrShot.dir = std::string(ui.pathle->text().toLocal8Bit().data());
 	conf.scrShot.format = getRFText(ui.ssfbox);